@@ -33,6 +33,25 @@ public:
         double xi, double eta, double zeta
     );
 
+    /**
+     * Deformation gradient of many HEX8 elements at one natural point
+     * Works on SimdDouble::WIDTH elements per step. Elements whose
+     * reference Jacobian is singular (where computeHex8 throws) get
+     * valid[e] = false and F[e] = 0.
+     *
+     * @param refNodes  Reference node positions, one array per element
+     * @param defNodes  Current node positions, same order
+     * @param F         Output, resized to the element count
+     * @param valid     Output, resized to the element count
+     */
+    static void computeHex8Batch(
+        const std::vector<std::array<Vector3D, 8>>& refNodes,
+        const std::vector<std::array<Vector3D, 8>>& defNodes,
+        double xi, double eta, double zeta,
+        std::vector<Matrix3x3>& F,
+        std::vector<bool>& valid
+    );
+
     /**
      * Compute deformation gradient for TET4 element
      * TET4 has constant strain, so no natural coordinates needed
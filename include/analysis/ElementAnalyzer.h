@@ -2,9 +2,11 @@
 
 #include "core/Mesh.h"
 #include "core/Element.h"
+#include "core/ElementBuckets.h"
 #include "analysis/StrainTensor.h"
 #include "analysis/StressTensor.h"
 #include "analysis/MaterialModel.h"
+#include "mapper/PointMapper.h"
 #include <vector>
 #include <optional>
 #include <functional>
@@ -117,11 +119,12 @@ public:
     );
 
     /**
-     * Analyze entire mesh
+     * Analyze entire mesh on the thread pool
      * 
      * @param refMesh   Reference mesh
      * @param defMesh   Deformed mesh (must have same topology)
-     * @param progress  Optional progress callback (0-100)
+     * @param progress  Optional progress callback (0-100), called on the
+     *                  calling thread
      * @return Analysis results for all elements
      */
     MeshAnalysisResult analyzeMesh(
@@ -130,11 +133,59 @@ public:
         std::function<void(int)> progress = nullptr
     );
 
+    /**
+     * Analyze the flat -> bent deformation of a mapping without a mapped mesh
+     *
+     * F at every Gauss point of each flat element (HEX8: setGaussPoints,
+     * TET4: centroid) is taken from the mapper's analytic derivatives, all
+     * points in one batch; strain and stress follow as in analyzeMesh().
+     * The element center is the mean mapped Gauss point.
+     *
+     * @param flatMesh  Flat mesh (reference configuration, materials)
+     * @param mapper    Mapper built with the flat mesh's bounds
+     * @param progress  Optional progress callback (0-100)
+     */
+    MeshAnalysisResult analyzeMapping(
+        const Mesh& flatMesh,
+        const PointMapper& mapper,
+        std::function<void(int)> progress = nullptr
+    );
+
+    /**
+     * Recompute selected elements of an existing result on the thread pool
+     *
+     * @param indices  Positions in result.elementResults (element ID order)
+     *
+     * Counts and statistics are refreshed afterwards. Used to patch the
+     * results of a previous run after local changes to the deformed mesh.
+     */
+    void reanalyzeElements(
+        const Mesh& refMesh,
+        const Mesh& defMesh,
+        const std::vector<size_t>& indices,
+        MeshAnalysisResult& result
+    );
+
     /**
      * Validate mesh pair (same topology)
      */
     static bool validateMeshPair(const Mesh& mesh1, const Mesh& mesh2, std::string& error);
 
+    /**
+     * Recompute min/max/avg von Mises statistics from element results
+     */
+    static void computeStatistics(MeshAnalysisResult& result);
+
+    /**
+     * Replace the stresses of a result with those of one material
+     *
+     * Valid elements get stress, von Mises and principal stresses from
+     * their stored strain, exactly as the analysis computes them, and the
+     * statistics are refreshed. The strain pass is not repeated, so one
+     * strain-only analysis can serve many materials.
+     */
+    static void applyMaterial(MeshAnalysisResult& result, const MaterialModel& material);
+
 private:
     std::optional<MaterialModel> material_;  // Default material
     StrainType strainType_;
@@ -143,23 +194,38 @@ private:
 
     // Helper methods
     ElementResult analyzeHex8(
-        const Element& elem,
+        int elementId,
         const std::array<Vector3D, 8>& refNodes,
         const std::array<Vector3D, 8>& defNodes,
         const MaterialModel* elemMaterial
     );
 
     ElementResult analyzeTet4(
-        const Element& elem,
+        int elementId,
         const std::array<Vector3D, 4>& refNodes,
         const std::array<Vector3D, 4>& defNodes,
         const MaterialModel* elemMaterial
     );
     
-    // Get material for element (checks part materials first if enabled)
-    const MaterialModel* getMaterialForElement(const Element& elem, const Mesh& refMesh) const;
+    // Gather node positions and run the analysis for one element of a type
+    template <ElementType Type>
+    ElementResult analyzeTyped(
+        int elementId,
+        int partId,
+        const std::array<int, ElementTraits<Type>::NODES>& nodeIds,
+        const Mesh& refMesh,
+        const Mesh& defMesh
+    );
+
+    // Strain measures and stress of a result from its (averaged) strain
+    void completeResult(ElementResult& result, const StrainTensor& strain,
+                        const MaterialModel* elemMaterial) const;
+
+    // Stress measures of a result from its strain
+    static void applyStress(ElementResult& result, const MaterialModel& material);
 
-    void computeStatistics(MeshAnalysisResult& result);
+    // Get material for a part (checks part materials first if enabled)
+    const MaterialModel* getMaterialForPart(int partId, const Mesh& refMesh) const;
 };
 
 } // namespace KooRemapper
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "analysis/ElementAnalyzer.h"
+#include "analysis/MaterialModel.h"
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Relaxation solve statistics
+ */
+struct RelaxationStats {
+    int iterations;
+    bool converged;
+    double initialResidual;     // ||f|| of the input stress field
+    double finalResidual;       // ||f|| after relaxation
+    double maxDisplacement;     // Largest relaxation displacement
+    size_t skippedElements;     // Degenerate or unsupported elements
+    size_t colors;              // Element colors used for assembly
+
+    RelaxationStats()
+        : iterations(0), converged(false)
+        , initialResidual(0), finalResidual(0), maxDisplacement(0)
+        , skippedElements(0), colors(0) {}
+};
+
+/**
+ * Equilibrium relaxation of a computed prestress field
+ *
+ * The geometric stress σ0 from ElementAnalyzer is generally not in
+ * equilibrium. This solves the linear-elastic problem K·u = -∫B^T·σ0 dV
+ * on the deformed configuration and replaces each element stress with
+ * the self-equilibrated σ0 + C·ε(u).
+ *
+ * The solve is a Jacobi-preconditioned conjugate gradient with
+ * element-by-element (matrix-free) operator application, parallelized
+ * over element colors. The body is unconstrained; the right-hand side
+ * is self-equilibrated, so rigid-body modes are simply projected out.
+ */
+class EquilibriumRelaxer {
+public:
+    EquilibriumRelaxer();
+
+    /**
+     * Default material (used when part materials are off or missing)
+     */
+    void setMaterial(const MaterialModel& material) { material_ = material; }
+
+    /**
+     * Use mesh part->material mapping when available
+     */
+    void setUsePartMaterials(bool use) { usePartMaterials_ = use; }
+
+    /**
+     * Relative residual tolerance ||r|| / ||f0||
+     */
+    void setTolerance(double tol) { tolerance_ = tol; }
+
+    /**
+     * Maximum CG iterations
+     */
+    void setMaxIterations(int n) { maxIterations_ = n; }
+
+    /**
+     * Relax the stresses in result in place
+     *
+     * @param refMesh   Reference mesh (materials)
+     * @param defMesh   Deformed mesh (geometry of the solve)
+     * @param result    Analysis result from ElementAnalyzer::analyzeMesh
+     * @param progress  Optional progress callback (0-100)
+     * @return false on failure (see getErrorMessage)
+     */
+    bool relax(const Mesh& refMesh, const Mesh& defMesh,
+               MeshAnalysisResult& result,
+               std::function<void(int)> progress = nullptr);
+
+    const RelaxationStats& getStats() const { return stats_; }
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    std::optional<MaterialModel> material_;
+    bool usePartMaterials_;
+    double tolerance_;
+    int maxIterations_;
+
+    RelaxationStats stats_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "analysis/MaterialModel.h"
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * One isotropic elastic material of a sweep
+ */
+struct MaterialSet {
+    std::string name;   // Output suffix; "set<N>" when the file has no names
+    double E = 0.0;
+    double nu = 0.0;
+
+    MaterialModel material() const { return MaterialModel::isotropicElastic(E, nu); }
+};
+
+/**
+ * Material sets for prestress --material-sweep
+ *
+ * CSV with one set per line, either "E,nu" or "name,E,nu". Blank lines and
+ * '#' comments are skipped; a first line that is not numeric is taken as
+ * a header. Names may only contain letters, digits, '_', '-' and '.'
+ * because they become part of the output file names.
+ */
+class MaterialSweep {
+public:
+    MaterialSweep() = default;
+    ~MaterialSweep() = default;
+
+    bool load(const std::string& filename);
+
+    const std::vector<MaterialSet>& getSets() const { return sets_; }
+
+    /**
+     * Output file of a set: "out.dynain" -> "out_<name>.dynain"
+     */
+    static std::string outputPath(const std::string& output, const MaterialSet& set);
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    std::vector<MaterialSet> sets_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
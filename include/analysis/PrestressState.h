@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "analysis/ElementAnalyzer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Saved inputs and results of a prestress run, for incremental reruns
+ *
+ * Holds the deformed node positions, a fingerprint of everything else the
+ * element results depend on (reference mesh, materials, analysis settings)
+ * and the element results themselves. When a rerun differs only in some
+ * deformed coordinates, just the elements touching a moved node need to
+ * be recomputed; all other results are reused unchanged.
+ *
+ * The file is binary in native byte order, written next to the outputs.
+ */
+class PrestressState {
+public:
+    PrestressState();
+    ~PrestressState() = default;
+
+    /**
+     * Hash of the reference mesh (nodes, connectivity, part materials) and
+     * an analysis settings string
+     */
+    static std::uint64_t fingerprint(const Mesh& refMesh, const std::string& settings);
+
+    /**
+     * Write the state of a finished run
+     */
+    bool save(const std::string& filename, std::uint64_t fingerprint,
+              const Mesh& defMesh, const MeshAnalysisResult& results);
+
+    /**
+     * Read a state file written by save()
+     */
+    bool load(const std::string& filename);
+
+    std::uint64_t getFingerprint() const { return fingerprint_; }
+
+    /**
+     * Elements of defMesh that touch a node whose deformed position differs
+     * from the saved one, as indices in element ID order
+     * @param movedNodes  Set to the number of moved nodes
+     * @return false if the node or element set differs from the saved run
+     */
+    bool findChangedElements(const Mesh& defMesh, std::vector<size_t>& indices,
+                             size_t& movedNodes);
+
+    /**
+     * Results of the saved run (moved out of the state)
+     */
+    MeshAnalysisResult takeResults() { return std::move(results_); }
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    std::uint64_t fingerprint_;
+    std::vector<int> nodeIds_;
+    std::vector<double> positions_;    // x, y, z per node
+    MeshAnalysisResult results_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "core/Vector3D.h"
+#include "analysis/ElementAnalyzer.h"
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Out-of-balance force at one node
+ */
+struct NodalResidual {
+    int nodeId;
+    Vector3D position;
+    Vector3D force;
+    double magnitude;
+
+    NodalResidual() : nodeId(0), magnitude(0) {}
+};
+
+/**
+ * Residual summary for the nodes of one part
+ */
+struct PartResidual {
+    int partId;
+    size_t nodeCount;
+    double l2Norm;
+    double maxNorm;
+    int maxNodeId;
+
+    PartResidual() : partId(0), nodeCount(0), l2Norm(0), maxNorm(0), maxNodeId(0) {}
+};
+
+/**
+ * Equilibrium check of an element stress field
+ */
+struct ResidualReport {
+    std::vector<NodalResidual> nodes;        // All nodes, ascending ID
+    std::vector<NodalResidual> worstNodes;   // Largest |f| first
+    std::vector<PartResidual> parts;         // Ascending part ID
+
+    double l2Norm;
+    double maxNorm;
+    size_t skippedElements;
+
+    ResidualReport() : l2Norm(0), maxNorm(0), skippedElements(0) {}
+};
+
+/**
+ * Nodal internal-force residual of a prestress field
+ *
+ * Assembles f_a = sum_e ∫ B_a^T σ_e dV on the deformed mesh. With no
+ * external loads, a stress state in equilibrium gives f = 0 at every
+ * node, so |f| measures how far the dynain stress is from balance.
+ */
+class ResidualAnalyzer {
+public:
+    ResidualAnalyzer() : worstNodeCount_(10) {}
+
+    /**
+     * Number of worst nodes to keep in the report
+     */
+    void setWorstNodeCount(int n) { worstNodeCount_ = n; }
+
+    /**
+     * Compute nodal residuals
+     *
+     * @param defMesh  Deformed mesh (stress configuration)
+     * @param result   Element stresses from ElementAnalyzer
+     * @param report   Output report
+     * @return false on failure (see getErrorMessage)
+     */
+    bool compute(const Mesh& defMesh, const MeshAnalysisResult& result, ResidualReport& report);
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    int worstNodeCount_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "core/Vector3D.h"
+#include "analysis/MaterialModel.h"
+#include "analysis/StressTensor.h"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Compact finite-element view of a solid mesh for matrix-free kernels
+ *
+ * Nodes and elements are renumbered densely (ascending ID order) and
+ * elements are grouped into colors whose members share no node, so each
+ * color can scatter into nodal vectors in parallel without atomics.
+ *
+ * Element integrals use the Gauss rules of DeformationGradient:
+ * HEX8 with 2x2x2 points, TET4 with one point. Geometry is recomputed
+ * on every call instead of stored, which keeps memory at the size of
+ * the mesh itself.
+ */
+class SolidAssembly {
+public:
+    using Stiffness = std::array<std::array<double, 6>, 6>;
+
+    SolidAssembly() = default;
+
+    /**
+     * Build from the effective node positions of a mesh
+     * Elements that are not HEX8/TET4 or have a non-positive Jacobian
+     * are excluded from all kernels.
+     *
+     * @return false on failure (see getErrorMessage)
+     */
+    bool build(const Mesh& mesh);
+
+    // Sizes and mapping back to mesh IDs
+    size_t nodeCount() const { return nodeIds_.size(); }
+    size_t elementCount() const { return elementIds_.size(); }
+    size_t colorCount() const { return colors_.size(); }
+    size_t skippedElementCount() const { return skipped_; }
+
+    int nodeId(size_t n) const { return nodeIds_[n]; }
+    int elementId(size_t e) const { return elementIds_[e]; }
+    int elementPartId(size_t e) const { return partIds_[e]; }
+    const Vector3D& nodePosition(size_t n) const { return positions_[n]; }
+    bool isElementActive(size_t e) const { return active_[e] != 0; }
+    int elementNodeCount(size_t e) const { return nodesPerElement_[e]; }
+    int elementNode(size_t e, int a) const { return conn_[e][a]; }  // Dense index
+
+    /**
+     * Assign the material of element e (Voigt stiffness via MaterialModel)
+     * Elements without a material contribute no stiffness.
+     */
+    void setElementMaterial(size_t e, const MaterialModel& material);
+
+    bool hasElementMaterial(size_t e) const { return materialIndex_[e] >= 0; }
+
+    /**
+     * Nodal internal forces f_a = sum_e ∫ B_a^T σ_e dV
+     *
+     * @param stress  One constant stress per element (dense order)
+     * @param forces  Output, resized to nodeCount()
+     */
+    void internalForces(const std::vector<StressTensor>& stress,
+                        std::vector<Vector3D>& forces) const;
+
+    /**
+     * Matrix-free stiffness product y = K x
+     */
+    void applyStiffness(const std::vector<Vector3D>& x,
+                        std::vector<Vector3D>& y) const;
+
+    /**
+     * Diagonal of K (for Jacobi preconditioning)
+     */
+    void stiffnessDiagonal(std::vector<Vector3D>& diag) const;
+
+    /**
+     * Volume-averaged stress of element e produced by nodal displacement u
+     */
+    StressTensor elementStress(size_t e, const std::vector<Vector3D>& u) const;
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    std::vector<int> nodeIds_;
+    std::vector<Vector3D> positions_;
+
+    std::vector<int> elementIds_;
+    std::vector<int> partIds_;
+    std::vector<int> nodesPerElement_;        // 8 (HEX8) or 4 (TET4)
+    std::vector<std::array<int, 8>> conn_;    // Dense node indices
+    std::vector<char> active_;
+    std::vector<int> materialIndex_;          // Index into stiffness_, -1 = none
+
+    std::vector<Stiffness> stiffness_;
+    std::vector<std::array<double, 2>> materialKeys_;  // (E, nu) of stiffness_ entries
+
+    std::vector<std::vector<size_t>> colors_;
+    size_t skipped_ = 0;
+    std::string errorMessage_;
+
+    void colorElements();
+};
+
+} // namespace KooRemapper
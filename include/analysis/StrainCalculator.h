@@ -5,6 +5,7 @@
 #include <array>
 #include <vector>
 #include <map>
+#include <ostream>
 
 namespace KooRemapper {
 
@@ -56,7 +57,8 @@ struct StrainData {
  */
 struct ElementStrainData {
     int elementId;
-    StrainData strain;           // Average strain for element
+    StrainData strain;           // Average strain for element (first strain type)
+    std::array<StrainData, 3> measures;  // Average strain per requested type, in order
     std::array<StrainData, 8> nodeStrains;  // Strain at each node
     double jacobian;               // Element Jacobian determinant
 };
@@ -113,7 +115,21 @@ public:
     /**
      * Set strain calculation type
      */
-    void setStrainType(StrainType type) { strainType_ = type; }
+    void setStrainType(StrainType type) { strainTypes_ = {type}; }
+
+    /**
+     * Compute several strain measures in one pass (at most one of each type)
+     * F is evaluated once per Gauss point and shared by all measures; the
+     * first type fills ElementStrainData::strain and the statistics.
+     */
+    void setStrainTypes(const std::vector<StrainType>& types);
+
+    const std::vector<StrainType>& getStrainTypes() const { return strainTypes_; }
+
+    /**
+     * Short name of a strain type, e.g. "green"
+     */
+    static const char* strainTypeName(StrainType type);
 
     /**
      * Calculate strain field
@@ -139,6 +155,11 @@ public:
     const StrainStats& getStats() const { return stats_; }
     const StrainStats& getStatistics() const { return stats_; }
 
+    /**
+     * Statistics of the measure-th requested strain type
+     */
+    const StrainStats& getStatistics(size_t measure) const { return measureStats_[measure]; }
+
     /**
      * Get node displacement vector
      */
@@ -156,6 +177,14 @@ public:
      */
     bool exportToCSV(const std::string& filename) const;
 
+    /**
+     * CSV header / data rows of exportToCSV(), for assembling partial outputs
+     * With several strain types the strain columns repeat per type, prefixed
+     * with the type name (e.g. green_exx).
+     */
+    void writeCSVHeader(std::ostream& out) const;
+    void writeCSVRows(std::ostream& out) const;
+
     /**
      * Get error message
      */
@@ -164,11 +193,12 @@ public:
 private:
     const Mesh* refMesh_ = nullptr;
     const Mesh* defMesh_ = nullptr;
-    StrainType strainType_ = StrainType::GREEN_LAGRANGE;
+    std::vector<StrainType> strainTypes_ = {StrainType::GREEN_LAGRANGE};
 
     std::map<int, Vector3D> displacements_;
     std::map<int, ElementStrainData> elementStrains_;
     StrainStats stats_;
+    std::array<StrainStats, 3> measureStats_;
     std::string errorMessage_;
 
     /**
@@ -179,7 +209,12 @@ private:
     /**
      * Calculate strain for a single element
      */
-    bool calculateElementStrain(const Element& element, ElementStrainData& data);
+    bool calculateElementStrain(const Element& element, ElementStrainData& data) const;
+
+    /**
+     * Strain of one type from a deformation gradient
+     */
+    static StrainData strainFromF(const std::array<std::array<double, 3>, 3>& F, StrainType type);
 
     /**
      * Calculate deformation gradient F at a natural coordinate point
@@ -217,6 +252,11 @@ private:
      * Update statistics
      */
     void updateStats();
+
+    /**
+     * Statistics of one measure over all elements
+     */
+    StrainStats computeStats(size_t measure) const;
 };
 
 } // namespace KooRemapper
@@ -35,6 +35,12 @@ public:
     void setColorsEnabled(bool enabled) { colorsEnabled_ = enabled; }
     bool colorsEnabled() const { return colorsEnabled_; }
 
+    /**
+     * Suppress all output except errors (e.g. on non-root MPI ranks)
+     */
+    void setQuiet(bool quiet) { quiet_ = quiet; }
+    bool isQuiet() const { return quiet_; }
+
     /**
      * Print colored text
      */
@@ -77,6 +83,9 @@ public:
 
 private:
     bool colorsEnabled_;
+    bool quiet_;
+
+    void write(const std::string& text, Color color) const;
 
     std::string colorCode(Color color) const;
     std::string resetCode() const;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Element.h"
+#include "core/Mesh.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Connectivity width per element type
+ *
+ * Element stores 8 corner IDs for every type; TET4 uses the first 4.
+ * HEX20, TET10 and UNKNOWN share the 8-wide UNKNOWN bucket.
+ */
+template <ElementType Type>
+struct ElementTraits {
+    static constexpr int NODES = Element::NUM_NODES;
+};
+
+template <>
+struct ElementTraits<ElementType::TET4> {
+    static constexpr int NODES = 4;
+};
+
+/**
+ * Elements of one type as parallel arrays, in ascending ID order
+ */
+template <ElementType Type>
+struct ElementBucket {
+    static constexpr ElementType TYPE = Type;
+    static constexpr int NODES = ElementTraits<Type>::NODES;
+
+    std::vector<int> ids;
+    std::vector<int> partIds;
+    std::vector<std::array<int, NODES>> nodeIds;
+    std::vector<size_t> positions;   // Index in mesh.getElements() order
+
+    size_t size() const { return ids.size(); }
+};
+
+/**
+ * Element connectivity of a mesh, segregated by element type
+ *
+ * Mesh::elements keeps all types in one ID-ordered map, so loops over it
+ * branch on Element::type per element. ElementBuckets copies the
+ * connectivity into one contiguous bucket per type (HEX8, TET4 and
+ * everything else under UNKNOWN). Kernels loop over each bucket with a
+ * type-specialized template instance and scatter their results back to
+ * mesh order through positions; writers that must keep ID order walk the
+ * same-type runs instead. The buckets are a snapshot: rebuild them after
+ * the mesh changes.
+ */
+class ElementBuckets {
+public:
+    explicit ElementBuckets(const Mesh& mesh);
+
+    const ElementBucket<ElementType::HEX8>& hex8() const { return hex8_; }
+    const ElementBucket<ElementType::TET4>& tet4() const { return tet4_; }
+    const ElementBucket<ElementType::UNKNOWN>& other() const { return other_; }
+
+    size_t size() const { return hex8_.size() + tet4_.size() + other_.size(); }
+
+    /**
+     * Bucket type and slot of an element ID
+     * @return false if the mesh has no such element
+     */
+    bool find(int id, ElementType& type, size_t& slot) const;
+
+    /**
+     * Call f(bucket) for every bucket; f is instantiated once per type
+     */
+    template <typename F>
+    void forEachBucket(F&& f) const {
+        f(hex8_);
+        f(tet4_);
+        f(other_);
+    }
+
+    /**
+     * Call f(bucket, firstSlot, count) for each maximal run of same-type
+     * elements, in ascending ID order
+     */
+    template <typename F>
+    void forEachRun(F&& f) const {
+        for (const Run& run : runs_) {
+            switch (run.type) {
+                case ElementType::HEX8: f(hex8_, run.first, run.count); break;
+                case ElementType::TET4: f(tet4_, run.first, run.count); break;
+                default:                f(other_, run.first, run.count); break;
+            }
+        }
+    }
+
+    size_t getRunCount() const { return runs_.size(); }
+
+private:
+    struct Run {
+        ElementType type;
+        size_t first;
+        size_t count;
+    };
+
+    ElementBucket<ElementType::HEX8> hex8_;
+    ElementBucket<ElementType::TET4> tet4_;
+    ElementBucket<ElementType::UNKNOWN> other_;
+    std::vector<Run> runs_;
+};
+
+} // namespace KooRemapper
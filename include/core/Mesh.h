@@ -189,7 +189,14 @@ public:
      * Returns nullptr if not found
      */
     const MaterialData* getElementMaterial(const Element& elem) const {
-        auto partIt = parts.find(elem.partId);
+        return getPartMaterial(elem.partId);
+    }
+
+    /**
+     * Get material assigned to a part (nullptr if none)
+     */
+    const MaterialData* getPartMaterial(int partId) const {
+        auto partIt = parts.find(partId);
         if (partIt == parts.end()) return nullptr;
         
         auto matIt = materials.find(partIt->second.materialId);
@@ -36,6 +36,16 @@ namespace Platform {
      */
     bool fileExists(const std::string& path);
 
+    /**
+     * True for "-", which names stdin (for inputs) or stdout (for outputs)
+     */
+    bool isStdStream(const std::string& path);
+
+    /**
+     * Put stdin and stdout in binary mode (no CR/LF translation on Windows)
+     */
+    void setBinaryStdio();
+
     /**
      * Create a directory (including parent directories)
      */
@@ -57,6 +67,16 @@ namespace Platform {
      */
     std::string getCurrentDirectory();
 
+    /**
+     * Name of this machine ("localhost" if unknown)
+     */
+    std::string getHostName();
+
+    /**
+     * User's home directory (empty if unknown)
+     */
+    std::string getHomeDirectory();
+
     /**
      * Extract filename from path
      */
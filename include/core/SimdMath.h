@@ -0,0 +1,594 @@
+#pragma once
+
+#include "core/Matrix3x3.h"
+#include "core/Vector3D.h"
+#include <cmath>
+#include <cstddef>
+
+// Instruction set used for SimdDouble (define KOOREMAPPER_NO_SIMD to force
+// the portable scalar fallback)
+#if !defined(KOOREMAPPER_NO_SIMD) && defined(__AVX512F__)
+    #include <immintrin.h>
+    #define KOOREMAPPER_SIMD_AVX512 1
+    #define KOOREMAPPER_SIMD_NS simd_avx512
+#elif !defined(KOOREMAPPER_NO_SIMD) && defined(__AVX__)
+    #include <immintrin.h>
+    #define KOOREMAPPER_SIMD_AVX 1
+    #define KOOREMAPPER_SIMD_NS simd_avx
+#elif !defined(KOOREMAPPER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+    #include <emmintrin.h>
+    #define KOOREMAPPER_SIMD_SSE2 1
+    #define KOOREMAPPER_SIMD_NS simd_sse2
+#elif !defined(KOOREMAPPER_NO_SIMD) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define KOOREMAPPER_SIMD_NEON 1
+    #define KOOREMAPPER_SIMD_NS simd_neon
+#else
+    #define KOOREMAPPER_SIMD_SCALAR 1
+    #define KOOREMAPPER_SIMD_NS simd_scalar
+#endif
+
+namespace KooRemapper {
+
+// The pack types differ per instruction set, and kernels built for several
+// ISA levels (see kernels/BatchKernels.h) are linked into one binary; the
+// inline namespace keeps each variant a distinct type.
+inline namespace KOOREMAPPER_SIMD_NS {
+
+/**
+ * Pack of doubles processed by one instruction stream
+ *
+ * Batch kernels work on SimdDouble::WIDTH elements at once, structure of
+ * arrays style: lane n of every pack belongs to element n. Arithmetic maps
+ * to AVX-512 (8 lanes), AVX (4 lanes), SSE2 or NEON (2 lanes), or a plain
+ * loop over 4 lanes that the compiler is free to auto-vectorize.
+ */
+class SimdDouble {
+public:
+#if defined(KOOREMAPPER_SIMD_AVX512)
+    static constexpr size_t WIDTH = 8;
+    using Native = __m512d;
+#elif defined(KOOREMAPPER_SIMD_AVX)
+    static constexpr size_t WIDTH = 4;
+    using Native = __m256d;
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+    static constexpr size_t WIDTH = 2;
+    using Native = __m128d;
+#elif defined(KOOREMAPPER_SIMD_NEON)
+    static constexpr size_t WIDTH = 2;
+    using Native = float64x2_t;
+#else
+    static constexpr size_t WIDTH = 4;
+#endif
+
+    SimdDouble() { *this = SimdDouble(0.0); }
+
+    /**
+     * Broadcast one value to all lanes
+     */
+    SimdDouble(double value) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        v_ = _mm512_set1_pd(value);
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        v_ = _mm256_set1_pd(value);
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        v_ = _mm_set1_pd(value);
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        v_ = vdupq_n_f64(value);
+#else
+        for (size_t i = 0; i < WIDTH; ++i) v_[i] = value;
+#endif
+    }
+
+    /**
+     * Load WIDTH consecutive values (no alignment required)
+     */
+    static SimdDouble load(const double* p) {
+        SimdDouble r;
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        r.v_ = _mm512_loadu_pd(p);
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        r.v_ = _mm256_loadu_pd(p);
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        r.v_ = _mm_loadu_pd(p);
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        r.v_ = vld1q_f64(p);
+#else
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = p[i];
+#endif
+        return r;
+    }
+
+    /**
+     * Store WIDTH consecutive values (no alignment required)
+     */
+    void store(double* p) const {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        _mm512_storeu_pd(p, v_);
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        _mm256_storeu_pd(p, v_);
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        _mm_storeu_pd(p, v_);
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        vst1q_f64(p, v_);
+#else
+        for (size_t i = 0; i < WIDTH; ++i) p[i] = v_[i];
+#endif
+    }
+
+    /**
+     * Lane access (slow path; for gathers, scatters and tests)
+     */
+    double lane(size_t i) const {
+        double values[WIDTH];
+        store(values);
+        return values[i];
+    }
+
+    void setLane(size_t i, double value) {
+        double values[WIDTH];
+        store(values);
+        values[i] = value;
+        *this = load(values);
+    }
+
+    friend SimdDouble operator+(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_add_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_add_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_add_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vaddq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] + b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble operator-(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_sub_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_sub_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_sub_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vsubq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] - b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble operator*(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_mul_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_mul_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_mul_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vmulq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] * b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble operator/(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_div_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_div_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_div_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vdivq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] / b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble operator-(const SimdDouble& a) { return SimdDouble(0.0) - a; }
+
+    SimdDouble& operator+=(const SimdDouble& b) { return *this = *this + b; }
+    SimdDouble& operator-=(const SimdDouble& b) { return *this = *this - b; }
+    SimdDouble& operator*=(const SimdDouble& b) { return *this = *this * b; }
+
+    friend SimdDouble sqrt(const SimdDouble& a) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_sqrt_pd(a.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_sqrt_pd(a.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_sqrt_pd(a.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vsqrtq_f64(a.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = std::sqrt(a.v_[i]);
+        return r;
+#endif
+    }
+
+    friend SimdDouble min(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_min_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_min_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_min_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vminq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] < b.v_[i] ? a.v_[i] : b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble max(const SimdDouble& a, const SimdDouble& b) {
+#if defined(KOOREMAPPER_SIMD_AVX512)
+        return SimdDouble(_mm512_max_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_AVX)
+        return SimdDouble(_mm256_max_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_SSE2)
+        return SimdDouble(_mm_max_pd(a.v_, b.v_));
+#elif defined(KOOREMAPPER_SIMD_NEON)
+        return SimdDouble(vmaxq_f64(a.v_, b.v_));
+#else
+        SimdDouble r;
+        for (size_t i = 0; i < WIDTH; ++i) r.v_[i] = a.v_[i] > b.v_[i] ? a.v_[i] : b.v_[i];
+        return r;
+#endif
+    }
+
+    friend SimdDouble abs(const SimdDouble& a) { return max(a, -a); }
+
+    /**
+     * Horizontal sum of all lanes
+     */
+    double sum() const {
+        double values[WIDTH];
+        store(values);
+        double total = 0.0;
+        for (size_t i = 0; i < WIDTH; ++i) total += values[i];
+        return total;
+    }
+
+private:
+#if !defined(KOOREMAPPER_SIMD_SCALAR)
+    explicit SimdDouble(Native v) : v_(v) {}
+    Native v_;
+#else
+    double v_[WIDTH];
+#endif
+};
+
+/**
+ * WIDTH 3D vectors in structure-of-arrays layout
+ */
+struct Vec3Pack {
+    SimdDouble x, y, z;
+
+    Vec3Pack() = default;
+    Vec3Pack(const SimdDouble& x_, const SimdDouble& y_, const SimdDouble& z_)
+        : x(x_), y(y_), z(z_) {}
+
+    /**
+     * Broadcast one vector to all lanes
+     */
+    static Vec3Pack broadcast(const Vector3D& v) { return Vec3Pack(v.x, v.y, v.z); }
+
+    /**
+     * Gather WIDTH consecutive Vector3D (AoS -> SoA)
+     * Lanes past count are zero.
+     */
+    static Vec3Pack gather(const Vector3D* v, size_t count = SimdDouble::WIDTH) {
+        double xs[SimdDouble::WIDTH] = {}, ys[SimdDouble::WIDTH] = {}, zs[SimdDouble::WIDTH] = {};
+        for (size_t i = 0; i < count && i < SimdDouble::WIDTH; ++i) {
+            xs[i] = v[i].x;
+            ys[i] = v[i].y;
+            zs[i] = v[i].z;
+        }
+        return Vec3Pack(SimdDouble::load(xs), SimdDouble::load(ys), SimdDouble::load(zs));
+    }
+
+    /**
+     * Scatter the first count lanes back to Vector3D (SoA -> AoS)
+     */
+    void scatter(Vector3D* v, size_t count = SimdDouble::WIDTH) const {
+        double xs[SimdDouble::WIDTH], ys[SimdDouble::WIDTH], zs[SimdDouble::WIDTH];
+        x.store(xs);
+        y.store(ys);
+        z.store(zs);
+        for (size_t i = 0; i < count && i < SimdDouble::WIDTH; ++i) {
+            v[i] = Vector3D(xs[i], ys[i], zs[i]);
+        }
+    }
+
+    Vector3D lane(size_t i) const { return Vector3D(x.lane(i), y.lane(i), z.lane(i)); }
+
+    Vec3Pack operator+(const Vec3Pack& o) const { return Vec3Pack(x + o.x, y + o.y, z + o.z); }
+    Vec3Pack operator-(const Vec3Pack& o) const { return Vec3Pack(x - o.x, y - o.y, z - o.z); }
+    Vec3Pack operator*(const SimdDouble& s) const { return Vec3Pack(x * s, y * s, z * s); }
+    Vec3Pack& operator+=(const Vec3Pack& o) { x += o.x; y += o.y; z += o.z; return *this; }
+
+    SimdDouble dot(const Vec3Pack& o) const { return x * o.x + y * o.y + z * o.z; }
+
+    Vec3Pack cross(const Vec3Pack& o) const {
+        return Vec3Pack(y * o.z - z * o.y,
+                        z * o.x - x * o.z,
+                        x * o.y - y * o.x);
+    }
+
+    SimdDouble magnitudeSquared() const { return dot(*this); }
+    SimdDouble magnitude() const { return sqrt(dot(*this)); }
+};
+
+/**
+ * WIDTH 3x3 matrices, one SimdDouble per entry (row-major like Matrix3x3)
+ */
+struct Mat3Pack {
+    SimdDouble m[3][3];
+
+    static Mat3Pack identity() {
+        Mat3Pack r;
+        r.m[0][0] = r.m[1][1] = r.m[2][2] = SimdDouble(1.0);
+        return r;
+    }
+
+    static Mat3Pack broadcast(const Matrix3x3& a) {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) r.m[i][j] = SimdDouble(a.m[i][j]);
+        return r;
+    }
+
+    static Mat3Pack fromColumns(const Vec3Pack& c0, const Vec3Pack& c1, const Vec3Pack& c2) {
+        Mat3Pack r;
+        r.m[0][0] = c0.x; r.m[0][1] = c1.x; r.m[0][2] = c2.x;
+        r.m[1][0] = c0.y; r.m[1][1] = c1.y; r.m[1][2] = c2.y;
+        r.m[2][0] = c0.z; r.m[2][1] = c1.z; r.m[2][2] = c2.z;
+        return r;
+    }
+
+    /**
+     * Gather WIDTH consecutive matrices; lanes past count are zero
+     */
+    static Mat3Pack gather(const Matrix3x3* a, size_t count = SimdDouble::WIDTH) {
+        Mat3Pack r;
+        double values[SimdDouble::WIDTH];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                for (size_t n = 0; n < SimdDouble::WIDTH; ++n) {
+                    values[n] = n < count ? a[n].m[i][j] : 0.0;
+                }
+                r.m[i][j] = SimdDouble::load(values);
+            }
+        }
+        return r;
+    }
+
+    /**
+     * Scatter the first count lanes back to Matrix3x3
+     */
+    void scatter(Matrix3x3* a, size_t count = SimdDouble::WIDTH) const {
+        double values[SimdDouble::WIDTH];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                m[i][j].store(values);
+                for (size_t n = 0; n < count && n < SimdDouble::WIDTH; ++n) {
+                    a[n].m[i][j] = values[n];
+                }
+            }
+        }
+    }
+
+    Matrix3x3 lane(size_t n) const {
+        Matrix3x3 a;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) a.m[i][j] = m[i][j].lane(n);
+        return a;
+    }
+
+    Mat3Pack operator+(const Mat3Pack& o) const {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) r.m[i][j] = m[i][j] + o.m[i][j];
+        return r;
+    }
+
+    Mat3Pack operator-(const Mat3Pack& o) const {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) r.m[i][j] = m[i][j] - o.m[i][j];
+        return r;
+    }
+
+    Mat3Pack operator*(const SimdDouble& s) const {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) r.m[i][j] = m[i][j] * s;
+        return r;
+    }
+
+    Mat3Pack operator*(const Mat3Pack& o) const {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                r.m[i][j] = m[i][0] * o.m[0][j] + m[i][1] * o.m[1][j] + m[i][2] * o.m[2][j];
+        return r;
+    }
+
+    Vec3Pack operator*(const Vec3Pack& v) const {
+        return Vec3Pack(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                        m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                        m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+    }
+
+    Mat3Pack transpose() const {
+        Mat3Pack r;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) r.m[i][j] = m[j][i];
+        return r;
+    }
+
+    SimdDouble determinant() const {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    SimdDouble trace() const { return m[0][0] + m[1][1] + m[2][2]; }
+
+    /**
+     * Inverse via the adjugate; det receives the determinant per lane
+     * Unlike Matrix3x3::inverse() this does not throw: lanes with a
+     * (near) singular matrix produce inf/nan, so callers check det.
+     */
+    Mat3Pack inverse(SimdDouble& det) const {
+        det = determinant();
+        SimdDouble invDet = SimdDouble(1.0) / det;
+        Mat3Pack r;
+        r.m[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * invDet;
+        r.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+        r.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+        r.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * invDet;
+        r.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+        r.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+        r.m[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * invDet;
+        r.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+        r.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+        return r;
+    }
+
+    SimdDouble frobeniusNorm() const {
+        SimdDouble sum(0.0);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) sum += m[i][j] * m[i][j];
+        return sqrt(sum);
+    }
+
+    SimdDouble doubleContraction(const Mat3Pack& o) const {
+        SimdDouble sum(0.0);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) sum += m[i][j] * o.m[i][j];
+        return sum;
+    }
+};
+
+/**
+ * WIDTH symmetric 3x3 tensors (6 independent components)
+ * Component names follow StrainTensor/StressTensor (xx, yy, zz, xy, yz, xz).
+ */
+struct SymTensorPack {
+    SimdDouble xx, yy, zz, xy, yz, xz;
+
+    /**
+     * Symmetric part of a matrix pack: 1/2 (A + A^T)
+     */
+    static SymTensorPack symmetricPart(const Mat3Pack& a) {
+        const SimdDouble half(0.5);
+        SymTensorPack t;
+        t.xx = a.m[0][0];
+        t.yy = a.m[1][1];
+        t.zz = a.m[2][2];
+        t.xy = (a.m[0][1] + a.m[1][0]) * half;
+        t.yz = (a.m[1][2] + a.m[2][1]) * half;
+        t.xz = (a.m[0][2] + a.m[2][0]) * half;
+        return t;
+    }
+
+    /**
+     * A^T A (e.g. right Cauchy-Green C = F^T F), computed without the
+     * redundant lower triangle
+     */
+    static SymTensorPack transposeProduct(const Mat3Pack& a) {
+        auto col = [&a](int i, int j) {
+            return a.m[0][i] * a.m[0][j] + a.m[1][i] * a.m[1][j] + a.m[2][i] * a.m[2][j];
+        };
+        SymTensorPack t;
+        t.xx = col(0, 0);
+        t.yy = col(1, 1);
+        t.zz = col(2, 2);
+        t.xy = col(0, 1);
+        t.yz = col(1, 2);
+        t.xz = col(0, 2);
+        return t;
+    }
+
+    Mat3Pack toMatrix() const {
+        Mat3Pack r;
+        r.m[0][0] = xx; r.m[0][1] = xy; r.m[0][2] = xz;
+        r.m[1][0] = xy; r.m[1][1] = yy; r.m[1][2] = yz;
+        r.m[2][0] = xz; r.m[2][1] = yz; r.m[2][2] = zz;
+        return r;
+    }
+
+    SymTensorPack operator+(const SymTensorPack& o) const {
+        return {xx + o.xx, yy + o.yy, zz + o.zz, xy + o.xy, yz + o.yz, xz + o.xz};
+    }
+
+    SymTensorPack operator-(const SymTensorPack& o) const {
+        return {xx - o.xx, yy - o.yy, zz - o.zz, xy - o.xy, yz - o.yz, xz - o.xz};
+    }
+
+    SymTensorPack operator*(const SimdDouble& s) const {
+        return {xx * s, yy * s, zz * s, xy * s, yz * s, xz * s};
+    }
+
+    SimdDouble trace() const { return xx + yy + zz; }
+
+    SimdDouble determinant() const {
+        return xx * (yy * zz - yz * yz)
+             - xy * (xy * zz - yz * xz)
+             + xz * (xy * yz - yy * xz);
+    }
+
+    /**
+     * Inverse (symmetric); det receives the determinant per lane
+     */
+    SymTensorPack inverse(SimdDouble& det) const {
+        det = determinant();
+        SimdDouble invDet = SimdDouble(1.0) / det;
+        return {(yy * zz - yz * yz) * invDet,
+                (xx * zz - xz * xz) * invDet,
+                (xx * yy - xy * xy) * invDet,
+                (xz * yz - xy * zz) * invDet,
+                (xy * xz - xx * yz) * invDet,
+                (xy * yz - xz * yy) * invDet};
+    }
+
+    /**
+     * A : B with off-diagonal terms counted twice
+     */
+    SimdDouble doubleContraction(const SymTensorPack& o) const {
+        return xx * o.xx + yy * o.yy + zz * o.zz
+             + SimdDouble(2.0) * (xy * o.xy + yz * o.yz + xz * o.xz);
+    }
+
+    SimdDouble frobeniusNorm() const { return sqrt(doubleContraction(*this)); }
+
+    /**
+     * von Mises equivalent (stress convention) sqrt(3/2 s:s), s = deviator
+     */
+    SimdDouble vonMises() const {
+        SimdDouble mean = trace() * SimdDouble(1.0 / 3.0);
+        SymTensorPack s = *this;
+        s.xx -= mean;
+        s.yy -= mean;
+        s.zz -= mean;
+        return sqrt(SimdDouble(1.5) * s.doubleContraction(s));
+    }
+};
+
+} // inline namespace KOOREMAPPER_SIMD_NS
+} // namespace KooRemapper
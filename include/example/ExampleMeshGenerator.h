@@ -59,7 +59,7 @@ struct ExampleMeshConfig {
 
     // Torus specific parameters
     double torusRadius = 40.0;      // Major radius of torus
-    double torusAngle = 180.0;      // Angle coverage in degrees
+    double torusAngle = 180.0;      // Angle coverage in degrees (360+: closed ring)
 
     // Twist specific parameters
     double twistAngle = 90.0;       // Total twist angle in degrees
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "generator/CurveInterpolator.h"
+#include "generator/SpaceCurveInterpolator.h"
+#include "generator/VariableDensityConfig.h"
 #include "core/Mesh.h"
 #include <vector>
 #include <string>
@@ -8,12 +10,64 @@
 
 namespace KooRemapper {
 
+/**
+ * Cross-section scale at one position along the curve
+ */
+struct CrossSectionStation {
+    double position;        // Fraction of the arc length (0 to 1)
+    double widthScale;
+    double thicknessScale;
+
+    CrossSectionStation() : position(0), widthScale(1.0), thicknessScale(1.0) {}
+    CrossSectionStation(double pos, double w, double t)
+        : position(pos), widthScale(w), thicknessScale(t) {}
+};
+
+/**
+ * Segment type of a multi-segment centerline
+ */
+enum class SegmentType {
+    STRAIGHT,
+    ARC,
+    SPLINE
+};
+
+/**
+ * One piece of a multi-segment planar centerline
+ *
+ * Each segment starts where the previous one ends and continues along its
+ * end direction; the first starts at the origin heading along +X.
+ */
+struct CenterlineSegment {
+    SegmentType type;
+    double length;                  // STRAIGHT
+    double radius;                  // ARC
+    double angle;                   // ARC: turn in degrees, positive to the left
+    std::vector<Vector2D> points;   // SPLINE: relative to the first point, x along
+                                    // the incoming direction
+    int elements;                   // Elements along this segment
+    
+    CenterlineSegment()
+        : type(SegmentType::STRAIGHT), length(0), radius(0), angle(0), elements(1) {}
+};
+
 /**
  * Configuration for curved mesh generation
  */
 struct CurvedMeshConfig {
     // Centerline points (x, y coordinates)
     std::vector<Vector2D> centerlinePoints;
+
+    // 3D centerline (global x, y, z); used instead of centerlinePoints
+    // when set. The cross-section follows rotation-minimizing frames.
+    std::vector<Vector3D> spaceCenterlinePoints;
+
+    // Multi-segment planar centerline; used instead of the point lists
+    // when set, with elements per segment
+    std::vector<CenterlineSegment> segments;
+    
+    // Width direction at the start of a 3D centerline
+    Vector3D widthDirection;
     
     // Interpolation type
     InterpolationType interpolation;
@@ -22,6 +76,15 @@ struct CurvedMeshConfig {
     double width;       // Y direction (perpendicular to curve plane)
     double thickness;   // Z direction (in curve plane, normal to tangent)
     
+    // Scale of width / thickness along the curve, linear between entries
+    // (constant cross-section if empty)
+    std::vector<CrossSectionStation> crossSectionProfile;
+    
+    // Density zones along the curve; when any zone has elements they set
+    // the stations instead of elementsAlongCurve. Zone lengths are weights
+    // scaled to the arc length, as for flat meshes.
+    VariableDensityConfig densityZones;
+    
     // Element counts
     int elementsAlongCurve;
     int elementsWidth;      // J direction
@@ -31,7 +94,8 @@ struct CurvedMeshConfig {
     bool centerAtOrigin;
     
     CurvedMeshConfig()
-        : interpolation(InterpolationType::CATMULL_ROM)
+        : widthDirection(0, 1, 0)
+        , interpolation(InterpolationType::CATMULL_ROM)
         , width(1.0)
         , thickness(1.0)
         , elementsAlongCurve(10)
@@ -39,9 +103,58 @@ struct CurvedMeshConfig {
         , elementsThickness(5)
         , centerAtOrigin(false)
     {}
+
+    bool isSpaceCurve() const { return !spaceCenterlinePoints.empty(); }
+
+    bool isAssembly() const { return !segments.empty(); }
+
+    size_t getCenterlinePointCount() const {
+        return isSpaceCurve() ? spaceCenterlinePoints.size() : centerlinePoints.size();
+    }
+
+    bool hasDensityZones() const { return densityZones.getTotalElementsI() > 0; }
+
+    int getElementsAlongCurve() const {
+        if (isAssembly()) {
+            int total = 0;
+            for (const auto& segment : segments) total += segment.elements;
+            return total;
+        }
+        return hasDensityZones() ? densityZones.getTotalElementsI() : elementsAlongCurve;
+    }
     
     bool validate(std::string& error) const {
-        if (centerlinePoints.size() < 2) {
+        if (isAssembly()) {
+            if (getCenterlinePointCount() > 0) {
+                error = "Use either centerline points or segments, not both";
+                return false;
+            }
+            if (hasDensityZones()) {
+                error = "Density zones are not supported with segments";
+                return false;
+            }
+            for (size_t i = 0; i < segments.size(); ++i) {
+                const CenterlineSegment& segment = segments[i];
+                std::string which = "Segment " + std::to_string(i + 1) + ": ";
+                if (segment.elements <= 0) {
+                    error = which + "element count must be positive";
+                    return false;
+                }
+                if (segment.type == SegmentType::STRAIGHT && segment.length <= 0) {
+                    error = which + "length must be positive";
+                    return false;
+                }
+                if (segment.type == SegmentType::ARC &&
+                    (segment.radius <= 0 || segment.angle == 0)) {
+                    error = which + "arc needs a positive radius and a non-zero angle";
+                    return false;
+                }
+                if (segment.type == SegmentType::SPLINE && segment.points.size() < 2) {
+                    error = which + "spline needs at least 2 points";
+                    return false;
+                }
+            }
+        } else if (getCenterlinePointCount() < 2) {
             error = "At least 2 centerline points required";
             return false;
         }
@@ -49,15 +162,31 @@ struct CurvedMeshConfig {
             error = "Width and thickness must be positive";
             return false;
         }
-        if (elementsAlongCurve <= 0 || elementsWidth <= 0 || elementsThickness <= 0) {
+        if (getElementsAlongCurve() <= 0 || elementsWidth <= 0 || elementsThickness <= 0) {
             error = "Element counts must be positive";
             return false;
         }
+        if (hasDensityZones() && densityZones.getTotalLength() <= 0) {
+            error = "Density zone lengths must be positive";
+            return false;
+        }
+        double previous = -1;
+        for (const auto& station : crossSectionProfile) {
+            if (station.position < 0 || station.position > 1 || station.position < previous) {
+                error = "Cross-section profile positions must be ascending in [0, 1]";
+                return false;
+            }
+            if (station.widthScale <= 0 || station.thicknessScale <= 0) {
+                error = "Cross-section profile scales must be positive";
+                return false;
+            }
+            previous = station.position;
+        }
         return true;
     }
     
     int getTotalElements() const {
-        return elementsAlongCurve * elementsWidth * elementsThickness;
+        return getElementsAlongCurve() * elementsWidth * elementsThickness;
     }
 };
 
@@ -73,6 +202,9 @@ struct CurvedMeshStats {
     int totalElements;
     int totalNodes;
     
+    double minElementLength;    // Shortest / longest station spacing along
+    double maxElementLength;    // the curve
+    
     double maxCurvature;        // Maximum curvature along curve
     double minRadius;           // Minimum radius of curvature
     double curvatureAtMax;      // Parameter t where max curvature occurs
@@ -86,6 +218,22 @@ struct CurvedMeshStats {
  * 2. Computing tangent and normal at each position
  * 3. Placing cross-section nodes perpendicular to the curve
  * 4. Connecting nodes to form HEX8 elements
+ *
+ * Planar centerlines lie in the XZ plane with the width along Y. 3D
+ * centerlines carry the cross-section on tabulated rotation-minimizing
+ * frames (width along the binormal, thickness along the normal). Node
+ * placement runs on the worker thread pool.
+ *
+ * Stations along the curve come from a precomputed table: uniform, or
+ * spaced by the density zones of VariableDensityMeshGenerator so that
+ * resolution goes where the curvature is. Each station also carries the
+ * cross-section scale from the profile.
+ *
+ * Multi-segment centerlines (straight, arc, spline) are laid out end to
+ * end first; each segment then fills its slice of the global station
+ * arrays concurrently. A station shared by two segments is written once,
+ * by the segment starting there, so interface nodes come out merged and
+ * numbered contiguously without any node search.
  */
 class CurvedMeshGenerator {
 public:
@@ -134,7 +282,64 @@ private:
     CurvedMeshStats stats_;
     std::string errorMessage_;
     CurveInterpolator curve_;
+    SpaceCurveInterpolator spaceCurve_;
+    
+    /**
+     * Cross-section station: arc length and cross-section scales
+     */
+    struct Station {
+        double arcLength;
+        double widthScale;
+        double thicknessScale;
+    };
+    
+    /**
+     * Placed segment of a multi-segment centerline
+     */
+    struct SegmentLayout {
+        SegmentType type;
+        Vector2D start;             // Start point
+        double heading;             // Start direction (radians from +X)
+        double turn;                // ARC: signed turn (radians)
+        double radius;              // ARC
+        double arcStart;            // Arc length at the start
+        double length;
+        int firstStation;           // Global station index of the start
+        int elements;
+        CurveInterpolator spline;   // SPLINE, in global coordinates
+    };
+    std::vector<SegmentLayout> segments_;
+    
+    /**
+     * Place the segments end to end with lengths scaled by scaleFactor
+     */
+    void layoutSegments(const CurvedMeshConfig& config, double scaleFactor);
+    
+    /**
+     * Position and unit tangent at arc length s within a placed segment
+     */
+    static void evaluateSegment(const SegmentLayout& segment, double s,
+                                Vector2D& position, Vector2D& tangent);
+    
+    /**
+     * Station table along a curve of the given arc length (per-segment
+     * uniform stations when segments_ is set)
+     */
+    std::vector<Station> computeStations(const CurvedMeshConfig& config,
+                                         double arcLength) const;
     
+    /**
+     * Curvature of a planar curve at parameter t
+     */
+    static double planarCurvature(const CurveInterpolator& curve, double t);
+    
+    /**
+     * Frame table resolution for 3D centerlines
+     */
+    static constexpr int FRAME_SAMPLES_PER_ELEMENT = 4;
+    static constexpr int MIN_FRAME_SAMPLES = 1000;
+    static constexpr int MAX_FRAME_SAMPLES = 1 << 22;
+
     /**
      * Compute curvature at parameter t
      */
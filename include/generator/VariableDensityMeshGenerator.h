@@ -87,18 +87,21 @@ public:
      */
     const std::string& getErrorMessage() const { return errorMessage_; }
 
+    /**
+     * Station positions (0 to targetLength) of the five density zones
+     *
+     * Shared by flat generation (X coordinates) and curved generation
+     * (arc length of each cross-section station).
+     */
+    static std::vector<double> computeStations(
+        const VariableDensityConfig& config,
+        double targetLength);
+
 private:
     ProgressCallback progressCallback_;
     VariableDensityStats stats_;
     std::string errorMessage_;
     
-    /**
-     * Compute X coordinates with variable spacing
-     */
-    std::vector<double> computeXCoordinates(
-        const VariableDensityConfig& config,
-        double scaleFactor);
-    
     /**
      * Compute transition zone spacing
      * @param startSize Starting element size
@@ -107,14 +110,14 @@ private:
      * @param growthType Type of growth
      * @return Vector of element sizes
      */
-    std::vector<double> computeTransitionSpacing(
+    static std::vector<double> computeTransitionSpacing(
         double startSize, double endSize, int numElements,
         GrowthType growthType);
     
     /**
      * Generate uniform spacing
      */
-    std::vector<double> computeUniformSpacing(
+    static std::vector<double> computeUniformSpacing(
         double length, int numElements);
     
     /**
@@ -37,7 +37,7 @@ struct ExtendedMeshConfig {
  * - Nested structures (indentation-based)
  * - Comments (#)
  * - String and numeric values
- * - List items (- [x, y] format)
+ * - List items (- [x, y] format, or "- key: value" mappings)
  */
 class YamlConfigReader {
 public:
@@ -107,6 +107,7 @@ private:
         bool isEmpty;
         bool isListItem;
         int listIndex;
+        int valueIndent;    // Column of a list item's value
     };
     ParsedLine parseLine(const std::string& line);
     
@@ -116,6 +117,9 @@ private:
     // Parse zone config from node
     ZoneConfig parseZoneConfig(const YamlNode* node);
     
+    // Parse the five zones of a variable_density block
+    void parseDensityZones(const YamlNode& node, VariableDensityConfig& config);
+    
     // Parse growth type
     GrowthType parseGrowthType(const std::string& str);
     
@@ -131,11 +135,15 @@ private:
     // Parse curved mesh config from node
     CurvedMeshConfig parseCurvedConfig(const YamlNode& root);
     
-    // Parse centerline points (list of [x, y] arrays)
-    std::vector<Vector2D> parseCenterlinePoints(const YamlNode* node);
+    // Parse centerline points (list of [x, y] or [x, y, z] arrays) into
+    // the planar or 3D point list of config
+    void parseCenterlinePoints(const YamlNode* node, CurvedMeshConfig& config);
+    
+    // Parse a list of centerline segments (straight, arc, spline)
+    void parseSegments(const YamlNode& node, CurvedMeshConfig& config);
     
-    // Parse a single point [x, y] from string
-    Vector2D parsePoint(const std::string& str);
+    // Parse the numbers of "[a, b, ...]" (or "a, b, ...")
+    std::vector<double> parseNumberList(const std::string& str);
     
     // Helper: trim whitespace
     std::string trim(const std::string& str);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Uniform subdivision of a HEX8 mesh without building the refined Mesh
+ *
+ * Every hex is split into ri x rj x rk sub-hexes along its local
+ * (0-1, 0-3, 0-4) axes; new nodes are placed by trilinear interpolation
+ * of the parent corners. Nodes on shared edges and faces are created
+ * once, keyed by the parent corner IDs, so the refined mesh is
+ * conforming wherever the input is.
+ *
+ * IDs are deterministic: original nodes keep theirs, new nodes are
+ * numbered from max(node ID) + 1 in order of first use while visiting
+ * elements by ascending ID, and sub-elements are numbered 1, 2, ...
+ * in the same order.
+ */
+class HexRefiner {
+public:
+    HexRefiner();
+    ~HexRefiner() = default;
+
+    /**
+     * Parse "n" (same factor on all axes) or "i,j,k"
+     */
+    static bool parseLevels(const std::string& text, std::array<int, 3>& levels,
+                            std::string& error);
+
+    /**
+     * Create the refined node set of mesh (positions in mesh coordinates)
+     * Fails on non-HEX8 elements, missing nodes, and shared edges that two
+     * elements would divide differently (mixed orientations with unequal
+     * factors).
+     */
+    bool build(const Mesh& mesh, const std::array<int, 3>& levels);
+
+    /**
+     * Refined nodes by ascending ID
+     */
+    const std::vector<int>& getNodeIds() const { return nodeIds_; }
+    const std::vector<Vector3D>& getPositions() const { return positions_; }
+    size_t getNodeCount() const { return nodeIds_.size(); }
+
+    /**
+     * Index of a refined node ID in getNodeIds(), or -1
+     */
+    long long indexOf(int nodeId) const;
+
+    size_t getElementCount() const { return parents_.size() * subCount(); }
+
+    using ElementVisitor = std::function<void(const Element& element)>;
+
+    /**
+     * Generate the sub-elements in ID order (valid after build())
+     */
+    void forEachElement(const ElementVisitor& visitor) const;
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    // Where lattice node (a,b,c) of a parent lives
+    struct LatticeNode {
+        enum Kind { CORNER, EDGE, FACE, INTERIOR } kind;
+        int id;               // CORNER: node ID, INTERIOR: index inside the parent
+        std::uint64_t key;    // EDGE/FACE: block key
+        int offset;           // EDGE/FACE: index inside the block
+        int countA, countB;   // EDGE/FACE: divisions along the block axes
+    };
+
+    std::array<int, 3> levels_;
+    std::vector<const Element*> parents_;
+    std::vector<int> interiorFirstId_;
+    // First node ID of the interior nodes of a shared edge (counted from
+    // the lower corner ID) or face (in its canonical frame)
+    std::unordered_map<std::uint64_t, int> edges_;
+    std::unordered_map<std::uint64_t, int> faces_;
+
+    std::vector<int> nodeIds_;
+    std::vector<Vector3D> positions_;
+    std::unordered_map<int, size_t> originalIndex_;
+    int firstNewId_;
+    std::string errorMessage_;
+
+    size_t subCount() const {
+        return static_cast<size_t>(levels_[0]) * levels_[1] * levels_[2];
+    }
+
+    LatticeNode classify(const Element& elem, int a, int b, int c) const;
+
+    /**
+     * Node ID of a classified lattice node, or -1 if its block is missing
+     */
+    int resolve(const LatticeNode& node, size_t parent) const;
+};
+
+} // namespace KooRemapper
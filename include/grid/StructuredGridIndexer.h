@@ -12,6 +12,10 @@ namespace KooRemapper {
 /**
  * Assigns i,j,k indices to elements in a structured grid
  * based on connectivity (not coordinates)
+ *
+ * Grids that close on themselves along an axis (rings, tubes) have no
+ * corner elements; that axis is reported as periodic, and its indices run
+ * 0..dim-1 with element dim-1 adjacent to element 0.
  */
 class StructuredGridIndexer {
 public:
@@ -33,6 +37,11 @@ public:
     int getDimJ() const { return dimJ_; }
     int getDimK() const { return dimK_; }
 
+    /**
+     * True if the grid closes on itself along an axis (0=i, 1=j, 2=k)
+     */
+    bool isPeriodic(int axis) const { return periodic_[axis]; }
+
     /**
      * Get element at grid index
      */
@@ -69,6 +78,7 @@ public:
 
 private:
     int dimI_, dimJ_, dimK_;
+    std::array<bool, 3> periodic_;
     std::string errorMessage_;
 
     // Direction mapping: which local face corresponds to which axis direction
@@ -89,6 +99,19 @@ private:
     bool determineInitialDirections(const Mesh& mesh, int startElem,
                                     const ConnectivityAnalyzer& connectivity);
 
+    /**
+     * Number of elements around the ring through startElem along a face
+     * axis, or 0 if the walk reaches a boundary (axis not periodic)
+     */
+    int findRingLength(const Mesh& mesh, int startElem, int axis,
+                       const ConnectivityAnalyzer& connectivity) const;
+
+    /**
+     * Detect periodic axes of a mesh with preassigned indices: element
+     * dim-1 shares a face with element 0
+     */
+    void detectPeriodicAxes(const Mesh& mesh, const ConnectivityAnalyzer& connectivity);
+
     /**
      * Propagate indices using BFS
      */
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+namespace KooRemapper {
+namespace Kernels {
+
+/**
+ * Raw view of an arc-length parametrized edge (EdgeInterpolator data)
+ * With cubic set, the edge is the CUBIC curve and arcLengths is unused.
+ */
+struct EdgePolyline {
+    const double* points;       // x,y,z per point
+    const double* arcLengths;   // Cumulative arc length per point
+    size_t count;
+    double totalLength;
+    bool closed;                // Parameters wrap around (closed ring)
+    const double* cubic = nullptr;          // a,b,c,d (x,y,z each) per segment
+    const double* cubicLengths = nullptr;   // Arc length table (cubicSamples per segment)
+    size_t cubicSamples = 0;
+};
+
+/**
+ * Hot batch kernels, compiled once per ISA level (see util/CpuFeatures.h)
+ *
+ * Kernels only see plain arrays, so every variant is self-contained.
+ * All variants are built without floating-point contraction and perform
+ * the same operations in the same order as the scalar code they replace,
+ * so results are bitwise identical whichever variant runs.
+ */
+struct KernelTable {
+    /**
+     * Edge-based mapping (ParametricMapper::mapToPhysical) of count
+     * (u,v,w) triples; edges are the four i-edges (j,k) = 00, N0, 0P, NP
+     */
+    void (*mapEdgeBlend)(const EdgePolyline* edges, const double* uvw,
+                         size_t count, double* xyz);
+
+    /**
+     * HEX8 deformation gradients at one natural point
+     * ref/def: 24 doubles per element (8 nodes x,y,z); dN: 24 doubles
+     * (dN/dxi, dN/deta, dN/dzeta per node); F: 9 doubles per element,
+     * row-major; valid[e] = 0 where the reference Jacobian is singular
+     */
+    void (*hex8DeformationGradients)(const double* ref, const double* def,
+                                     size_t count, const double* dN,
+                                     double* F, unsigned char* valid);
+
+    /**
+     * HEX8 Jacobian determinant at the element center
+     * (Validator::calculateJacobian); corners: 24 doubles per element
+     */
+    void (*hex8CenterJacobians)(const double* corners, size_t count, double* jacobians);
+};
+
+/**
+ * Kernel table of the active ISA level
+ */
+const KernelTable& active();
+
+} // namespace Kernels
+} // namespace KooRemapper
@@ -5,18 +5,46 @@
 
 namespace KooRemapper {
 
+/**
+ * Curve through the points of an edge
+ */
+enum class EdgeInterpolation {
+    LINEAR,     // Polyline (chord-length parameterized)
+    CUBIC       // C1 cubic Hermite (arc-length parameterized)
+};
+
 /**
  * Interpolates along an edge using arc-length parameterization
+ *
+ * A closed edge (the boundary of a reference that the indexer found
+ * periodic; its last point is its first) wraps parameters outside 0..1
+ * around instead of clamping them.
+ *
+ * CUBIC joins the points with C1 Hermite segments. Tangents are the
+ * chord-length weighted (Bessel) differences of the neighbouring chords,
+ * zeroed where the edge turns by 90 degrees or more so sharp corners do
+ * not overshoot. Every segment is split into CUBIC_SAMPLES sub-steps whose
+ * arc lengths are tabulated; t is inverted through that table, so one
+ * query is a binary search plus a cubic, about the cost of the polyline.
  */
 class EdgeInterpolator {
 public:
     EdgeInterpolator();
     ~EdgeInterpolator() = default;
 
+    /**
+     * Arc-length table entries per cubic segment
+     */
+    static constexpr size_t CUBIC_SAMPLES = 8;
+
     /**
      * Build interpolator from a list of points
+     * @param closed  Edge is a loop (topology, not coordinates, decides);
+     *                the last point must then repeat the first
      */
-    void build(const std::vector<Vector3D>& points);
+    void build(const std::vector<Vector3D>& points,
+               EdgeInterpolation mode = EdgeInterpolation::LINEAR,
+               bool closed = false);
 
     /**
      * Get interpolated position at parameter t (0 to 1)
@@ -29,7 +57,21 @@ public:
     Vector3D tangent(double t) const;
 
     /**
-     * Get total arc length
+     * Get derivative dP/dt at parameter t (not normalized)
+     * On a segment this is the chord direction scaled by
+     * totalLength / segmentLength, i.e. its norm is the total arc length
+     * (for CUBIC, up to the arc-length table resolution).
+     */
+    Vector3D derivative(double t) const;
+
+    /**
+     * Position and derivative at t with a single segment lookup
+     * position is identical to interpolate(t).
+     */
+    void evaluate(double t, Vector3D& position, Vector3D& derivative) const;
+
+    /**
+     * Get total arc length (of the polyline, or of the cubic curve)
      */
     double getTotalLength() const { return totalLength_; }
 
@@ -43,6 +85,27 @@ public:
      */
     const Vector3D& getPoint(size_t index) const { return points_[index]; }
 
+    /**
+     * All points and their cumulative chord lengths (for batch kernels)
+     */
+    const std::vector<Vector3D>& getPoints() const { return points_; }
+    const std::vector<double>& getArcLengths() const { return arcLengths_; }
+
+    /**
+     * CUBIC data for batch kernels: per segment the coefficients a, b, c, d
+     * of P(s) = a + b s + c s^2 + d s^3 (s = 0..1), and the cumulative arc
+     * length at every 1/CUBIC_SAMPLES step of s
+     */
+    const std::vector<Vector3D>& getCubicCoefficients() const { return coefficients_; }
+    const std::vector<double>& getCubicLengths() const { return cubicLengths_; }
+
+    EdgeInterpolation getMode() const { return mode_; }
+
+    /**
+     * True if the edge was built as a closed loop
+     */
+    bool isClosed() const { return closed_; }
+
     /**
      * Check if interpolator is valid
      */
@@ -50,14 +113,41 @@ public:
 
 private:
     std::vector<Vector3D> points_;
-    std::vector<double> arcLengths_;  // Cumulative arc lengths
+    std::vector<double> arcLengths_;  // Cumulative chord lengths
     double totalLength_;
+    bool closed_;
+    EdgeInterpolation mode_;
+
+    std::vector<Vector3D> coefficients_;  // CUBIC: a, b, c, d per segment
+    std::vector<double> cubicLengths_;    // CUBIC: arc length table
+
+    /**
+     * Tangents, coefficients and arc length table of the CUBIC curve
+     */
+    void buildCubic();
+
+    /**
+     * CUBIC arc length table step at targetLength (its segment is
+     * step / CUBIC_SAMPLES) and the local parameter s in that segment
+     */
+    size_t locateCubic(double targetLength, double& s) const;
+
+    /**
+     * Clamp t to 0..1, or wrap it for a closed edge
+     */
+    double normalizeParameter(double t) const;
 
     /**
      * Find segment containing parameter t
      * Returns segment index and local parameter within segment
      */
     std::pair<size_t, double> findSegment(double t) const;
+
+    /**
+     * Index of the first interval of lengths whose end reaches targetLength
+     * (binary search over cumulative lengths)
+     */
+    size_t locate(const std::vector<double>& lengths, double targetLength) const;
 };
 
 } // namespace KooRemapper
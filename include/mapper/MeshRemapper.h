@@ -49,18 +49,41 @@ public:
      */
     void setFlatMesh(const Mesh* mesh);
 
+    /**
+     * Override the flat-mesh bounding box used for the (u,v,w) parametrization
+     * Needed when the flat mesh is only one partition of the full mesh.
+     */
+    void setFlatBounds(const Vector3D& minBound, const Vector3D& maxBound);
+
+    /**
+     * Curve through the bent edge nodes (see ParametricMapper)
+     */
+    void setEdgeInterpolation(EdgeInterpolation mode) { paramMapper_.setEdgeInterpolation(mode); }
+
     /**
      * Perform the mapping operation
      * @return true if successful
      */
     bool performMapping();
 
+    /**
+     * Analyze the bent mesh and build the parametric mapper only
+     * (steps 1-2 of performMapping; no flat mesh needed)
+     * @return true if successful
+     */
+    bool buildMapper();
+
     /**
      * Get the result mesh (bent unstructured)
      */
     const Mesh& getResult() const { return resultMesh_; }
     Mesh& getResult() { return resultMesh_; }
 
+    /**
+     * Parametric mapping of the bent mesh (valid after performMapping/buildMapper)
+     */
+    const ParametricMapper& getParametricMapper() const { return paramMapper_; }
+
     /**
      * Get mapping statistics
      */
@@ -90,6 +113,10 @@ private:
     const Mesh* flatMesh_;
     Mesh resultMesh_;
 
+    bool hasFlatBounds_;
+    Vector3D flatMin_;
+    Vector3D flatMax_;
+
     // Analysis components
     ConnectivityAnalyzer connectivity_;
     StructuredGridIndexer indexer_;
@@ -7,9 +7,30 @@
 #include "grid/EdgeCalculator.h"
 #include "grid/BoundaryExtractor.h"
 #include <array>
+#include <iosfwd>
+#include <vector>
 
 namespace KooRemapper {
 
+/**
+ * Mapped position and first derivatives of the mapping at one (u,v,w)
+ *
+ * The columns dX/du, dX/dv, dX/dw form the 3x3 Jacobian of the mapping;
+ * they transform parametric directions (fibers, normals via the inverse
+ * transpose, material axes) into the bent configuration.
+ */
+struct MappingDerivatives {
+    Vector3D position;
+    Vector3D dXdu;
+    Vector3D dXdv;
+    Vector3D dXdw;
+
+    /**
+     * det[dX/du dX/dv dX/dw]; positive for a non-inverted mapping
+     */
+    double jacobian() const { return dXdu.dot(dXdv.cross(dXdw)); }
+};
+
 /**
  * Maps parametric coordinates (u,v,w) in [0,1]^3 to physical coordinates
  * using transfinite interpolation (Gordon-Hall method)
@@ -19,11 +40,21 @@ public:
     ParametricMapper();
     ~ParametricMapper() = default;
 
+    /**
+     * Curve through the bent edge nodes (default LINEAR); set before
+     * build(). CUBIC lets a much coarser reference reach the same accuracy.
+     */
+    void setEdgeInterpolation(EdgeInterpolation mode) { edgeInterpolation_ = mode; }
+    EdgeInterpolation getEdgeInterpolation() const { return edgeInterpolation_; }
+
     /**
      * Build mapper from a bent structured mesh
+     * @param closed  The indexer found the i axis periodic
+     *                (StructuredGridIndexer::isPeriodic(0)); the i-edges
+     *                are then loops
      */
     void build(const Mesh& mesh, const BoundaryExtractor& boundary,
-               const EdgeCalculator& edgeCalc);
+               const EdgeCalculator& edgeCalc, bool closed = false);
 
     /**
      * Map parametric coordinate to physical coordinate
@@ -34,6 +65,28 @@ public:
      */
     Vector3D mapToPhysical(double u, double v, double w) const;
 
+    /**
+     * Position and analytic derivatives of mapToPhysical() at (u,v,w)
+     * Parameters are clamped to [0,1]; at edge-polyline vertices the
+     * derivative along u is taken from the segment containing the point.
+     */
+    MappingDerivatives evaluate(double u, double v, double w) const;
+
+    /**
+     * Batched mapToPhysical() for many (u,v,w) points (stored as x,y,z)
+     * Runs on the worker thread pool.
+     */
+    void mapToPhysicalBatch(const std::vector<Vector3D>& uvw,
+                            std::vector<Vector3D>& positions) const;
+
+    /**
+     * Batched evaluate() for many (u,v,w) points (stored as x,y,z)
+     * Shares the position kernel, so derivatives add only a few
+     * multiply-adds per point. Runs on the worker thread pool.
+     */
+    void evaluateBatch(const std::vector<Vector3D>& uvw,
+                       std::vector<MappingDerivatives>& results) const;
+
     /**
      * Simpler trilinear interpolation using only 8 corners
      */
@@ -49,11 +102,30 @@ public:
      */
     Vector3D edgeBasedInterpolate(double u, double v, double w) const;
 
+    /**
+     * Write corners and edge polylines (everything the mapping depends on)
+     * Values are written with round-trip precision, so a reloaded mapper
+     * reproduces mapToPhysical() bit for bit. A CUBIC mapper starts with an
+     * "interpolation cubic" line.
+     */
+    bool save(std::ostream& out) const;
+
+    /**
+     * Rebuild the mapper from data written by save()
+     */
+    bool load(std::istream& in);
+
     /**
      * Check if mapper is valid
      */
     bool isValid() const { return isValid_; }
 
+    /**
+     * True if the reference closes on itself along i (its i-edges are
+     * closed loops); u then wraps around instead of clamping
+     */
+    bool isClosed() const { return edges_[0].isClosed(); }
+
     /**
      * Get corner positions
      */
@@ -71,11 +143,12 @@ private:
 
     bool isValid_;
     bool useTransfinite_;
+    EdgeInterpolation edgeInterpolation_;
 
     /**
      * Build edge interpolators
      */
-    void buildEdges(const Mesh& mesh, const EdgeCalculator& edgeCalc);
+    void buildEdges(const Mesh& mesh, const EdgeCalculator& edgeCalc, bool closed);
 
     /**
      * Build face interpolators
@@ -96,6 +169,12 @@ private:
      * U-fold has start and end i-edges at similar X positions
      */
     bool isUFoldGeometry() const;
+
+    /**
+     * Edge-based kernel shared by the batched and single-point paths
+     */
+    template <bool WithDerivatives>
+    void evaluateKernel(double u, double v, double w, MappingDerivatives& out) const;
 };
 
 } // namespace KooRemapper
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "core/Vector3D.h"
+#include "mapper/ParametricMapper.h"
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Maps arbitrary flat-frame points onto the bent geometry
+ *
+ * Holds the parametric mapper of a bent mesh together with the flat-frame
+ * bounding box that defines the (u,v,w) parametrization, i.e. exactly what
+ * MeshRemapper uses for mesh nodes. The pair can be saved to a small cache
+ * file so repeated point-set runs skip the bent mesh analysis.
+ */
+class PointMapper {
+public:
+    PointMapper();
+    ~PointMapper() = default;
+
+    /**
+     * Curve through the bent edge nodes for build() (see ParametricMapper)
+     */
+    void setEdgeInterpolation(EdgeInterpolation mode) { edgeInterpolation_ = mode; }
+
+    /**
+     * Build from a bent structured mesh and the flat-frame bounds
+     */
+    bool build(const Mesh& bentMesh, const Vector3D& flatMin, const Vector3D& flatMax);
+
+    /**
+     * Save mapper and flat bounds to a cache file
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * Load a cache file written by save()
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Map flat-frame points to bent positions in place
+     * Points outside the flat bounds are clamped, as for mesh nodes.
+     * Runs on the worker thread pool.
+     */
+    void mapPoints(std::vector<Vector3D>& points) const;
+
+    /**
+     * Bent positions and derivatives of the mapping at flat-frame points
+     * dXdu, dXdv, dXdw are taken per unit flat x, y, z, so they are the
+     * columns of the flat -> bent deformation gradient. Runs on the worker
+     * thread pool.
+     */
+    void evaluatePoints(const std::vector<Vector3D>& points,
+                        std::vector<MappingDerivatives>& results) const;
+
+    bool isValid() const { return mapper_.isValid(); }
+    const Vector3D& getFlatMin() const { return flatMin_; }
+    const Vector3D& getFlatMax() const { return flatMax_; }
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    ParametricMapper mapper_;
+    Vector3D flatMin_;
+    Vector3D flatMax_;
+    std::string errorMessage_;
+    EdgeInterpolation edgeInterpolation_ = EdgeInterpolation::LINEAR;
+
+    // Scratch (u,v,w) buffer reused across chunks
+    mutable std::vector<Vector3D> uvw_;
+
+    /**
+     * Fill uvw_ with the parameters of flat-frame points
+     */
+    void toParametric(const std::vector<Vector3D>& points) const;
+};
+
+} // namespace KooRemapper
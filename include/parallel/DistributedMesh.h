@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "parallel/MpiContext.h"
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Partitioned k-file access for MPI runs
+ *
+ * Each rank parses only its byte range of the *NODE and *ELEMENT_SOLID
+ * data (see KFileReader::readPartition), so no rank ever holds the whole
+ * mesh. Nodes referenced by local elements but owned by another rank
+ * ("ghost" nodes) are fetched through a hash directory: node id N is
+ * registered at rank N % size, which answers coordinate requests.
+ */
+class DistributedMesh {
+public:
+    explicit DistributedMesh(const MpiContext& mpi);
+
+    /**
+     * Read this rank's partition of a k-file (collective)
+     * Rank 0 scans the section layout and broadcasts it.
+     * @throws std::runtime_error on every rank if the file cannot be read
+     */
+    Mesh readPartition(const std::string& filename, bool readElements = true);
+
+    /**
+     * Add every node referenced by target's elements (collective)
+     * Positions are taken from the owned nodes of all ranks; nodes already
+     * present in target are overwritten with the owner's position.
+     * @return number of referenced node ids that no rank owns
+     */
+    long long gatherNodes(const Mesh& owned, Mesh& target) const;
+
+    /**
+     * Global bounding box of the owned nodes of all ranks (collective)
+     */
+    void globalBounds(const Mesh& owned, Vector3D& minBound, Vector3D& maxBound) const;
+
+private:
+    const MpiContext& mpi_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * RAII wrapper around the MPI environment
+ *
+ * Initializes MPI on construction and finalizes it on destruction, and
+ * offers the few collectives the distributed drivers need. All methods
+ * except rank()/size() are collective over MPI_COMM_WORLD.
+ */
+class MpiContext {
+public:
+    MpiContext(int* argc, char*** argv);
+    ~MpiContext();
+
+    MpiContext(const MpiContext&) = delete;
+    MpiContext& operator=(const MpiContext&) = delete;
+
+    int rank() const { return rank_; }
+    int size() const { return size_; }
+    bool isRoot() const { return rank_ == 0; }
+
+    void barrier() const;
+
+    // Reductions (result on all ranks)
+    double minAll(double value) const;
+    double maxAll(double value) const;
+    double sumAll(double value) const;
+    long long sumAll(long long value) const;
+
+    /**
+     * True on all ranks only if value is true on every rank
+     */
+    bool allTrue(bool value) const;
+
+    /**
+     * Broadcast a byte string from root
+     */
+    void broadcast(std::string& data, int root = 0) const;
+
+    /**
+     * Personalized all-to-all exchange of byte buffers
+     * send[r] is delivered to rank r; result[r] came from rank r.
+     * Throws std::runtime_error on every rank if any rank would send or
+     * receive more than 2 GB.
+     */
+    std::vector<std::string> exchange(const std::vector<std::string>& send) const;
+
+private:
+    int rank_;
+    int size_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "parallel/MpiContext.h"
+#include <mpi.h>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Shared output file written collectively with MPI-IO
+ *
+ * Every write() call is collective: each rank contributes one block (which
+ * may be empty), and the blocks are stored back to back in rank order at
+ * the current end of the file. A file can thus be assembled from sections
+ * such as "header on root" followed by "node lines from every rank".
+ */
+class OrderedFileWriter {
+public:
+    explicit OrderedFileWriter(const MpiContext& mpi);
+    ~OrderedFileWriter();
+
+    /**
+     * Create (truncate) the output file (collective)
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Append one block per rank, in rank order (collective)
+     */
+    bool write(const std::string& block);
+
+    /**
+     * Append a block contributed by root only (collective)
+     */
+    bool writeRoot(const std::string& block);
+
+    void close();
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    const MpiContext& mpi_;
+    MPI_File file_;
+    bool isOpen_;
+    long long offset_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "analysis/ElementAnalyzer.h"
+#include "core/Mesh.h"
+#include <ostream>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Writer for Abaqus input (.inp) files
+ *
+ * Mesh output is *NODE followed by one *ELEMENT block per run of elements
+ * with the same type and part, each adding to the element set PART-<pid>.
+ * HEX8 is written as C3D8 and TET4 as C3D4 (LS-DYNA solid node order is
+ * the Abaqus order); other types keep their 8 corner nodes as C3D8, as in
+ * KFileWriter. Sections and materials are left to the including model.
+ *
+ * Stress output is an *INITIAL CONDITIONS, TYPE=STRESS block (one value
+ * per element: S11, S22, S33, S12, S13, S23) for *INCLUDE in a model with
+ * the same element IDs.
+ */
+class AbaqusWriter {
+public:
+    AbaqusWriter();
+    ~AbaqusWriter() = default;
+
+    /**
+     * Write mesh to an .inp file
+     * @param filename Output file path, or "-" for stdout
+     * @param useMappedPositions If true, use mapped positions instead of original
+     */
+    bool writeFile(const std::string& filename, const Mesh& mesh,
+                   bool useMappedPositions = true);
+
+    bool write(std::ostream& out, const Mesh& mesh, bool useMappedPositions = true);
+
+    /**
+     * Write the element stresses of an analysis as initial conditions
+     * @param refFile, defFile  Mesh filenames (for comments)
+     */
+    bool writeStressFile(const std::string& filename, const MeshAnalysisResult& results,
+                         const std::string& refFile = "", const std::string& defFile = "");
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+    /**
+     * Digits after the decimal point of coordinates and stresses
+     * (scientific; default: 9, as KFileWriter)
+     */
+    void setPrecision(int precision) { precision_ = precision; }
+
+    /**
+     * Section-level output; writeFile() is header + node keyword + node
+     * lines + elements, writeStressFile() is stress header + stress lines
+     */
+    void writeHeader(std::ostream& out);
+    void writeNodeKeyword(std::ostream& out);
+    void writeNodeLines(std::ostream& out, const Mesh& mesh, bool useMappedPositions);
+    void writeElements(std::ostream& out, const Mesh& mesh);
+    void writeStressHeader(std::ostream& out, const std::string& refFile,
+                           const std::string& defFile);
+    void writeStressLines(std::ostream& out, const MeshAnalysisResult& results);
+
+private:
+    std::string errorMessage_;
+    int precision_;
+};
+
+} // namespace KooRemapper
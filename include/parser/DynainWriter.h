@@ -1,15 +1,19 @@
 #pragma once
 
 #include "analysis/ElementAnalyzer.h"
+#include "analysis/ResidualAnalyzer.h"
 #include "analysis/StrainTensor.h"
 #include "analysis/StressTensor.h"
 #include "core/Mesh.h"
 #include <string>
 #include <vector>
 #include <fstream>
+#include <ostream>
 
 namespace KooRemapper {
 
+class AsyncOutputStream;
+
 /**
  * Writer for LS-DYNA dynain format
  * 
@@ -23,7 +27,7 @@ public:
     /**
      * Write dynain file with initial stresses
      * 
-     * @param filename    Output file path
+     * @param filename    Output file path, or "-" for stdout
      * @param results     Element analysis results
      * @param strainType  Strain type used (for comment)
      * @param refFile     Reference mesh filename (for comment)
@@ -50,6 +54,18 @@ public:
         const MeshAnalysisResult& results
     );
 
+    /**
+     * Write nodal residual force field to CSV file
+     * 
+     * @param filename  Output CSV path
+     * @param report    Residual report from ResidualAnalyzer
+     * @return true on success
+     */
+    bool writeResidualCSV(
+        const std::string& filename,
+        const ResidualReport& report
+    );
+
     /**
      * Get error message if write failed
      */
@@ -60,16 +76,30 @@ public:
      */
     void setLargeDeformation(bool large) { largeDeformation_ = large; }
 
-private:
-    std::string errorMessage_;
-    bool largeDeformation_;
-
-    void writeHeader(std::ofstream& file, 
+    /**
+     * Section-level output, for callers that assemble a dynain file from
+     * several pieces. writeFile() is header + stress cards + "*END".
+     */
+    void writeHeader(std::ostream& file, 
                     StrainType strainType,
                     const std::string& refFile,
                     const std::string& defFile);
+
+    void writeStressCards(std::ostream& file, const MeshAnalysisResult& results);
+
+    /**
+     * CSV header / data rows of writeStrainCSV()
+     */
+    void writeStrainCSVHeader(std::ostream& file, bool hasMaterial);
+    void writeStrainCSVRows(std::ostream& file, const MeshAnalysisResult& results);
+
+private:
+    std::string errorMessage_;
+    bool largeDeformation_;
     
-    void writeStressCard(std::ofstream& file, const ElementResult& result);
+    void writeStressCard(std::ostream& file, const ElementResult& result);
+
+    bool closeFile(AsyncOutputStream& file, const std::string& filename);
     
     std::string getCurrentDateTime();
 };
@@ -1,13 +1,27 @@
 #pragma once
 
 #include "core/Mesh.h"
+#include "util/Metrics.h"
 #include <string>
 #include <fstream>
+#include <istream>
 #include <vector>
 #include <functional>
 
 namespace KooRemapper {
 
+/**
+ * Byte range of one keyword section in a k-file
+ */
+struct KFileSection {
+    std::string keyword;       // Upper-case keyword without '*'
+    long long keywordOffset;   // Offset of the keyword line
+    long long dataBegin;       // First byte after the keyword line
+    long long dataEnd;         // Offset of the next keyword line (or EOF)
+
+    KFileSection() : keywordOffset(0), dataBegin(0), dataEnd(0) {}
+};
+
 /**
  * Parser for LS-DYNA keyword (.k) files
  *
@@ -27,12 +41,57 @@ public:
 
     /**
      * Read a k-file and return the mesh
-     * @param filename Path to the k-file
+     * @param filename Path to the k-file, or "-" for stdin
      * @return Parsed mesh
      * @throws std::runtime_error on parse errors
      */
     Mesh readFile(const std::string& filename);
 
+    /**
+     * Read a k-file from a stream in a single forward pass
+     * The stream is never seeked, so pipes and stdin work.
+     * @throws std::runtime_error on parse errors
+     */
+    Mesh read(std::istream& in);
+
+    /**
+     * Locate all keyword sections without parsing their data
+     * @throws std::runtime_error if the file cannot be opened (or is stdin)
+     */
+    std::vector<KFileSection> scanSections(const std::string& filename);
+
+    /**
+     * Read one of numParts partitions of a k-file
+     *
+     * The data of all *NODE sections (and of all *ELEMENT_SOLID sections)
+     * is split into numParts contiguous byte ranges; a line belongs to the
+     * range holding its first byte, so file order is preserved across
+     * parts. *PART and *MAT_ELASTIC are small and read by every part.
+     *
+     * @param filename       Path to the k-file
+     * @param sections       Result of scanSections() for this file
+     * @param part           Partition index (0-based)
+     * @param numParts       Number of partitions
+     * @param readElements   If false, *ELEMENT_SOLID data is skipped
+     * @throws std::runtime_error on parse errors
+     */
+    Mesh readPartition(const std::string& filename,
+                       const std::vector<KFileSection>& sections,
+                       int part, int numParts,
+                       bool readElements = true);
+
+    using NodeVisitor = std::function<void(int id, const Vector3D& position)>;
+
+    /**
+     * Stream every node of all *NODE sections through a visitor
+     * Nothing is stored, so this works for files larger than memory
+     * (e.g. to compute a bounding box or pick out a subset of nodes).
+     * @throws std::runtime_error on parse errors
+     */
+    void forEachNode(const std::string& filename,
+                     const std::vector<KFileSection>& sections,
+                     const NodeVisitor& visitor);
+
     /**
      * Set progress callback
      */
@@ -57,15 +116,38 @@ private:
     int currentLine_;
     int linesProcessed_;
     long fileSize_;
+    long long bytesRead_;        // Consumed by the forward parser
+    std::string pendingLine_;    // One-line lookahead handed back by a section parser
+    bool hasPendingLine_;
     ProgressCallback progressCallback_;
+    NodeVisitor nodeVisitor_;   // If set, parsed nodes go here instead of mesh_
+
+    // Event counts of the current read, handed to Metrics by flushMetrics()
+    Metrics::Values counts_;
+    Metrics::Counter blockCounter_;   // Byte counter of the current keyword block
+
+    Mesh readStream(std::istream& in);
+
+    // Forward-only line input; a section parser that reads the next
+    // keyword line pushes it back for the caller instead of seeking
+    bool nextLine(std::istream& in, std::string& line);
+    void pushBackLine(const std::string& line);
 
     // Parse methods
-    bool parseFile(std::ifstream& file);
-    bool parseNodeSection(std::ifstream& file);
-    bool parseElementSolidSection(std::ifstream& file);
-    bool parsePartSection(std::ifstream& file);
-    bool parseMatElasticSection(std::ifstream& file);
-    void skipToNextKeyword(std::ifstream& file);
+    bool parseFile(std::istream& file);
+    bool parseNodeSection(std::istream& file);
+    bool parseElementSolidSection(std::istream& file);
+    bool parsePartSection(std::istream& file);
+    bool parseMatElasticSection(std::istream& file);
+    void skipToNextKeyword(std::istream& file);
+
+    // Single data lines (shared by full and partitioned reads)
+    void parseNodeLine(const std::string& line);
+    void parseElementLine(const std::string& line);
+
+    // Parse the data lines starting in [begin, end) of one section
+    bool parseLineRange(std::ifstream& file, const KFileSection& section,
+                        long long begin, long long end, bool nodes);
 
     // Helper methods
     bool isKeywordLine(const std::string& line) const;
@@ -79,7 +161,12 @@ private:
     int parseInt(const std::string& str) const;
 
     // Report progress
-    void reportProgress(std::streampos currentPos);
+    void reportProgress(long long bytesRead);
+
+    // Metrics
+    void countLine(const std::string& line);
+    void flushMetrics();
+    static Metrics::Counter keywordCounter(const std::string& keyword);
 };
 
 } // namespace KooRemapper
@@ -3,6 +3,7 @@
 #include "core/Mesh.h"
 #include <string>
 #include <fstream>
+#include <ostream>
 
 namespace KooRemapper {
 
@@ -16,7 +17,7 @@ public:
 
     /**
      * Write mesh to a k-file
-     * @param filename Output file path
+     * @param filename Output file path, or "-" for stdout
      * @param mesh Mesh to write
      * @param useMappedPositions If true, use mapped positions instead of original
      * @return true on success
@@ -24,6 +25,12 @@ public:
     bool writeFile(const std::string& filename, const Mesh& mesh,
                    bool useMappedPositions = true);
 
+    /**
+     * Write mesh as a k-file to any stream (pipe, socket, memory)
+     * @return true on success
+     */
+    bool write(std::ostream& out, const Mesh& mesh, bool useMappedPositions = true);
+
     /**
      * Get last error message
      */
@@ -44,17 +51,32 @@ public:
      */
     void setIncludeHeader(bool include) { includeHeader_ = include; }
 
+    /**
+     * Section-level output, for callers that assemble a k-file from
+     * several pieces (e.g. partitioned or ordered parallel writes).
+     * writeFile() is header + node keyword + node lines +
+     * element keyword + element lines + end.
+     */
+    void writeHeader(std::ostream& out);
+    void writeNodeKeyword(std::ostream& out);
+    void writeNodeLines(std::ostream& out, const Mesh& mesh, bool useMappedPositions);
+    void writeElementKeyword(std::ostream& out);
+    void writeElementLines(std::ostream& out, const Mesh& mesh);
+    void writeEnd(std::ostream& out);
+
+    /**
+     * Single node / element lines, for callers that generate data on the
+     * fly instead of holding a Mesh (IDs must come in ascending order)
+     */
+    void writeNodeLine(std::ostream& out, int id, const Vector3D& position);
+    void writeElementLine(std::ostream& out, const Element& element);
+
 private:
     std::string errorMessage_;
     int precision_;
     int coordFieldWidth_;
     bool includeHeader_;
 
-    void writeHeader(std::ofstream& file);
-    void writeNodeSection(std::ofstream& file, const Mesh& mesh, bool useMappedPositions);
-    void writeElementSection(std::ofstream& file, const Mesh& mesh);
-    void writeEnd(std::ofstream& file);
-
     std::string formatDouble(double value) const;
     std::string formatInt(int value, int width) const;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include <ostream>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Nastran bulk data field format
+ */
+enum class NastranField {
+    FREE,   // Comma separated; GRID* keeps 16-character coordinates
+    LARGE   // Fixed 16-character fields (GRID*, CHEXA*, CTETRA*)
+};
+
+/**
+ * Writer for Nastran bulk data (.bdf) geometry
+ *
+ * BEGIN BULK, GRID entries, solid element entries with the LS-DYNA part
+ * ID as PID, and ENDDATA. HEX8 (and types written with 8 corner nodes, as
+ * in KFileWriter) is CHEXA, TET4 is CTETRA; collapsed hexes in the LS-DYNA
+ * conventions become CPENTA, CPYRAM or CTETRA, since Nastran rejects
+ * repeated grids. Other collapsed hexes fail the write with an error
+ * naming the element. The LS-DYNA solid node order is the Nastran order.
+ * Properties and materials are left to the including deck.
+ *
+ * Coordinates always use 16-character fields: free format writes them as
+ * large-field free entries (GRID*), so neither format rounds them to the
+ * 8 characters of small fields.
+ */
+class NastranWriter {
+public:
+    NastranWriter();
+    ~NastranWriter() = default;
+
+    /**
+     * Write mesh to a bulk data file
+     * @param filename Output file path, or "-" for stdout
+     * @param useMappedPositions If true, use mapped positions instead of original
+     */
+    bool writeFile(const std::string& filename, const Mesh& mesh,
+                   bool useMappedPositions = true);
+
+    bool write(std::ostream& out, const Mesh& mesh, bool useMappedPositions = true);
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+    void setFieldFormat(NastranField format) { format_ = format; }
+    NastranField getFieldFormat() const { return format_; }
+
+    /**
+     * Section-level output; writeFile() is header + node lines + element
+     * lines + end
+     */
+    void writeHeader(std::ostream& out);
+    void writeNodeLines(std::ostream& out, const Mesh& mesh, bool useMappedPositions);
+    void writeElementLines(std::ostream& out, const Mesh& mesh);
+    void writeEnd(std::ostream& out);
+
+private:
+    std::string errorMessage_;
+    NastranField format_;
+
+    /**
+     * One entry with integer fields: name, then 8 fields per line
+     * (4 per line in large format), continued with '+' / '*'
+     */
+    void writeIntEntry(std::ostream& out, const char* name, const int* fields, int count);
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "core/Vector3D.h"
+#include "util/AsyncFileWriter.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * On-disk layout of a point set
+ *
+ * CSV:    one point per line, "x,y,z[,extra...]" (comma, space or tab
+ *         separated). An optional non-numeric first line is a header.
+ *         Columns after z are carried through to the output verbatim.
+ * BINARY: raw native-endian float64 x,y,z triplets, no header.
+ */
+enum class PointFormat {
+    CSV,
+    BINARY
+};
+
+/**
+ * Format implied by a file extension (.bin / .raw / .xyzb = BINARY)
+ */
+PointFormat pointFormatFromPath(const std::string& path);
+
+/**
+ * Parse "csv" or "bin"
+ */
+bool parsePointFormat(const std::string& text, PointFormat& format);
+
+/**
+ * Chunk of a point set: coordinates plus per-point trailing CSV columns
+ */
+struct PointChunk {
+    std::vector<Vector3D> points;
+    std::vector<std::string> extras;  // Empty for BINARY input
+
+    size_t size() const { return points.size(); }
+    void clear() { points.clear(); extras.clear(); }
+};
+
+/**
+ * Streaming point-set reader; memory use is bounded by the chunk size
+ */
+class PointSetReader {
+public:
+    PointSetReader();
+    ~PointSetReader() = default;
+
+    /**
+     * @param filename  Input path, or "-" for stdin
+     */
+    bool open(const std::string& filename, PointFormat format);
+
+    /**
+     * Read up to maxPoints points into chunk (replacing its contents)
+     * @return Number of points read; 0 at end of input or on error
+     */
+    size_t read(PointChunk& chunk, size_t maxPoints);
+
+    void close();
+
+    /**
+     * CSV header line (empty if none)
+     */
+    const std::string& getHeader() const { return header_; }
+
+    /**
+     * Column separator detected in CSV input
+     */
+    char getSeparator() const { return separator_; }
+
+    long long getPointsRead() const { return pointsRead_; }
+    bool hasError() const { return !errorMessage_.empty(); }
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    std::ifstream file_;
+    std::istream* in_;       // file_, or std::cin for "-"
+    PointFormat format_;
+    std::string filename_;
+    std::string header_;
+    std::string pending_;    // First data line read while detecting the header
+    bool hasPending_;
+    char separator_;
+    long long lineNumber_;
+    long long pointsRead_;
+    std::string errorMessage_;
+
+    bool parseLine(const std::string& line, Vector3D& point, std::string& extra) const;
+};
+
+/**
+ * Streaming point-set writer matching PointSetReader's layout
+ */
+class PointSetWriter {
+public:
+    PointSetWriter();
+    ~PointSetWriter() = default;
+
+    /**
+     * @param filename   Output path, or "-" for stdout
+     * @param header     CSV header line written first (ignored for BINARY)
+     * @param separator  CSV column separator
+     */
+    bool open(const std::string& filename, PointFormat format,
+              const std::string& header = "", char separator = ',');
+
+    /**
+     * Append a chunk; extras (if any) follow z on each CSV line
+     */
+    bool write(const PointChunk& chunk);
+
+    bool close();
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    AsyncOutputStream file_;
+    PointFormat format_;
+    std::string filename_;
+    char separator_;
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
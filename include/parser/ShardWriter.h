@@ -0,0 +1,92 @@
+#pragma once
+
+#include "util/AsyncFileWriter.h"
+#include <string>
+#include <vector>
+#include <fstream>
+
+namespace KooRemapper {
+
+/**
+ * Partial output of one shard of a sharded (--shard k/N) run
+ *
+ * An output file is described as a sequence of segments (e.g. header,
+ * node lines, element keyword, element lines, *END). Shard k appends its
+ * share of every segment to "<output>.shard<k>" and records the segment
+ * lengths in "<output>.shard<k>.manifest". ShardMerger then rebuilds the
+ * final file segment by segment, taking the shards in order.
+ *
+ * Segments that only one shard should contribute (headers, keywords) are
+ * written with writeFirst(), which is a no-op on every shard but shard 0.
+ */
+class ShardWriter {
+public:
+    ShardWriter();
+    ~ShardWriter() = default;
+
+    /**
+     * Create the partial output of one shard
+     * @param output     Final output path (after merging)
+     * @param shard      Shard index, 0 <= shard < numShards
+     * @param numShards  Total number of shards
+     */
+    bool open(const std::string& output, int shard, int numShards);
+
+    /**
+     * Append this shard's part of the next segment
+     */
+    bool write(const std::string& block);
+
+    /**
+     * Append a segment contributed by shard 0 only
+     */
+    bool writeFirst(const std::string& block);
+
+    /**
+     * Finish the partial output and write the manifest
+     */
+    bool close();
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+    static std::string partialPath(const std::string& output, int shard);
+    static std::string manifestPath(const std::string& output, int shard);
+
+private:
+    AsyncOutputStream file_;
+    std::string output_;
+    int shard_;
+    int numShards_;
+    std::vector<long long> segments_;
+    std::string errorMessage_;
+};
+
+/**
+ * Stitches the partial outputs of all shards into the final file
+ */
+class ShardMerger {
+public:
+    ShardMerger();
+    ~ShardMerger() = default;
+
+    /**
+     * Merge "<output>.shard0..N-1" into output
+     * N is taken from the manifest of shard 0; every shard must be present.
+     * @param removeParts  Delete partial files and manifests after merging
+     */
+    bool merge(const std::string& output, bool removeParts = false);
+
+    int getShardCount() const { return shardCount_; }
+    long long getBytesWritten() const { return bytesWritten_; }
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    int shardCount_;
+    long long bytesWritten_;
+    std::string errorMessage_;
+
+    bool readManifest(const std::string& output, int shard, int& numShards,
+                      std::vector<long long>& segments);
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <ios>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Output file whose disk writes run on a dedicated writer thread
+ *
+ * The caller formats into one of a small ring of large buffers (three by
+ * default). A full buffer is handed to the writer thread, which issues a
+ * single large write while the caller keeps formatting into the next one,
+ * so formatting/compute and disk I/O overlap. The caller only blocks when
+ * every buffer is waiting for the disk.
+ *
+ * If the writer thread cannot be started, buffers are written on the
+ * calling thread instead (same output, no overlap). The file name "-"
+ * writes to stdout, which is flushed but left open by close().
+ *
+ * flush()/std::endl do not force a write; data reaches the file when a
+ * buffer fills and at close(). Write errors are reported by close().
+ */
+class AsyncFileWriter : public std::streambuf {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+    static constexpr size_t DEFAULT_BUFFER_COUNT = 3;
+
+    AsyncFileWriter();
+    ~AsyncFileWriter() override;
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /**
+     * Create (or append to, with std::ios::app) a file
+     * @param mode         std::ios::binary / std::ios::app as for std::ofstream
+     * @param bufferSize   Bytes per buffer
+     * @param bufferCount  Buffers in the ring (at least 2)
+     */
+    bool open(const std::string& filename,
+              std::ios::openmode mode = std::ios::out,
+              size_t bufferSize = DEFAULT_BUFFER_SIZE,
+              size_t bufferCount = DEFAULT_BUFFER_COUNT);
+
+    /**
+     * Write out pending data, stop the writer thread and close the file
+     * @return false if any write failed
+     */
+    bool close();
+
+    bool isOpen() const { return file_ != nullptr; }
+    bool hasError() const { return failed_.load(std::memory_order_relaxed); }
+
+    /**
+     * Bytes handed to the file so far (complete after close())
+     */
+    long long getBytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+
+    /**
+     * Valid after close()
+     */
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+    int sync() override;
+
+private:
+    std::FILE* file_;
+    bool ownsFile_;
+    std::string filename_;
+    std::vector<std::vector<char>> buffers_;
+    size_t current_;
+
+    // Buffers (index, length) waiting for the writer, and buffers free to fill
+    std::deque<std::pair<size_t, size_t>> ready_;
+    std::vector<size_t> free_;
+    std::mutex mutex_;
+    std::condition_variable readyCv_;
+    std::condition_variable freeCv_;
+    std::thread thread_;
+    bool threaded_;
+    bool stop_;
+
+    std::atomic<bool> failed_;
+    std::atomic<long long> bytesWritten_;
+    std::string errorMessage_;
+
+    /**
+     * Hand the current buffer to the writer and continue in a free one
+     */
+    bool submit();
+
+    void writeBuffer(size_t index, size_t length);
+    void writerLoop();
+};
+
+/**
+ * std::ostream over an AsyncFileWriter, usable wherever a writer takes
+ * std::ostream& (section-level k-file/dynain/CSV output)
+ * Buffers are TuningProfile::active().writeBuffer bytes.
+ */
+class AsyncOutputStream : public std::ostream {
+public:
+    AsyncOutputStream();
+    explicit AsyncOutputStream(const std::string& filename,
+                               std::ios::openmode mode = std::ios::out);
+
+    bool open(const std::string& filename, std::ios::openmode mode = std::ios::out);
+    bool is_open() const { return writer_.isOpen(); }
+
+    /**
+     * @return false if the stream or any disk write failed
+     */
+    bool close();
+
+    const std::string& getErrorMessage() const { return writer_.getErrorMessage(); }
+
+private:
+    AsyncFileWriter writer_;
+};
+
+} // namespace KooRemapper
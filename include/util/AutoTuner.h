@@ -0,0 +1,87 @@
+#pragma once
+
+#include "util/TuningProfile.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Timings of one parameter sweep
+ */
+struct TuningSweep {
+    std::string benchmark;          // e.g. "map batch"
+    std::string parameter;          // Profile key, e.g. "map_chunk"
+    std::vector<size_t> values;     // Candidates, ascending
+    std::vector<double> seconds;    // Fastest run per candidate
+    size_t chosen = 0;              // Index into values
+};
+
+/**
+ * Calibrated micro-benchmarks that pick a TuningProfile for this machine
+ *
+ * The hot loops run on a synthetic bent ARC mesh:
+ *   threads, map_chunk   batch mapping (ParametricMapper)
+ *   element_chunk        element strain/stress analysis
+ *   read_buffer          k-file parsing
+ *   write_buffer         k-file formatting and output
+ * Sweeps run in this order and each keeps the earlier choices. Every
+ * candidate is timed until its runs add up to a minimum time and the
+ * fastest run counts; the smallest candidate within 3% of the best wins,
+ * so noise does not buy extra threads or memory.
+ */
+class AutoTuner {
+public:
+    AutoTuner();
+    ~AutoTuner() = default;
+
+    /**
+     * Smaller problems and shorter timing (a few seconds in total)
+     */
+    void setQuick(bool quick) { quick_ = quick; }
+
+    /**
+     * Directory for the temporary k-file of the I/O benchmarks
+     */
+    void setWorkDirectory(const std::string& dir) { workDir_ = dir; }
+
+    /**
+     * Called after each finished sweep
+     */
+    void setSweepCallback(std::function<void(const TuningSweep&)> callback) {
+        sweepCallback_ = callback;
+    }
+
+    /**
+     * Run all sweeps; profile receives the chosen values
+     * The active profile is restored afterwards.
+     */
+    bool run(TuningProfile& profile);
+
+    const std::vector<TuningSweep>& getSweeps() const { return sweeps_; }
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    bool quick_;
+    std::string workDir_;
+    std::function<void(const TuningSweep&)> sweepCallback_;
+    std::vector<TuningSweep> sweeps_;
+    std::string errorMessage_;
+
+    /**
+     * Fastest of repeated runs of body, in seconds (after one warm-up run)
+     */
+    double timeBest(const std::function<void()>& body) const;
+
+    /**
+     * Time body for each candidate after setting it on the profile and
+     * apply the winner
+     */
+    void sweep(const std::string& benchmark, const std::string& parameter,
+               const std::vector<size_t>& values, TuningProfile& profile,
+               const std::function<void(TuningProfile&, size_t)>& set,
+               const std::function<void()>& body);
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Instruction-set levels the batch kernels are built for
+ */
+enum class IsaLevel {
+    BASELINE,   // x86-64 SSE2 / aarch64 NEON / generic
+    AVX2,       // AVX2 + FMA
+    AVX512      // AVX-512 F/DQ
+};
+
+/**
+ * CPU feature detection and kernel ISA selection
+ *
+ * The kernel ISA is picked once, on first use: the best level that both
+ * the CPU (and OS) support and the binary was built with. The environment
+ * variable KOOREMAPPER_ISA=baseline|avx2|avx512 caps the choice, e.g. to
+ * compare paths on one machine.
+ */
+class CpuFeatures {
+public:
+    /**
+     * Best level supported by this CPU and OS
+     */
+    static IsaLevel detected();
+
+    /**
+     * Whether kernels for a level are compiled into this binary
+     */
+    static bool isCompiled(IsaLevel level);
+
+    /**
+     * Level used by the batch kernels
+     */
+    static IsaLevel active();
+
+    /**
+     * Force a level (must be detected and compiled); used by tests
+     * @return false if the level is not available here
+     */
+    static bool setActive(IsaLevel level);
+
+    static const char* name(IsaLevel level);
+    static bool parse(const std::string& text, IsaLevel& level);
+
+    /**
+     * One-line report, e.g. "avx2 (cpu: avx512, built: baseline avx2 avx512)"
+     */
+    static std::string describe();
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Read-only memory mapping of a whole file
+ *
+ * Lets a scan touch the file through the page cache without copying it
+ * into a buffer. Empty files open successfully with size() 0 and a null
+ * data pointer. The mapping is released by close() or the destructor.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file for reading
+     */
+    bool open(const std::string& filename);
+
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    const std::string& getErrorMessage() const { return errorMessage_; }
+
+private:
+    const char* data_;
+    size_t size_;
+#ifdef PLATFORM_WINDOWS
+    void* fileHandle_;
+    void* mappingHandle_;
+#else
+    int fd_;
+#endif
+    std::string errorMessage_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Hot-path event counters
+ *
+ * Each thread counts into its own block, so an increment is a plain
+ * load/add/store without locking or shared cache lines; blocks stay
+ * registered after their thread ends and snapshot() sums them. Hot loops
+ * should still count per batch rather than per item where they can.
+ *
+ * Built with KOOREMAPPER_METRICS=OFF (CMake), add() compiles to nothing
+ * and snapshot() returns zeros.
+ */
+namespace Metrics {
+
+enum Counter : int {
+    KFILE_LINES,                // Lines read by KFileReader
+    KFILE_COMMENT_LINES,        // '$' lines skipped
+    KFILE_BLANK_LINES,
+    KFILE_BYTES_NODE,           // Bytes read per keyword block
+    KFILE_BYTES_ELEMENT,
+    KFILE_BYTES_PART,
+    KFILE_BYTES_MATERIAL,
+    KFILE_BYTES_OTHER,          // Skipped keywords, header, *END
+    EDGE_QUERIES,               // EdgeInterpolator position/derivative queries
+    EDGE_SEARCHES,              // Binary searches for the arc length segment
+    EDGE_SEARCH_STEPS,          // Comparisons in those searches
+    EDGE_LINEAR_STEPS,          // Segments scanned by the linear tangent search
+    MAPPER_POINTS,              // Points mapped one at a time
+    MAPPER_BATCH_POINTS,        // Points mapped by the batch kernel
+    MAPPER_KERNEL_EDGE_SEARCHES,// Edge searches inside the batch kernel (4 per point)
+    MAPPER_CACHE_HITS,          // Mapper cache files loaded
+    MAPPER_CACHE_MISSES,        // Mappers built from meshes
+    ANALYSIS_ELEMENTS,          // Elements analyzed
+    ANALYSIS_NODE_LOOKUPS,      // Node map lookups (reference + deformed)
+    ANALYSIS_MATERIAL_LOOKUPS,  // Part -> material map lookups
+    WRITER_NODE_LINES,          // Mesh node records written (k-file, .inp, bulk data)
+    WRITER_ELEMENT_LINES,       // Mesh element records written
+    WRITER_STRESS_RECORDS,      // Element stress records (dynain, .inp)
+    WRITER_BUFFER_WRITES,       // Buffers handed to the OS by AsyncFileWriter
+    WRITER_BYTES,               // Bytes written by AsyncFileWriter
+    COUNTER_COUNT
+};
+
+using Values = std::array<std::uint64_t, COUNTER_COUNT>;
+
+/**
+ * JSON key of a counter, e.g. "kfile.lines"
+ */
+const char* name(Counter counter);
+
+#ifdef KOOREMAPPER_METRICS
+
+struct ThreadBlock {
+    std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> values{};
+};
+
+/**
+ * Register a block for the calling thread
+ */
+ThreadBlock* registerThread();
+
+inline thread_local ThreadBlock* threadBlock = nullptr;
+
+inline void add(Counter counter, std::uint64_t n = 1) {
+    ThreadBlock* block = threadBlock;
+    if (!block) {
+        block = threadBlock = registerThread();
+    }
+    // Only this thread writes the block; relaxed atomics keep snapshot() race-free
+    auto& value = block->values[counter];
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+constexpr bool enabled() { return true; }
+
+#else
+
+inline void add(Counter, std::uint64_t = 1) {}
+
+constexpr bool enabled() { return false; }
+
+#endif
+
+/**
+ * Sum over all threads so far
+ */
+Values snapshot();
+
+/**
+ * Number of threads that have counted something
+ */
+size_t threadCount();
+
+/**
+ * Write snapshot() as JSON, with a few derived per-query ratios
+ */
+bool writeJson(const std::string& filename, std::string& error);
+
+} // namespace Metrics
+} // namespace KooRemapper
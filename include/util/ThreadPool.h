@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KooRemapper {
+
+/**
+ * Persistent worker pool for data-parallel loops
+ *
+ * Workers are created once and reused, so loops that run many times
+ * (e.g. one operator application per solver iteration) do not pay
+ * thread start-up cost. The calling thread takes part in the work.
+ * Calls made from inside a parallel body run serially.
+ */
+class ThreadPool {
+public:
+    using RangeBody = std::function<void(size_t begin, size_t end)>;
+    using SumBody = std::function<double(size_t begin, size_t end)>;
+
+    /**
+     * Process-wide pool
+     */
+    static ThreadPool& instance();
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Set number of threads including the caller (0 = hardware concurrency)
+     */
+    void setThreadCount(int count);
+
+    /**
+     * Number of threads including the caller
+     */
+    int threadCount() const;
+
+    /**
+     * Run body over [0, count) split into contiguous chunks
+     *
+     * @param count     Number of items
+     * @param body      Called with [begin, end) sub-ranges
+     * @param minChunk  Smallest chunk handed to a thread
+     */
+    void parallelFor(size_t count, const RangeBody& body, size_t minChunk = 256);
+
+    /**
+     * Parallel sum over [0, count)
+     * Chunk boundaries depend only on count and chunkSize, so the result
+     * is bitwise reproducible regardless of the thread count.
+     */
+    double parallelSum(size_t count, const SumBody& body, size_t chunkSize = 4096);
+
+private:
+    ThreadPool();
+
+    void startWorkers(size_t count);
+    void stopWorkers();
+    void workerLoop(size_t seen);
+    void runChunks();
+
+    std::vector<std::thread> workers_;  // Changed and read under callMutex_
+    std::atomic<int> threadCount_;      // workers_.size() + 1, for lock-free reads
+    std::mutex callMutex_;          // Serializes jobs and resizes
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    bool stop_;
+    size_t generation_;
+    size_t pending_;                // Workers still busy with current job
+
+    // Current job
+    const RangeBody* body_;
+    size_t count_;
+    size_t chunk_;
+    size_t numChunks_;
+    std::atomic<size_t> nextChunk_;
+    std::exception_ptr error_;
+};
+
+} // namespace KooRemapper
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace KooRemapper {
+
+/**
+ * Block sizes and thread count that depend on the machine
+ *
+ * The defaults are the built-in values. `KooRemapper tune` measures
+ * better ones and saves them as a per-host profile, which every later
+ * run loads at start-up (see defaultPath()). The profile is a text file
+ * of "key = value" lines; unknown keys are ignored.
+ */
+struct TuningProfile {
+    int threads = 0;                  // Threads incl. caller (0 = all cores)
+    size_t mapChunk = 256;            // Points per chunk in batch mapping
+    size_t elementChunk = 64;         // Elements per chunk in element analysis
+    size_t readBuffer = 0;            // k-file read buffer, bytes (0 = library default)
+    size_t writeBuffer = 1 << 20;     // Output buffer (AsyncFileWriter), bytes
+
+    /**
+     * Parameters used by this process
+     */
+    static const TuningProfile& active();
+
+    /**
+     * Replace the active parameters and set the thread pool size
+     * Not thread-safe: call between parallel sections.
+     */
+    static void apply(const TuningProfile& profile);
+
+    /**
+     * $KOOREMAPPER_TUNE if set, else ~/.kooremapper/tune-<host>.cfg
+     */
+    static std::string defaultPath();
+
+    /**
+     * Apply the profile at defaultPath() if there is one
+     * KOOREMAPPER_TUNE=none skips it.
+     * @param path   Set to the profile used (empty if none)
+     * @return false only if a profile exists but cannot be read
+     */
+    static bool loadDefault(std::string& path, std::string& error);
+
+    bool load(const std::string& filename, std::string& error);
+    bool save(const std::string& filename, std::string& error) const;
+};
+
+} // namespace KooRemapper
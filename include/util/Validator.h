@@ -26,6 +26,35 @@ struct ValidationResult {
     }
 };
 
+/**
+ * One keyword block found by Validator::preflightKFile()
+ */
+struct KFileBlock {
+    std::string keyword;    // Upper-case keyword without '*' or format suffix
+    size_t line;            // 1-based line of the keyword
+    long long offset;       // Byte offset of the keyword line
+    long long bytes;        // Keyword line through the end of its data
+    size_t records;         // Data lines (not blank, not comments)
+    bool longFormat;        // '+' suffix, or *KEYWORD LONG=Y
+    bool freeFormat;        // First record is comma separated
+
+    KFileBlock() : line(0), offset(0), bytes(0), records(0),
+                   longFormat(false), freeFormat(false) {}
+};
+
+/**
+ * Result of a k-file pre-flight scan
+ */
+struct KFilePreflight {
+    ValidationResult validation;
+    std::vector<KFileBlock> blocks;
+    long long fileSize;
+    size_t lines;
+    bool hasEnd;
+
+    KFilePreflight() : fileSize(0), lines(0), hasEnd(false) {}
+};
+
 /**
  * Mesh validator
  */
@@ -62,15 +91,35 @@ public:
     static bool isWritable(const std::string& path);
 
     /**
-     * Validate k-file format
+     * Validate k-file format (preflightKFile() finds no errors)
      */
     static bool isValidKFile(const std::string& path);
 
+    /**
+     * Scan a k-file for structural errors without parsing it
+     *
+     * The file is memory-mapped and walked line by line with memchr (a
+     * vectorized newline search); only keyword lines, line lengths and
+     * the rare record too short for the fixed-column layout are looked
+     * at. Reports every keyword block and flags what the parser would
+     * otherwise silently drop or fail on late: data before the first
+     * keyword, node/element records too short to parse, and a missing
+     * *END (a truncated file).
+     */
+    static KFilePreflight preflightKFile(const std::string& path);
+
     /**
      * Calculate Jacobian for a hexahedral or tetrahedral element
      */
     static double calculateJacobian(const Mesh& mesh, const Element& elem);
 
+    /**
+     * calculateJacobian() for every element, in mesh.getElements() order
+     * Runs once per element-type bucket; HEX8 elements go through the
+     * vectorized batch kernel.
+     */
+    static std::vector<double> calculateJacobians(const Mesh& mesh);
+
     /**
      * Calculate aspect ratio for a hexahedral element
      */
@@ -1,4 +1,6 @@
 #include "analysis/DeformationGradient.h"
+#include "kernels/BatchKernels.h"
+#include <algorithm>
 #include <cmath>
 
 namespace KooRemapper {
@@ -114,6 +116,51 @@ Matrix3x3 DeformationGradient::computeHex8(
     return J_def * J_ref_inv;
 }
 
+void DeformationGradient::computeHex8Batch(
+    const std::vector<std::array<Vector3D, 8>>& refNodes,
+    const std::vector<std::array<Vector3D, 8>>& defNodes,
+    double xi, double eta, double zeta,
+    std::vector<Matrix3x3>& F,
+    std::vector<bool>& valid)
+{
+    const size_t count = std::min(refNodes.size(), defNodes.size());
+    F.assign(count, Matrix3x3());
+    valid.assign(count, false);
+    if (count == 0) return;
+
+    // Flatten to the kernel layout (24 doubles per element, 9 per F)
+    auto dN = shapeFunctionDerivativesHex8(xi, eta, zeta);
+    std::array<double, 24> dNFlat;
+    for (int k = 0; k < 8; ++k) {
+        dNFlat[3 * k] = dN[k].x;
+        dNFlat[3 * k + 1] = dN[k].y;
+        dNFlat[3 * k + 2] = dN[k].z;
+    }
+
+    std::vector<double> ref(24 * count), def(24 * count), result(9 * count);
+    std::vector<unsigned char> ok(count);
+    for (size_t e = 0; e < count; ++e) {
+        for (int k = 0; k < 8; ++k) {
+            for (int c = 0; c < 3; ++c) {
+                ref[24 * e + 3 * k + c] = refNodes[e][k][c];
+                def[24 * e + 3 * k + c] = defNodes[e][k][c];
+            }
+        }
+    }
+
+    Kernels::active().hex8DeformationGradients(ref.data(), def.data(), count,
+                                                dNFlat.data(), result.data(), ok.data());
+
+    for (size_t e = 0; e < count; ++e) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                F[e].m[i][j] = result[9 * e + 3 * i + j];
+            }
+        }
+        valid[e] = ok[e] != 0;
+    }
+}
+
 Matrix3x3 DeformationGradient::computeTet4(
     const std::array<Vector3D, 4>& refNodes,
     const std::array<Vector3D, 4>& defNodes)
@@ -1,7 +1,13 @@
 #include "analysis/ElementAnalyzer.h"
 #include "analysis/DeformationGradient.h"
+#include "util/Metrics.h"
+#include "util/ThreadPool.h"
+#include "util/TuningProfile.h"
 #include <limits>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <type_traits>
 
 namespace KooRemapper {
 
@@ -21,11 +27,12 @@ void ElementAnalyzer::clearMaterial()
     material_.reset();
 }
 
-const MaterialModel* ElementAnalyzer::getMaterialForElement(const Element& elem, const Mesh& refMesh) const
+const MaterialModel* ElementAnalyzer::getMaterialForPart(int partId, const Mesh& refMesh) const
 {
     // First, try to get material from mesh (part -> material mapping)
     if (usePartMaterials_) {
-        const MaterialData* matData = refMesh.getElementMaterial(elem);
+        Metrics::add(Metrics::ANALYSIS_MATERIAL_LOOKUPS);
+        const MaterialData* matData = refMesh.getPartMaterial(partId);
         if (matData && matData->isValid()) {
             // Create a static MaterialModel from MaterialData
             // Note: This is a workaround - in production, we'd cache these
@@ -82,70 +89,76 @@ bool ElementAnalyzer::validateMeshPair(const Mesh& mesh1, const Mesh& mesh2, std
     return true;
 }
 
-ElementResult ElementAnalyzer::analyzeElement(
-    const Element& elem,
+template <ElementType Type>
+ElementResult ElementAnalyzer::analyzeTyped(
+    int elementId,
+    int partId,
+    const std::array<int, ElementTraits<Type>::NODES>& nodeIds,
     const Mesh& refMesh,
     const Mesh& defMesh)
 {
     ElementResult result;
-    result.elementId = elem.id;
+    result.elementId = elementId;
     result.isValid = false;
-    
-    // Get material for this element (from part or default)
-    const MaterialModel* elemMaterial = getMaterialForElement(elem, refMesh);
-    
-    if (elem.type == ElementType::HEX8) {
+    Metrics::add(Metrics::ANALYSIS_ELEMENTS);
+
+    if constexpr (Type != ElementType::HEX8 && Type != ElementType::TET4) {
+        result.errorMessage = "Unsupported element type";
+        return result;
+    } else {
+        // Get material for this element (from part or default)
+        const MaterialModel* elemMaterial = getMaterialForPart(partId, refMesh);
+
         // Get node positions
-        std::array<Vector3D, 8> refNodes, defNodes;
-        
-        for (int i = 0; i < 8; ++i) {
-            const Node* refNode = refMesh.getNode(elem.nodeIds[i]);
-            const Node* defNode = defMesh.getNode(elem.nodeIds[i]);
-            
+        constexpr int N = ElementTraits<Type>::NODES;
+        std::array<Vector3D, N> refNodes, defNodes;
+        Metrics::add(Metrics::ANALYSIS_NODE_LOOKUPS, 2 * N);
+
+        for (int i = 0; i < N; ++i) {
+            const Node* refNode = refMesh.getNode(nodeIds[i]);
+            const Node* defNode = defMesh.getNode(nodeIds[i]);
+
             if (!refNode || !defNode) {
-                result.errorMessage = "Missing node " + std::to_string(elem.nodeIds[i]);
+                result.errorMessage = "Missing node " + std::to_string(nodeIds[i]);
                 return result;
             }
-            
+
             refNodes[i] = refNode->getEffectivePosition();
             defNodes[i] = defNode->getEffectivePosition();
         }
-        
-        return analyzeHex8(elem, refNodes, defNodes, elemMaterial);
-    }
-    else if (elem.type == ElementType::TET4) {
-        // Get node positions
-        std::array<Vector3D, 4> refNodes, defNodes;
-        
-        for (int i = 0; i < 4; ++i) {
-            const Node* refNode = refMesh.getNode(elem.nodeIds[i]);
-            const Node* defNode = defMesh.getNode(elem.nodeIds[i]);
-            
-            if (!refNode || !defNode) {
-                result.errorMessage = "Missing node " + std::to_string(elem.nodeIds[i]);
-                return result;
-            }
-            
-            refNodes[i] = refNode->getEffectivePosition();
-            defNodes[i] = defNode->getEffectivePosition();
+
+        if constexpr (Type == ElementType::HEX8) {
+            return analyzeHex8(elementId, refNodes, defNodes, elemMaterial);
+        } else {
+            return analyzeTet4(elementId, refNodes, defNodes, elemMaterial);
         }
-        
-        return analyzeTet4(elem, refNodes, defNodes, elemMaterial);
     }
-    else {
-        result.errorMessage = "Unsupported element type";
-        return result;
+}
+
+ElementResult ElementAnalyzer::analyzeElement(
+    const Element& elem,
+    const Mesh& refMesh,
+    const Mesh& defMesh)
+{
+    if (elem.type == ElementType::HEX8) {
+        return analyzeTyped<ElementType::HEX8>(elem.id, elem.partId, elem.nodeIds, refMesh, defMesh);
     }
+    if (elem.type == ElementType::TET4) {
+        const auto& n = elem.nodeIds;
+        return analyzeTyped<ElementType::TET4>(elem.id, elem.partId, {n[0], n[1], n[2], n[3]},
+                                               refMesh, defMesh);
+    }
+    return analyzeTyped<ElementType::UNKNOWN>(elem.id, elem.partId, elem.nodeIds, refMesh, defMesh);
 }
 
 ElementResult ElementAnalyzer::analyzeHex8(
-    const Element& elem,
+    int elementId,
     const std::array<Vector3D, 8>& refNodes,
     const std::array<Vector3D, 8>& defNodes,
     const MaterialModel* elemMaterial)
 {
     ElementResult result;
-    result.elementId = elem.id;
+    result.elementId = elementId;
     
     // Compute element center
     result.center = Vector3D(0, 0, 0);
@@ -184,24 +197,7 @@ ElementResult ElementAnalyzer::analyzeHex8(
             avgStrain *= (1.0 / totalWeight);
         }
         
-        result.strain = avgStrain;
-        result.vonMisesStrain = avgStrain.vonMisesStrain();
-        
-        auto principalStrains = avgStrain.principalStrains();
-        result.maxPrincipalStrain = principalStrains[0];
-        result.minPrincipalStrain = principalStrains[2];
-        
-        // Compute stress if material is available
-        if (elemMaterial) {
-            result.stress = elemMaterial->computeStress(avgStrain);
-            result.vonMisesStress = result.stress.vonMises();
-            
-            auto principalStresses = result.stress.principalStresses();
-            result.maxPrincipalStress = principalStresses[0];
-            result.minPrincipalStress = principalStresses[2];
-        }
-        
-        result.isValid = true;
+        completeResult(result, avgStrain, elemMaterial);
     }
     catch (const std::exception& e) {
         result.isValid = false;
@@ -212,13 +208,13 @@ ElementResult ElementAnalyzer::analyzeHex8(
 }
 
 ElementResult ElementAnalyzer::analyzeTet4(
-    const Element& elem,
+    int elementId,
     const std::array<Vector3D, 4>& refNodes,
     const std::array<Vector3D, 4>& defNodes,
     const MaterialModel* elemMaterial)
 {
     ElementResult result;
-    result.elementId = elem.id;
+    result.elementId = elementId;
     
     // Compute element center
     result.center = Vector3D(0, 0, 0);
@@ -231,24 +227,7 @@ ElementResult ElementAnalyzer::analyzeTet4(
         // TET4 has constant strain
         Matrix3x3 F = DeformationGradient::computeTet4(refNodes, defNodes);
         
-        result.strain = StrainTensor::fromDeformationGradient(F, strainType_);
-        result.vonMisesStrain = result.strain.vonMisesStrain();
-        
-        auto principalStrains = result.strain.principalStrains();
-        result.maxPrincipalStrain = principalStrains[0];
-        result.minPrincipalStrain = principalStrains[2];
-        
-        // Compute stress if material is available
-        if (elemMaterial) {
-            result.stress = elemMaterial->computeStress(result.strain);
-            result.vonMisesStress = result.stress.vonMises();
-            
-            auto principalStresses = result.stress.principalStresses();
-            result.maxPrincipalStress = principalStresses[0];
-            result.minPrincipalStress = principalStresses[2];
-        }
-        
-        result.isValid = true;
+        completeResult(result, StrainTensor::fromDeformationGradient(F, strainType_), elemMaterial);
     }
     catch (const std::exception& e) {
         result.isValid = false;
@@ -258,6 +237,49 @@ ElementResult ElementAnalyzer::analyzeTet4(
     return result;
 }
 
+void ElementAnalyzer::completeResult(ElementResult& result, const StrainTensor& strain,
+                                     const MaterialModel* elemMaterial) const
+{
+    result.strain = strain;
+    result.vonMisesStrain = strain.vonMisesStrain();
+    
+    auto principalStrains = strain.principalStrains();
+    result.maxPrincipalStrain = principalStrains[0];
+    result.minPrincipalStrain = principalStrains[2];
+    
+    // Compute stress if material is available
+    if (elemMaterial) {
+        applyStress(result, *elemMaterial);
+    }
+    
+    result.isValid = true;
+}
+
+void ElementAnalyzer::applyStress(ElementResult& result, const MaterialModel& material)
+{
+    result.stress = material.computeStress(result.strain);
+    result.vonMisesStress = result.stress.vonMises();
+    
+    auto principalStresses = result.stress.principalStresses();
+    result.maxPrincipalStress = principalStresses[0];
+    result.minPrincipalStress = principalStresses[2];
+}
+
+void ElementAnalyzer::applyMaterial(MeshAnalysisResult& result, const MaterialModel& material)
+{
+    result.hasMaterial = true;
+    auto& elements = result.elementResults;
+    ThreadPool::instance().parallelFor(elements.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (elements[i].isValid) {
+                applyStress(elements[i], material);
+            }
+        }
+    }, TuningProfile::active().elementChunk);
+
+    computeStatistics(result);
+}
+
 MeshAnalysisResult ElementAnalyzer::analyzeMesh(
     const Mesh& refMesh,
     const Mesh& defMesh,
@@ -273,26 +295,39 @@ MeshAnalysisResult ElementAnalyzer::analyzeMesh(
     }
     result.hasMaterial = hasAnyMaterial;
     
-    const auto& elements = refMesh.getElements();
-    size_t total = elements.size();
-    size_t processed = 0;
+    // One homogeneous loop per element type; results land in ID order
+    ElementBuckets buckets(refMesh);
+    size_t total = buckets.size();
+    std::atomic<size_t> processed(0);
+    const std::thread::id caller = std::this_thread::get_id();
     
-    result.elementResults.reserve(total);
+    result.elementResults.resize(total);
     
-    for (const auto& [id, elem] : elements) {
-        ElementResult elemResult = analyzeElement(elem, refMesh, defMesh);
-        result.elementResults.push_back(elemResult);
-        
-        if (elemResult.isValid) {
+    // analyzeTyped only reads shared state (materials are thread_local);
+    // progress is reported from the calling thread only
+    buckets.forEachBucket([&](const auto& bucket) {
+        constexpr ElementType type = std::decay_t<decltype(bucket)>::TYPE;
+        ThreadPool::instance().parallelFor(bucket.size(), [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; ++s) {
+                result.elementResults[bucket.positions[s]] = analyzeTyped<type>(
+                    bucket.ids[s], bucket.partIds[s], bucket.nodeIds[s], refMesh, defMesh);
+            }
+            size_t done = processed.fetch_add(end - begin) + (end - begin);
+            if (progress && std::this_thread::get_id() == caller) {
+                progress(static_cast<int>(100 * done / total));
+            }
+        }, TuningProfile::active().elementChunk);
+    });
+    if (progress && total > 0) {
+        progress(100);
+    }
+    
+    for (const auto& er : result.elementResults) {
+        if (er.isValid) {
             result.validElements++;
         } else {
             result.invalidElements++;
         }
-        
-        processed++;
-        if (progress && total > 0) {
-            progress(static_cast<int>(100 * processed / total));
-        }
     }
     
     computeStatistics(result);
@@ -300,6 +335,166 @@ MeshAnalysisResult ElementAnalyzer::analyzeMesh(
     return result;
 }
 
+MeshAnalysisResult ElementAnalyzer::analyzeMapping(
+    const Mesh& flatMesh,
+    const PointMapper& mapper,
+    std::function<void(int)> progress)
+{
+    MeshAnalysisResult result;
+    result.hasMaterial = material_.has_value() ||
+                         (usePartMaterials_ && flatMesh.getMaterialCount() > 0);
+
+    const auto hexPoints = DeformationGradient::gaussPointsHex8(numGaussPoints_);
+    std::vector<std::array<double, 8>> hexShapes;
+    for (const auto& gp : hexPoints) {
+        hexShapes.push_back(DeformationGradient::shapeFunctionsHex8(gp[0], gp[1], gp[2]));
+    }
+
+    ElementBuckets buckets(flatMesh);
+    const size_t total = buckets.size();
+    std::atomic<size_t> processed(0);
+    const std::thread::id caller = std::this_thread::get_id();
+    const size_t chunk = TuningProfile::active().elementChunk;
+
+    result.elementResults.resize(total);
+
+    // Per element type: flat Gauss points -> one mapper batch -> F, strain, stress
+    buckets.forEachBucket([&](const auto& bucket) {
+        using Bucket = std::decay_t<decltype(bucket)>;
+        constexpr ElementType type = Bucket::TYPE;
+        constexpr int N = Bucket::NODES;
+        const size_t count = bucket.size();
+
+        if constexpr (type != ElementType::HEX8 && type != ElementType::TET4) {
+            for (size_t s = 0; s < count; ++s) {
+                ElementResult& er = result.elementResults[bucket.positions[s]];
+                er.elementId = bucket.ids[s];
+                er.isValid = false;
+                er.errorMessage = "Unsupported element type";
+            }
+            processed += count;
+        } else {
+            const size_t G = (type == ElementType::HEX8) ? hexShapes.size() : 1;
+            std::vector<Vector3D> points(count * G);
+            std::vector<int> missingNode(count, 0);
+
+            ThreadPool::instance().parallelFor(count, [&](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; ++s) {
+                    std::array<Vector3D, N> X;
+                    for (int k = 0; k < N && missingNode[s] == 0; ++k) {
+                        const Node* node = flatMesh.getNode(bucket.nodeIds[s][k]);
+                        if (node) {
+                            X[k] = node->getEffectivePosition();
+                        } else {
+                            missingNode[s] = bucket.nodeIds[s][k];
+                        }
+                    }
+                    if (missingNode[s] != 0) continue;
+
+                    if constexpr (type == ElementType::HEX8) {
+                        for (size_t g = 0; g < G; ++g) {
+                            Vector3D p;
+                            for (int k = 0; k < 8; ++k) {
+                                p += X[k] * hexShapes[g][k];
+                            }
+                            points[s * G + g] = p;
+                        }
+                    } else {
+                        points[s] = (X[0] + X[1] + X[2] + X[3]) / 4.0;
+                    }
+                }
+                Metrics::add(Metrics::ANALYSIS_NODE_LOOKUPS, N * (end - begin));
+            }, chunk);
+
+            std::vector<MappingDerivatives> mapped;
+            mapper.evaluatePoints(points, mapped);
+
+            ThreadPool::instance().parallelFor(count, [&](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; ++s) {
+                    ElementResult& er = result.elementResults[bucket.positions[s]];
+                    er.elementId = bucket.ids[s];
+                    if (missingNode[s] != 0) {
+                        er.isValid = false;
+                        er.errorMessage = "Missing node " + std::to_string(missingNode[s]);
+                        continue;
+                    }
+
+                    // Strain averaged over the Gauss points, as in analyzeHex8
+                    StrainTensor avgStrain;
+                    double totalWeight = 0;
+                    Vector3D center;
+                    for (size_t g = 0; g < G; ++g) {
+                        const MappingDerivatives& d = mapped[s * G + g];
+                        Matrix3x3 F = Matrix3x3::fromColumns(d.dXdu, d.dXdv, d.dXdw);
+                        double weight = (type == ElementType::HEX8) ? hexPoints[g][3] : 1.0;
+                        avgStrain += StrainTensor::fromDeformationGradient(F, strainType_) * weight;
+                        totalWeight += weight;
+                        center += d.position;
+                    }
+                    if (totalWeight > 0) {
+                        avgStrain *= (1.0 / totalWeight);
+                    }
+                    er.center = center / static_cast<double>(G);
+                    completeResult(er, avgStrain, getMaterialForPart(bucket.partIds[s], flatMesh));
+                }
+                Metrics::add(Metrics::ANALYSIS_ELEMENTS, end - begin);
+                size_t done = processed.fetch_add(end - begin) + (end - begin);
+                if (progress && std::this_thread::get_id() == caller) {
+                    progress(static_cast<int>(100 * done / total));
+                }
+            }, chunk);
+        }
+    });
+    if (progress && total > 0) {
+        progress(100);
+    }
+
+    for (const auto& er : result.elementResults) {
+        if (er.isValid) {
+            result.validElements++;
+        } else {
+            result.invalidElements++;
+        }
+    }
+
+    computeStatistics(result);
+
+    return result;
+}
+
+void ElementAnalyzer::reanalyzeElements(
+    const Mesh& refMesh,
+    const Mesh& defMesh,
+    const std::vector<size_t>& indices,
+    MeshAnalysisResult& result)
+{
+    std::vector<const Element*> elements;
+    elements.reserve(refMesh.getElementCount());
+    for (const auto& [id, elem] : refMesh.getElements()) {
+        elements.push_back(&elem);
+    }
+
+    // analyzeElement only reads shared state (materials are thread_local)
+    ThreadPool::instance().parallelFor(indices.size(), [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            size_t index = indices[n];
+            result.elementResults[index] = analyzeElement(*elements[index], refMesh, defMesh);
+        }
+    }, TuningProfile::active().elementChunk);
+
+    result.validElements = 0;
+    result.invalidElements = 0;
+    for (const auto& er : result.elementResults) {
+        if (er.isValid) {
+            result.validElements++;
+        } else {
+            result.invalidElements++;
+        }
+    }
+
+    computeStatistics(result);
+}
+
 void ElementAnalyzer::computeStatistics(MeshAnalysisResult& result)
 {
     if (result.elementResults.empty()) return;
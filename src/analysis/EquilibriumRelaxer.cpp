@@ -0,0 +1,265 @@
+#include "analysis/EquilibriumRelaxer.h"
+#include "analysis/SolidAssembly.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace KooRemapper {
+
+namespace {
+
+using Field = std::vector<Vector3D>;
+
+double dot(const Field& a, const Field& b)
+{
+    return ThreadPool::instance().parallelSum(a.size(), [&](size_t begin, size_t end) {
+        double s = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            s += a[i].dot(b[i]);
+        }
+        return s;
+    });
+}
+
+/**
+ * Remove the components of v along the (orthonormal) rigid-body modes
+ */
+void project(Field& v, const std::vector<Field>& modes)
+{
+    for (const auto& q : modes) {
+        double c = dot(q, v);
+        ThreadPool::instance().parallelFor(v.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                v[i] -= q[i] * c;
+            }
+        });
+    }
+}
+
+/**
+ * Orthonormal basis of the six rigid-body modes restricted to active nodes
+ */
+std::vector<Field> rigidBodyModes(const SolidAssembly& assembly, const std::vector<char>& activeNode)
+{
+    size_t n = assembly.nodeCount();
+
+    Vector3D center(0, 0, 0);
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!activeNode[i]) continue;
+        center += assembly.nodePosition(i);
+        ++count;
+    }
+    if (count == 0) return {};
+    center = center / static_cast<double>(count);
+
+    std::vector<Field> modes;
+    for (int m = 0; m < 6; ++m) {
+        Field q(n, Vector3D(0, 0, 0));
+        Vector3D axis(0, 0, 0);
+        axis[m % 3] = 1.0;
+        for (size_t i = 0; i < n; ++i) {
+            if (!activeNode[i]) continue;
+            q[i] = (m < 3) ? axis : axis.cross(assembly.nodePosition(i) - center);
+        }
+
+        // Modified Gram-Schmidt
+        for (const auto& prev : modes) {
+            double c = dot(prev, q);
+            for (size_t i = 0; i < n; ++i) q[i] -= prev[i] * c;
+        }
+        double norm = std::sqrt(dot(q, q));
+        if (norm < 1e-12) continue;  // Degenerate (e.g. all nodes on a line)
+        for (size_t i = 0; i < n; ++i) q[i] = q[i] / norm;
+        modes.push_back(std::move(q));
+    }
+    return modes;
+}
+
+} // anonymous namespace
+
+EquilibriumRelaxer::EquilibriumRelaxer()
+    : usePartMaterials_(true)
+    , tolerance_(1e-6)
+    , maxIterations_(5000)
+{}
+
+bool EquilibriumRelaxer::relax(const Mesh& refMesh, const Mesh& defMesh,
+                               MeshAnalysisResult& result,
+                               std::function<void(int)> progress)
+{
+    stats_ = RelaxationStats();
+    errorMessage_.clear();
+
+    if (!result.hasMaterial) {
+        errorMessage_ = "Relaxation requires a material (no stress was computed)";
+        return false;
+    }
+
+    SolidAssembly assembly;
+    if (!assembly.build(defMesh)) {
+        errorMessage_ = assembly.getErrorMessage();
+        return false;
+    }
+    stats_.skippedElements = assembly.skippedElementCount();
+    stats_.colors = assembly.colorCount();
+
+    // Element results by ID (analysis order need not match assembly order)
+    std::unordered_map<int, size_t> resultIndex;
+    resultIndex.reserve(result.elementResults.size());
+    for (size_t r = 0; r < result.elementResults.size(); ++r) {
+        resultIndex[result.elementResults[r].elementId] = r;
+    }
+
+    size_t numElements = assembly.elementCount();
+    std::vector<StressTensor> initialStress(numElements);
+    std::vector<long> elementResult(numElements, -1);
+    size_t withMaterial = 0;
+
+    for (size_t e = 0; e < numElements; ++e) {
+        int id = assembly.elementId(e);
+        auto it = resultIndex.find(id);
+        if (it != resultIndex.end() && result.elementResults[it->second].isValid) {
+            elementResult[e] = static_cast<long>(it->second);
+            initialStress[e] = result.elementResults[it->second].stress;
+        }
+
+        if (!assembly.isElementActive(e)) continue;
+
+        const Element* elem = refMesh.getElement(id);
+        const MaterialData* matData = (usePartMaterials_ && elem) ? refMesh.getElementMaterial(*elem) : nullptr;
+        if (matData && matData->isValid()) {
+            assembly.setElementMaterial(e, MaterialModel::isotropicElastic(matData->E, matData->nu));
+            ++withMaterial;
+        } else if (material_.has_value()) {
+            assembly.setElementMaterial(e, material_.value());
+            ++withMaterial;
+        }
+    }
+
+    if (withMaterial == 0) {
+        errorMessage_ = "No element has a valid material";
+        return false;
+    }
+
+    auto& pool = ThreadPool::instance();
+    size_t n = assembly.nodeCount();
+
+    // Right-hand side: b = -f(σ0)
+    Field b;
+    assembly.internalForces(initialStress, b);
+    pool.parallelFor(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) b[i] = -b[i];
+    });
+
+    // Jacobi preconditioner; nodes without stiffness stay fixed at zero
+    Field diag;
+    assembly.stiffnessDiagonal(diag);
+    Field invDiag(n);
+    std::vector<char> activeNode(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (int d = 0; d < 3; ++d) {
+            invDiag[i][d] = diag[i][d] > 0 ? 1.0 / diag[i][d] : 0.0;
+        }
+        activeNode[i] = diag[i].x > 0 ? 1 : 0;
+        if (!activeNode[i]) b[i] = Vector3D(0, 0, 0);
+    }
+
+    auto modes = rigidBodyModes(assembly, activeNode);
+    project(b, modes);
+
+    double bNorm = std::sqrt(dot(b, b));
+    stats_.initialResidual = bNorm;
+    stats_.finalResidual = bNorm;
+
+    Field u(n, Vector3D(0, 0, 0));
+
+    if (bNorm > 0) {
+        Field r = b;
+        Field z(n), p(n), Ap;
+
+        auto precondition = [&]() {
+            pool.parallelFor(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    z[i] = Vector3D(r[i].x * invDiag[i].x, r[i].y * invDiag[i].y, r[i].z * invDiag[i].z);
+                }
+            });
+        };
+
+        precondition();
+        p = z;
+        double rz = dot(r, z);
+        double target = tolerance_ * bNorm;
+        double rNorm = bNorm;
+
+        for (int it = 1; it <= maxIterations_; ++it) {
+            assembly.applyStiffness(p, Ap);
+            double pAp = dot(p, Ap);
+            if (!(pAp > 0)) break;  // Breakdown (no stiffness along p)
+
+            double alpha = rz / pAp;
+            pool.parallelFor(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    u[i] += p[i] * alpha;
+                    r[i] -= Ap[i] * alpha;
+                }
+            });
+
+            rNorm = std::sqrt(dot(r, r));
+            stats_.iterations = it;
+
+            if (progress && it % 10 == 0) {
+                // Progress on a log scale between ||b|| and the target
+                double done = std::log(bNorm / rNorm) / std::log(1.0 / tolerance_);
+                progress(std::clamp(static_cast<int>(100 * done), 0, 99));
+            }
+
+            if (rNorm <= target) {
+                stats_.converged = true;
+                break;
+            }
+
+            precondition();
+            double rzNew = dot(r, z);
+            double beta = rzNew / rz;
+            rz = rzNew;
+            pool.parallelFor(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    p[i] = z[i] + p[i] * beta;
+                }
+            });
+        }
+
+        stats_.finalResidual = rNorm;
+        project(u, modes);
+    } else {
+        stats_.converged = true;
+    }
+
+    for (const auto& v : u) {
+        stats_.maxDisplacement = std::max(stats_.maxDisplacement, v.magnitude());
+    }
+
+    // σ = σ0 + C·ε(u)
+    pool.parallelFor(numElements, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; ++e) {
+            if (elementResult[e] < 0 || !assembly.hasElementMaterial(e)) continue;
+
+            ElementResult& er = result.elementResults[elementResult[e]];
+            er.stress = initialStress[e] + assembly.elementStress(e, u);
+            er.vonMisesStress = er.stress.vonMises();
+
+            auto principal = er.stress.principalStresses();
+            er.maxPrincipalStress = principal[0];
+            er.minPrincipalStress = principal[2];
+        }
+    });
+
+    ElementAnalyzer::computeStatistics(result);
+
+    if (progress) progress(100);
+    return true;
+}
+
+} // namespace KooRemapper
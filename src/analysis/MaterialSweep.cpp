@@ -0,0 +1,114 @@
+#include "analysis/MaterialSweep.h"
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace KooRemapper {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+bool validName(const std::string& name) {
+    if (name.empty()) return false;
+    for (char c : name) {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                  c == '_' || c == '-' || c == '.';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool MaterialSweep::load(const std::string& filename) {
+    sets_.clear();
+    errorMessage_.clear();
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open material sweep: " + filename;
+        return false;
+    }
+
+    std::set<std::string> names;
+    std::string line;
+    int lineNumber = 0;
+    bool first = true;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) {
+            fields.push_back(trim(field));
+        }
+
+        const std::string where = filename + ":" + std::to_string(lineNumber) + ": ";
+        if (fields.size() != 2 && fields.size() != 3) {
+            errorMessage_ = where + "expected E,nu or name,E,nu";
+            return false;
+        }
+
+        MaterialSet set;
+        size_t firstValue = fields.size() - 2;
+        bool numeric = parseDouble(fields[firstValue], set.E) &&
+                       parseDouble(fields[firstValue + 1], set.nu);
+        if (!numeric) {
+            if (first) {
+                first = false;  // Header
+                continue;
+            }
+            errorMessage_ = where + "invalid number";
+            return false;
+        }
+        first = false;
+
+        set.name = fields.size() == 3 ? fields[0] : "set" + std::to_string(sets_.size() + 1);
+        if (!validName(set.name)) {
+            errorMessage_ = where + "invalid set name: " + set.name;
+            return false;
+        }
+        if (!names.insert(set.name).second) {
+            errorMessage_ = where + "duplicate set name: " + set.name;
+            return false;
+        }
+        if (!set.material().isValid()) {
+            errorMessage_ = where + "invalid material (need E > 0, 0 < nu < 0.5)";
+            return false;
+        }
+        sets_.push_back(set);
+    }
+
+    if (sets_.empty()) {
+        errorMessage_ = "No material sets in " + filename;
+        return false;
+    }
+    return true;
+}
+
+std::string MaterialSweep::outputPath(const std::string& output, const MaterialSet& set) {
+    size_t slash = output.find_last_of("/\\");
+    size_t dot = output.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return output + "_" + set.name;
+    }
+    return output.substr(0, dot) + "_" + set.name + output.substr(dot);
+}
+
+} // namespace KooRemapper
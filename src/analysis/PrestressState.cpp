@@ -0,0 +1,306 @@
+#include "analysis/PrestressState.h"
+#include "util/AsyncFileWriter.h"
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+namespace KooRemapper {
+
+namespace {
+
+const char* STATE_TAG = "KooRemapper prestress state";
+const std::uint32_t STATE_VERSION = 1;
+
+// Doubles stored per element result
+const size_t RESULT_VALUES = 21;
+
+// 64-bit FNV-1a
+class Hasher {
+public:
+    void add(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ULL;
+        }
+    }
+    template <typename T>
+    void add(const T& value) { add(&value, sizeof(T)); }
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+void packResult(const ElementResult& r, double* v) {
+    const double values[RESULT_VALUES] = {
+        r.center.x, r.center.y, r.center.z,
+        r.strain.xx, r.strain.yy, r.strain.zz, r.strain.xy, r.strain.yz, r.strain.xz,
+        r.stress.xx, r.stress.yy, r.stress.zz, r.stress.xy, r.stress.yz, r.stress.xz,
+        r.vonMisesStrain, r.vonMisesStress,
+        r.maxPrincipalStrain, r.minPrincipalStrain,
+        r.maxPrincipalStress, r.minPrincipalStress
+    };
+    std::memcpy(v, values, sizeof(values));
+}
+
+void unpackResult(const double* v, ElementResult& r) {
+    r.center = Vector3D(v[0], v[1], v[2]);
+    r.strain.xx = v[3];  r.strain.yy = v[4];  r.strain.zz = v[5];
+    r.strain.xy = v[6];  r.strain.yz = v[7];  r.strain.xz = v[8];
+    r.stress.xx = v[9];  r.stress.yy = v[10]; r.stress.zz = v[11];
+    r.stress.xy = v[12]; r.stress.yz = v[13]; r.stress.xz = v[14];
+    r.vonMisesStrain = v[15];
+    r.vonMisesStress = v[16];
+    r.maxPrincipalStrain = v[17];
+    r.minPrincipalStrain = v[18];
+    r.maxPrincipalStress = v[19];
+    r.minPrincipalStress = v[20];
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+bool readArray(std::istream& in, std::vector<T>& values, size_t count) {
+    values.resize(count);
+    in.read(reinterpret_cast<char*>(values.data()),
+            static_cast<std::streamsize>(count * sizeof(T)));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+} // anonymous namespace
+
+PrestressState::PrestressState()
+    : fingerprint_(0)
+{}
+
+std::uint64_t PrestressState::fingerprint(const Mesh& refMesh, const std::string& settings) {
+    Hasher hasher;
+    hasher.add(settings.data(), settings.size());
+
+    for (const auto& [id, node] : refMesh.getNodes()) {
+        const Vector3D& p = node.getEffectivePosition();
+        hasher.add(id);
+        hasher.add(p.x);
+        hasher.add(p.y);
+        hasher.add(p.z);
+    }
+    for (const auto& [id, elem] : refMesh.getElements()) {
+        hasher.add(id);
+        hasher.add(static_cast<int>(elem.type));
+        hasher.add(elem.nodeIds);
+        const MaterialData* material = refMesh.getElementMaterial(elem);
+        double E = material ? material->E : 0.0;
+        double nu = material ? material->nu : 0.0;
+        hasher.add(E);
+        hasher.add(nu);
+    }
+    return hasher.value();
+}
+
+bool PrestressState::save(const std::string& filename, std::uint64_t fingerprint,
+                          const Mesh& defMesh, const MeshAnalysisResult& results) {
+    errorMessage_.clear();
+
+    AsyncOutputStream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot create file: " + filename;
+        return false;
+    }
+
+    std::vector<int> nodeIds;
+    std::vector<double> positions;
+    nodeIds.reserve(defMesh.getNodeCount());
+    positions.reserve(defMesh.getNodeCount() * 3);
+    for (const auto& [id, node] : defMesh.getNodes()) {
+        const Vector3D& p = node.getEffectivePosition();
+        nodeIds.push_back(id);
+        positions.push_back(p.x);
+        positions.push_back(p.y);
+        positions.push_back(p.z);
+    }
+
+    const size_t count = results.elementResults.size();
+    std::vector<int> elementIds(count);
+    std::vector<std::uint8_t> valid(count);
+    std::vector<double> values(count * RESULT_VALUES);
+    std::uint64_t messageCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const ElementResult& r = results.elementResults[i];
+        elementIds[i] = r.elementId;
+        valid[i] = r.isValid ? 1 : 0;
+        packResult(r, &values[i * RESULT_VALUES]);
+        if (!r.errorMessage.empty()) ++messageCount;
+    }
+
+    file << STATE_TAG << "\n";
+    writeValue(file, STATE_VERSION);
+    writeValue(file, fingerprint);
+    writeValue(file, static_cast<std::uint64_t>(nodeIds.size()));
+    writeValue(file, static_cast<std::uint64_t>(count));
+    writeValue(file, static_cast<std::uint8_t>(results.hasMaterial ? 1 : 0));
+    writeArray(file, nodeIds);
+    writeArray(file, positions);
+    writeArray(file, elementIds);
+    writeArray(file, valid);
+    writeArray(file, values);
+
+    // Messages of failed elements: index, length, text
+    writeValue(file, messageCount);
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& message = results.elementResults[i].errorMessage;
+        if (message.empty()) continue;
+        writeValue(file, static_cast<std::uint64_t>(i));
+        writeValue(file, static_cast<std::uint32_t>(message.size()));
+        file.write(message.data(), static_cast<std::streamsize>(message.size()));
+    }
+
+    if (!file.close()) {
+        errorMessage_ = file.getErrorMessage().empty() ? "Error writing " + filename
+                                                       : file.getErrorMessage();
+        return false;
+    }
+    return true;
+}
+
+bool PrestressState::load(const std::string& filename) {
+    errorMessage_.clear();
+    nodeIds_.clear();
+    positions_.clear();
+    results_ = MeshAnalysisResult();
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file: " + filename;
+        return false;
+    }
+
+    std::string tag;
+    std::uint32_t version = 0;
+    std::getline(file, tag);
+    if (tag != STATE_TAG || !readValue(file, version) || version != STATE_VERSION) {
+        errorMessage_ = "Not a prestress state (or written by another version): " + filename;
+        return false;
+    }
+
+    std::uint64_t nodeCount = 0, count = 0, messageCount = 0;
+    std::uint8_t hasMaterial = 0;
+    std::vector<int> elementIds;
+    std::vector<std::uint8_t> valid;
+    std::vector<double> values;
+    bool ok = readValue(file, fingerprint_) &&
+              readValue(file, nodeCount) &&
+              readValue(file, count) &&
+              readValue(file, hasMaterial) &&
+              readArray(file, nodeIds_, nodeCount) &&
+              readArray(file, positions_, nodeCount * 3) &&
+              readArray(file, elementIds, count) &&
+              readArray(file, valid, count) &&
+              readArray(file, values, count * RESULT_VALUES) &&
+              readValue(file, messageCount);
+
+    std::vector<ElementResult>& elementResults = results_.elementResults;
+    if (ok) {
+        elementResults.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            ElementResult& r = elementResults[i];
+            r.elementId = elementIds[i];
+            r.isValid = valid[i] != 0;
+            unpackResult(&values[i * RESULT_VALUES], r);
+        }
+    }
+    for (std::uint64_t m = 0; ok && m < messageCount; ++m) {
+        std::uint64_t index = 0;
+        std::uint32_t length = 0;
+        ok = readValue(file, index) && readValue(file, length) && index < count;
+        if (ok) {
+            std::string& message = elementResults[index].errorMessage;
+            message.resize(length);
+            ok = static_cast<bool>(file.read(&message[0], length));
+        }
+    }
+    if (!ok) {
+        errorMessage_ = "Invalid prestress state: " + filename;
+        nodeIds_.clear();
+        positions_.clear();
+        results_ = MeshAnalysisResult();
+        return false;
+    }
+
+    results_.hasMaterial = hasMaterial != 0;
+    for (const auto& r : elementResults) {
+        if (r.isValid) {
+            results_.validElements++;
+        } else {
+            results_.invalidElements++;
+        }
+    }
+    ElementAnalyzer::computeStatistics(results_);
+    return true;
+}
+
+bool PrestressState::findChangedElements(const Mesh& defMesh, std::vector<size_t>& indices,
+                                         size_t& movedNodes) {
+    indices.clear();
+    movedNodes = 0;
+
+    if (defMesh.getNodeCount() != nodeIds_.size() ||
+        defMesh.getElementCount() != results_.elementResults.size()) {
+        errorMessage_ = "Mesh size differs from the saved run";
+        return false;
+    }
+
+    // Both sides are in ascending ID order; compare bit patterns so that
+    // any change, however small, triggers a recompute
+    std::unordered_set<int> moved;
+    size_t n = 0;
+    for (const auto& [id, node] : defMesh.getNodes()) {
+        if (id != nodeIds_[n]) {
+            errorMessage_ = "Node IDs differ from the saved run";
+            return false;
+        }
+        const Vector3D& p = node.getEffectivePosition();
+        if (std::memcmp(&p.x, &positions_[n * 3], sizeof(double)) != 0 ||
+            std::memcmp(&p.y, &positions_[n * 3 + 1], sizeof(double)) != 0 ||
+            std::memcmp(&p.z, &positions_[n * 3 + 2], sizeof(double)) != 0) {
+            moved.insert(id);
+        }
+        ++n;
+    }
+    movedNodes = moved.size();
+
+    size_t index = 0;
+    for (const auto& [id, elem] : defMesh.getElements()) {
+        if (id != results_.elementResults[index].elementId) {
+            errorMessage_ = "Element IDs differ from the saved run";
+            indices.clear();
+            return false;
+        }
+        if (!moved.empty()) {
+            for (int nodeId : elem.nodeIds) {
+                if (moved.count(nodeId)) {
+                    indices.push_back(index);
+                    break;
+                }
+            }
+        }
+        ++index;
+    }
+    return true;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,98 @@
+#include "analysis/ResidualAnalyzer.h"
+#include "analysis/SolidAssembly.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace KooRemapper {
+
+bool ResidualAnalyzer::compute(const Mesh& defMesh, const MeshAnalysisResult& result,
+                               ResidualReport& report)
+{
+    report = ResidualReport();
+    errorMessage_.clear();
+
+    SolidAssembly assembly;
+    if (!assembly.build(defMesh)) {
+        errorMessage_ = assembly.getErrorMessage();
+        return false;
+    }
+    report.skippedElements = assembly.skippedElementCount();
+
+    std::unordered_map<int, const ElementResult*> byId;
+    byId.reserve(result.elementResults.size());
+    for (const auto& er : result.elementResults) {
+        if (er.isValid) byId[er.elementId] = &er;
+    }
+
+    size_t numElements = assembly.elementCount();
+    std::vector<StressTensor> stress(numElements);
+    for (size_t e = 0; e < numElements; ++e) {
+        auto it = byId.find(assembly.elementId(e));
+        if (it != byId.end()) stress[e] = it->second->stress;
+    }
+
+    std::vector<Vector3D> forces;
+    assembly.internalForces(stress, forces);
+
+    size_t n = assembly.nodeCount();
+    report.nodes.resize(n);
+    double sumSq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        NodalResidual& r = report.nodes[i];
+        r.nodeId = assembly.nodeId(i);
+        r.position = assembly.nodePosition(i);
+        r.force = forces[i];
+        r.magnitude = forces[i].magnitude();
+        sumSq += r.magnitude * r.magnitude;
+        report.maxNorm = std::max(report.maxNorm, r.magnitude);
+    }
+    report.l2Norm = std::sqrt(sumSq);
+
+    // Worst nodes
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    size_t keep = std::min(n, static_cast<size_t>(std::max(worstNodeCount_, 0)));
+    std::partial_sort(order.begin(), order.begin() + keep, order.end(),
+        [&](size_t a, size_t b) { return report.nodes[a].magnitude > report.nodes[b].magnitude; });
+    for (size_t i = 0; i < keep; ++i) {
+        report.worstNodes.push_back(report.nodes[order[i]]);
+    }
+
+    // Per-part norms over the nodes each part's active elements touch:
+    // (part, dense node) pairs sorted and deduplicated, then one pass
+    std::vector<std::pair<int, int>> partNodes;
+    for (size_t e = 0; e < numElements; ++e) {
+        if (!assembly.isElementActive(e)) continue;
+        int partId = assembly.elementPartId(e);
+        for (int a = 0; a < assembly.elementNodeCount(e); ++a) {
+            partNodes.emplace_back(partId, assembly.elementNode(e, a));
+        }
+    }
+    std::sort(partNodes.begin(), partNodes.end());
+    partNodes.erase(std::unique(partNodes.begin(), partNodes.end()), partNodes.end());
+
+    std::vector<double> partSq;
+    for (const auto& [partId, i] : partNodes) {
+        if (report.parts.empty() || report.parts.back().partId != partId) {
+            report.parts.emplace_back();
+            report.parts.back().partId = partId;
+            partSq.push_back(0.0);
+        }
+        PartResidual& pr = report.parts.back();
+        const NodalResidual& r = report.nodes[i];
+        pr.nodeCount++;
+        partSq.back() += r.magnitude * r.magnitude;
+        if (r.magnitude > pr.maxNorm) {
+            pr.maxNorm = r.magnitude;
+            pr.maxNodeId = r.nodeId;
+        }
+    }
+    for (size_t p = 0; p < report.parts.size(); ++p) {
+        report.parts[p].l2Norm = std::sqrt(partSq[p]);
+    }
+
+    return true;
+}
+
+} // namespace KooRemapper
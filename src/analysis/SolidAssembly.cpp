@@ -0,0 +1,423 @@
+#include "analysis/SolidAssembly.h"
+#include "analysis/DeformationGradient.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <bitset>
+#include <unordered_map>
+
+namespace KooRemapper {
+
+namespace {
+
+constexpr int MAX_COLORS = 128;
+
+/**
+ * Shape function derivatives in natural coordinates at the Gauss points
+ */
+struct ReferenceRule {
+    int numPoints;
+    int numNodes;
+    double dNdxi[8][8][3];   // [point][node][xi, eta, zeta]
+    double weight[8];
+};
+
+ReferenceRule makeHexRule()
+{
+    ReferenceRule rule{};
+    auto points = DeformationGradient::gaussPointsHex8(8);
+    rule.numPoints = static_cast<int>(points.size());
+    rule.numNodes = 8;
+
+    for (int p = 0; p < rule.numPoints; ++p) {
+        auto dN = DeformationGradient::shapeFunctionDerivativesHex8(
+            points[p][0], points[p][1], points[p][2]);
+        for (int a = 0; a < 8; ++a) {
+            for (int j = 0; j < 3; ++j) {
+                rule.dNdxi[p][a][j] = dN[a][j];
+            }
+        }
+        rule.weight[p] = points[p][3];
+    }
+    return rule;
+}
+
+ReferenceRule makeTetRule()
+{
+    // N = [1-ξ-η-ζ, ξ, η, ζ], one point, reference volume 1/6
+    ReferenceRule rule{};
+    rule.numPoints = 1;
+    rule.numNodes = 4;
+    const double dN[4][3] = {{-1, -1, -1}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (int a = 0; a < 4; ++a) {
+        for (int j = 0; j < 3; ++j) {
+            rule.dNdxi[0][a][j] = dN[a][j];
+        }
+    }
+    rule.weight[0] = 1.0 / 6.0;
+    return rule;
+}
+
+const ReferenceRule& ruleFor(int numNodes)
+{
+    static const ReferenceRule hexRule = makeHexRule();
+    static const ReferenceRule tetRule = makeTetRule();
+    return numNodes == 8 ? hexRule : tetRule;
+}
+
+/**
+ * Physical shape function gradients and integration weights of one element
+ */
+struct ElementGeometry {
+    int numPoints;
+    int numNodes;
+    double dNdx[8][8][3];    // [point][node][x, y, z]
+    double dv[8];            // det(J) * weight
+};
+
+bool computeGeometry(const ReferenceRule& rule, const Vector3D* x, ElementGeometry& g)
+{
+    g.numPoints = rule.numPoints;
+    g.numNodes = rule.numNodes;
+
+    for (int p = 0; p < rule.numPoints; ++p) {
+        // J_ij = ∂x_i/∂ξ_j
+        double J[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+        for (int a = 0; a < rule.numNodes; ++a) {
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    J[i][j] += x[a][i] * rule.dNdxi[p][a][j];
+                }
+            }
+        }
+
+        double det = J[0][0] * (J[1][1] * J[2][2] - J[1][2] * J[2][1])
+                   - J[0][1] * (J[1][0] * J[2][2] - J[1][2] * J[2][0])
+                   + J[0][2] * (J[1][0] * J[2][1] - J[1][1] * J[2][0]);
+        if (!(det > 1e-30)) {
+            return false;
+        }
+
+        double inv = 1.0 / det;
+        double Ji[3][3];
+        Ji[0][0] = (J[1][1] * J[2][2] - J[1][2] * J[2][1]) * inv;
+        Ji[0][1] = (J[0][2] * J[2][1] - J[0][1] * J[2][2]) * inv;
+        Ji[0][2] = (J[0][1] * J[1][2] - J[0][2] * J[1][1]) * inv;
+        Ji[1][0] = (J[1][2] * J[2][0] - J[1][0] * J[2][2]) * inv;
+        Ji[1][1] = (J[0][0] * J[2][2] - J[0][2] * J[2][0]) * inv;
+        Ji[1][2] = (J[0][2] * J[1][0] - J[0][0] * J[1][2]) * inv;
+        Ji[2][0] = (J[1][0] * J[2][1] - J[1][1] * J[2][0]) * inv;
+        Ji[2][1] = (J[0][1] * J[2][0] - J[0][0] * J[2][1]) * inv;
+        Ji[2][2] = (J[0][0] * J[1][1] - J[0][1] * J[1][0]) * inv;
+
+        // dN/dx_i = sum_j dN/dξ_j * (J^-1)_ji
+        for (int a = 0; a < rule.numNodes; ++a) {
+            for (int i = 0; i < 3; ++i) {
+                g.dNdx[p][a][i] = rule.dNdxi[p][a][0] * Ji[0][i]
+                                + rule.dNdxi[p][a][1] * Ji[1][i]
+                                + rule.dNdxi[p][a][2] * Ji[2][i];
+            }
+        }
+        g.dv[p] = det * rule.weight[p];
+    }
+    return true;
+}
+
+// σ (Voigt) = C ε (Voigt, engineering shear)
+inline void voigtProduct(const SolidAssembly::Stiffness& C, const double eps[6], double sig[6])
+{
+    for (int r = 0; r < 6; ++r) {
+        double s = 0.0;
+        for (int c = 0; c < 6; ++c) {
+            s += C[r][c] * eps[c];
+        }
+        sig[r] = s;
+    }
+}
+
+// f_a += σ · ∇N_a dv  (Voigt order xx, yy, zz, xy, yz, xz)
+inline void scatterStress(const double sig[6], const double* dN, double dv, Vector3D& f)
+{
+    f.x += (sig[0] * dN[0] + sig[3] * dN[1] + sig[5] * dN[2]) * dv;
+    f.y += (sig[3] * dN[0] + sig[1] * dN[1] + sig[4] * dN[2]) * dv;
+    f.z += (sig[5] * dN[0] + sig[4] * dN[1] + sig[2] * dN[2]) * dv;
+}
+
+// Voigt strain of the displacement field at one Gauss point
+inline void strainAt(const ElementGeometry& g, int p, const Vector3D* u, double eps[6])
+{
+    double H[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    for (int a = 0; a < g.numNodes; ++a) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                H[i][j] += u[a][i] * g.dNdx[p][a][j];
+            }
+        }
+    }
+    eps[0] = H[0][0];
+    eps[1] = H[1][1];
+    eps[2] = H[2][2];
+    eps[3] = H[0][1] + H[1][0];
+    eps[4] = H[1][2] + H[2][1];
+    eps[5] = H[0][2] + H[2][0];
+}
+
+} // anonymous namespace
+
+bool SolidAssembly::build(const Mesh& mesh)
+{
+    *this = SolidAssembly();
+
+    const auto& nodes = mesh.getNodes();
+    std::unordered_map<int, int> nodeIndex;
+    nodeIndex.reserve(nodes.size());
+    nodeIds_.reserve(nodes.size());
+    positions_.reserve(nodes.size());
+
+    for (const auto& [id, node] : nodes) {
+        nodeIndex[id] = static_cast<int>(nodeIds_.size());
+        nodeIds_.push_back(id);
+        positions_.push_back(node.getEffectivePosition());
+    }
+
+    const auto& elements = mesh.getElements();
+    size_t numElements = elements.size();
+    elementIds_.reserve(numElements);
+    partIds_.reserve(numElements);
+    nodesPerElement_.reserve(numElements);
+    conn_.reserve(numElements);
+    active_.reserve(numElements);
+
+    for (const auto& [id, elem] : elements) {
+        int nn = elem.type == ElementType::HEX8 ? 8
+               : elem.type == ElementType::TET4 ? 4 : 0;
+
+        std::array<int, 8> local;
+        local.fill(0);
+        bool ok = nn > 0;
+        for (int a = 0; a < nn && ok; ++a) {
+            auto it = nodeIndex.find(elem.nodeIds[a]);
+            if (it == nodeIndex.end()) {
+                ok = false;
+            } else {
+                local[a] = it->second;
+            }
+        }
+
+        elementIds_.push_back(id);
+        partIds_.push_back(elem.partId);
+        nodesPerElement_.push_back(ok ? nn : 0);
+        conn_.push_back(local);
+        active_.push_back(ok ? 1 : 0);
+    }
+
+    materialIndex_.assign(numElements, -1);
+
+    // Reject degenerate/inverted elements up front so kernels need no checks
+    ThreadPool::instance().parallelFor(numElements, [&](size_t begin, size_t end) {
+        ElementGeometry g;
+        Vector3D x[8];
+        for (size_t e = begin; e < end; ++e) {
+            if (!active_[e]) continue;
+            int nn = nodesPerElement_[e];
+            for (int a = 0; a < nn; ++a) x[a] = positions_[conn_[e][a]];
+            if (!computeGeometry(ruleFor(nn), x, g)) {
+                active_[e] = 0;
+            }
+        }
+    });
+
+    skipped_ = static_cast<size_t>(std::count(active_.begin(), active_.end(), 0));
+
+    colorElements();
+    if (!errorMessage_.empty()) {
+        return false;
+    }
+    return true;
+}
+
+void SolidAssembly::colorElements()
+{
+    // Greedy coloring: smallest color not yet used at any node of the element
+    std::vector<std::bitset<MAX_COLORS>> used(nodeIds_.size());
+
+    for (size_t e = 0; e < elementIds_.size(); ++e) {
+        if (!active_[e]) continue;
+
+        std::bitset<MAX_COLORS> taken;
+        int nn = nodesPerElement_[e];
+        for (int a = 0; a < nn; ++a) {
+            taken |= used[conn_[e][a]];
+        }
+
+        int color = 0;
+        while (color < MAX_COLORS && taken.test(color)) {
+            ++color;
+        }
+        if (color == MAX_COLORS) {
+            errorMessage_ = "Element coloring exceeded " + std::to_string(MAX_COLORS)
+                          + " colors at element " + std::to_string(elementIds_[e]);
+            return;
+        }
+
+        for (int a = 0; a < nn; ++a) {
+            used[conn_[e][a]].set(color);
+        }
+        if (static_cast<size_t>(color) >= colors_.size()) {
+            colors_.resize(color + 1);
+        }
+        colors_[color].push_back(e);
+    }
+}
+
+void SolidAssembly::setElementMaterial(size_t e, const MaterialModel& material)
+{
+    double E = material.youngsModulus();
+    double nu = material.poissonsRatio();
+
+    for (size_t m = 0; m < materialKeys_.size(); ++m) {
+        if (materialKeys_[m][0] == E && materialKeys_[m][1] == nu) {
+            materialIndex_[e] = static_cast<int>(m);
+            return;
+        }
+    }
+
+    materialKeys_.push_back({{E, nu}});
+    stiffness_.push_back(material.stiffnessMatrix());
+    materialIndex_[e] = static_cast<int>(stiffness_.size() - 1);
+}
+
+void SolidAssembly::internalForces(const std::vector<StressTensor>& stress,
+                                   std::vector<Vector3D>& forces) const
+{
+    forces.assign(nodeIds_.size(), Vector3D(0, 0, 0));
+
+    for (const auto& color : colors_) {
+        ThreadPool::instance().parallelFor(color.size(), [&](size_t begin, size_t end) {
+            ElementGeometry g;
+            Vector3D x[8];
+            for (size_t c = begin; c < end; ++c) {
+                size_t e = color[c];
+                int nn = nodesPerElement_[e];
+                for (int a = 0; a < nn; ++a) x[a] = positions_[conn_[e][a]];
+                computeGeometry(ruleFor(nn), x, g);
+
+                auto sig = stress[e].toVoigt();
+                for (int p = 0; p < g.numPoints; ++p) {
+                    for (int a = 0; a < nn; ++a) {
+                        scatterStress(sig.data(), g.dNdx[p][a], g.dv[p], forces[conn_[e][a]]);
+                    }
+                }
+            }
+        }, 64);
+    }
+}
+
+void SolidAssembly::applyStiffness(const std::vector<Vector3D>& xv,
+                                   std::vector<Vector3D>& y) const
+{
+    y.assign(nodeIds_.size(), Vector3D(0, 0, 0));
+
+    for (const auto& color : colors_) {
+        ThreadPool::instance().parallelFor(color.size(), [&](size_t begin, size_t end) {
+            ElementGeometry g;
+            Vector3D x[8];
+            Vector3D u[8];
+            for (size_t c = begin; c < end; ++c) {
+                size_t e = color[c];
+                if (materialIndex_[e] < 0) continue;
+                const Stiffness& C = stiffness_[materialIndex_[e]];
+
+                int nn = nodesPerElement_[e];
+                for (int a = 0; a < nn; ++a) {
+                    x[a] = positions_[conn_[e][a]];
+                    u[a] = xv[conn_[e][a]];
+                }
+                computeGeometry(ruleFor(nn), x, g);
+
+                for (int p = 0; p < g.numPoints; ++p) {
+                    double eps[6], sig[6];
+                    strainAt(g, p, u, eps);
+                    voigtProduct(C, eps, sig);
+                    for (int a = 0; a < nn; ++a) {
+                        scatterStress(sig, g.dNdx[p][a], g.dv[p], y[conn_[e][a]]);
+                    }
+                }
+            }
+        }, 64);
+    }
+}
+
+void SolidAssembly::stiffnessDiagonal(std::vector<Vector3D>& diag) const
+{
+    diag.assign(nodeIds_.size(), Vector3D(0, 0, 0));
+
+    for (const auto& color : colors_) {
+        ThreadPool::instance().parallelFor(color.size(), [&](size_t begin, size_t end) {
+            ElementGeometry g;
+            Vector3D x[8];
+            for (size_t c = begin; c < end; ++c) {
+                size_t e = color[c];
+                if (materialIndex_[e] < 0) continue;
+                const Stiffness& C = stiffness_[materialIndex_[e]];
+
+                int nn = nodesPerElement_[e];
+                for (int a = 0; a < nn; ++a) x[a] = positions_[conn_[e][a]];
+                computeGeometry(ruleFor(nn), x, g);
+
+                for (int p = 0; p < g.numPoints; ++p) {
+                    for (int a = 0; a < nn; ++a) {
+                        const double* d = g.dNdx[p][a];
+                        // Strain of a unit displacement of node a in x, y, z
+                        const double b[3][6] = {
+                            {d[0], 0, 0, d[1], 0, d[2]},
+                            {0, d[1], 0, d[0], d[2], 0},
+                            {0, 0, d[2], 0, d[1], d[0]}
+                        };
+                        Vector3D& out = diag[conn_[e][a]];
+                        for (int i = 0; i < 3; ++i) {
+                            double sig[6];
+                            voigtProduct(C, b[i], sig);
+                            double k = 0.0;
+                            for (int r = 0; r < 6; ++r) k += b[i][r] * sig[r];
+                            out[i] += k * g.dv[p];
+                        }
+                    }
+                }
+            }
+        }, 64);
+    }
+}
+
+StressTensor SolidAssembly::elementStress(size_t e, const std::vector<Vector3D>& uv) const
+{
+    if (!active_[e] || materialIndex_[e] < 0) {
+        return StressTensor();
+    }
+    const Stiffness& C = stiffness_[materialIndex_[e]];
+
+    int nn = nodesPerElement_[e];
+    Vector3D x[8];
+    Vector3D u[8];
+    for (int a = 0; a < nn; ++a) {
+        x[a] = positions_[conn_[e][a]];
+        u[a] = uv[conn_[e][a]];
+    }
+
+    ElementGeometry g;
+    computeGeometry(ruleFor(nn), x, g);
+
+    std::array<double, 6> avg = {{0, 0, 0, 0, 0, 0}};
+    double volume = 0.0;
+    for (int p = 0; p < g.numPoints; ++p) {
+        double eps[6], sig[6];
+        strainAt(g, p, u, eps);
+        voigtProduct(C, eps, sig);
+        for (int r = 0; r < 6; ++r) avg[r] += sig[r] * g.dv[p];
+        volume += g.dv[p];
+    }
+    for (int r = 0; r < 6; ++r) avg[r] /= volume;
+
+    return StressTensor::fromVoigt(avg);
+}
+
+} // namespace KooRemapper
@@ -1,4 +1,7 @@
 #include "analysis/StrainCalculator.h"
+#include "util/AsyncFileWriter.h"
+#include "util/ThreadPool.h"
+#include "util/TuningProfile.h"
 #include <cmath>
 #include <fstream>
 #include <algorithm>
@@ -52,6 +55,27 @@ std::array<double, 3> StrainData::principal() const {
 
 StrainCalculator::StrainCalculator() = default;
 
+void StrainCalculator::setStrainTypes(const std::vector<StrainType>& types) {
+    std::vector<StrainType> unique;
+    for (StrainType type : types) {
+        if (std::find(unique.begin(), unique.end(), type) == unique.end()) {
+            unique.push_back(type);
+        }
+    }
+    if (!unique.empty()) {
+        strainTypes_ = unique;
+    }
+}
+
+const char* StrainCalculator::strainTypeName(StrainType type) {
+    switch (type) {
+        case StrainType::ENGINEERING:    return "engineering";
+        case StrainType::GREEN_LAGRANGE: return "green";
+        case StrainType::LOGARITHMIC:    return "log";
+    }
+    return "unknown";
+}
+
 bool StrainCalculator::calculate() {
     if (!refMesh_ || !defMesh_) {
         errorMessage_ = "Reference or deformed mesh not set";
@@ -68,15 +92,29 @@ bool StrainCalculator::calculate() {
         return false;
     }
 
-    // Calculate strains for each element
+    // Calculate strains for each element (every measure in the same loop);
+    // elements are independent, so chunks run in parallel and the results
+    // are inserted in ID order afterwards
     elementStrains_.clear();
 
+    std::vector<const Element*> elements;
+    elements.reserve(refMesh_->getElementCount());
     for (const auto& [elemId, element] : refMesh_->getElements()) {
-        ElementStrainData data;
-        data.elementId = elemId;
+        elements.push_back(&element);
+    }
+
+    std::vector<ElementStrainData> results(elements.size());
+    std::vector<char> computed(elements.size(), 0);
+    ThreadPool::instance().parallelFor(elements.size(), [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; ++e) {
+            results[e].elementId = elements[e]->id;
+            computed[e] = calculateElementStrain(*elements[e], results[e]) ? 1 : 0;
+        }
+    }, TuningProfile::active().elementChunk);
 
-        if (calculateElementStrain(element, data)) {
-            elementStrains_[elemId] = data;
+    for (size_t e = 0; e < elements.size(); ++e) {
+        if (computed[e]) {
+            elementStrains_.emplace_hint(elementStrains_.end(), results[e].elementId, results[e]);
         }
     }
 
@@ -103,12 +141,14 @@ bool StrainCalculator::calculateDisplacements() {
     return true;
 }
 
-bool StrainCalculator::calculateElementStrain(const Element& element, ElementStrainData& data) {
+bool StrainCalculator::calculateElementStrain(const Element& element, ElementStrainData& data) const {
     // Gauss points for 2x2x2 integration
     const double gp = 1.0 / std::sqrt(3.0);
     const double gaussPoints[2] = {-gp, gp};
 
-    StrainData avgStrain;
+    // One F per Gauss point, shared by every requested measure
+    const size_t numMeasures = strainTypes_.size();
+    std::array<StrainData, 3> avgStrains;
     int numPoints = 0;
 
     // Integrate over Gauss points
@@ -118,66 +158,16 @@ bool StrainCalculator::calculateElementStrain(const Element& element, ElementStr
                 // Calculate deformation gradient
                 auto F = calculateDeformationGradient(element, xi, eta, zeta);
 
-                // Calculate strain based on type
-                StrainData strain;
-
-                if (strainType_ == StrainType::ENGINEERING) {
-                    // Engineering strain: e = 0.5 * (F + F^T) - I
-                    strain.exx = F[0][0] - 1.0;
-                    strain.eyy = F[1][1] - 1.0;
-                    strain.ezz = F[2][2] - 1.0;
-                    strain.exy = 0.5 * (F[0][1] + F[1][0]);
-                    strain.eyz = 0.5 * (F[1][2] + F[2][1]);
-                    strain.exz = 0.5 * (F[0][2] + F[2][0]);
+                for (size_t m = 0; m < numMeasures; ++m) {
+                    StrainData strain = strainFromF(F, strainTypes_[m]);
+                    StrainData& avgStrain = avgStrains[m];
+                    avgStrain.exx += strain.exx;
+                    avgStrain.eyy += strain.eyy;
+                    avgStrain.ezz += strain.ezz;
+                    avgStrain.exy += strain.exy;
+                    avgStrain.eyz += strain.eyz;
+                    avgStrain.exz += strain.exz;
                 }
-                else if (strainType_ == StrainType::GREEN_LAGRANGE) {
-                    // Green-Lagrange: E = 0.5 * (F^T * F - I)
-                    // C = F^T * F (Right Cauchy-Green tensor)
-                    double C[3][3];
-                    for (int i = 0; i < 3; ++i) {
-                        for (int j = 0; j < 3; ++j) {
-                            C[i][j] = 0.0;
-                            for (int k = 0; k < 3; ++k) {
-                                C[i][j] += F[k][i] * F[k][j];
-                            }
-                        }
-                    }
-
-                    strain.exx = 0.5 * (C[0][0] - 1.0);
-                    strain.eyy = 0.5 * (C[1][1] - 1.0);
-                    strain.ezz = 0.5 * (C[2][2] - 1.0);
-                    strain.exy = 0.5 * C[0][1];
-                    strain.eyz = 0.5 * C[1][2];
-                    strain.exz = 0.5 * C[0][2];
-                }
-                else if (strainType_ == StrainType::LOGARITHMIC) {
-                    // Logarithmic (Hencky) strain: e = 0.5 * ln(C)
-                    // Simplified: use principal stretches
-                    double C[3][3];
-                    for (int i = 0; i < 3; ++i) {
-                        for (int j = 0; j < 3; ++j) {
-                            C[i][j] = 0.0;
-                            for (int k = 0; k < 3; ++k) {
-                                C[i][j] += F[k][i] * F[k][j];
-                            }
-                        }
-                    }
-
-                    // For now, use diagonal approximation
-                    strain.exx = 0.5 * std::log(std::max(1e-10, C[0][0]));
-                    strain.eyy = 0.5 * std::log(std::max(1e-10, C[1][1]));
-                    strain.ezz = 0.5 * std::log(std::max(1e-10, C[2][2]));
-                    strain.exy = 0.5 * C[0][1] / std::sqrt(C[0][0] * C[1][1]);
-                    strain.eyz = 0.5 * C[1][2] / std::sqrt(C[1][1] * C[2][2]);
-                    strain.exz = 0.5 * C[0][2] / std::sqrt(C[0][0] * C[2][2]);
-                }
-
-                avgStrain.exx += strain.exx;
-                avgStrain.eyy += strain.eyy;
-                avgStrain.ezz += strain.ezz;
-                avgStrain.exy += strain.exy;
-                avgStrain.eyz += strain.eyz;
-                avgStrain.exz += strain.exz;
                 numPoints++;
             }
         }
@@ -185,15 +175,19 @@ bool StrainCalculator::calculateElementStrain(const Element& element, ElementStr
 
     // Average strain
     if (numPoints > 0) {
-        avgStrain.exx /= numPoints;
-        avgStrain.eyy /= numPoints;
-        avgStrain.ezz /= numPoints;
-        avgStrain.exy /= numPoints;
-        avgStrain.eyz /= numPoints;
-        avgStrain.exz /= numPoints;
+        for (size_t m = 0; m < numMeasures; ++m) {
+            StrainData& avgStrain = avgStrains[m];
+            avgStrain.exx /= numPoints;
+            avgStrain.eyy /= numPoints;
+            avgStrain.ezz /= numPoints;
+            avgStrain.exy /= numPoints;
+            avgStrain.eyz /= numPoints;
+            avgStrain.exz /= numPoints;
+        }
     }
 
-    data.strain = avgStrain;
+    data.measures = avgStrains;
+    data.strain = avgStrains[0];
 
     // Calculate Jacobian at center
     auto J = jacobianMatrix(element, 0.0, 0.0, 0.0, false);
@@ -233,6 +227,64 @@ bool StrainCalculator::calculateElementStrain(const Element& element, ElementStr
     return true;
 }
 
+StrainData StrainCalculator::strainFromF(const std::array<std::array<double, 3>, 3>& F,
+                                         StrainType type) {
+    StrainData strain;
+
+    if (type == StrainType::ENGINEERING) {
+        // Engineering strain: e = 0.5 * (F + F^T) - I
+        strain.exx = F[0][0] - 1.0;
+        strain.eyy = F[1][1] - 1.0;
+        strain.ezz = F[2][2] - 1.0;
+        strain.exy = 0.5 * (F[0][1] + F[1][0]);
+        strain.eyz = 0.5 * (F[1][2] + F[2][1]);
+        strain.exz = 0.5 * (F[0][2] + F[2][0]);
+    }
+    else if (type == StrainType::GREEN_LAGRANGE) {
+        // Green-Lagrange: E = 0.5 * (F^T * F - I)
+        // C = F^T * F (Right Cauchy-Green tensor)
+        double C[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                C[i][j] = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                    C[i][j] += F[k][i] * F[k][j];
+                }
+            }
+        }
+
+        strain.exx = 0.5 * (C[0][0] - 1.0);
+        strain.eyy = 0.5 * (C[1][1] - 1.0);
+        strain.ezz = 0.5 * (C[2][2] - 1.0);
+        strain.exy = 0.5 * C[0][1];
+        strain.eyz = 0.5 * C[1][2];
+        strain.exz = 0.5 * C[0][2];
+    }
+    else if (type == StrainType::LOGARITHMIC) {
+        // Logarithmic (Hencky) strain: e = 0.5 * ln(C)
+        // Simplified: use principal stretches
+        double C[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                C[i][j] = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                    C[i][j] += F[k][i] * F[k][j];
+                }
+            }
+        }
+
+        // For now, use diagonal approximation
+        strain.exx = 0.5 * std::log(std::max(1e-10, C[0][0]));
+        strain.eyy = 0.5 * std::log(std::max(1e-10, C[1][1]));
+        strain.ezz = 0.5 * std::log(std::max(1e-10, C[2][2]));
+        strain.exy = 0.5 * C[0][1] / std::sqrt(C[0][0] * C[1][1]);
+        strain.eyz = 0.5 * C[1][2] / std::sqrt(C[1][1] * C[2][2]);
+        strain.exz = 0.5 * C[0][2] / std::sqrt(C[0][0] * C[2][2]);
+    }
+
+    return strain;
+}
+
 std::array<std::array<double, 3>, 3> StrainCalculator::calculateDeformationGradient(
     const Element& element, double xi, double eta, double zeta) const {
 
@@ -363,49 +415,60 @@ double StrainCalculator::determinant3x3(const std::array<std::array<double, 3>,
 }
 
 void StrainCalculator::updateStats() {
-    stats_ = StrainStats();
+    measureStats_ = {};
+    for (size_t m = 0; m < strainTypes_.size(); ++m) {
+        measureStats_[m] = computeStats(m);
+    }
+    stats_ = measureStats_[0];
+}
+
+StrainStats StrainCalculator::computeStats(size_t measure) const {
+    StrainStats stats;
 
-    if (elementStrains_.empty()) return;
+    if (elementStrains_.empty()) return stats;
 
-    stats_.minVonMises = std::numeric_limits<double>::max();
-    stats_.maxVonMises = std::numeric_limits<double>::lowest();
-    stats_.minVolumetric = std::numeric_limits<double>::max();
-    stats_.maxVolumetric = std::numeric_limits<double>::lowest();
-    stats_.minMaxShear = std::numeric_limits<double>::max();
-    stats_.maxMaxShear = std::numeric_limits<double>::lowest();
-    stats_.minPrincipal = std::numeric_limits<double>::max();
-    stats_.maxPrincipal = std::numeric_limits<double>::lowest();
+    stats.minVonMises = std::numeric_limits<double>::max();
+    stats.maxVonMises = std::numeric_limits<double>::lowest();
+    stats.minVolumetric = std::numeric_limits<double>::max();
+    stats.maxVolumetric = std::numeric_limits<double>::lowest();
+    stats.minMaxShear = std::numeric_limits<double>::max();
+    stats.maxMaxShear = std::numeric_limits<double>::lowest();
+    stats.minPrincipal = std::numeric_limits<double>::max();
+    stats.maxPrincipal = std::numeric_limits<double>::lowest();
 
     double sumVonMises = 0.0;
     double sumVolumetric = 0.0;
     double sumMaxShear = 0.0;
 
     for (const auto& [id, data] : elementStrains_) {
-        double vm = data.strain.vonMises();
-        double vol = data.strain.volumetric();
-        double ms = data.strain.maxShear();
-        auto principals = data.strain.principal();
-
-        stats_.minVonMises = std::min(stats_.minVonMises, vm);
-        stats_.maxVonMises = std::max(stats_.maxVonMises, vm);
-        stats_.minVolumetric = std::min(stats_.minVolumetric, vol);
-        stats_.maxVolumetric = std::max(stats_.maxVolumetric, vol);
-        stats_.minMaxShear = std::min(stats_.minMaxShear, ms);
-        stats_.maxMaxShear = std::max(stats_.maxMaxShear, ms);
-        stats_.minPrincipal = std::min(stats_.minPrincipal, principals[2]);
-        stats_.maxPrincipal = std::max(stats_.maxPrincipal, principals[0]);
+        const StrainData& strain = data.measures[measure];
+        double vm = strain.vonMises();
+        double vol = strain.volumetric();
+        double ms = strain.maxShear();
+        auto principals = strain.principal();
+
+        stats.minVonMises = std::min(stats.minVonMises, vm);
+        stats.maxVonMises = std::max(stats.maxVonMises, vm);
+        stats.minVolumetric = std::min(stats.minVolumetric, vol);
+        stats.maxVolumetric = std::max(stats.maxVolumetric, vol);
+        stats.minMaxShear = std::min(stats.minMaxShear, ms);
+        stats.maxMaxShear = std::max(stats.maxMaxShear, ms);
+        stats.minPrincipal = std::min(stats.minPrincipal, principals[2]);
+        stats.maxPrincipal = std::max(stats.maxPrincipal, principals[0]);
 
         sumVonMises += vm;
         sumVolumetric += vol;
         sumMaxShear += ms;
-        stats_.elementsProcessed++;
+        stats.elementsProcessed++;
     }
 
-    if (stats_.elementsProcessed > 0) {
-        stats_.avgVonMises = sumVonMises / stats_.elementsProcessed;
-        stats_.avgVolumetric = sumVolumetric / stats_.elementsProcessed;
-        stats_.avgMaxShear = sumMaxShear / stats_.elementsProcessed;
+    if (stats.elementsProcessed > 0) {
+        stats.avgVonMises = sumVonMises / stats.elementsProcessed;
+        stats.avgVolumetric = sumVolumetric / stats.elementsProcessed;
+        stats.avgMaxShear = sumMaxShear / stats.elementsProcessed;
     }
+
+    return stats;
 }
 
 const ElementStrainData* StrainCalculator::getElementStrain(int elementId) const {
@@ -419,28 +482,49 @@ Vector3D StrainCalculator::getNodeDisplacement(int nodeId) const {
 }
 
 bool StrainCalculator::exportToCSV(const std::string& filename) const {
-    std::ofstream file(filename);
+    AsyncOutputStream file(filename);
     if (!file.is_open()) {
         return false;
     }
 
-    file << "ElementID,exx,eyy,ezz,exy,eyz,exz,VonMises,Volumetric,MaxShear,Jacobian\n";
+    writeCSVHeader(file);
+    writeCSVRows(file);
 
-    for (const auto& [id, data] : elementStrains_) {
-        file << id << ","
-             << data.strain.exx << ","
-             << data.strain.eyy << ","
-             << data.strain.ezz << ","
-             << data.strain.exy << ","
-             << data.strain.eyz << ","
-             << data.strain.exz << ","
-             << data.strain.vonMises() << ","
-             << data.strain.volumetric() << ","
-             << data.strain.maxShear() << ","
-             << data.jacobian << "\n";
+    return file.close();
+}
+
+void StrainCalculator::writeCSVHeader(std::ostream& file) const {
+    if (strainTypes_.size() == 1) {
+        file << "ElementID,exx,eyy,ezz,exy,eyz,exz,VonMises,Volumetric,MaxShear,Jacobian\n";
+        return;
     }
 
-    return true;
+    file << "ElementID";
+    for (StrainType type : strainTypes_) {
+        const std::string p = std::string(",") + strainTypeName(type) + "_";
+        file << p << "exx" << p << "eyy" << p << "ezz" << p << "exy" << p << "eyz" << p << "exz"
+             << p << "VonMises" << p << "Volumetric" << p << "MaxShear";
+    }
+    file << ",Jacobian\n";
+}
+
+void StrainCalculator::writeCSVRows(std::ostream& file) const {
+    for (const auto& [id, data] : elementStrains_) {
+        file << id << ",";
+        for (size_t m = 0; m < strainTypes_.size(); ++m) {
+            const StrainData& strain = data.measures[m];
+            file << strain.exx << ","
+                 << strain.eyy << ","
+                 << strain.ezz << ","
+                 << strain.exy << ","
+                 << strain.eyz << ","
+                 << strain.exz << ","
+                 << strain.vonMises() << ","
+                 << strain.volumetric() << ","
+                 << strain.maxShear() << ",";
+        }
+        file << data.jacobian << "\n";
+    }
 }
 
 } // namespace KooRemapper
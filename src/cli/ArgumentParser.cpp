@@ -90,7 +90,8 @@ bool ArgumentParser::parse(int argc, char* argv[]) {
 
         if (arg.empty()) continue;
 
-        if (arg[0] == '-') {
+        // A lone "-" is a positional argument (stdin/stdout)
+        if (arg[0] == '-' && arg != "-") {
             // Option or flag
             std::string flagName = normalizeFlag(arg);
 
@@ -118,7 +119,8 @@ bool ArgumentParser::parse(int argc, char* argv[]) {
             } else if (opt.hasValue) {
                 if (!value.empty()) {
                     opt.value = value;
-                } else if (i + 1 < args.size() && args[i + 1][0] != '-') {
+                } else if (i + 1 < args.size() &&
+                           (args[i + 1][0] != '-' || args[i + 1] == "-")) {
                     opt.value = args[++i];
                 } else {
                     errorMessage_ = "Option " + arg + " requires a value";
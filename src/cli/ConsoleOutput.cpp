@@ -7,6 +7,7 @@ namespace KooRemapper {
 
 ConsoleOutput::ConsoleOutput()
     : colorsEnabled_(true)
+    , quiet_(false)
 {
     // Try to enable ANSI colors
     colorsEnabled_ = Platform::enableAnsiColors();
@@ -36,12 +37,18 @@ std::string ConsoleOutput::resetCode() const {
     return colorsEnabled_ ? "\033[0m" : "";
 }
 
-void ConsoleOutput::print(const std::string& text, Color color) const {
+void ConsoleOutput::write(const std::string& text, Color color) const {
     std::cout << colorCode(color) << text << resetCode();
 }
 
+void ConsoleOutput::print(const std::string& text, Color color) const {
+    if (quiet_) return;
+    write(text, color);
+}
+
 void ConsoleOutput::println(const std::string& text, Color color) const {
-    print(text, color);
+    if (quiet_) return;
+    write(text, color);
     std::cout << "\n";
 }
 
@@ -61,11 +68,13 @@ void ConsoleOutput::warning(const std::string& message) const {
 }
 
 void ConsoleOutput::error(const std::string& message) const {
-    print("[ERROR] ", Color::BRIGHT_RED);
-    println(message);
+    // Errors are shown even when quiet
+    write("[ERROR] ", Color::BRIGHT_RED);
+    write(message + "\n", Color::DEFAULT);
 }
 
 void ConsoleOutput::progressBar(int percent, int width) const {
+    if (quiet_) return;
     percent = std::max(0, std::min(100, percent));
 
     int filled = (width * percent) / 100;
@@ -107,10 +116,12 @@ void ConsoleOutput::header(const std::string& text) const {
 
 void ConsoleOutput::keyValue(const std::string& key, const std::string& value,
                              int keyWidth) const {
+    if (quiet_) return;
     std::cout << std::left << std::setw(keyWidth) << (key + ":") << value << "\n";
 }
 
 void ConsoleOutput::clearLine() const {
+    if (quiet_) return;
     std::cout << "\r" << std::string(80, ' ') << "\r" << std::flush;
 }
 
@@ -0,0 +1,72 @@
+#include "core/ElementBuckets.h"
+#include <algorithm>
+
+namespace KooRemapper {
+
+namespace {
+
+ElementType bucketType(ElementType type) {
+    return (type == ElementType::HEX8 || type == ElementType::TET4) ? type : ElementType::UNKNOWN;
+}
+
+template <ElementType Type>
+size_t append(ElementBucket<Type>& bucket, const Element& elem, size_t position) {
+    std::array<int, ElementBucket<Type>::NODES> nodes;
+    std::copy_n(elem.nodeIds.begin(), nodes.size(), nodes.begin());
+
+    bucket.ids.push_back(elem.id);
+    bucket.partIds.push_back(elem.partId);
+    bucket.nodeIds.push_back(nodes);
+    bucket.positions.push_back(position);
+    return bucket.size() - 1;
+}
+
+template <ElementType Type>
+bool findSlot(const ElementBucket<Type>& bucket, int id, size_t& slot) {
+    auto it = std::lower_bound(bucket.ids.begin(), bucket.ids.end(), id);
+    if (it == bucket.ids.end() || *it != id) {
+        return false;
+    }
+    slot = static_cast<size_t>(it - bucket.ids.begin());
+    return true;
+}
+
+} // anonymous namespace
+
+ElementBuckets::ElementBuckets(const Mesh& mesh) {
+    size_t position = 0;
+    for (const auto& [id, elem] : mesh.getElements()) {
+        ElementType type = bucketType(elem.type);
+        size_t slot;
+        switch (type) {
+            case ElementType::HEX8: slot = append(hex8_, elem, position); break;
+            case ElementType::TET4: slot = append(tet4_, elem, position); break;
+            default:                slot = append(other_, elem, position); break;
+        }
+
+        if (!runs_.empty() && runs_.back().type == type) {
+            ++runs_.back().count;
+        } else {
+            runs_.push_back({type, slot, 1});
+        }
+        ++position;
+    }
+}
+
+bool ElementBuckets::find(int id, ElementType& type, size_t& slot) const {
+    if (findSlot(hex8_, id, slot)) {
+        type = ElementType::HEX8;
+        return true;
+    }
+    if (findSlot(tet4_, id, slot)) {
+        type = ElementType::TET4;
+        return true;
+    }
+    if (findSlot(other_, id, slot)) {
+        type = ElementType::UNKNOWN;
+        return true;
+    }
+    return false;
+}
+
+} // namespace KooRemapper
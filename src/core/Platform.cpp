@@ -1,10 +1,14 @@
 #include "core/Platform.h"
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
 #ifdef PLATFORM_WINDOWS
     #include <windows.h>
     #include <direct.h>
+    #include <fcntl.h>
+    #include <io.h>
     #define getcwd _getcwd
 #else
     #include <unistd.h>
@@ -58,6 +62,17 @@ bool fileExists(const std::string& path) {
     return file.good();
 }
 
+bool isStdStream(const std::string& path) {
+    return path == "-";
+}
+
+void setBinaryStdio() {
+#ifdef PLATFORM_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+}
+
 bool createDirectory(const std::string& path) {
 #ifdef PLATFORM_WINDOWS
     return _mkdir(path.c_str()) == 0 || errno == EEXIST;
@@ -114,6 +129,32 @@ std::string getCurrentDirectory() {
     return "";
 }
 
+std::string getHostName() {
+#ifdef PLATFORM_WINDOWS
+    char buffer[MAX_COMPUTERNAME_LENGTH + 1];
+    DWORD size = sizeof(buffer);
+    if (GetComputerNameA(buffer, &size)) {
+        return std::string(buffer, size);
+    }
+#else
+    char buffer[256];
+    if (gethostname(buffer, sizeof(buffer)) == 0) {
+        buffer[sizeof(buffer) - 1] = '\0';
+        return std::string(buffer);
+    }
+#endif
+    return "localhost";
+}
+
+std::string getHomeDirectory() {
+#ifdef PLATFORM_WINDOWS
+    const char* home = std::getenv("USERPROFILE");
+#else
+    const char* home = std::getenv("HOME");
+#endif
+    return home ? std::string(home) : std::string();
+}
+
 std::string getFilename(const std::string& path) {
     size_t pos = path.find_last_of("/\\");
     if (pos != std::string::npos) {
@@ -101,26 +101,29 @@ Mesh ExampleMeshGenerator::generateBentMesh(const ExampleMeshConfig& config) {
     int nodeId = config.startNodeId;
     int elemId = config.startElementId;
 
+    // A full torus closes on itself: its last elements reuse the i = 0 nodes
+    const bool closed = config.bentType == BentMeshType::TORUS && config.torusAngle >= 360.0;
+    int nodesPerRow = closed ? config.dimI : config.dimI + 1;
+    int nodesPerSlice = nodesPerRow * (config.dimJ + 1);
+
     for (int k = 0; k <= config.dimK; ++k) {
         for (int j = 0; j <= config.dimJ; ++j) {
-            for (int i = 0; i <= config.dimI; ++i) {
+            for (int i = 0; i < nodesPerRow; ++i) {
                 Vector3D pos = computeBentPosition(i, j, k, config);
                 mesh.addNode(Node(nodeId++, pos));
             }
         }
     }
 
-    int nodesPerRow = config.dimI + 1;
-    int nodesPerSlice = nodesPerRow * (config.dimJ + 1);
-
     for (int k = 0; k < config.dimK; ++k) {
         for (int j = 0; j < config.dimJ; ++j) {
             for (int i = 0; i < config.dimI; ++i) {
                 int base = config.startNodeId + i + j * nodesPerRow + k * nodesPerSlice;
+                int next = (closed && i + 1 == config.dimI) ? 1 - config.dimI : 1;
                 std::array<int, 8> nodes = {
-                    base, base + 1, base + 1 + nodesPerRow, base + nodesPerRow,
-                    base + nodesPerSlice, base + 1 + nodesPerSlice,
-                    base + 1 + nodesPerRow + nodesPerSlice, base + nodesPerRow + nodesPerSlice
+                    base, base + next, base + next + nodesPerRow, base + nodesPerRow,
+                    base + nodesPerSlice, base + next + nodesPerSlice,
+                    base + next + nodesPerRow + nodesPerSlice, base + nodesPerRow + nodesPerSlice
                 };
                 Element elem(elemId++, config.partId, nodes);
                 elem.i = i; elem.j = j; elem.k = k;
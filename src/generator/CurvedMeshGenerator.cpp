@@ -1,8 +1,15 @@
 #include "generator/CurvedMeshGenerator.h"
+#include "generator/VariableDensityMeshGenerator.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <limits>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 namespace KooRemapper {
 
 CurvedMeshGenerator::CurvedMeshGenerator()
@@ -28,10 +35,26 @@ Mesh CurvedMeshGenerator::generate(
     reportProgress(5);
     
     // Setup curve interpolator
-    curve_.setControlPoints(config.centerlinePoints);
-    curve_.setInterpolationType(config.interpolation);
+    const bool space = config.isSpaceCurve();
+    const bool assembly = config.isAssembly();
+    segments_.clear();
+    if (assembly) {
+        spaceCurve_ = SpaceCurveInterpolator();
+        layoutSegments(config, 1.0);
+    } else if (space) {
+        spaceCurve_.setInterpolationType(config.interpolation);
+        spaceCurve_.setControlPoints(config.spaceCenterlinePoints);
+    } else {
+        spaceCurve_ = SpaceCurveInterpolator();
+        curve_.setControlPoints(config.centerlinePoints);
+        curve_.setInterpolationType(config.interpolation);
+    }
     
-    double originalArcLength = curve_.getArcLength();
+    auto currentArcLength = [&]() {
+        if (assembly) return segments_.back().arcStart + segments_.back().length;
+        return space ? spaceCurve_.getArcLength() : curve_.getArcLength();
+    };
+    double originalArcLength = currentArcLength();
     
     // Determine scale factor and dimensions
     double scaleFactor = 1.0;
@@ -41,7 +64,13 @@ Mesh CurvedMeshGenerator::generate(
     if (refArcLength > 0) {
         // Scale curve to match reference arc length
         scaleFactor = refArcLength / originalArcLength;
-        curve_.scale(scaleFactor);
+        if (assembly) {
+            layoutSegments(config, scaleFactor);
+        } else if (space) {
+            spaceCurve_.scale(scaleFactor);
+        } else {
+            curve_.scale(scaleFactor);
+        }
     }
     
     if (refWidth > 0) {
@@ -57,7 +86,7 @@ Mesh CurvedMeshGenerator::generate(
     analyzeCurve();
     
     // Store stats
-    stats_.arcLength = curve_.getArcLength();
+    stats_.arcLength = currentArcLength();
     stats_.scaleFactor = scaleFactor;
     stats_.width = width;
     stats_.thickness = thickness;
@@ -68,20 +97,67 @@ Mesh CurvedMeshGenerator::generate(
     // Generate mesh
     Mesh mesh;
     
-    int ni = config.elementsAlongCurve + 1;  // Nodes along curve
+    const int elementsAlong = config.getElementsAlongCurve();
+    int ni = elementsAlong + 1;               // Nodes along curve
     int nj = config.elementsWidth + 1;        // Nodes in width direction
     int nk = config.elementsThickness + 1;    // Nodes in thickness direction
     
-    // Precompute positions along curve (arc length parameterized)
-    std::vector<Vector2D> curvePositions(ni);
-    std::vector<Vector2D> curveTangents(ni);
-    std::vector<Vector2D> curveNormals(ni);
+    std::vector<Station> stations = computeStations(config, stats_.arcLength);
+    stats_.minElementLength = std::numeric_limits<double>::max();
+    stats_.maxElementLength = 0;
+    for (int i = 1; i < ni; ++i) {
+        double ds = stations[i].arcLength - stations[i - 1].arcLength;
+        stats_.minElementLength = std::min(stats_.minElementLength, ds);
+        stats_.maxElementLength = std::max(stats_.maxElementLength, ds);
+    }
     
-    for (int i = 0; i < ni; ++i) {
-        double s = (static_cast<double>(i) / (ni - 1)) * stats_.arcLength;
-        curvePositions[i] = curve_.evaluateAtArcLength(s);
-        curveTangents[i] = curve_.evaluateTangentAtArcLength(s).normalized();
-        curveNormals[i] = curveTangents[i].perpendicular();
+    // Precompute the cross-section frame at each station (arc length
+    // parameterized): origin, width direction and thickness direction
+    std::vector<Vector2D> curvePositions;
+    std::vector<Vector2D> curveNormals;
+    std::vector<CurveFrame> frames;
+    
+    if (space) {
+        // Frame table fine enough for the shortest station spacing
+        double perStation = stats_.minElementLength > 0
+            ? std::ceil(stats_.arcLength / stats_.minElementLength) : elementsAlong;
+        double samples = std::clamp(FRAME_SAMPLES_PER_ELEMENT * perStation,
+                                    static_cast<double>(MIN_FRAME_SAMPLES),
+                                    static_cast<double>(MAX_FRAME_SAMPLES));
+        spaceCurve_.buildFrames(config.widthDirection, static_cast<int>(samples));
+        frames.resize(ni);
+        ThreadPool::instance().parallelFor(frames.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                frames[i] = spaceCurve_.frameAtArcLength(stations[i].arcLength);
+            }
+        });
+    } else if (assembly) {
+        // Each segment fills its own slice; the end station belongs to the
+        // next segment (it is that segment's start), except for the last
+        curvePositions.resize(ni);
+        curveNormals.resize(ni);
+        ThreadPool::instance().parallelFor(segments_.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; ++n) {
+                const SegmentLayout& segment = segments_[n];
+                int count = segment.elements + (n + 1 == segments_.size() ? 1 : 0);
+                for (int m = 0; m < count; ++m) {
+                    int i = segment.firstStation + m;
+                    Vector2D tangent;
+                    evaluateSegment(segment, stations[i].arcLength - segment.arcStart,
+                                    curvePositions[i], tangent);
+                    curveNormals[i] = tangent.perpendicular();
+                }
+            }
+        }, 1);
+    } else {
+        curvePositions.resize(ni);
+        curveNormals.resize(ni);
+        for (int i = 0; i < ni; ++i) {
+            double s = stations[i].arcLength;
+            curvePositions[i] = curve_.evaluateAtArcLength(s);
+            Vector2D tangent = curve_.evaluateTangentAtArcLength(s).normalized();
+            curveNormals[i] = tangent.perpendicular();
+        }
     }
     
     reportProgress(20);
@@ -89,38 +165,46 @@ Mesh CurvedMeshGenerator::generate(
     // Create nodes
     // Standard structured grid ordering: K -> J -> I (outer to inner)
     // This matches the expected ordering for the mapper
-    // Coordinate system at each curve point:
+    // Coordinate system at each planar curve point:
     // - X: curve position X + normal * thickness offset
     // - Y: width direction (out of plane)
     // - Z: curve position Y + normal * thickness offset (curve Y becomes Z)
-    
-    int nodeId = 1;
-    for (int k = 0; k < nk; ++k) {
-        // Thickness offset (centered)
-        double thicknessRatio = static_cast<double>(k) / (nk - 1) - 0.5;
-        double thicknessOffset = thicknessRatio * thickness;
-        
-        for (int j = 0; j < nj; ++j) {
-            // Width offset (centered)
+    // A 3D curve point moves along its frame's binormal (width) and
+    // normal (thickness) instead.
+    //
+    // Node (i,j,k) gets ID 1 + i + j*ni + k*ni*nj, so the (j,k) rows can be
+    // placed in parallel and inserted in order afterwards.
+    std::vector<Vector3D> positions(static_cast<size_t>(ni) * nj * nk);
+    ThreadPool::instance().parallelFor(static_cast<size_t>(nj) * nk, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            int j = static_cast<int>(row % nj);
+            int k = static_cast<int>(row / nj);
+            
+            // Thickness / width offsets (centered), scaled per station
+            double thicknessRatio = static_cast<double>(k) / (nk - 1) - 0.5;
             double widthRatio = static_cast<double>(j) / (nj - 1) - 0.5;
-            double y = widthRatio * width;
             
+            Vector3D* out = &positions[row * ni];
             for (int i = 0; i < ni; ++i) {
-                const Vector2D& pos = curvePositions[i];
-                const Vector2D& normal = curveNormals[i];
-                
-                // Position along normal direction
-                double x = pos.x + normal.x * thicknessOffset;
-                double z = pos.y + normal.y * thicknessOffset;
-                
-                mesh.addNode(nodeId++, x, y, z);
+                double thicknessOffset = thicknessRatio * thickness * stations[i].thicknessScale;
+                double y = widthRatio * width * stations[i].widthScale;
+                if (space) {
+                    const CurveFrame& f = frames[i];
+                    out[i] = f.position + f.binormal * y + f.normal * thicknessOffset;
+                } else {
+                    const Vector2D& pos = curvePositions[i];
+                    const Vector2D& normal = curveNormals[i];
+                    out[i] = Vector3D(pos.x + normal.x * thicknessOffset, y,
+                                      pos.y + normal.y * thicknessOffset);
+                }
             }
         }
-        
-        if (progressCallback_ && k % 2 == 0) {
-            int progress = 20 + (50 * k / nk);
-            reportProgress(progress);
-        }
+    }, 1);
+    
+    reportProgress(50);
+    
+    for (size_t n = 0; n < positions.size(); ++n) {
+        mesh.addNode(static_cast<int>(n) + 1, positions[n].x, positions[n].y, positions[n].z);
     }
     
     reportProgress(70);
@@ -130,7 +214,7 @@ Mesh CurvedMeshGenerator::generate(
     int elemId = 1;
     for (int k = 0; k < config.elementsThickness; ++k) {
         for (int j = 0; j < config.elementsWidth; ++j) {
-            for (int i = 0; i < config.elementsAlongCurve; ++i) {
+            for (int i = 0; i < elementsAlong; ++i) {
                 // HEX8 node indices (LS-DYNA convention)
                 // Face at i: nodes n1-n4
                 // Face at i+1: nodes n5-n8
@@ -171,7 +255,7 @@ Mesh CurvedMeshGenerator::generate(
     stats_.totalNodes = static_cast<int>(mesh.getNodeCount());
     
     // Set grid dimensions
-    mesh.setGridDimensions(config.elementsAlongCurve, 
+    mesh.setGridDimensions(elementsAlong, 
                            config.elementsWidth, 
                            config.elementsThickness);
     
@@ -186,7 +270,154 @@ Mesh CurvedMeshGenerator::generate(
     return mesh;
 }
 
+void CurvedMeshGenerator::layoutSegments(const CurvedMeshConfig& config, double scaleFactor) {
+    segments_.clear();
+    segments_.reserve(config.segments.size());
+    
+    Vector2D point(0, 0);
+    double heading = 0;
+    double arcLength = 0;
+    int station = 0;
+    
+    for (const auto& segment : config.segments) {
+        SegmentLayout layout;
+        layout.type = segment.type;
+        layout.start = point;
+        layout.heading = heading;
+        layout.turn = 0;
+        layout.radius = 0;
+        layout.arcStart = arcLength;
+        layout.firstStation = station;
+        layout.elements = segment.elements;
+        
+        switch (segment.type) {
+            case SegmentType::STRAIGHT:
+                layout.length = segment.length * scaleFactor;
+                break;
+            case SegmentType::ARC:
+                layout.radius = segment.radius * scaleFactor;
+                layout.turn = segment.angle * M_PI / 180.0;
+                layout.length = layout.radius * std::abs(layout.turn);
+                break;
+            case SegmentType::SPLINE: {
+                // Rotate the local points onto the incoming direction
+                double c = std::cos(heading);
+                double s = std::sin(heading);
+                std::vector<Vector2D> points;
+                points.reserve(segment.points.size());
+                for (const auto& p : segment.points) {
+                    Vector2D local = (p - segment.points.front()) * scaleFactor;
+                    points.emplace_back(point.x + local.x * c - local.y * s,
+                                        point.y + local.x * s + local.y * c);
+                }
+                layout.spline.setInterpolationType(config.interpolation);
+                layout.spline.setControlPoints(points);
+                layout.length = layout.spline.getArcLength();
+                break;
+            }
+        }
+        
+        // The next segment continues from the end point and direction
+        Vector2D tangent;
+        evaluateSegment(layout, layout.length, point, tangent);
+        heading = std::atan2(tangent.y, tangent.x);
+        arcLength += layout.length;
+        station += segment.elements;
+        
+        segments_.push_back(std::move(layout));
+    }
+}
+
+void CurvedMeshGenerator::evaluateSegment(const SegmentLayout& segment, double s,
+                                          Vector2D& position, Vector2D& tangent)
+{
+    switch (segment.type) {
+        case SegmentType::STRAIGHT:
+            tangent = Vector2D(std::cos(segment.heading), std::sin(segment.heading));
+            position = segment.start + tangent * s;
+            break;
+        case SegmentType::ARC: {
+            // Center lies on the inside of the turn
+            double side = segment.turn > 0 ? segment.radius : -segment.radius;
+            Vector2D startTangent(std::cos(segment.heading), std::sin(segment.heading));
+            Vector2D center = segment.start + startTangent.perpendicular() * side;
+            double angle = segment.heading + s / side;
+            tangent = Vector2D(std::cos(angle), std::sin(angle));
+            position = center - tangent.perpendicular() * side;
+            break;
+        }
+        case SegmentType::SPLINE:
+            position = segment.spline.evaluateAtArcLength(s);
+            tangent = segment.spline.evaluateTangentAtArcLength(s).normalized();
+            break;
+    }
+}
+
+std::vector<CurvedMeshGenerator::Station> CurvedMeshGenerator::computeStations(
+    const CurvedMeshConfig& config, double arcLength) const
+{
+    const int elementsAlong = config.getElementsAlongCurve();
+    std::vector<Station> stations(static_cast<size_t>(elementsAlong) + 1);
+    
+    if (!segments_.empty()) {
+        // Uniform within each segment
+        for (const auto& segment : segments_) {
+            for (int m = 0; m < segment.elements; ++m) {
+                stations[segment.firstStation + m].arcLength =
+                    segment.arcStart + (static_cast<double>(m) / segment.elements) * segment.length;
+            }
+        }
+        stations.back().arcLength = arcLength;
+    } else if (config.hasDensityZones()) {
+        std::vector<double> positions =
+            VariableDensityMeshGenerator::computeStations(config.densityZones, arcLength);
+        for (size_t i = 0; i < stations.size(); ++i) {
+            stations[i].arcLength = std::min(positions[i], arcLength);
+        }
+        stations.back().arcLength = arcLength;
+    } else {
+        for (int i = 0; i <= elementsAlong; ++i) {
+            stations[i].arcLength = (static_cast<double>(i) / elementsAlong) * arcLength;
+        }
+    }
+    
+    // Cross-section scales, linear between profile entries and constant
+    // beyond the first / last one
+    const auto& profile = config.crossSectionProfile;
+    for (auto& station : stations) {
+        station.widthScale = 1.0;
+        station.thicknessScale = 1.0;
+        if (profile.empty()) continue;
+        
+        double u = arcLength > 0 ? station.arcLength / arcLength : 0.0;
+        auto next = std::upper_bound(profile.begin(), profile.end(), u,
+            [](double value, const CrossSectionStation& p) { return value < p.position; });
+        if (next == profile.begin()) {
+            station.widthScale = profile.front().widthScale;
+            station.thicknessScale = profile.front().thicknessScale;
+        } else if (next == profile.end()) {
+            station.widthScale = profile.back().widthScale;
+            station.thicknessScale = profile.back().thicknessScale;
+        } else {
+            const CrossSectionStation& a = *(next - 1);
+            const CrossSectionStation& b = *next;
+            double w = (u - a.position) / (b.position - a.position);
+            station.widthScale = a.widthScale + (b.widthScale - a.widthScale) * w;
+            station.thicknessScale = a.thicknessScale + (b.thicknessScale - a.thicknessScale) * w;
+        }
+    }
+    
+    return stations;
+}
+
 double CurvedMeshGenerator::computeCurvature(double t) const {
+    if (spaceCurve_.getPointCount() > 0) {
+        return spaceCurve_.curvature(t);
+    }
+    return planarCurvature(curve_, t);
+}
+
+double CurvedMeshGenerator::planarCurvature(const CurveInterpolator& curve, double t) {
     // Curvature = |x'y'' - y'x''| / (x'^2 + y'^2)^(3/2)
     // For simplicity, use numerical differentiation
     
@@ -194,9 +425,9 @@ double CurvedMeshGenerator::computeCurvature(double t) const {
     double t0 = std::max(0.0, t - h);
     double t1 = std::min(1.0, t + h);
     
-    Vector2D p0 = curve_.evaluate(t0);
-    Vector2D p1 = curve_.evaluate(t);
-    Vector2D p2 = curve_.evaluate(t1);
+    Vector2D p0 = curve.evaluate(t0);
+    Vector2D p1 = curve.evaluate(t);
+    Vector2D p2 = curve.evaluate(t1);
     
     // First derivative (central difference)
     Vector2D dp = (p2 - p0) / (t1 - t0);
@@ -219,7 +450,33 @@ void CurvedMeshGenerator::analyzeCurve() {
     stats_.minRadius = std::numeric_limits<double>::max();
     
     const int samples = 100;
-    for (int i = 0; i <= samples; ++i) {
+    
+    if (!segments_.empty()) {
+        // Arcs have constant curvature; splines are sampled. The location
+        // is reported as a fraction of the total arc length.
+        const SegmentLayout& last = segments_.back();
+        double total = last.arcStart + last.length;
+        for (const auto& segment : segments_) {
+            if (segment.type == SegmentType::ARC) {
+                double curvature = 1.0 / segment.radius;
+                if (curvature > stats_.maxCurvature) {
+                    stats_.maxCurvature = curvature;
+                    stats_.curvatureAtMax = (segment.arcStart + segment.length / 2) / total;
+                }
+            } else if (segment.type == SegmentType::SPLINE) {
+                for (int i = 0; i <= samples; ++i) {
+                    double t = static_cast<double>(i) / samples;
+                    double curvature = planarCurvature(segment.spline, t);
+                    if (curvature > stats_.maxCurvature) {
+                        stats_.maxCurvature = curvature;
+                        stats_.curvatureAtMax = (segment.arcStart + t * segment.length) / total;
+                    }
+                }
+            }
+        }
+    }
+    
+    for (int i = 0; segments_.empty() && i <= samples; ++i) {
         double t = static_cast<double>(i) / samples;
         double curvature = computeCurvature(t);
         
@@ -0,0 +1,294 @@
+#include "generator/SpaceCurveInterpolator.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace KooRemapper {
+
+namespace {
+
+Vector3D catmullRom(const Vector3D& p0, const Vector3D& p1,
+                    const Vector3D& p2, const Vector3D& p3, double t) {
+    double t2 = t * t;
+    double t3 = t2 * t;
+    return ((p1 * 2) +
+            (p2 - p0) * t +
+            (p0 * 2 - p1 * 5 + p2 * 4 - p3) * t2 +
+            (p1 * 3 - p0 - p2 * 3 + p3) * t3) * 0.5;
+}
+
+Vector3D catmullRomTangent(const Vector3D& p0, const Vector3D& p1,
+                           const Vector3D& p2, const Vector3D& p3, double t) {
+    double t2 = t * t;
+    return ((p2 - p0) +
+            (p0 * 4 - p1 * 10 + p2 * 8 - p3 * 2) * t +
+            (p1 * 9 - p0 * 3 - p2 * 9 + p3 * 3) * t2) * 0.5;
+}
+
+Vector3D catmullRomSecond(const Vector3D& p0, const Vector3D& p1,
+                          const Vector3D& p2, const Vector3D& p3, double t) {
+    return ((p0 * 4 - p1 * 10 + p2 * 8 - p3 * 2) +
+            (p1 * 9 - p0 * 3 - p2 * 9 + p3 * 3) * (2 * t)) * 0.5;
+}
+
+// Component of v normal to the unit vector t, normalized (zero if parallel)
+Vector3D orthogonalTo(const Vector3D& v, const Vector3D& t) {
+    Vector3D r = v - t * v.dot(t);
+    return r.magnitude() > 1e-8 * std::max(v.magnitude(), 1.0) ? r.normalized() : Vector3D();
+}
+
+} // anonymous namespace
+
+SpaceCurveInterpolator::SpaceCurveInterpolator()
+    : interpolationType_(InterpolationType::CATMULL_ROM)
+    , totalArcLength_(0)
+{}
+
+void SpaceCurveInterpolator::setControlPoints(const std::vector<Vector3D>& points) {
+    if (points.size() < 2) {
+        throw std::runtime_error("Curve requires at least 2 control points");
+    }
+    controlPoints_ = points;
+    recomputeArcLength();
+}
+
+void SpaceCurveInterpolator::recomputeArcLength() {
+    arcLengthTable_.clear();
+    parameterTable_.clear();
+    frames_.clear();
+    totalArcLength_ = 0;
+
+    if (controlPoints_.size() < 2) {
+        return;
+    }
+
+    const int segments = static_cast<int>(controlPoints_.size()) - 1;
+    const int samples = std::max(ARC_LENGTH_SAMPLES, SAMPLES_PER_SEGMENT * segments);
+    arcLengthTable_.reserve(samples + 1);
+    parameterTable_.reserve(samples + 1);
+
+    double cumLength = 0;
+    Vector3D prevPoint = evaluate(0);
+    arcLengthTable_.push_back(0);
+    parameterTable_.push_back(0);
+
+    for (int i = 1; i <= samples; ++i) {
+        double t = static_cast<double>(i) / samples;
+        Vector3D currPoint = evaluate(t);
+        cumLength += (currPoint - prevPoint).magnitude();
+        arcLengthTable_.push_back(cumLength);
+        parameterTable_.push_back(t);
+        prevPoint = currPoint;
+    }
+
+    totalArcLength_ = cumLength;
+}
+
+void SpaceCurveInterpolator::getSegmentAndLocalT(double t, int& segment, double& localT) const {
+    int numSegments = static_cast<int>(controlPoints_.size()) - 1;
+    double scaledT = std::clamp(t, 0.0, 1.0) * numSegments;
+    segment = static_cast<int>(scaledT);
+    if (segment >= numSegments) {
+        segment = numSegments - 1;
+        localT = 1.0;
+    } else {
+        localT = scaledT - segment;
+    }
+}
+
+void SpaceCurveInterpolator::getSegmentPoints(int segment, Vector3D& p0, Vector3D& p1,
+                                              Vector3D& p2, Vector3D& p3) const {
+    int n = static_cast<int>(controlPoints_.size());
+    p1 = controlPoints_[segment];
+    p2 = controlPoints_[segment + 1];
+    // Extrapolated end points as in CurveInterpolator
+    p0 = (segment == 0) ? p1 * 2 - p2 : controlPoints_[segment - 1];
+    p3 = (segment + 2 >= n) ? p2 * 2 - p1 : controlPoints_[segment + 2];
+}
+
+Vector3D SpaceCurveInterpolator::evaluate(double t) const {
+    if (controlPoints_.size() < 2) {
+        return Vector3D();
+    }
+
+    int segment;
+    double localT;
+    getSegmentAndLocalT(t, segment, localT);
+
+    if (interpolationType_ == InterpolationType::LINEAR) {
+        const Vector3D& p1 = controlPoints_[segment];
+        const Vector3D& p2 = controlPoints_[segment + 1];
+        return p1 + (p2 - p1) * localT;
+    }
+
+    // CATMULL_ROM, and BSPLINE as in CurveInterpolator
+    Vector3D p0, p1, p2, p3;
+    getSegmentPoints(segment, p0, p1, p2, p3);
+    return catmullRom(p0, p1, p2, p3, localT);
+}
+
+Vector3D SpaceCurveInterpolator::evaluateTangent(double t) const {
+    if (controlPoints_.size() < 2) {
+        return Vector3D(1, 0, 0);
+    }
+
+    int segment;
+    double localT;
+    getSegmentAndLocalT(t, segment, localT);
+    int numSegments = static_cast<int>(controlPoints_.size()) - 1;
+
+    if (interpolationType_ == InterpolationType::LINEAR) {
+        return (controlPoints_[segment + 1] - controlPoints_[segment]) * numSegments;
+    }
+
+    Vector3D p0, p1, p2, p3;
+    getSegmentPoints(segment, p0, p1, p2, p3);
+    return catmullRomTangent(p0, p1, p2, p3, localT) * numSegments;
+}
+
+double SpaceCurveInterpolator::curvature(double t) const {
+    if (controlPoints_.size() < 2 || interpolationType_ == InterpolationType::LINEAR) {
+        return 0;
+    }
+
+    int segment;
+    double localT;
+    getSegmentAndLocalT(t, segment, localT);
+    double numSegments = static_cast<double>(controlPoints_.size() - 1);
+
+    Vector3D p0, p1, p2, p3;
+    getSegmentPoints(segment, p0, p1, p2, p3);
+    Vector3D d1 = catmullRomTangent(p0, p1, p2, p3, localT) * numSegments;
+    Vector3D d2 = catmullRomSecond(p0, p1, p2, p3, localT) * (numSegments * numSegments);
+
+    double speed = d1.magnitude();
+    if (speed < 1e-12) return 0;
+    return d1.cross(d2).magnitude() / (speed * speed * speed);
+}
+
+double SpaceCurveInterpolator::parameterAtArcLength(double s) const {
+    if (totalArcLength_ <= 0 || arcLengthTable_.empty()) {
+        return 0;
+    }
+
+    s = std::clamp(s, 0.0, totalArcLength_);
+    auto it = std::lower_bound(arcLengthTable_.begin(), arcLengthTable_.end(), s);
+    if (it == arcLengthTable_.begin()) {
+        return 0;
+    }
+    if (it == arcLengthTable_.end()) {
+        return 1;
+    }
+
+    size_t idx = std::distance(arcLengthTable_.begin(), it);
+    double s0 = arcLengthTable_[idx - 1];
+    double s1 = arcLengthTable_[idx];
+    double t0 = parameterTable_[idx - 1];
+    double t1 = parameterTable_[idx];
+    if (s1 - s0 < 1e-10) {
+        return t0;
+    }
+    return t0 + (t1 - t0) * ((s - s0) / (s1 - s0));
+}
+
+Vector3D SpaceCurveInterpolator::evaluateAtArcLength(double s) const {
+    return evaluate(parameterAtArcLength(s));
+}
+
+void SpaceCurveInterpolator::scale(double factor) {
+    for (auto& pt : controlPoints_) {
+        pt *= factor;
+    }
+    recomputeArcLength();
+}
+
+void SpaceCurveInterpolator::buildFrames(const Vector3D& startBinormal, int samples) {
+    samples = std::max(samples, 1);
+    frames_.assign(static_cast<size_t>(samples) + 1, CurveFrame());
+
+    // Positions and tangents are independent per station
+    const double length = totalArcLength_;
+    ThreadPool::instance().parallelFor(frames_.size(), [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            CurveFrame& f = frames_[m];
+            f.arcLength = length * static_cast<double>(m) / samples;
+            double t = parameterAtArcLength(f.arcLength);
+            f.position = evaluate(t);
+            f.tangent = evaluateTangent(t).normalized();
+        }
+    });
+
+    // Degenerate (zero-speed) tangents inherit their predecessor's
+    for (size_t m = 0; m < frames_.size(); ++m) {
+        if (frames_[m].tangent.magnitude() == 0) {
+            frames_[m].tangent = m > 0 ? frames_[m - 1].tangent : Vector3D(1, 0, 0);
+        }
+    }
+
+    Vector3D binormal = orthogonalTo(startBinormal, frames_[0].tangent);
+    if (binormal.magnitude() == 0) binormal = orthogonalTo(Vector3D(0, 1, 0), frames_[0].tangent);
+    if (binormal.magnitude() == 0) binormal = orthogonalTo(Vector3D(0, 0, 1), frames_[0].tangent);
+    frames_[0].binormal = binormal;
+
+    // Double reflection: reflect frame m across the bisector plane of the
+    // chord, then across the plane that maps the reflected tangent onto
+    // the tangent at m + 1
+    for (size_t m = 0; m + 1 < frames_.size(); ++m) {
+        const CurveFrame& a = frames_[m];
+        CurveFrame& b = frames_[m + 1];
+
+        Vector3D r = a.binormal;
+        Vector3D t = a.tangent;
+        Vector3D v1 = b.position - a.position;
+        double c1 = v1.dot(v1);
+        if (c1 > 0) {
+            r = r - v1 * (2.0 / c1 * v1.dot(r));
+            t = t - v1 * (2.0 / c1 * v1.dot(t));
+        }
+        Vector3D v2 = b.tangent - t;
+        double c2 = v2.dot(v2);
+        if (c2 > 0) {
+            r = r - v2 * (2.0 / c2 * v2.dot(r));
+        }
+
+        // Keep the frame orthonormal against round-off drift
+        Vector3D fixed = orthogonalTo(r, b.tangent);
+        b.binormal = fixed.magnitude() > 0 ? fixed : a.binormal;
+    }
+
+    for (auto& f : frames_) {
+        f.normal = f.tangent.cross(f.binormal);
+    }
+}
+
+CurveFrame SpaceCurveInterpolator::frameAtArcLength(double s) const {
+    CurveFrame frame;
+    frame.arcLength = std::clamp(s, 0.0, totalArcLength_);
+
+    double t = parameterAtArcLength(frame.arcLength);
+    frame.position = evaluate(t);
+    frame.tangent = evaluateTangent(t).normalized();
+
+    if (frames_.empty()) {
+        return frame;
+    }
+
+    // Stations are evenly spaced in arc length
+    const size_t last = frames_.size() - 1;
+    double x = totalArcLength_ > 0 ? frame.arcLength / totalArcLength_ * last : 0.0;
+    size_t m = std::min(static_cast<size_t>(x), last > 0 ? last - 1 : 0);
+    double w = last > 0 ? x - static_cast<double>(m) : 0.0;
+    const CurveFrame& a = frames_[m];
+    const CurveFrame& b = frames_[std::min(m + 1, last)];
+
+    if (frame.tangent.magnitude() == 0) {
+        frame.tangent = a.tangent;
+    }
+    Vector3D binormal = orthogonalTo(a.binormal * (1 - w) + b.binormal * w, frame.tangent);
+    frame.binormal = binormal.magnitude() > 0 ? binormal : a.binormal;
+    frame.normal = frame.tangent.cross(frame.binormal);
+    return frame;
+}
+
+} // namespace KooRemapper
@@ -35,7 +35,7 @@ Mesh VariableDensityMeshGenerator::generate(
     reportProgress(5);
     
     // Compute X coordinates (this auto-scales to match refLengthI)
-    std::vector<double> xCoords = computeXCoordinates(config, refLengthI);
+    std::vector<double> xCoords = computeStations(config, refLengthI);
     
     // Calculate actual zone lengths from coordinates
     // We need to trace through the coordinates to get zone boundaries
@@ -99,7 +99,7 @@ Mesh VariableDensityMeshGenerator::generate(
     return mesh;
 }
 
-std::vector<double> VariableDensityMeshGenerator::computeXCoordinates(
+std::vector<double> VariableDensityMeshGenerator::computeStations(
     const VariableDensityConfig& config,
     double targetLength)
 {
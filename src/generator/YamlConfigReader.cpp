@@ -62,6 +62,7 @@ YamlConfigReader::ParsedLine YamlConfigReader::parseLine(const std::string& line
     result.isEmpty = true;
     result.isListItem = false;
     result.listIndex = -1;
+    result.valueIndent = 0;
     
     if (line.empty()) return result;
     
@@ -89,6 +90,17 @@ YamlConfigReader::ParsedLine YamlConfigReader::parseLine(const std::string& line
         } else {
             result.value = trim(content.substr(1));  // "- [x,y]" -> "[x,y]"
         }
+        result.valueIndent = static_cast<int>(line.find(result.value, result.indent + 1));
+        
+        // "- key: value" starts a mapping item
+        size_t colonPos = result.value.find(':');
+        if (colonPos != std::string::npos && colonPos > 0 &&
+            (colonPos + 1 == result.value.size() || result.value[colonPos + 1] == ' ') &&
+            result.value.find_first_of(" [\"'") > colonPos) {
+            ParsedLine entry = parseLine(result.value);
+            result.key = entry.key;
+            result.value = entry.value;
+        }
         return result;
     }
     
@@ -152,8 +164,18 @@ YamlConfigReader::YamlNode YamlConfigReader::parseYaml(const std::string& conten
             std::string key = std::to_string(listCounter++);
             
             YamlNode& newNode = parent->children[key];
-            newNode.value = parsed.value;
-            // List items typically don't have children in our use case
+            if (parsed.key.empty()) {
+                newNode.value = parsed.value;
+            } else {
+                // Mapping item: its first key, then the following keys
+                // indented to the same column
+                nodeStack.push_back({parsed.indent, &newNode, 0});
+                YamlNode& entry = newNode.children[parsed.key];
+                entry.value = parsed.value;
+                if (parsed.value.empty()) {
+                    nodeStack.push_back({parsed.valueIndent, &entry, 0});
+                }
+            }
         } else {
             // Regular key-value pair
             YamlNode& newNode = parent->children[parsed.key];
@@ -195,6 +217,14 @@ ZoneConfig YamlConfigReader::parseZoneConfig(const YamlNode* node) {
     return config;
 }
 
+void YamlConfigReader::parseDensityZones(const YamlNode& node, VariableDensityConfig& config) {
+    config.zone1_denseStart = parseZoneConfig(node.getChild("zone1_dense_start"));
+    config.zone2_increasing = parseZoneConfig(node.getChild("zone2_increasing"));
+    config.zone3_sparse = parseZoneConfig(node.getChild("zone3_sparse"));
+    config.zone4_decreasing = parseZoneConfig(node.getChild("zone4_decreasing"));
+    config.zone5_denseEnd = parseZoneConfig(node.getChild("zone5_dense_end"));
+}
+
 VariableDensityConfig YamlConfigReader::nodeToConfig(const YamlNode& root) {
     VariableDensityConfig config;
     
@@ -226,11 +256,7 @@ VariableDensityConfig YamlConfigReader::nodeToConfig(const YamlNode& root) {
     
     // Parse variable density zones
     if (auto* vd = root.getChild("variable_density")) {
-        config.zone1_denseStart = parseZoneConfig(vd->getChild("zone1_dense_start"));
-        config.zone2_increasing = parseZoneConfig(vd->getChild("zone2_increasing"));
-        config.zone3_sparse = parseZoneConfig(vd->getChild("zone3_sparse"));
-        config.zone4_decreasing = parseZoneConfig(vd->getChild("zone4_decreasing"));
-        config.zone5_denseEnd = parseZoneConfig(vd->getChild("zone5_dense_end"));
+        parseDensityZones(*vd, config);
     }
     
     // Parse options
@@ -284,68 +310,120 @@ InterpolationType YamlConfigReader::parseInterpolationType(const std::string& st
     return InterpolationType::CATMULL_ROM;  // Default
 }
 
-Vector2D YamlConfigReader::parsePoint(const std::string& str) {
-    // Parse "[x, y]" or "x, y" format
+std::vector<double> YamlConfigReader::parseNumberList(const std::string& str) {
+    // Parse "[x, y, ...]" or "x, y, ..." format
     std::string s = trim(str);
     
     // Remove brackets if present
     if (!s.empty() && s.front() == '[') s = s.substr(1);
     if (!s.empty() && s.back() == ']') s.pop_back();
     
-    // Find comma
-    size_t commaPos = s.find(',');
-    if (commaPos == std::string::npos) {
-        return Vector2D(0, 0);
+    std::vector<double> values;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        double value = 0;
+        try {
+            value = std::stod(trim(item));
+        } catch (...) {}
+        values.push_back(value);
     }
-    
-    std::string xStr = trim(s.substr(0, commaPos));
-    std::string yStr = trim(s.substr(commaPos + 1));
-    
-    double x = 0, y = 0;
-    try {
-        x = std::stod(xStr);
-        y = std::stod(yStr);
-    } catch (...) {}
-    
-    return Vector2D(x, y);
+    return values;
 }
 
-std::vector<Vector2D> YamlConfigReader::parseCenterlinePoints(const YamlNode* node) {
-    std::vector<Vector2D> points;
-    if (!node) return points;
+void YamlConfigReader::parseCenterlinePoints(const YamlNode* node, CurvedMeshConfig& config) {
+    config.centerlinePoints.clear();
+    config.spaceCenterlinePoints.clear();
+    if (!node) return;
     
     // Points are stored as children with numeric keys (from list parsing)
     // or as a single value with multiple lines
     
     // Check for child nodes (list items become children)
-    if (!node->children.empty()) {
-        // Collect all numeric-keyed children and sort them
-        std::vector<std::pair<int, Vector2D>> indexedPoints;
-        
-        for (const auto& [key, child] : node->children) {
-            try {
-                int idx = std::stoi(key);
-                Vector2D pt = parsePoint(child.value);
-                indexedPoints.push_back({idx, pt});
-            } catch (...) {
-                // Non-numeric key, try to parse value
-                Vector2D pt = parsePoint(child.value);
-                if (pt.x != 0 || pt.y != 0) {
-                    indexedPoints.push_back({static_cast<int>(indexedPoints.size()), pt});
-                }
+    if (node->children.empty()) return;
+    
+    // Collect all numeric-keyed children and sort them
+    std::vector<std::pair<int, std::vector<double>>> indexedPoints;
+    
+    for (const auto& [key, child] : node->children) {
+        std::vector<double> pt = parseNumberList(child.value);
+        try {
+            int idx = std::stoi(key);
+            indexedPoints.push_back({idx, pt});
+        } catch (...) {
+            // Non-numeric key, keep non-zero points only
+            bool nonZero = std::any_of(pt.begin(), pt.end(), [](double v) { return v != 0; });
+            if (nonZero) {
+                indexedPoints.push_back({static_cast<int>(indexedPoints.size()), pt});
             }
         }
+    }
+    
+    // Sort by index
+    std::sort(indexedPoints.begin(), indexedPoints.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    // [x, y] points make a planar centerline, [x, y, z] points a 3D one
+    bool space = std::any_of(indexedPoints.begin(), indexedPoints.end(),
+        [](const auto& p) { return p.second.size() == 3; });
+    
+    for (const auto& [idx, pt] : indexedPoints) {
+        if (space && pt.size() == 3) {
+            config.spaceCenterlinePoints.emplace_back(pt[0], pt[1], pt[2]);
+        } else if (!space && pt.size() == 2) {
+            config.centerlinePoints.emplace_back(pt[0], pt[1]);
+        } else if (!space && pt.size() < 2) {
+            config.centerlinePoints.emplace_back(0, 0);
+        } else {
+            throw std::runtime_error("Centerline points must be all [x, y] or all [x, y, z]");
+        }
+    }
+}
+
+void YamlConfigReader::parseSegments(const YamlNode& node, CurvedMeshConfig& config) {
+    std::vector<std::pair<int, const YamlNode*>> items;
+    for (const auto& [key, child] : node.children) {
+        try {
+            items.push_back({std::stoi(key), &child});
+        } catch (...) {}
+    }
+    std::sort(items.begin(), items.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    for (const auto& [idx, item] : items) {
+        CenterlineSegment segment;
+        std::string type;
+        if (auto* t = item->getChild("type")) {
+            type = t->asString();
+            std::transform(type.begin(), type.end(), type.begin(), ::tolower);
+        }
         
-        // Sort by index
-        std::sort(indexedPoints.begin(), indexedPoints.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
+        if (type == "straight" || type == "line") {
+            segment.type = SegmentType::STRAIGHT;
+        } else if (type == "arc") {
+            segment.type = SegmentType::ARC;
+        } else if (type == "spline") {
+            segment.type = SegmentType::SPLINE;
+        } else {
+            throw std::runtime_error("Segment " + std::to_string(idx + 1) +
+                                     ": unknown type '" + type + "' (straight, arc, spline)");
+        }
         
-        for (const auto& [idx, pt] : indexedPoints) {
-            points.push_back(pt);
+        if (auto* v = item->getChild("length")) segment.length = v->asDouble();
+        if (auto* v = item->getChild("radius")) segment.radius = v->asDouble();
+        if (auto* v = item->getChild("angle")) segment.angle = v->asDouble();
+        if (auto* v = item->getChild("elements")) segment.elements = v->asInt(1);
+        if (auto* pts = item->getChild("points")) {
+            CurvedMeshConfig points;
+            parseCenterlinePoints(pts, points);
+            if (points.isSpaceCurve()) {
+                throw std::runtime_error("Segment " + std::to_string(idx + 1) +
+                                         ": spline points must be [x, y]");
+            }
+            segment.points = points.centerlinePoints;
         }
+        config.segments.push_back(segment);
     }
-    
-    return points;
 }
 
 CurvedMeshConfig YamlConfigReader::parseCurvedConfig(const YamlNode& root) {
@@ -353,7 +431,20 @@ CurvedMeshConfig YamlConfigReader::parseCurvedConfig(const YamlNode& root) {
     
     // Parse centerline points
     if (auto* pts = root.getChild("centerline_points")) {
-        config.centerlinePoints = parseCenterlinePoints(pts);
+        parseCenterlinePoints(pts, config);
+    }
+    
+    // Multi-segment centerline
+    if (auto* segs = root.getChild("segments")) {
+        parseSegments(*segs, config);
+    }
+    
+    // Start of the width direction for 3D centerlines
+    if (auto* dir = root.getChild("width_direction")) {
+        std::vector<double> d = parseNumberList(dir->asString());
+        if (d.size() == 3) {
+            config.widthDirection = Vector3D(d[0], d[1], d[2]);
+        }
     }
     
     // Parse interpolation type
@@ -371,6 +462,30 @@ CurvedMeshConfig YamlConfigReader::parseCurvedConfig(const YamlNode& root) {
         }
     }
     
+    // Scale of the cross-section along the curve
+    if (auto* profile = root.getChild("cross_section_profile")) {
+        std::vector<std::pair<int, std::vector<double>>> entries;
+        for (const auto& [key, child] : profile->children) {
+            try {
+                entries.push_back({std::stoi(key), parseNumberList(child.value)});
+            } catch (...) {}
+        }
+        std::sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [idx, v] : entries) {
+            if (v.size() != 3) {
+                throw std::runtime_error(
+                    "Cross-section profile entries must be [position, width_scale, thickness_scale]");
+            }
+            config.crossSectionProfile.emplace_back(v[0], v[1], v[2]);
+        }
+    }
+    
+    // Density zones along the curve (replace elements_along_curve)
+    if (auto* vd = root.getChild("variable_density")) {
+        parseDensityZones(*vd, config.densityZones);
+    }
+    
     // Parse element counts
     if (auto* e = root.getChild("elements_along_curve")) {
         config.elementsAlongCurve = e->asInt(10);
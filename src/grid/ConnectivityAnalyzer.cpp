@@ -111,12 +111,14 @@ void ConnectivityAnalyzer::validateStructuredGrid(const Mesh& mesh) {
     }
 
     // For a valid structured grid:
-    // - Should have exactly 8 corner elements
+    // - Should have exactly 8 corner elements, or none when the grid
+    //   closes on itself (the indexer determines the periodic direction)
     // - Number of edge, face, interior elements depends on dimensions
-    if (cornerCount == 8) {
+    if (cornerCount == 8 || cornerCount == 0) {
         isStructured_ = true;
     } else {
-        errorMessage_ = "Expected 8 corner elements, found " + std::to_string(cornerCount);
+        errorMessage_ = "Expected 8 corner elements (or none for a closed grid), found " +
+                        std::to_string(cornerCount);
         isStructured_ = false;
     }
 }
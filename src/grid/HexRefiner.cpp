@@ -0,0 +1,316 @@
+#include "grid/HexRefiner.h"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+
+namespace KooRemapper {
+
+namespace {
+
+// Corner of the parent hex at local coordinates (x, y, z) in {0, 1}
+int cornerIndex(int x, int y, int z) {
+    static const int bottom[2][2] = {{0, 3}, {1, 2}};  // [x][y]
+    return z * 4 + bottom[x][y];
+}
+
+std::uint64_t pairKey(int a, int b) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) |
+           static_cast<std::uint32_t>(b);
+}
+
+Vector3D trilinear(const std::array<Vector3D, 8>& c, double u, double v, double w) {
+    Vector3D bottom = (c[0] * (1 - u) + c[1] * u) * (1 - v) + (c[3] * (1 - u) + c[2] * u) * v;
+    Vector3D top = (c[4] * (1 - u) + c[5] * u) * (1 - v) + (c[7] * (1 - u) + c[6] * u) * v;
+    return bottom * (1 - w) + top * w;
+}
+
+} // anonymous namespace
+
+HexRefiner::HexRefiner()
+    : levels_{{1, 1, 1}}
+    , firstNewId_(0)
+{}
+
+bool HexRefiner::parseLevels(const std::string& text, std::array<int, 3>& levels,
+                             std::string& error) {
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        try {
+            size_t used = 0;
+            int value = std::stoi(item, &used);
+            if (used != item.size() || value < 1) throw std::invalid_argument(item);
+            values.push_back(value);
+        } catch (const std::exception&) {
+            values.clear();
+            break;
+        }
+    }
+
+    if (values.size() == 1) {
+        levels = {{values[0], values[0], values[0]}};
+    } else if (values.size() == 3) {
+        levels = {{values[0], values[1], values[2]}};
+    } else {
+        error = "Invalid --refine value '" + text + "' (expected n or i,j,k with factors >= 1)";
+        return false;
+    }
+    return true;
+}
+
+bool HexRefiner::build(const Mesh& mesh, const std::array<int, 3>& levels) {
+    errorMessage_.clear();
+    levels_ = levels;
+    parents_.clear();
+    interiorFirstId_.clear();
+    edges_.clear();
+    faces_.clear();
+    nodeIds_.clear();
+    positions_.clear();
+    originalIndex_.clear();
+
+    for (const auto& [id, elem] : mesh.elements) {
+        if (elem.type != ElementType::HEX8) {
+            errorMessage_ = "Refinement needs HEX8 elements (element " + std::to_string(id) +
+                            " is not)";
+            return false;
+        }
+        for (int n : elem.nodeIds) {
+            if (!mesh.hasNode(n)) {
+                errorMessage_ = "Element " + std::to_string(id) + " references missing node " +
+                                std::to_string(n);
+                return false;
+            }
+        }
+        parents_.push_back(&elem);
+    }
+
+    // Every shared edge must get the same number of divisions from all its
+    // elements (faces follow from their edges), else the result would have
+    // hanging nodes
+    std::unordered_map<std::uint64_t, int> edgeDivisions;
+    for (const Element* elem : parents_) {
+        for (int d = 0; d < 3; ++d) {
+            for (int s = 0; s < 4; ++s) {
+                int lo[3], hi[3];
+                int other = 0;
+                for (int e = 0; e < 3; ++e) {
+                    lo[e] = hi[e] = (e == d) ? 0 : ((s >> other++) & 1);
+                }
+                hi[d] = 1;
+                int p0 = elem->nodeIds[cornerIndex(lo[0], lo[1], lo[2])];
+                int p1 = elem->nodeIds[cornerIndex(hi[0], hi[1], hi[2])];
+                std::uint64_t key = p0 < p1 ? pairKey(p0, p1) : pairKey(p1, p0);
+                auto result = edgeDivisions.emplace(key, levels_[d]);
+                if (!result.second && result.first->second != levels_[d]) {
+                    errorMessage_ = "Element " + std::to_string(elem->id) +
+                                    " would divide a shared edge differently from its "
+                                    "neighbour (use the same factor on all axes)";
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Original nodes first, then new ones as they are created
+    int maxId = 0;
+    for (const auto& [id, node] : mesh.nodes) {
+        originalIndex_[id] = nodeIds_.size();
+        nodeIds_.push_back(id);
+        positions_.push_back(node.position);
+        maxId = std::max(maxId, id);
+    }
+    firstNewId_ = maxId + 1;
+
+    const size_t originalCount = nodeIds_.size();
+    long long nextId = firstNewId_;
+    auto allocate = [&](long long count) {
+        int first = static_cast<int>(nextId);
+        nextId += count;
+        positions_.resize(originalCount + static_cast<size_t>(nextId - firstNewId_));
+        return first;
+    };
+
+    const int* r = levels_.data();
+    const long long interiorCount = static_cast<long long>(r[0] - 1) * (r[1] - 1) * (r[2] - 1);
+    interiorFirstId_.resize(parents_.size());
+
+    for (size_t p = 0; p < parents_.size(); ++p) {
+        const Element& elem = *parents_[p];
+        std::array<Vector3D, 8> corners;
+        for (int n = 0; n < 8; ++n) {
+            corners[n] = mesh.getNode(elem.nodeIds[n])->position;
+        }
+
+        // Nodes numbered from here on are created (and placed) by this parent
+        const long long ownFirst = nextId;
+        interiorFirstId_[p] = allocate(interiorCount);
+
+        for (int c = 0; c <= r[2]; ++c) {
+            for (int b = 0; b <= r[1]; ++b) {
+                for (int a = 0; a <= r[0]; ++a) {
+                    LatticeNode node = classify(elem, a, b, c);
+                    if (node.kind == LatticeNode::EDGE || node.kind == LatticeNode::FACE) {
+                        auto& blocks = node.kind == LatticeNode::EDGE ? edges_ : faces_;
+                        auto it = blocks.find(node.key);
+                        if (it == blocks.end()) {
+                            long long count = node.kind == LatticeNode::EDGE
+                                ? node.countA - 1
+                                : static_cast<long long>(node.countA - 1) * (node.countB - 1);
+                            blocks.emplace(node.key, allocate(count));
+                        }
+                    }
+                    if (nextId - 1 > static_cast<long long>(INT_MAX)) {
+                        errorMessage_ = "Refined mesh exceeds the node ID range";
+                        return false;
+                    }
+
+                    int id = resolve(node, p);
+                    if (id >= ownFirst) {
+                        size_t index = originalCount + static_cast<size_t>(id - firstNewId_);
+                        positions_[index] = trilinear(corners,
+                                                      static_cast<double>(a) / r[0],
+                                                      static_cast<double>(b) / r[1],
+                                                      static_cast<double>(c) / r[2]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (long long id = firstNewId_; id < nextId; ++id) {
+        nodeIds_.push_back(static_cast<int>(id));
+    }
+    return true;
+}
+
+long long HexRefiner::indexOf(int nodeId) const {
+    if (nodeId >= firstNewId_) {
+        long long index = static_cast<long long>(originalIndex_.size()) + (nodeId - firstNewId_);
+        return index < static_cast<long long>(nodeIds_.size()) ? index : -1;
+    }
+    auto it = originalIndex_.find(nodeId);
+    return it != originalIndex_.end() ? static_cast<long long>(it->second) : -1;
+}
+
+HexRefiner::LatticeNode HexRefiner::classify(const Element& elem, int a, int b, int c) const {
+    const int* r = levels_.data();
+    const int t[3] = {a, b, c};
+    bool on[3];
+    int onCount = 0;
+    for (int d = 0; d < 3; ++d) {
+        on[d] = (t[d] == 0 || t[d] == r[d]);
+        onCount += on[d] ? 1 : 0;
+    }
+    auto side = [&](int d) { return t[d] == 0 ? 0 : 1; };
+    auto corner = [&](const int xyz[3]) { return elem.nodeIds[cornerIndex(xyz[0], xyz[1], xyz[2])]; };
+
+    LatticeNode node{LatticeNode::CORNER, 0, 0, 0, 1, 1};
+    if (onCount == 3) {
+        const int xyz[3] = {side(0), side(1), side(2)};
+        node.id = corner(xyz);
+    } else if (onCount == 2) {
+        // Edge along the free axis d, counted from its lower corner ID
+        int d = !on[0] ? 0 : (!on[1] ? 1 : 2);
+        int lo[3] = {side(0), side(1), side(2)};
+        int hi[3] = {side(0), side(1), side(2)};
+        lo[d] = 0;
+        hi[d] = 1;
+        int p0 = corner(lo);
+        int p1 = corner(hi);
+        node.kind = LatticeNode::EDGE;
+        node.key = p0 < p1 ? pairKey(p0, p1) : pairKey(p1, p0);
+        node.offset = (p0 < p1 ? t[d] : r[d] - t[d]) - 1;
+        node.countA = r[d];
+    } else if (onCount == 1) {
+        // Face normal to axis f, free axes x1 < x2
+        int f = on[0] ? 0 : (on[1] ? 1 : 2);
+        int x1 = f == 0 ? 1 : 0;
+        int x2 = f == 2 ? 1 : 2;
+        int C[2][2];
+        for (int s1 = 0; s1 < 2; ++s1) {
+            for (int s2 = 0; s2 < 2; ++s2) {
+                int xyz[3];
+                xyz[f] = side(f);
+                xyz[x1] = s1;
+                xyz[x2] = s2;
+                C[s1][s2] = corner(xyz);
+            }
+        }
+        // Canonical frame: origin at the lowest corner ID, first axis
+        // towards its lower-ID neighbour; keyed by origin and opposite corner
+        int o1 = 0, o2 = 0;
+        for (int s1 = 0; s1 < 2; ++s1) {
+            for (int s2 = 0; s2 < 2; ++s2) {
+                if (C[s1][s2] < C[o1][o2]) {
+                    o1 = s1;
+                    o2 = s2;
+                }
+            }
+        }
+        int u1 = o1 ? r[x1] - t[x1] : t[x1];
+        int u2 = o2 ? r[x2] - t[x2] : t[x2];
+        bool firstIs1 = C[1 - o1][o2] < C[o1][1 - o2];
+        int A = firstIs1 ? u1 : u2;
+        int B = firstIs1 ? u2 : u1;
+        node.kind = LatticeNode::FACE;
+        node.key = pairKey(C[o1][o2], C[1 - o1][1 - o2]);
+        node.countA = firstIs1 ? r[x1] : r[x2];
+        node.countB = firstIs1 ? r[x2] : r[x1];
+        node.offset = (A - 1) * (node.countB - 1) + (B - 1);
+    } else {
+        node.kind = LatticeNode::INTERIOR;
+        node.id = ((c - 1) * (r[1] - 1) + (b - 1)) * (r[0] - 1) + (a - 1);
+    }
+    return node;
+}
+
+int HexRefiner::resolve(const LatticeNode& node, size_t parent) const {
+    switch (node.kind) {
+        case LatticeNode::CORNER:
+            return node.id;
+        case LatticeNode::INTERIOR:
+            return interiorFirstId_[parent] + node.id;
+        case LatticeNode::EDGE:
+        case LatticeNode::FACE: {
+            const auto& blocks = node.kind == LatticeNode::EDGE ? edges_ : faces_;
+            auto it = blocks.find(node.key);
+            return it != blocks.end() ? it->second + node.offset : -1;
+        }
+    }
+    return -1;
+}
+
+void HexRefiner::forEachElement(const ElementVisitor& visitor) const {
+    const int ri = levels_[0], rj = levels_[1], rk = levels_[2];
+    const int ni = ri + 1, nj = rj + 1;
+    std::vector<int> ids(static_cast<size_t>(ni) * nj * (rk + 1));
+    auto at = [&](int a, int b, int c) { return ids[(static_cast<size_t>(c) * nj + b) * ni + a]; };
+    int nextElementId = 1;
+
+    for (size_t p = 0; p < parents_.size(); ++p) {
+        const Element& elem = *parents_[p];
+        for (int c = 0; c <= rk; ++c) {
+            for (int b = 0; b <= rj; ++b) {
+                for (int a = 0; a <= ri; ++a) {
+                    ids[(static_cast<size_t>(c) * nj + b) * ni + a] = resolve(classify(elem, a, b, c), p);
+                }
+            }
+        }
+
+        for (int c = 0; c < rk; ++c) {
+            for (int b = 0; b < rj; ++b) {
+                for (int a = 0; a < ri; ++a) {
+                    Element sub(nextElementId++, elem.partId, {{
+                        at(a, b, c), at(a + 1, b, c), at(a + 1, b + 1, c), at(a, b + 1, c),
+                        at(a, b, c + 1), at(a + 1, b, c + 1), at(a + 1, b + 1, c + 1), at(a, b + 1, c + 1)
+                    }});
+                    visitor(sub);
+                }
+            }
+        }
+    }
+}
+
+} // namespace KooRemapper
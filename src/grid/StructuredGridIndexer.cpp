@@ -9,6 +9,8 @@ namespace KooRemapper {
 StructuredGridIndexer::StructuredGridIndexer()
     : dimI_(0), dimJ_(0), dimK_(0)
 {
+    periodic_.fill(false);
+
     // Default axis-to-face mapping:
     // Face 0,1 -> i-axis (i-, i+)
     // Face 2,3 -> j-axis (j-, j+)
@@ -22,6 +24,7 @@ bool StructuredGridIndexer::assignIndices(Mesh& mesh,
                                           const ConnectivityAnalyzer& connectivity) {
     errorMessage_.clear();
     dimI_ = dimJ_ = dimK_ = 0;
+    periodic_.fill(false);
 
     if (mesh.elements.empty()) {
         errorMessage_ = "Mesh has no elements";
@@ -40,6 +43,7 @@ bool StructuredGridIndexer::assignIndices(Mesh& mesh,
     if (allAssigned) {
         // Use existing indices - just calculate dimensions
         calculateDimensions(mesh);
+        detectPeriodicAxes(mesh, connectivity);
         mesh.setGridDimensions(dimI_, dimJ_, dimK_);
         return true;
     }
@@ -50,16 +54,23 @@ bool StructuredGridIndexer::assignIndices(Mesh& mesh,
         elem.indexAssigned = false;
     }
 
-    // Find starting corner
+    // Find starting corner; a grid closed along some axis has none, and
+    // any element can start it
     int startElem = findStartCorner(mesh, connectivity);
-    if (startElem < 0) {
-        errorMessage_ = "Cannot find corner element to start indexing";
-        return false;
-    }
-
-    // Determine initial directions
-    if (!determineInitialDirections(mesh, startElem, connectivity)) {
-        return false;
+    if (startElem >= 0) {
+        // Determine initial directions
+        if (!determineInitialDirections(mesh, startElem, connectivity)) {
+            return false;
+        }
+    } else {
+        startElem = mesh.elements.begin()->first;
+        for (int axis = 0; axis < 3; ++axis) {
+            periodic_[axis] = findRingLength(mesh, startElem, axis, connectivity) > 0;
+        }
+        if (!periodic_[0] && !periodic_[1] && !periodic_[2]) {
+            errorMessage_ = "Cannot find corner element to start indexing";
+            return false;
+        }
     }
 
     // Propagate indices via BFS
@@ -134,8 +145,64 @@ bool StructuredGridIndexer::determineInitialDirections(const Mesh& mesh, int sta
     return true;
 }
 
+int StructuredGridIndexer::findRingLength(const Mesh& mesh, int startElem, int axis,
+                                          const ConnectivityAnalyzer& connectivity) const {
+    // Walk through the positive face of the axis; a structured ring returns
+    // to the start after as many steps as it has elements
+    const int positiveFace = axis * 2 + 1;
+    const int maxSteps = static_cast<int>(mesh.elements.size());
+    int current = startElem;
+    for (int steps = 1; steps <= maxSteps; ++steps) {
+        int next = -1;
+        for (const auto& neighbor : connectivity.getNeighbors(current)) {
+            if (neighbor.throughFace == positiveFace) {
+                next = neighbor.neighborElementId;
+                break;
+            }
+        }
+        if (next < 0) {
+            return 0;
+        }
+        if (next == startElem) {
+            return steps;
+        }
+        current = next;
+    }
+    return 0;
+}
+
+void StructuredGridIndexer::detectPeriodicAxes(const Mesh& mesh,
+                                               const ConnectivityAnalyzer& connectivity) {
+    const std::array<int, 3> dims = {dimI_, dimJ_, dimK_};
+    for (const auto& [id, elem] : mesh.elements) {
+        const std::array<int, 3> idx = {elem.i, elem.j, elem.k};
+        for (const auto& neighbor : connectivity.getNeighbors(id)) {
+            const Element* other = mesh.getElement(neighbor.neighborElementId);
+            if (!other) continue;
+            const std::array<int, 3> otherIdx = {other->i, other->j, other->k};
+            for (int axis = 0; axis < 3; ++axis) {
+                // Two elements (dim 2) are adjacent either way; a ring needs 3
+                if (dims[axis] >= 3 && idx[axis] == 0 && otherIdx[axis] == dims[axis] - 1 &&
+                    idx[(axis + 1) % 3] == otherIdx[(axis + 1) % 3] &&
+                    idx[(axis + 2) % 3] == otherIdx[(axis + 2) % 3]) {
+                    periodic_[axis] = true;
+                }
+            }
+        }
+    }
+}
+
 bool StructuredGridIndexer::propagateIndices(Mesh& mesh, int startElem,
                                              const ConnectivityAnalyzer& connectivity) {
+    // Ring lengths of periodic axes; indices along them wrap modulo the
+    // length so that the seam lies at the start element
+    std::array<int, 3> ringLength = {0, 0, 0};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (periodic_[axis]) {
+            ringLength[axis] = findRingLength(mesh, startElem, axis, connectivity);
+        }
+    }
+
     // BFS queue: (element ID, i, j, k)
     std::queue<std::tuple<int, int, int, int>> queue;
 
@@ -159,7 +226,7 @@ bool StructuredGridIndexer::propagateIndices(Mesh& mesh, int startElem,
 
         for (const auto& neighbor : neighbors) {
             Element* neighborElem = mesh.getElement(neighbor.neighborElementId);
-            if (!neighborElem || neighborElem->indexAssigned) {
+            if (!neighborElem) {
                 continue;
             }
 
@@ -168,11 +235,22 @@ bool StructuredGridIndexer::propagateIndices(Mesh& mesh, int startElem,
             int axis = face / 2;      // 0=i, 1=j, 2=k
             int dir = (face % 2 == 0) ? -1 : 1;  // even=negative, odd=positive
 
-            int ni = i, nj = j, nk = k;
-            switch (axis) {
-                case 0: ni += dir; break;
-                case 1: nj += dir; break;
-                case 2: nk += dir; break;
+            std::array<int, 3> idx = {i, j, k};
+            idx[axis] += dir;
+            if (ringLength[axis] > 0) {
+                idx[axis] = (idx[axis] + ringLength[axis]) % ringLength[axis];
+            }
+            int ni = idx[0], nj = idx[1], nk = idx[2];
+
+            if (neighborElem->indexAssigned) {
+                // Around a ring the BFS meets already indexed elements
+                if (ringLength[axis] > 0 &&
+                    (neighborElem->i != ni || neighborElem->j != nj || neighborElem->k != nk)) {
+                    errorMessage_ = "Inconsistent structured indices at element " +
+                                    std::to_string(neighbor.neighborElementId);
+                    return false;
+                }
+                continue;
             }
 
             neighborElem->setGridIndex(ni, nj, nk);
@@ -189,7 +267,7 @@ bool StructuredGridIndexer::propagateIndices(Mesh& mesh, int startElem,
         }
     }
 
-    // Normalize indices to start from 0
+    // Normalize indices to start from 0 (periodic axes already do)
     int minI = 0, minJ = 0, minK = 0;
     for (const auto& [id, elem] : mesh.elements) {
         minI = std::min(minI, elem.i);
@@ -247,6 +325,11 @@ void StructuredGridIndexer::reorderAxes(Mesh& mesh) {
         elem.k = oldIdx[perm[2]];
     }
 
+    std::array<bool, 3> oldPeriodic = periodic_;
+    for (int i = 0; i < 3; ++i) {
+        periodic_[i] = oldPeriodic[perm[i]];
+    }
+
     // Update dimensions
     dimI_ = dims[0].first;
     dimJ_ = dims[1].first;
@@ -271,6 +354,7 @@ void StructuredGridIndexer::swapAxes(Mesh& mesh, int axis1, int axis2) {
         elem.j = idx[1];
         elem.k = idx[2];
     }
+    std::swap(periodic_[axis1], periodic_[axis2]);
 
     if (axis1 == 0 || axis2 == 0) {
         if (axis1 == 1 || axis2 == 1) {
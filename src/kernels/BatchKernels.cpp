@@ -0,0 +1,271 @@
+// Compiled once per ISA level with KOOREMAPPER_KERNEL_NS set to the level
+// name (see CMakeLists.txt). Only plain arrays and the ISA-specific pack
+// types may be used here: an inline function shared with the rest of the
+// library could otherwise be emitted with instructions the CPU lacks.
+#include "kernels/BatchKernels.h"
+#include "core/SimdMath.h"
+#include <cmath>
+
+#ifndef KOOREMAPPER_KERNEL_NS
+#error "KOOREMAPPER_KERNEL_NS must name the ISA level of this build"
+#endif
+
+namespace KooRemapper {
+namespace Kernels {
+namespace KOOREMAPPER_KERNEL_NS {
+
+namespace {
+
+const size_t W = SimdDouble::WIDTH;
+
+// std::max(0.0, std::min(1.0, t)), including its handling of -0.0
+double clampUnit(double t) {
+    double upper = (t < 1.0) ? t : 1.0;
+    return (0.0 < upper) ? upper : 0.0;
+}
+
+// Parameter of a closed edge as EdgeInterpolator wraps it
+double wrapUnit(double t) {
+    return (t < 0.0 || t > 1.0) ? t - std::floor(t) : t;
+}
+
+// Segment endpoints and local parameter of EdgeInterpolator::interpolate(t)
+void edgeSegment(const EdgePolyline& edge, double t, const double*& a,
+                 const double*& b, double& localT) {
+    static const double ZERO[3] = {0.0, 0.0, 0.0};
+    localT = 0.0;
+    if (edge.count == 0) {
+        a = b = ZERO;
+        return;
+    }
+    const double* last = edge.points + 3 * (edge.count - 1);
+    if (edge.count == 1 || t <= 0.0) {
+        a = b = edge.points;
+        return;
+    }
+    if (t >= 1.0) {
+        a = b = last;
+        return;
+    }
+
+    // First i >= 1 with arcLengths[i] >= target (std::lower_bound)
+    double target = t * edge.totalLength;
+    size_t lo = 1, hi = edge.count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (edge.arcLengths[mid] < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    size_t idx = (lo == edge.count) ? edge.count - 2 : lo - 1;
+
+    double segmentLength = edge.arcLengths[idx + 1] - edge.arcLengths[idx];
+    localT = (segmentLength > 0) ? (target - edge.arcLengths[idx]) / segmentLength : 0.0;
+    a = edge.points + 3 * idx;
+    b = a + 3;
+}
+
+// Point of EdgeInterpolator::interpolate(t) on a CUBIC edge
+void edgeCubicPoint(const EdgePolyline& edge, double t, double* out) {
+    const double* p = edge.points;
+    if (edge.count == 1 || t <= 0.0) {
+        out[0] = p[0]; out[1] = p[1]; out[2] = p[2];
+        return;
+    }
+    if (t >= 1.0) {
+        p += 3 * (edge.count - 1);
+        out[0] = p[0]; out[1] = p[1]; out[2] = p[2];
+        return;
+    }
+
+    // Table step (std::lower_bound), then s linear in arc length within it
+    const size_t entries = edge.cubicSamples * (edge.count - 1) + 1;
+    double target = t * edge.totalLength;
+    size_t lo = 1, hi = entries;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (edge.cubicLengths[mid] < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    size_t step = (lo == entries) ? entries - 2 : lo - 1;
+
+    double subLength = edge.cubicLengths[step + 1] - edge.cubicLengths[step];
+    double f = (subLength > 0) ? (target - edge.cubicLengths[step]) / subLength : 0.0;
+    double s = (static_cast<double>(step % edge.cubicSamples) + f) /
+               static_cast<double>(edge.cubicSamples);
+
+    // ((d*s + c)*s + b)*s + a
+    const double* c = edge.cubic + 12 * (step / edge.cubicSamples);
+    for (int k = 0; k < 3; ++k) {
+        out[k] = ((c[9 + k] * s + c[6 + k]) * s + c[3 + k]) * s + c[k];
+    }
+}
+
+Vec3Pack loadLanes(const double (&x)[SimdDouble::WIDTH], const double (&y)[SimdDouble::WIDTH],
+                   const double (&z)[SimdDouble::WIDTH]) {
+    return Vec3Pack(SimdDouble::load(x), SimdDouble::load(y), SimdDouble::load(z));
+}
+
+void mapEdgeBlend(const EdgePolyline* edges, const double* uvw, size_t count, double* xyz) {
+    const SimdDouble one(1.0);
+    double u[W], v[W], w[W];
+    double ax[W], ay[W], az[W], bx[W], by[W], bz[W], t[W];
+    double ox[W], oy[W], oz[W];
+
+    for (size_t first = 0; first < count; first += W) {
+        const size_t lanes = (count - first < W) ? count - first : W;
+        for (size_t n = 0; n < W; ++n) {
+            const double* p = uvw + 3 * (first + (n < lanes ? n : 0));
+            u[n] = edges[0].closed ? wrapUnit(p[0]) : clampUnit(p[0]);
+            v[n] = clampUnit(p[1]);
+            w[n] = clampUnit(p[2]);
+        }
+
+        // Point on each i-edge at u: lerp(a, b, t) = a*(1-t) + b*t
+        Vec3Pack onEdge[4];
+        for (int e = 0; e < 4; ++e) {
+            if (edges[e].cubic && edges[e].count > 0) {
+                for (size_t n = 0; n < W; ++n) {
+                    double point[3];
+                    edgeCubicPoint(edges[e], u[n], point);
+                    ax[n] = point[0]; ay[n] = point[1]; az[n] = point[2];
+                }
+                onEdge[e] = loadLanes(ax, ay, az);
+                continue;
+            }
+            for (size_t n = 0; n < W; ++n) {
+                const double* a;
+                const double* b;
+                edgeSegment(edges[e], u[n], a, b, t[n]);
+                ax[n] = a[0]; ay[n] = a[1]; az[n] = a[2];
+                bx[n] = b[0]; by[n] = b[1]; bz[n] = b[2];
+            }
+            SimdDouble localT = SimdDouble::load(t);
+            onEdge[e] = loadLanes(ax, ay, az) * (one - localT) + loadLanes(bx, by, bz) * localT;
+        }
+
+        // Bilinear blend in (v,w), as in ParametricMapper::edgeBasedInterpolate
+        SimdDouble pv = SimdDouble::load(v);
+        SimdDouble pw = SimdDouble::load(w);
+        SimdDouble mv = one - pv;
+        SimdDouble mw = one - pw;
+        Vec3Pack bottom = onEdge[0] * mv + onEdge[1] * pv;
+        Vec3Pack top = onEdge[2] * mv + onEdge[3] * pv;
+        Vec3Pack position = bottom * mw + top * pw;
+
+        position.x.store(ox);
+        position.y.store(oy);
+        position.z.store(oz);
+        for (size_t n = 0; n < lanes; ++n) {
+            double* out = xyz + 3 * (first + n);
+            out[0] = ox[n];
+            out[1] = oy[n];
+            out[2] = oz[n];
+        }
+    }
+}
+
+// Pack of node k of up to W elements (24 doubles per element); unused lanes repeat lane 0
+Vec3Pack loadNode(const double* nodes, size_t first, size_t lanes, int k) {
+    double x[W], y[W], z[W];
+    for (size_t n = 0; n < W; ++n) {
+        const double* p = nodes + 24 * (first + (n < lanes ? n : 0)) + 3 * k;
+        x[n] = p[0];
+        y[n] = p[1];
+        z[n] = p[2];
+    }
+    return loadLanes(x, y, z);
+}
+
+void hex8DeformationGradients(const double* ref, const double* def, size_t count,
+                              const double* dN, double* F, unsigned char* valid) {
+    double values[W];
+    double det[W];
+
+    for (size_t first = 0; first < count; first += W) {
+        const size_t lanes = (count - first < W) ? count - first : W;
+
+        // Jacobian columns dX/dxi_j = sum_k dN_k/dxi_j * X_k
+        // (same order as DeformationGradient::computeJacobianHex8)
+        Vec3Pack refCol[3], defCol[3];
+        for (int k = 0; k < 8; ++k) {
+            Vec3Pack r = loadNode(ref, first, lanes, k);
+            Vec3Pack d = loadNode(def, first, lanes, k);
+            for (int j = 0; j < 3; ++j) {
+                SimdDouble weight(dN[3 * k + j]);
+                refCol[j] += r * weight;
+                defCol[j] += d * weight;
+            }
+        }
+
+        Mat3Pack J_ref = Mat3Pack::fromColumns(refCol[0], refCol[1], refCol[2]);
+        Mat3Pack J_def = Mat3Pack::fromColumns(defCol[0], defCol[1], defCol[2]);
+
+        // F = J_def * J_ref^(-1)
+        SimdDouble detRef;
+        Mat3Pack J_ref_inv = J_ref.inverse(detRef);
+        Mat3Pack result = J_def * J_ref_inv;
+
+        detRef.store(det);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                result.m[i][j].store(values);
+                for (size_t n = 0; n < lanes; ++n) {
+                    F[9 * (first + n) + 3 * i + j] = values[n];
+                }
+            }
+        }
+        for (size_t n = 0; n < lanes; ++n) {
+            bool ok = det[n] >= 1e-14 || det[n] <= -1e-14;
+            valid[first + n] = ok ? 1 : 0;
+            if (!ok) {
+                for (int c = 0; c < 9; ++c) F[9 * (first + n) + c] = 0.0;
+            }
+        }
+    }
+}
+
+void hex8CenterJacobians(const double* corners, size_t count, double* jacobians) {
+    const SimdDouble quarter(0.25);
+    double values[W];
+
+    for (size_t first = 0; first < count; first += W) {
+        const size_t lanes = (count - first < W) ? count - first : W;
+        Vec3Pack c[8];
+        for (int k = 0; k < 8; ++k) {
+            c[k] = loadNode(corners, first, lanes, k);
+        }
+
+        Vec3Pack dxdu = (c[1] + c[2] + c[5] + c[6]) * quarter -
+                        (c[0] + c[3] + c[4] + c[7]) * quarter;
+        Vec3Pack dxdv = (c[2] + c[3] + c[6] + c[7]) * quarter -
+                        (c[0] + c[1] + c[4] + c[5]) * quarter;
+        Vec3Pack dxdw = (c[4] + c[5] + c[6] + c[7]) * quarter -
+                        (c[0] + c[1] + c[2] + c[3]) * quarter;
+
+        dxdu.dot(dxdv.cross(dxdw)).store(values);
+        for (size_t n = 0; n < lanes; ++n) {
+            jacobians[first + n] = values[n];
+        }
+    }
+}
+
+} // anonymous namespace
+
+const KernelTable& table() {
+    static const KernelTable kernels = {
+        mapEdgeBlend,
+        hex8DeformationGradients,
+        hex8CenterJacobians
+    };
+    return kernels;
+}
+
+} // namespace KOOREMAPPER_KERNEL_NS
+} // namespace Kernels
+} // namespace KooRemapper
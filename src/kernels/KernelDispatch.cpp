@@ -0,0 +1,32 @@
+#include "kernels/BatchKernels.h"
+#include "util/CpuFeatures.h"
+
+namespace KooRemapper {
+namespace Kernels {
+
+// One table per compiled ISA variant of BatchKernels.cpp
+namespace baseline { const KernelTable& table(); }
+#ifdef KOOREMAPPER_KERNELS_AVX2
+namespace avx2 { const KernelTable& table(); }
+#endif
+#ifdef KOOREMAPPER_KERNELS_AVX512
+namespace avx512 { const KernelTable& table(); }
+#endif
+
+const KernelTable& active() {
+    switch (CpuFeatures::active()) {
+#ifdef KOOREMAPPER_KERNELS_AVX512
+        case IsaLevel::AVX512:
+            return avx512::table();
+#endif
+#ifdef KOOREMAPPER_KERNELS_AVX2
+        case IsaLevel::AVX2:
+            return avx2::table();
+#endif
+        default:
+            return baseline::table();
+    }
+}
+
+} // namespace Kernels
+} // namespace KooRemapper
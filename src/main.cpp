@@ -3,25 +3,53 @@
 #include "parser/KFileReader.h"
 #include "parser/KFileWriter.h"
 #include "parser/DynainWriter.h"
+#include "parser/AbaqusWriter.h"
+#include "parser/NastranWriter.h"
+#include "parser/ShardWriter.h"
+#include "parser/PointSetIO.h"
+#include "grid/HexRefiner.h"
 #include "mapper/MeshRemapper.h"
 #include "mapper/FlatMeshGenerator.h"
+#include "mapper/PointMapper.h"
 #include "example/ExampleMeshGenerator.h"
 #include "generator/VariableDensityConfig.h"
 #include "generator/YamlConfigReader.h"
 #include "generator/VariableDensityMeshGenerator.h"
 #include "generator/CurvedMeshGenerator.h"
 #include "analysis/StrainCalculator.h"
+#include "analysis/MaterialSweep.h"
 #include "analysis/ElementAnalyzer.h"
 #include "analysis/MaterialModel.h"
+#include "analysis/EquilibriumRelaxer.h"
+#include "analysis/ResidualAnalyzer.h"
+#include "analysis/PrestressState.h"
 #include "cli/ArgumentParser.h"
 #include "cli/ConsoleOutput.h"
 #include "util/Logger.h"
 #include "util/Timer.h"
 #include "util/Validator.h"
+#include "util/ThreadPool.h"
+#include "util/CpuFeatures.h"
+#include "util/AsyncFileWriter.h"
+#include "util/TuningProfile.h"
+#include "util/AutoTuner.h"
+#include "util/Metrics.h"
+#include "kernels/BatchKernels.h"
+#ifdef KOOREMAPPER_WITH_MPI
+#include "parallel/MpiContext.h"
+#include "parallel/DistributedMesh.h"
+#include "parallel/OrderedFileWriter.h"
+#endif
 
 #include <iostream>
 #include <memory>
 #include <limits>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include <thread>
+#include <unordered_set>
 
 using namespace KooRemapper;
 
@@ -34,18 +62,300 @@ constexpr const char* VERSION = "1.0.0";
 void printBanner(const ConsoleOutput& console) {
     console.separator('=', 60);
     console.println("  KooRemapper - Mesh Mapping Tool for LS-DYNA", ConsoleOutput::Color::BRIGHT_CYAN);
-    console.println("  Version " + std::string(VERSION), ConsoleOutput::Color::CYAN);
+    console.println("  Version " + std::string(VERSION) + "  [kernels: " +
+                    CpuFeatures::name(CpuFeatures::active()) + "]", ConsoleOutput::Color::CYAN);
     console.separator('=', 60);
     std::cout << "\n";
 }
 
+/**
+ * Shard selection of a sharded run (--shard k/N)
+ */
+struct ShardSpec {
+    bool active = false;
+    int index = 0;   // 0 <= index < count
+    int count = 1;
+
+    std::string label() const {
+        return std::to_string(index) + "/" + std::to_string(count);
+    }
+};
+
+/**
+ * Parse "k/N" (0-based shard index k)
+ */
+bool parseShard(const std::string& text, ShardSpec& shard, std::string& error) {
+    size_t slash = text.find('/');
+    try {
+        if (slash == std::string::npos) throw std::invalid_argument(text);
+        shard.index = std::stoi(text.substr(0, slash));
+        shard.count = std::stoi(text.substr(slash + 1));
+    } catch (const std::exception&) {
+        error = "Invalid --shard value '" + text + "' (expected k/N)";
+        return false;
+    }
+    if (shard.count < 1 || shard.index < 0 || shard.index >= shard.count) {
+        error = "Invalid --shard value '" + text + "' (need 0 <= k < N)";
+        return false;
+    }
+    shard.active = true;
+    return true;
+}
+
+/**
+ * Parse --edge-interp (linear or cubic)
+ */
+bool parseEdgeInterpolation(const std::string& text, EdgeInterpolation& mode) {
+    if (text.empty() || text == "linear") {
+        mode = EdgeInterpolation::LINEAR;
+    } else if (text == "cubic") {
+        mode = EdgeInterpolation::CUBIC;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Solver format of a mesh or stress output
+ */
+enum class OutputFormat {
+    LSDYNA,         // k-file / dynain
+    ABAQUS,         // .inp (*INITIAL CONDITIONS for stresses)
+    NASTRAN,        // Bulk data, free field
+    NASTRAN_LARGE   // Bulk data, large field
+};
+
+/**
+ * Parse --format (lsdyna, abaqus, nastran, nastran-large); without it the
+ * output extension decides (.inp: Abaqus, .bdf/.nas: Nastran)
+ */
+bool parseOutputFormat(const std::string& text, const std::string& outputFile,
+                       OutputFormat& format) {
+    if (text.empty()) {
+        std::string name = Platform::getFilename(outputFile);
+        size_t dot = name.rfind('.');
+        std::string ext = dot == std::string::npos ? "" : name.substr(dot);
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (ext == ".inp") {
+            format = OutputFormat::ABAQUS;
+        } else if (ext == ".bdf" || ext == ".nas") {
+            format = OutputFormat::NASTRAN;
+        } else {
+            format = OutputFormat::LSDYNA;
+        }
+    } else if (text == "lsdyna") {
+        format = OutputFormat::LSDYNA;
+    } else if (text == "abaqus") {
+        format = OutputFormat::ABAQUS;
+    } else if (text == "nastran") {
+        format = OutputFormat::NASTRAN;
+    } else if (text == "nastran-large") {
+        format = OutputFormat::NASTRAN_LARGE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Write a mesh (mapped positions) in a solver format
+ */
+bool writeMeshFile(const std::string& filename, const Mesh& mesh, OutputFormat format,
+                   std::string& error) {
+    if (format == OutputFormat::ABAQUS) {
+        AbaqusWriter writer;
+        if (!writer.writeFile(filename, mesh, true)) {
+            error = writer.getErrorMessage();
+            return false;
+        }
+    } else if (format == OutputFormat::NASTRAN || format == OutputFormat::NASTRAN_LARGE) {
+        NastranWriter writer;
+        writer.setFieldFormat(format == OutputFormat::NASTRAN_LARGE ? NastranField::LARGE
+                                                                    : NastranField::FREE);
+        if (!writer.writeFile(filename, mesh, true)) {
+            error = writer.getErrorMessage();
+            return false;
+        }
+    } else {
+        KFileWriter writer;
+        if (!writer.writeFile(filename, mesh, true)) {
+            error = writer.getErrorMessage();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Parse strain --type: one of engineering, green, log, a comma-separated
+ * list of them, or "all"
+ */
+bool parseStrainTypes(const std::string& text, std::vector<StrainCalculator::StrainType>& types) {
+    using Type = StrainCalculator::StrainType;
+    types.clear();
+    if (text == "all") {
+        types = {Type::ENGINEERING, Type::GREEN_LAGRANGE, Type::LOGARITHMIC};
+        return true;
+    }
+
+    std::stringstream list(text);
+    std::string name;
+    while (std::getline(list, name, ',')) {
+        if (name == "engineering") {
+            types.push_back(Type::ENGINEERING);
+        } else if (name == "green") {
+            types.push_back(Type::GREEN_LAGRANGE);
+        } else if (name == "log") {
+            types.push_back(Type::LOGARITHMIC);
+        } else {
+            return false;
+        }
+    }
+    return !types.empty();
+}
+
+/**
+ * Load the elements of one shard together with every node they reference
+ *
+ * Elements are split into N contiguous ranges of the *ELEMENT_SOLID data.
+ * If ownedNodes is given it receives the shard's range of the *NODE data,
+ * so that every node belongs to exactly one shard. If bounds are given they
+ * receive the bounding box of all nodes in the file.
+ * @throws std::runtime_error on read errors
+ */
+Mesh loadShardMesh(const std::string& filename, const ShardSpec& shard,
+                   Mesh* ownedNodes = nullptr,
+                   Vector3D* boundsMin = nullptr, Vector3D* boundsMax = nullptr) {
+    KFileReader reader;
+    std::vector<KFileSection> sections = reader.scanSections(filename);
+    Mesh part = reader.readPartition(filename, sections, shard.index, shard.count);
+
+    Mesh mesh;
+    mesh.elements = std::move(part.elements);
+    mesh.parts = std::move(part.parts);
+    mesh.materials = std::move(part.materials);
+
+    std::unordered_set<int> referenced;
+    for (const auto& [id, elem] : mesh.elements) {
+        for (int n : elem.nodeIds) {
+            const Node* node = part.getNode(n);
+            if (node) {
+                mesh.addNode(*node);
+            } else if (n > 0) {
+                referenced.insert(n);
+            }
+        }
+    }
+
+    // One streaming pass over all nodes for the remaining references
+    const double inf = std::numeric_limits<double>::max();
+    Vector3D minB(inf, inf, inf), maxB(-inf, -inf, -inf);
+    bool wantBounds = boundsMin && boundsMax;
+    if (!referenced.empty() || wantBounds) {
+        reader.forEachNode(filename, sections, [&](int id, const Vector3D& p) {
+            if (wantBounds) {
+                minB = Vector3D(std::min(minB.x, p.x), std::min(minB.y, p.y), std::min(minB.z, p.z));
+                maxB = Vector3D(std::max(maxB.x, p.x), std::max(maxB.y, p.y), std::max(maxB.z, p.z));
+            }
+            if (referenced.count(id)) {
+                mesh.addNode(id, p.x, p.y, p.z);
+            }
+        });
+    }
+    if (wantBounds) {
+        *boundsMin = minB;
+        *boundsMax = maxB;
+    }
+
+    if (ownedNodes) {
+        ownedNodes->nodes = std::move(part.nodes);
+    }
+    return mesh;
+}
+
+/**
+ * Load the nodes of mesh from another file with the same node ids
+ * (deformed counterpart of a shard); elements are copied from mesh.
+ * @throws std::runtime_error on read errors
+ */
+Mesh loadShardCounterpart(const std::string& filename, const Mesh& mesh) {
+    KFileReader reader;
+    std::vector<KFileSection> sections = reader.scanSections(filename);
+
+    Mesh result;
+    result.elements = mesh.elements;
+    reader.forEachNode(filename, sections, [&](int id, const Vector3D& p) {
+        if (mesh.hasNode(id)) {
+            result.addNode(id, p.x, p.y, p.z);
+        }
+    });
+    return result;
+}
+
+/**
+ * stdin can be read once: reject more than one "-" among the inputs
+ * before any of them is consumed
+ */
+bool checkStdinInputs(const std::vector<std::string>& inputs, const ConsoleOutput& console) {
+    size_t count = std::count_if(inputs.begin(), inputs.end(),
+                                 [](const std::string& name) { return Platform::isStdStream(name); });
+    if (count > 1) {
+        console.error("Only one input can be read from stdin (\"-\")");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Pre-flight scan of an input k-file before it is parsed in full
+ * Structural errors (truncated file, unparsable records) are reported in
+ * a fraction of the parse time; stdin cannot be scanned ahead.
+ * @return false if the file has errors
+ */
+bool preflightInput(const std::string& filename, const ConsoleOutput& console) {
+    if (Platform::isStdStream(filename)) {
+        return true;
+    }
+    KFilePreflight report = Validator::preflightKFile(filename);
+    for (const auto& warn : report.validation.warnings) {
+        console.warning(Platform::getFilename(filename) + ": " + warn);
+    }
+    if (!report.validation.isValid) {
+        for (const auto& err : report.validation.errors) {
+            console.error(Platform::getFilename(filename) + ": " + err);
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Report a finished shard and how to merge it
+ */
+void reportShardOutput(const std::vector<std::string>& outputs, const ShardSpec& shard,
+                       const ConsoleOutput& console) {
+    console.success("Shard " + shard.label() + " written");
+    console.info("After all " + std::to_string(shard.count) + " shards have finished, run:");
+    for (const auto& output : outputs) {
+        console.println("  KooRemapper merge " + output);
+    }
+}
+
 /**
  * Run the mapping operation
  */
 int runMapping(const std::string& bentFile, const std::string& flatFile,
-               const std::string& outputFile, const ConsoleOutput& console) {
+               const std::string& outputFile, const ShardSpec& shard,
+               EdgeInterpolation edgeInterpolation, OutputFormat format,
+               const ConsoleOutput& console) {
     Timer timer;
 
+    if (!preflightInput(bentFile, console) || !preflightInput(flatFile, console)) {
+        return 1;
+    }
+
     // Load bent mesh
     console.info("Loading bent mesh: " + bentFile);
     KFileReader reader;
@@ -71,11 +381,24 @@ int runMapping(const std::string& bentFile, const std::string& flatFile,
         console.warning(warn);
     }
 
-    // Load flat mesh
-    console.info("Loading flat mesh: " + flatFile);
+    // Load flat mesh (or one shard of it)
     Mesh flatMesh;
+    Mesh ownedNodes;
+    Vector3D flatMin, flatMax;
     try {
-        flatMesh = reader.readFile(flatFile);
+        if (shard.active) {
+            console.info("Loading flat mesh shard " + shard.label() + ": " + flatFile);
+            flatMesh = loadShardMesh(flatFile, shard, &ownedNodes, &flatMin, &flatMax);
+            // Owned nodes outside the shard's elements are mapped here too
+            for (const auto& [id, node] : ownedNodes.nodes) {
+                if (!flatMesh.hasNode(id)) {
+                    flatMesh.addNode(node);
+                }
+            }
+        } else {
+            console.info("Loading flat mesh: " + flatFile);
+            flatMesh = reader.readFile(flatFile);
+        }
     } catch (const std::exception& e) {
         console.error("Failed to load flat mesh: " + std::string(e.what()));
         return 1;
@@ -97,6 +420,10 @@ int runMapping(const std::string& bentFile, const std::string& flatFile,
     MeshRemapper remapper;
     remapper.setBentMesh(&bentMesh);
     remapper.setFlatMesh(&flatMesh);
+    remapper.setEdgeInterpolation(edgeInterpolation);
+    if (shard.active) {
+        remapper.setFlatBounds(flatMin, flatMax);  // Same parametrization in every shard
+    }
 
     // Set progress callback
     remapper.setProgressCallback([&console](int percent) {
@@ -128,12 +455,192 @@ int runMapping(const std::string& bentFile, const std::string& flatFile,
     std::cout << "\n";
 
     // Write output (use mapped positions)
+    KFileWriter writer;
+    if (shard.active) {
+        // Each node is written by the shard owning it
+        Mesh outputMesh;
+        const Mesh& result = remapper.getResult();
+        for (const auto& [id, node] : ownedNodes.nodes) {
+            const Node* mappedNode = result.getNode(id);
+            outputMesh.addNode(mappedNode ? *mappedNode : node);
+        }
+        outputMesh.elements = result.elements;
+
+        console.info("Writing shard output: " + ShardWriter::partialPath(outputFile, shard.index));
+        std::ostringstream head, nodes, elemHead, elems, tail;
+        writer.writeHeader(head);
+        writer.writeNodeKeyword(head);
+        writer.writeNodeLines(nodes, outputMesh, true);
+        writer.writeElementKeyword(elemHead);
+        writer.writeElementLines(elems, outputMesh);
+        writer.writeEnd(tail);
+
+        ShardWriter out;
+        bool ok = out.open(outputFile, shard.index, shard.count) &&
+                  out.writeFirst(head.str()) &&
+                  out.write(nodes.str()) &&
+                  out.writeFirst(elemHead.str()) &&
+                  out.write(elems.str()) &&
+                  out.writeFirst(tail.str()) &&
+                  out.close();
+        if (!ok) {
+            console.error("Failed to write output: " + out.getErrorMessage());
+            return 1;
+        }
+        reportShardOutput({outputFile}, shard, console);
+    } else {
+        console.info("Writing output: " + outputFile);
+        std::string writeError;
+        if (!writeMeshFile(outputFile, remapper.getResult(), format, writeError)) {
+            console.error("Failed to write output: " + writeError);
+            return 1;
+        }
+        console.success("Output written successfully");
+    }
+
+    timer.stop();
+    console.info("Total time: " + timer.elapsedString());
+
+    return 0;
+}
+
+/**
+ * Map an in-memory refinement of the flat mesh (map --refine)
+ *
+ * Every flat hex is subdivided by HexRefiner, the refined nodes go through
+ * the batched mapper and the node/element lines are streamed to the
+ * output; the fine mesh is never written, parsed or held as a Mesh.
+ */
+int runRefinedMapping(const std::string& bentFile, const std::string& flatFile,
+                      const std::string& outputFile, const std::array<int, 3>& levels,
+                      EdgeInterpolation edgeInterpolation, const ConsoleOutput& console) {
+    Timer timer;
+
+    if (!preflightInput(bentFile, console) || !preflightInput(flatFile, console)) {
+        return 1;
+    }
+
+    console.info("Loading bent mesh: " + bentFile);
+    KFileReader reader;
+    Mesh bentMesh;
+    Mesh flatMesh;
+    try {
+        bentMesh = reader.readFile(bentFile);
+        console.info("Loading flat mesh: " + flatFile);
+        flatMesh = reader.readFile(flatFile);
+    } catch (const std::exception& e) {
+        console.error("Failed to load mesh: " + std::string(e.what()));
+        return 1;
+    }
+
+    auto bentValidation = Validator::validateBentMesh(bentMesh);
+    if (!bentValidation.isValid) {
+        for (const auto& err : bentValidation.errors) {
+            console.error(err);
+        }
+        return 1;
+    }
+    auto flatValidation = Validator::validateFlatMesh(flatMesh);
+    if (!flatValidation.isValid) {
+        for (const auto& err : flatValidation.errors) {
+            console.error(err);
+        }
+        return 1;
+    }
+
+    // Same (u,v,w) parametrization as map: the flat bounding box, which
+    // refinement does not change
+    Vector3D flatMin, flatMax;
+    flatMesh.calculateBoundingBox(flatMin, flatMax);
+    PointMapper mapper;
+    mapper.setEdgeInterpolation(edgeInterpolation);
+    console.info("Building parametric mapper...");
+    if (!mapper.build(bentMesh, flatMin, flatMax)) {
+        console.error("Failed to build mapper: " + mapper.getErrorMessage());
+        return 1;
+    }
+
+    std::string label = std::to_string(levels[0]) + "x" + std::to_string(levels[1]) + "x" +
+                        std::to_string(levels[2]);
+    console.info("Refining flat mesh " + label + "...");
+    HexRefiner refiner;
+    if (!refiner.build(flatMesh, levels)) {
+        console.error("Refinement failed: " + refiner.getErrorMessage());
+        return 1;
+    }
+    console.success("Refined to " + std::to_string(refiner.getNodeCount()) + " nodes, " +
+                    std::to_string(refiner.getElementCount()) + " elements");
+
+    std::vector<Vector3D> positions = refiner.getPositions();
+    mapper.mapPoints(positions);
+
+    // Stream the refined mesh out
     console.info("Writing output: " + outputFile);
+    AsyncOutputStream out(outputFile);
+    if (!out.is_open()) {
+        console.error("Failed to write output: Cannot create file: " + outputFile);
+        return 1;
+    }
     KFileWriter writer;
-    if (!writer.writeFile(outputFile, remapper.getResult(), true)) {
-        console.error("Failed to write output: " + writer.getErrorMessage());
+    writer.writeHeader(out);
+    writer.writeNodeKeyword(out);
+    const std::vector<int>& ids = refiner.getNodeIds();
+    for (size_t n = 0; n < ids.size(); ++n) {
+        writer.writeNodeLine(out, ids[n], positions[n]);
+    }
+
+    // Centre Jacobians with the kernel of map's validation step, in
+    // batches gathered while the elements stream out
+    const size_t batchSize = 4096;
+    std::vector<double> corners;
+    std::vector<double> jacobians(batchSize);
+    corners.reserve(batchSize * 24);
+    double minJacobian = std::numeric_limits<double>::max();
+    double maxJacobian = std::numeric_limits<double>::lowest();
+    long long invalid = 0;
+    auto flushJacobians = [&]() {
+        size_t count = corners.size() / 24;
+        Kernels::active().hex8CenterJacobians(corners.data(), count, jacobians.data());
+        for (size_t e = 0; e < count; ++e) {
+            minJacobian = std::min(minJacobian, jacobians[e]);
+            maxJacobian = std::max(maxJacobian, jacobians[e]);
+            if (jacobians[e] <= 0) ++invalid;
+        }
+        corners.clear();
+    };
+
+    writer.writeElementKeyword(out);
+    refiner.forEachElement([&](const Element& elem) {
+        writer.writeElementLine(out, elem);
+
+        for (int i = 0; i < 8; ++i) {
+            const Vector3D& p = positions[static_cast<size_t>(refiner.indexOf(elem.nodeIds[i]))];
+            corners.push_back(p.x);
+            corners.push_back(p.y);
+            corners.push_back(p.z);
+        }
+        if (corners.size() == batchSize * 24) flushJacobians();
+    });
+    flushJacobians();
+    writer.writeEnd(out);
+    if (!out.close()) {
+        console.error("Failed to write output: " + out.getErrorMessage());
         return 1;
     }
+
+    std::cout << "\n";
+    console.header("Mapping Statistics");
+    console.keyValue("Refinement", label);
+    console.keyValue("Nodes processed", std::to_string(refiner.getNodeCount()));
+    console.keyValue("Elements processed", std::to_string(refiner.getElementCount()));
+    if (refiner.getElementCount() > 0) {
+        console.keyValue("Min Jacobian", std::to_string(minJacobian));
+        console.keyValue("Max Jacobian", std::to_string(maxJacobian));
+    }
+    if (invalid > 0) {
+        console.warning("Invalid elements (negative Jacobian): " + std::to_string(invalid));
+    }
+    std::cout << "\n";
     console.success("Output written successfully");
 
     timer.stop();
@@ -258,16 +765,22 @@ int runGenerate(const std::string& type, const std::string& outputPrefix,
  * Calculate strain between two meshes
  */
 int runStrain(const std::string& refFile, const std::string& defFile,
-              const std::string& outputFile, const std::string& strainType,
-              const ConsoleOutput& console) {
+              const std::string& outputFile,
+              const std::vector<StrainCalculator::StrainType>& strainTypes,
+              const ShardSpec& shard, const ConsoleOutput& console) {
     Timer timer;
 
     // Load reference mesh
-    console.info("Loading reference mesh: " + refFile);
     KFileReader reader;
     Mesh refMesh;
     try {
-        refMesh = reader.readFile(refFile);
+        if (shard.active) {
+            console.info("Loading reference mesh shard " + shard.label() + ": " + refFile);
+            refMesh = loadShardMesh(refFile, shard);
+        } else {
+            console.info("Loading reference mesh: " + refFile);
+            refMesh = reader.readFile(refFile);
+        }
     } catch (const std::exception& e) {
         console.error("Failed to load reference mesh: " + std::string(e.what()));
         return 1;
@@ -279,7 +792,8 @@ int runStrain(const std::string& refFile, const std::string& defFile,
     console.info("Loading deformed mesh: " + defFile);
     Mesh defMesh;
     try {
-        defMesh = reader.readFile(defFile);
+        defMesh = shard.active ? loadShardCounterpart(defFile, refMesh)
+                               : reader.readFile(defFile);
     } catch (const std::exception& e) {
         console.error("Failed to load deformed mesh: " + std::string(e.what()));
         return 1;
@@ -292,14 +806,8 @@ int runStrain(const std::string& refFile, const std::string& defFile,
     calc.setReferenceMesh(&refMesh);
     calc.setDeformedMesh(&defMesh);
 
-    // Set strain type
-    if (strainType == "engineering") {
-        calc.setStrainType(StrainCalculator::StrainType::ENGINEERING);
-    } else if (strainType == "green") {
-        calc.setStrainType(StrainCalculator::StrainType::GREEN_LAGRANGE);
-    } else if (strainType == "log") {
-        calc.setStrainType(StrainCalculator::StrainType::LOGARITHMIC);
-    }
+    // Set strain types (several share one pass over the elements)
+    calc.setStrainTypes(strainTypes);
 
     // Calculate strains
     console.info("Calculating strains...");
@@ -310,24 +818,46 @@ int runStrain(const std::string& refFile, const std::string& defFile,
     console.success("Strain calculation completed");
 
     // Get statistics
-    const auto& stats = calc.getStatistics();
-    std::cout << "\n";
-    console.header("Strain Statistics");
-    console.keyValue("Max Von Mises", std::to_string(stats.maxVonMises));
-    console.keyValue("Avg Von Mises", std::to_string(stats.avgVonMises));
-    console.keyValue("Max Volumetric", std::to_string(stats.maxVolumetric));
-    console.keyValue("Min Volumetric", std::to_string(stats.minVolumetric));
-    console.keyValue("Max Principal", std::to_string(stats.maxPrincipal));
-    console.keyValue("Min Principal", std::to_string(stats.minPrincipal));
+    const auto& types = calc.getStrainTypes();
+    for (size_t m = 0; m < types.size(); ++m) {
+        const auto& stats = calc.getStatistics(m);
+        std::cout << "\n";
+        console.header(types.size() == 1 ? std::string("Strain Statistics")
+                       : "Strain Statistics (" + std::string(StrainCalculator::strainTypeName(types[m])) + ")");
+        console.keyValue("Max Von Mises", std::to_string(stats.maxVonMises));
+        console.keyValue("Avg Von Mises", std::to_string(stats.avgVonMises));
+        console.keyValue("Max Volumetric", std::to_string(stats.maxVolumetric));
+        console.keyValue("Min Volumetric", std::to_string(stats.minVolumetric));
+        console.keyValue("Max Principal", std::to_string(stats.maxPrincipal));
+        console.keyValue("Min Principal", std::to_string(stats.minPrincipal));
+    }
     std::cout << "\n";
 
     // Export to CSV
-    console.info("Exporting results: " + outputFile);
-    if (!calc.exportToCSV(outputFile)) {
-        console.error("Failed to export results");
-        return 1;
+    if (shard.active) {
+        console.info("Exporting shard results: " + ShardWriter::partialPath(outputFile, shard.index));
+        std::ostringstream head, rows;
+        calc.writeCSVHeader(head);
+        calc.writeCSVRows(rows);
+
+        ShardWriter out;
+        bool ok = out.open(outputFile, shard.index, shard.count) &&
+                  out.writeFirst(head.str()) &&
+                  out.write(rows.str()) &&
+                  out.close();
+        if (!ok) {
+            console.error("Failed to export results: " + out.getErrorMessage());
+            return 1;
+        }
+        reportShardOutput({outputFile}, shard, console);
+    } else {
+        console.info("Exporting results: " + outputFile);
+        if (!calc.exportToCSV(outputFile)) {
+            console.error("Failed to export results");
+            return 1;
+        }
+        console.success("Results exported successfully");
     }
-    console.success("Results exported successfully");
 
     timer.stop();
     console.info("Total time: " + timer.elapsedString());
@@ -411,23 +941,212 @@ int runUnfold(const std::string& bentFile, const std::string& outputFile,
     return 0;
 }
 
+/**
+ * Options of the prestress command
+ */
+struct PrestressOptions {
+    double E = 0.0;
+    double nu = 0.0;
+    StrainType strainType = StrainType::ENGINEERING;
+    bool outputCSV = false;
+
+    // Equilibrium relaxation
+    bool relax = false;
+    double relaxTolerance = 1e-6;
+    int relaxMaxIterations = 5000;
+
+    // Nodal force residual report
+    bool residual = false;
+    std::string residualFile;
+
+    // Partial run over one element range
+    ShardSpec shard;
+
+    // Saved state of the previous run; only elements touching moved
+    // deformed nodes are recomputed
+    std::string incrementalState;
+
+    // Deformation of the flat -> bent mapping itself (--analytic): def_mesh
+    // is the bent reference and F comes from the mapper's derivatives
+    bool analytic = false;
+    EdgeInterpolation edgeInterpolation = EdgeInterpolation::LINEAR;
+
+    // CSV of (E, nu) sets: one strain pass, one output per set
+    std::string materialSweep;
+
+    // Stress output: dynain or Abaqus initial conditions
+    OutputFormat format = OutputFormat::LSDYNA;
+};
+
+/**
+ * Write the element stresses of a prestress run as dynain or, for
+ * OutputFormat::ABAQUS, as Abaqus *INITIAL CONDITIONS
+ */
+bool writeStressOutput(const std::string& filename, const MeshAnalysisResult& results,
+                       OutputFormat format, StrainType strainType,
+                       const std::string& refFile, const std::string& defFile,
+                       const ConsoleOutput& console) {
+    if (format == OutputFormat::ABAQUS) {
+        console.info("Writing Abaqus initial stress file: " + filename);
+        AbaqusWriter writer;
+        if (!writer.writeStressFile(filename, results, refFile, defFile)) {
+            console.error("Failed to write initial stress file: " + writer.getErrorMessage());
+            return false;
+        }
+        return true;
+    }
+
+    console.info("Writing dynain file: " + filename);
+    DynainWriter writer;
+    writer.setLargeDeformation(strainType == StrainType::GREEN_LAGRANGE);
+    if (!writer.writeFile(filename, results, strainType, refFile, defFile)) {
+        console.error("Failed to write dynain: " + writer.getErrorMessage());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Stresses and outputs of every set of a material sweep
+ * results holds the strains of one strain-only analysis; its stresses are
+ * replaced set by set.
+ */
+int writeMaterialSweep(const MaterialSweep& sweep, MeshAnalysisResult& results,
+                       const std::string& outputFile, const PrestressOptions& options,
+                       const std::string& refFile, const std::string& defLabel,
+                       const ConsoleOutput& console) {
+    DynainWriter writer;
+
+    std::vector<std::string> summary;
+    for (const auto& set : sweep.getSets()) {
+        ElementAnalyzer::applyMaterial(results, set.material());
+
+        std::string file = MaterialSweep::outputPath(outputFile, set);
+        if (!writeStressOutput(file, results, options.format, options.strainType,
+                               refFile, defLabel, console)) {
+            return 1;
+        }
+        if (options.outputCSV) {
+            std::string csvFile = file;
+            size_t dotPos = csvFile.rfind('.');
+            csvFile = (dotPos != std::string::npos ? csvFile.substr(0, dotPos) : csvFile) + ".csv";
+            if (!writer.writeStrainCSV(csvFile, results)) {
+                console.error("Failed to write CSV: " + writer.getErrorMessage());
+                return 1;
+            }
+        }
+
+        std::ostringstream line;
+        line << "E=" << set.E << " nu=" << set.nu
+             << "  von Mises min/max/avg " << results.minVonMisesStress << " / "
+             << results.maxVonMisesStress << " / " << results.avgVonMisesStress;
+        summary.push_back(line.str());
+    }
+
+    std::cout << "\n";
+    console.header("Material Sweep (" + std::to_string(sweep.getSets().size()) + " sets)");
+    for (size_t i = 0; i < summary.size(); ++i) {
+        console.keyValue(sweep.getSets()[i].name, summary[i]);
+    }
+    std::cout << "\n";
+    console.success("Wrote " + std::to_string(summary.size()) + " stress files");
+    return 0;
+}
+
 /**
  * Calculate prestress from deformed configuration
+ * With options.analytic, refFile is the flat mesh and defFile the bent
+ * reference it would be mapped onto; no mapped mesh is built.
  */
 int runPrestress(const std::string& refFile, const std::string& defFile,
-                 const std::string& outputFile, 
-                 double E, double nu,
-                 StrainType strainType,
-                 bool outputCSV,
+                 const std::string& outputFile,
+                 const PrestressOptions& options,
                  const ConsoleOutput& console) {
     Timer timer;
+    const double E = options.E;
+    const double nu = options.nu;
+    const StrainType strainType = options.strainType;
+    const bool outputCSV = options.outputCSV;
+    const ShardSpec& shard = options.shard;
+
+    // Relaxation and the residual need the whole mesh
+    bool relax = options.relax;
+    bool residual = options.residual || !options.residualFile.empty();
+    if (shard.active && (relax || residual)) {
+        console.warning("--relax and --residual need the whole mesh; ignored with --shard");
+        relax = residual = false;
+    }
+
+    // The dynain and its CSV cannot share stdout
+    if (outputCSV && Platform::isStdStream(outputFile)) {
+        console.error("--csv needs a named output file (the dynain goes to stdout)");
+        return 1;
+    }
+
+    // Reused results must stay valid element by element
+    const std::string& stateFile = options.incrementalState;
+    if (!stateFile.empty()) {
+        if (shard.active) {
+            console.error("--incremental cannot be combined with --shard");
+            return 1;
+        }
+        if (relax) {
+            console.error("--incremental cannot be combined with --relax "
+                          "(relaxation changes every element)");
+            return 1;
+        }
+        if (Platform::isStdStream(stateFile)) {
+            console.error("--incremental needs a state file name");
+            return 1;
+        }
+    }
+
+    // The analytic mode has no deformed mesh to relax, check or compare
+    const bool analytic = options.analytic;
+    if (analytic && (shard.active || relax || residual || !stateFile.empty())) {
+        console.error("--analytic cannot be combined with --shard, --relax, --residual "
+                      "or --incremental (they need the mapped mesh)");
+        return 1;
+    }
+
+    // A sweep replaces the material options and writes whole-mesh outputs
+    MaterialSweep sweep;
+    const bool sweeping = !options.materialSweep.empty();
+    if (sweeping) {
+        if (shard.active || relax || residual || !stateFile.empty()) {
+            console.error("--material-sweep cannot be combined with --shard, --relax, "
+                          "--residual or --incremental");
+            return 1;
+        }
+        if (E > 0 || nu > 0) {
+            console.error("--material-sweep replaces --E/--nu; give the materials in the sweep file");
+            return 1;
+        }
+        if (Platform::isStdStream(outputFile)) {
+            console.error("--material-sweep needs a named output file (one file per set)");
+            return 1;
+        }
+        if (!sweep.load(options.materialSweep)) {
+            console.error(sweep.getErrorMessage());
+            return 1;
+        }
+    }
+
+    if (!preflightInput(refFile, console) || !preflightInput(defFile, console)) {
+        return 1;
+    }
 
     // Load reference mesh
-    console.info("Loading reference mesh: " + refFile);
     KFileReader reader;
     Mesh refMesh;
     try {
-        refMesh = reader.readFile(refFile);
+        if (shard.active) {
+            console.info("Loading reference mesh shard " + shard.label() + ": " + refFile);
+            refMesh = loadShardMesh(refFile, shard);
+        } else {
+            console.info("Loading reference mesh: " + refFile);
+            refMesh = reader.readFile(refFile);
+        }
     } catch (const std::exception& e) {
         console.error("Failed to load reference mesh: " + std::string(e.what()));
         return 1;
@@ -445,23 +1164,53 @@ int runPrestress(const std::string& refFile, const std::string& defFile,
         }
     }
 
-    // Load deformed mesh
-    console.info("Loading deformed mesh: " + defFile);
     Mesh defMesh;
-    try {
-        defMesh = reader.readFile(defFile);
-    } catch (const std::exception& e) {
-        console.error("Failed to load deformed mesh: " + std::string(e.what()));
-        return 1;
-    }
-    console.success("Loaded " + std::to_string(defMesh.getNodeCount()) + " nodes, " +
-                   std::to_string(defMesh.getElementCount()) + " elements");
+    PointMapper mapper;
+    if (analytic) {
+        // Mapper of the flat mesh onto the bent reference, as map builds it
+        console.info("Loading bent reference mesh: " + defFile);
+        Mesh bentMesh;
+        try {
+            bentMesh = reader.readFile(defFile);
+        } catch (const std::exception& e) {
+            console.error("Failed to load bent mesh: " + std::string(e.what()));
+            return 1;
+        }
+        auto bentValidation = Validator::validateBentMesh(bentMesh);
+        if (!bentValidation.isValid) {
+            for (const auto& err : bentValidation.errors) {
+                console.error(err);
+            }
+            return 1;
+        }
 
-    // Validate mesh pair
-    std::string validationError;
-    if (!ElementAnalyzer::validateMeshPair(refMesh, defMesh, validationError)) {
-        console.error("Mesh pair validation failed: " + validationError);
-        return 1;
+        Vector3D flatMin, flatMax;
+        refMesh.calculateBoundingBox(flatMin, flatMax);
+        console.info("Building parametric mapper...");
+        mapper.setEdgeInterpolation(options.edgeInterpolation);
+        if (!mapper.build(bentMesh, flatMin, flatMax)) {
+            console.error("Failed to build mapper: " + mapper.getErrorMessage());
+            return 1;
+        }
+    } else {
+        // Load deformed mesh
+        console.info("Loading deformed mesh: " + defFile);
+        try {
+            defMesh = shard.active ? loadShardCounterpart(defFile, refMesh)
+                                   : reader.readFile(defFile);
+        } catch (const std::exception& e) {
+            console.error("Failed to load deformed mesh: " + std::string(e.what()));
+            return 1;
+        }
+        console.success("Loaded " + std::to_string(defMesh.getNodeCount()) + " nodes, " +
+                       std::to_string(defMesh.getElementCount()) + " elements");
+
+        // Validate mesh pair
+        std::string validationError;
+        if (!ElementAnalyzer::validateMeshPair(refMesh, defMesh, validationError)) {
+            console.error("Mesh pair validation failed: " + validationError);
+            return 1;
+        }
     }
 
     // Setup analyzer
@@ -475,7 +1224,13 @@ int runPrestress(const std::string& refFile, const std::string& defFile,
     bool hasKFileMaterial = (refMesh.getMaterialCount() > 0);
     bool hasMaterial = hasCmdLineMaterial || hasKFileMaterial;
     
-    if (hasCmdLineMaterial) {
+    if (sweeping) {
+        // Strains only; every set's stresses follow from them
+        hasMaterial = false;
+        analyzer.setUsePartMaterials(false);
+        console.info("Material sweep: " + std::to_string(sweep.getSets().size()) +
+                     " sets from " + options.materialSweep + " (strains computed once)");
+    } else if (hasCmdLineMaterial) {
         // Command line material overrides K-file materials completely
         MaterialModel material = MaterialModel::isotropicElastic(E, nu);
         analyzer.setMaterial(material);
@@ -487,17 +1242,107 @@ int runPrestress(const std::string& refFile, const std::string& defFile,
     } else if (hasKFileMaterial) {
         analyzer.setUsePartMaterials(true);  // Enable per-part lookup
         console.info("Using materials from K-file (per-part)");
+    } else if (options.format != OutputFormat::LSDYNA) {
+        // Strain-only runs write a CSV, which must not land under .inp
+        console.error("Abaqus stress output needs a material (-E/-nu or *MAT_ELASTIC in the reference)");
+        return 1;
     } else {
         console.info("No material specified, computing strain only");
     }
 
-    // Run analysis with progress
-    MeshAnalysisResult results = analyzer.analyzeMesh(refMesh, defMesh, 
-        [&console](int percent) {
-            console.progressBar(percent);
-        });
-    console.clearLine();
-    console.success("Analysis completed");
+    // Reuse the previous run where the deformed mesh is unchanged
+    MeshAnalysisResult results;
+    bool reused = false;
+    std::uint64_t fingerprint = 0;
+    if (!stateFile.empty()) {
+        std::ostringstream settings;
+        settings.precision(std::numeric_limits<double>::max_digits10);
+        settings << "strain=" << static_cast<int>(strainType);
+        if (hasCmdLineMaterial) {
+            settings << " E=" << E << " nu=" << nu;
+        }
+        fingerprint = PrestressState::fingerprint(refMesh, settings.str());
+
+        PrestressState state;
+        std::vector<size_t> changed;
+        size_t movedNodes = 0;
+        if (!state.load(stateFile)) {
+            console.info("Full analysis: " + state.getErrorMessage());
+        } else if (state.getFingerprint() != fingerprint) {
+            console.info("Full analysis: reference mesh or settings changed since the saved run");
+        } else if (!state.findChangedElements(defMesh, changed, movedNodes)) {
+            console.info("Full analysis: " + state.getErrorMessage());
+        } else {
+            console.info("Incremental analysis: " + std::to_string(movedNodes) + " moved node(s), " +
+                         std::to_string(changed.size()) + " of " +
+                         std::to_string(defMesh.getElementCount()) + " elements to recompute");
+            results = state.takeResults();
+            analyzer.reanalyzeElements(refMesh, defMesh, changed, results);
+            reused = true;
+            console.success("Analysis completed (" +
+                            std::to_string(defMesh.getElementCount() - changed.size()) +
+                            " elements reused)");
+        }
+    }
+
+    if (analytic) {
+        results = analyzer.analyzeMapping(refMesh, mapper,
+            [&console](int percent) {
+                console.progressBar(percent);
+            });
+        console.clearLine();
+        console.success("Analysis completed (analytic deformation gradient)");
+    } else if (!reused) {
+        results = analyzer.analyzeMesh(refMesh, defMesh,
+            [&console](int percent) {
+                console.progressBar(percent);
+            });
+        console.clearLine();
+        console.success("Analysis completed");
+    }
+
+    // Relax the geometric stress to a self-equilibrated field
+    if (relax) {
+        if (!hasMaterial) {
+            console.warning("Relaxation skipped: no material specified");
+        } else {
+            console.info("Relaxing prestress to equilibrium (" +
+                         std::to_string(ThreadPool::instance().threadCount()) + " threads)...");
+            EquilibriumRelaxer relaxer;
+            relaxer.setTolerance(options.relaxTolerance);
+            relaxer.setMaxIterations(options.relaxMaxIterations);
+            if (hasCmdLineMaterial) {
+                relaxer.setMaterial(MaterialModel::isotropicElastic(E, nu));
+                relaxer.setUsePartMaterials(false);
+            }
+
+            Timer relaxTimer;
+            bool ok = relaxer.relax(refMesh, defMesh, results,
+                [&console](int percent) {
+                    console.progressBar(percent);
+                });
+            console.clearLine();
+            if (!ok) {
+                console.error("Relaxation failed: " + relaxer.getErrorMessage());
+                return 1;
+            }
+
+            const RelaxationStats& rs = relaxer.getStats();
+            if (rs.converged) {
+                console.success("Relaxation converged in " + std::to_string(rs.iterations) +
+                                " iterations (" + relaxTimer.elapsedString() + ")");
+            } else {
+                console.warning("Relaxation stopped after " + std::to_string(rs.iterations) +
+                                " iterations without reaching tolerance");
+            }
+            console.keyValue("Initial force residual", std::to_string(rs.initialResidual));
+            console.keyValue("Final force residual", std::to_string(rs.finalResidual));
+            console.keyValue("Max relaxation displacement", std::to_string(rs.maxDisplacement));
+            if (rs.skippedElements > 0) {
+                console.warning("Elements excluded from relaxation: " + std::to_string(rs.skippedElements));
+            }
+        }
+    }
 
     // Print statistics
     std::cout << "\n";
@@ -521,17 +1366,88 @@ int runPrestress(const std::string& refFile, const std::string& defFile,
     }
     std::cout << "\n";
 
+    std::string defLabel = analytic ? defFile + " (analytic mapping)" : defFile;
+    if (sweeping) {
+        int status = writeMaterialSweep(sweep, results, outputFile, options,
+                                        refFile, defLabel, console);
+        if (status == 0) {
+            timer.stop();
+            console.info("Total time: " + timer.elapsedString());
+        }
+        return status;
+    }
+
     // Write output
     DynainWriter writer;
     writer.setLargeDeformation(strainType == StrainType::GREEN_LAGRANGE);
 
-    if (hasMaterial) {
-        console.info("Writing dynain file: " + outputFile);
-        if (!writer.writeFile(outputFile, results, strainType, refFile, defFile)) {
-            console.error("Failed to write dynain: " + writer.getErrorMessage());
+    // Equilibrium check of the stress that will be written
+    if (residual && hasMaterial) {
+        Timer residualTimer;
+        ResidualAnalyzer residualAnalyzer;
+        residualAnalyzer.setWorstNodeCount(5);
+        ResidualReport report;
+        if (!residualAnalyzer.compute(defMesh, results, report)) {
+            console.error("Residual computation failed: " + residualAnalyzer.getErrorMessage());
             return 1;
         }
-        console.success("Dynain file written successfully");
+
+        console.header("Nodal Force Residual");
+        console.keyValue("L2 norm", std::to_string(report.l2Norm));
+        console.keyValue("Max nodal force", std::to_string(report.maxNorm));
+        for (const auto& part : report.parts) {
+            console.keyValue("Part " + std::to_string(part.partId),
+                "L2=" + std::to_string(part.l2Norm) +
+                ", max=" + std::to_string(part.maxNorm) +
+                " (node " + std::to_string(part.maxNodeId) + ")");
+        }
+        console.println("  Worst nodes:");
+        for (const auto& r : report.worstNodes) {
+            console.println("    Node " + std::to_string(r.nodeId) + ": |f|=" + std::to_string(r.magnitude));
+        }
+        if (report.skippedElements > 0) {
+            console.warning("Elements excluded from residual: " + std::to_string(report.skippedElements));
+        }
+        console.info("Residual time: " + residualTimer.elapsedString());
+
+        if (!options.residualFile.empty()) {
+            console.info("Writing residual field: " + options.residualFile);
+            if (!writer.writeResidualCSV(options.residualFile, report)) {
+                console.error("Failed to write residual: " + writer.getErrorMessage());
+                return 1;
+            }
+        }
+        std::cout << "\n";
+    } else if (residual) {
+        console.warning("Residual report skipped: no material specified");
+    }
+
+    std::vector<std::string> shardOutputs;
+
+    if (hasMaterial && shard.active) {
+        console.info("Writing dynain shard: " + ShardWriter::partialPath(outputFile, shard.index));
+        std::ostringstream head, cards;
+        writer.writeHeader(head, strainType, refFile, defFile);
+        writer.writeStressCards(cards, results);
+
+        ShardWriter out;
+        bool ok = out.open(outputFile, shard.index, shard.count) &&
+                  out.writeFirst(head.str()) &&
+                  out.write(cards.str()) &&
+                  out.writeFirst("*END\n") &&
+                  out.close();
+        if (!ok) {
+            console.error("Failed to write dynain: " + out.getErrorMessage());
+            return 1;
+        }
+        shardOutputs.push_back(outputFile);
+    } else if (hasMaterial) {
+        if (!writeStressOutput(outputFile, results, options.format, strainType,
+                               refFile, defLabel, console)) {
+            return 1;
+        }
+        console.success(options.format == OutputFormat::ABAQUS ? "Initial stress file written successfully"
+                                                              : "Dynain file written successfully");
     }
 
     // Write CSV if requested or if no material
@@ -547,13 +1463,264 @@ int runPrestress(const std::string& refFile, const std::string& defFile,
             }
         }
         
-        console.info("Writing CSV file: " + csvFile);
-        if (!writer.writeStrainCSV(csvFile, results)) {
-            console.error("Failed to write CSV: " + writer.getErrorMessage());
+        if (shard.active) {
+            console.info("Writing CSV shard: " + ShardWriter::partialPath(csvFile, shard.index));
+            std::ostringstream head, rows;
+            writer.writeStrainCSVHeader(head, results.hasMaterial);
+            writer.writeStrainCSVRows(rows, results);
+
+            ShardWriter out;
+            bool ok = out.open(csvFile, shard.index, shard.count) &&
+                      out.writeFirst(head.str()) &&
+                      out.write(rows.str()) &&
+                      out.close();
+            if (!ok) {
+                console.error("Failed to write CSV: " + out.getErrorMessage());
+                return 1;
+            }
+            shardOutputs.push_back(csvFile);
+        } else {
+            console.info("Writing CSV file: " + csvFile);
+            if (!writer.writeStrainCSV(csvFile, results)) {
+                console.error("Failed to write CSV: " + writer.getErrorMessage());
+                return 1;
+            }
+            console.success("CSV file written successfully");
+        }
+    }
+
+    if (shard.active) {
+        reportShardOutput(shardOutputs, shard, console);
+    }
+
+    if (!stateFile.empty()) {
+        console.info("Saving state: " + stateFile);
+        PrestressState state;
+        if (!state.save(stateFile, fingerprint, defMesh, results)) {
+            console.error("Failed to save state: " + state.getErrorMessage());
+            return 1;
+        }
+    }
+
+    timer.stop();
+    console.info("Total time: " + timer.elapsedString());
+
+    return 0;
+}
+
+/**
+ * Merge the shard outputs of a sharded run
+ */
+int runMerge(const std::string& outputFile, bool clean, const ConsoleOutput& console) {
+    Timer timer;
+
+    console.info("Merging shards into: " + outputFile);
+    ShardMerger merger;
+    if (!merger.merge(outputFile, clean)) {
+        console.error("Merge failed: " + merger.getErrorMessage());
+        return 1;
+    }
+    console.success("Merged " + std::to_string(merger.getShardCount()) + " shards (" +
+                    std::to_string(merger.getBytesWritten()) + " bytes)");
+
+    timer.stop();
+    console.info("Total time: " + timer.elapsedString());
+
+    return 0;
+}
+
+/**
+ * Benchmark the hot loops and save a tuning profile for this host
+ */
+int runTune(const std::string& profileFile, const std::string& workDir, bool quick,
+            bool dryRun, const ConsoleOutput& console) {
+    Timer timer;
+
+    console.keyValue("Host", Platform::getHostName());
+    console.keyValue("Cores", std::to_string(std::max(1u, std::thread::hardware_concurrency())));
+    console.keyValue("Kernels", CpuFeatures::describe());
+    std::cout << "\n";
+    console.info(std::string("Running ") + (quick ? "quick " : "") + "benchmarks...");
+
+    AutoTuner tuner;
+    tuner.setQuick(quick);
+    tuner.setWorkDirectory(workDir);
+    tuner.setSweepCallback([&console](const TuningSweep& sweep) {
+        std::ostringstream table;
+        table << "  " << sweep.benchmark << " / " << sweep.parameter << "\n";
+        for (size_t n = 0; n < sweep.values.size(); ++n) {
+            table << "  " << std::setw(14) << sweep.values[n]
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << sweep.seconds[n] * 1000.0 << " ms"
+                  << (n == sweep.chosen ? "  <" : "") << "\n";
+        }
+        std::cout << "\n" << table.str();
+    });
+
+    TuningProfile profile;
+    if (!tuner.run(profile)) {
+        console.error("Tuning failed: " + tuner.getErrorMessage());
+        return 1;
+    }
+    std::cout << "\n";
+    console.success("Tuning completed in " + timer.elapsedString());
+
+    if (dryRun) {
+        console.info("Profile not saved (--dry-run)");
+        return 0;
+    }
+    std::string error;
+    if (!profile.save(profileFile, error)) {
+        console.error(error);
+        return 1;
+    }
+    console.success("Profile saved: " + profileFile);
+    console.info("Later runs on this host load it automatically");
+    return 0;
+}
+
+/**
+ * Print the tuning profile in effect
+ */
+int runTuneShow(const std::string& profilePath, const ConsoleOutput& console) {
+    const TuningProfile& profile = TuningProfile::active();
+    console.keyValue("Profile", profilePath.empty() ? "(none, built-in defaults)" : profilePath);
+    console.keyValue("threads", std::to_string(profile.threads) +
+                     " (pool: " + std::to_string(ThreadPool::instance().threadCount()) + ")");
+    console.keyValue("map_chunk", std::to_string(profile.mapChunk));
+    console.keyValue("element_chunk", std::to_string(profile.elementChunk));
+    console.keyValue("read_buffer", std::to_string(profile.readBuffer));
+    console.keyValue("write_buffer", std::to_string(profile.writeBuffer));
+    return 0;
+}
+
+/**
+ * Options of the map-points command
+ */
+struct MapPointsOptions {
+    std::string mapperFile;             // Mapper cache (load, or build and save)
+    bool formatSet = false;
+    PointFormat format = PointFormat::CSV;
+    size_t chunkSize = 1 << 20;         // Points per streamed chunk
+    EdgeInterpolation edgeInterpolation = EdgeInterpolation::LINEAR;
+};
+
+/**
+ * Map a flat-frame point set (CSV or binary xyz) onto the bent geometry
+ * bentFile/flatFile may be empty when a valid mapper cache is given.
+ */
+int runMapPoints(const std::string& bentFile, const std::string& flatFile,
+                 const std::string& inputFile, const std::string& outputFile,
+                 const MapPointsOptions& options, const ConsoleOutput& console) {
+    Timer timer;
+
+    // Mapper: from the cache, or built from the bent and flat meshes
+    PointMapper mapper;
+    bool fromCache = false;
+    if (!options.mapperFile.empty() && bentFile.empty()) {
+        console.info("Loading mapper cache: " + options.mapperFile);
+        if (!mapper.load(options.mapperFile)) {
+            console.error("Failed to load mapper: " + mapper.getErrorMessage());
+            return 1;
+        }
+        fromCache = true;
+    } else {
+        console.info("Loading bent mesh: " + bentFile);
+        KFileReader reader;
+        Mesh bentMesh;
+        Mesh flatMesh;
+        try {
+            bentMesh = reader.readFile(bentFile);
+            console.info("Loading flat mesh (frame of the points): " + flatFile);
+            flatMesh = reader.readFile(flatFile);
+        } catch (const std::exception& e) {
+            console.error("Failed to load mesh: " + std::string(e.what()));
+            return 1;
+        }
+
+        auto bentValidation = Validator::validateBentMesh(bentMesh);
+        if (!bentValidation.isValid) {
+            for (const auto& err : bentValidation.errors) {
+                console.error(err);
+            }
+            return 1;
+        }
+        if (flatMesh.getNodeCount() == 0) {
+            console.error("Flat mesh has no nodes: " + flatFile);
+            return 1;
+        }
+
+        Vector3D flatMin, flatMax;
+        flatMesh.calculateBoundingBox(flatMin, flatMax);
+
+        console.info("Building parametric mapper...");
+        mapper.setEdgeInterpolation(options.edgeInterpolation);
+        if (!mapper.build(bentMesh, flatMin, flatMax)) {
+            console.error("Failed to build mapper: " + mapper.getErrorMessage());
+            return 1;
+        }
+
+        if (!options.mapperFile.empty()) {
+            if (!mapper.save(options.mapperFile)) {
+                console.error("Failed to write mapper cache: " + options.mapperFile);
+                return 1;
+            }
+            console.success("Mapper cache written: " + options.mapperFile);
+        }
+    }
+
+    const Vector3D& flatMin = mapper.getFlatMin();
+    const Vector3D& flatMax = mapper.getFlatMax();
+    console.keyValue("Flat frame min", "(" + std::to_string(flatMin.x) + ", " +
+                     std::to_string(flatMin.y) + ", " + std::to_string(flatMin.z) + ")");
+    console.keyValue("Flat frame max", "(" + std::to_string(flatMax.x) + ", " +
+                     std::to_string(flatMax.y) + ", " + std::to_string(flatMax.z) + ")");
+
+    // Stream the points through the mapper chunk by chunk
+    PointFormat format = options.formatSet ? options.format : pointFormatFromPath(inputFile);
+    PointSetReader in;
+    if (!in.open(inputFile, format)) {
+        console.error("Failed to open points: " + in.getErrorMessage());
+        return 1;
+    }
+    PointSetWriter out;
+    if (!out.open(outputFile, format, in.getHeader(), in.getSeparator())) {
+        console.error("Failed to write output: " + out.getErrorMessage());
+        return 1;
+    }
+
+    console.info("Mapping points: " + inputFile + " (" +
+                 std::string(format == PointFormat::BINARY ? "binary" : "csv") + ", " +
+                 std::to_string(ThreadPool::instance().threadCount()) + " threads)");
+    Timer mapTimer;
+    PointChunk chunk;
+    while (in.read(chunk, options.chunkSize) > 0) {
+        mapper.mapPoints(chunk.points);
+        if (!out.write(chunk)) {
+            console.error("Failed to write output: " + out.getErrorMessage());
             return 1;
         }
-        console.success("CSV file written successfully");
     }
+    mapTimer.stop();
+
+    if (in.hasError()) {
+        console.error("Failed to read points: " + in.getErrorMessage());
+        return 1;
+    }
+    if (!out.close()) {
+        console.error("Failed to write output: " + out.getErrorMessage());
+        return 1;
+    }
+
+    long long count = in.getPointsRead();
+    double seconds = mapTimer.elapsedSec();
+    console.success("Mapped " + std::to_string(count) + " points" +
+                    (fromCache ? " (cached mapper)" : ""));
+    if (seconds > 0) {
+        console.keyValue("Throughput", std::to_string(static_cast<long long>(count / seconds)) +
+                         " points/s");
+    }
+    console.success("Output written: " + outputFile);
 
     timer.stop();
     console.info("Total time: " + timer.elapsedString());
@@ -616,8 +1783,7 @@ int runInfo(const std::string& meshFile, const ConsoleOutput& console) {
     double maxJ = std::numeric_limits<double>::lowest();
     int negativeCount = 0;
 
-    for (const auto& [id, elem] : mesh.getElements()) {
-        double j = Validator::calculateJacobian(mesh, elem);
+    for (double j : Validator::calculateJacobians(mesh)) {
         if (j < minJ) minJ = j;
         if (j > maxJ) maxJ = j;
         if (j <= 0) negativeCount++;
@@ -635,6 +1801,51 @@ int runInfo(const std::string& meshFile, const ConsoleOutput& console) {
     return 0;
 }
 
+/**
+ * Pre-flight report of a k-file: keyword blocks and structural errors,
+ * without loading the mesh
+ */
+int runPreflight(const std::string& meshFile, const ConsoleOutput& console) {
+    Timer timer;
+    KFilePreflight report = Validator::preflightKFile(meshFile);
+
+    console.header("Pre-flight: " + Platform::getFilename(meshFile));
+    console.keyValue("File size", std::to_string(report.fileSize) + " bytes");
+    console.keyValue("Lines", std::to_string(report.lines));
+    console.keyValue("Keyword blocks", std::to_string(report.blocks.size()));
+    console.keyValue("Scan time", timer.elapsedString());
+
+    if (!report.blocks.empty()) {
+        std::ostringstream table;
+        table << "  " << std::left << std::setw(24) << "Keyword" << std::right
+              << std::setw(10) << "Line" << std::setw(12) << "Records"
+              << std::setw(14) << "Bytes" << "  Format\n";
+        for (const auto& block : report.blocks) {
+            table << "  " << std::left << std::setw(24) << ("*" + block.keyword) << std::right
+                  << std::setw(10) << block.line << std::setw(12) << block.records
+                  << std::setw(14) << block.bytes << "  ";
+            if (block.records > 0) {
+                table << (block.freeFormat ? "free" : "fixed") << (block.longFormat ? ", long" : "");
+            }
+            table << "\n";
+        }
+        std::cout << "\n" << table.str();
+    }
+
+    std::cout << "\n";
+    for (const auto& warn : report.validation.warnings) {
+        console.warning(warn);
+    }
+    if (!report.validation.isValid) {
+        for (const auto& err : report.validation.errors) {
+            console.error(err);
+        }
+        return 1;
+    }
+    console.success("No structural errors found");
+    return 0;
+}
+
 /**
  * Generate variable density mesh from YAML config
  */
@@ -721,8 +1932,14 @@ int runGenerateVar(const std::string& configFile, const std::string& outputFile,
         }
         
         console.success("Configuration loaded (CURVED)");
-        console.keyValue("Centerline points", std::to_string(curvedConfig.centerlinePoints.size()));
-        console.keyValue("Elements along curve", std::to_string(curvedConfig.elementsAlongCurve));
+        if (curvedConfig.isAssembly()) {
+            console.keyValue("Centerline segments", std::to_string(curvedConfig.segments.size()));
+        } else {
+            console.keyValue("Centerline points", std::to_string(curvedConfig.getCenterlinePointCount()) +
+                             (curvedConfig.isSpaceCurve() ? " (3D)" : " (planar)"));
+        }
+        console.keyValue("Elements along curve", std::to_string(curvedConfig.getElementsAlongCurve()) +
+                         (curvedConfig.hasDensityZones() ? " (zoned)" : ""));
         console.keyValue("Elements J (width)", std::to_string(curvedConfig.elementsWidth));
         console.keyValue("Elements K (thickness)", std::to_string(curvedConfig.elementsThickness));
         console.keyValue("Total elements", std::to_string(curvedConfig.getTotalElements()));
@@ -755,6 +1972,8 @@ int runGenerateVar(const std::string& configFile, const std::string& outputFile,
         console.keyValue("Scale factor", std::to_string(stats.scaleFactor));
         console.keyValue("Width", std::to_string(stats.width));
         console.keyValue("Thickness", std::to_string(stats.thickness));
+        console.keyValue("Element length", std::to_string(stats.minElementLength) + " - " +
+                         std::to_string(stats.maxElementLength));
         console.keyValue("Max curvature", std::to_string(stats.maxCurvature));
         console.keyValue("Min radius", std::to_string(stats.minRadius));
         std::cout << "\n";
@@ -844,54 +2063,540 @@ int runGenerateVar(const std::string& configFile, const std::string& outputFile,
     return 0;
 }
 
-int main(int argc, char* argv[]) {
-    ConsoleOutput console;
+#ifdef KOOREMAPPER_WITH_MPI
+/**
+ * Run the mapping operation distributed over MPI ranks
+ *
+ * Each rank reads its partition of the flat mesh, fetches the ghost nodes
+ * of its elements and maps them against the (small) bent mesh, which every
+ * rank reads in full. The output is assembled in file order with MPI-IO.
+ */
+int runDistributedMapping(const std::string& bentFile, const std::string& flatFile,
+                          const std::string& outputFile, EdgeInterpolation edgeInterpolation,
+                          const MpiContext& mpi, const ConsoleOutput& console) {
+    Timer timer;
+    console.info("Distributed mapping on " + std::to_string(mpi.size()) + " ranks");
 
-    // Check for subcommand
-    if (argc < 2) {
-        printBanner(console);
-        console.println("Usage: KooRemapper <command> [options]");
-        std::cout << "\n";
-        console.println("Commands:");
-        console.println("  map         Map a flat mesh onto a bent reference mesh");
-        console.println("  unfold      Generate flat mesh from a bent structured mesh");
-        console.println("  generate    Generate example meshes for testing");
-        console.println("  generate-var Generate variable density mesh from YAML config");
-        console.println("  strain      Calculate strain between two meshes");
-        console.println("  prestress   Calculate prestress from deformed configuration");
-        console.println("  info        Display information about a mesh file");
-        console.println("  help        Show help for a command");
-        console.println("  version     Show version information");
-        std::cout << "\n";
-        console.println("Use 'KooRemapper help <command>' for more information.");
+    // Load bent mesh (every rank)
+    console.info("Loading bent mesh: " + bentFile);
+    KFileReader reader;
+    Mesh bentMesh;
+    std::string localError;
+    try {
+        bentMesh = reader.readFile(bentFile);
+    } catch (const std::exception& e) {
+        localError = e.what();
+    }
+    if (!mpi.allTrue(localError.empty())) {
+        if (!localError.empty()) console.error("Failed to load bent mesh: " + localError);
         return 1;
     }
 
-    std::string command = argv[1];
+    auto bentValidation = Validator::validateBentMesh(bentMesh);
+    if (!bentValidation.isValid) {
+        for (const auto& err : bentValidation.errors) {
+            if (mpi.isRoot()) console.error(err);
+        }
+        return 1;
+    }
+    for (const auto& warn : bentValidation.warnings) {
+        console.warning(warn);
+    }
 
-    // Version command
-    if (command == "version" || command == "--version" || command == "-v") {
-        console.println("KooRemapper version " + std::string(VERSION));
-        return 0;
+    // Load this rank's partition of the flat mesh
+    console.info("Loading flat mesh partitions: " + flatFile);
+    DistributedMesh distributed(mpi);
+    Mesh ownedNodes;
+    try {
+        ownedNodes = distributed.readPartition(flatFile);
+    } catch (const std::exception& e) {
+        if (mpi.isRoot()) console.error("Failed to load flat mesh: " + std::string(e.what()));
+        return 1;
     }
 
-    // Help command
-    if (command == "help" || command == "--help" || command == "-h") {
-        if (argc > 2) {
-            std::string helpCmd = argv[2];
-            if (helpCmd == "map") {
-                console.println("Usage: KooRemapper map <bent_mesh> <flat_mesh> <output>");
-                std::cout << "\n";
-                console.println("Map a flat unstructured mesh onto a bent structured mesh.");
-                std::cout << "\n";
-                console.println("Arguments:");
-                console.println("  bent_mesh   The bent structured reference mesh (k-file)");
-                console.println("  flat_mesh   The flat mesh to be mapped (k-file)");
-                console.println("  output      Output file path for the mapped mesh");
-            } else if (helpCmd == "generate") {
-                console.println("Usage: KooRemapper generate [options] <type> <output_prefix>");
-                std::cout << "\n";
-                console.println("Generate example meshes for testing.");
+    long long totalNodes = mpi.sumAll(static_cast<long long>(ownedNodes.getNodeCount()));
+    long long totalElements = mpi.sumAll(static_cast<long long>(ownedNodes.getElementCount()));
+    console.success("Loaded " + std::to_string(totalNodes) + " nodes, " +
+                    std::to_string(totalElements) + " elements");
+    if (totalNodes == 0 || totalElements == 0) {
+        if (mpi.isRoot()) console.error("Flat mesh has no nodes or elements");
+        return 1;
+    }
+
+    // Global parametrization box, then ghost nodes of the local elements
+    Vector3D flatMin, flatMax;
+    distributed.globalBounds(ownedNodes, flatMin, flatMax);
+
+    Mesh flatMesh;
+    flatMesh.elements = ownedNodes.elements;
+    flatMesh.parts = ownedNodes.parts;
+    long long missing = mpi.sumAll(distributed.gatherNodes(ownedNodes, flatMesh));
+    if (missing > 0) {
+        if (mpi.isRoot()) console.error("Elements reference " + std::to_string(missing) + " undefined nodes");
+        return 1;
+    }
+    // Owned nodes not referenced by any local element are mapped here too
+    for (const auto& [id, node] : ownedNodes.nodes) {
+        if (!flatMesh.hasNode(id)) {
+            flatMesh.addNode(node);
+        }
+    }
+
+    // Perform mapping
+    console.info("Performing mesh mapping...");
+    MeshRemapper remapper;
+    remapper.setBentMesh(&bentMesh);
+    remapper.setFlatMesh(&flatMesh);
+    remapper.setFlatBounds(flatMin, flatMax);
+    remapper.setEdgeInterpolation(edgeInterpolation);
+    remapper.setProgressCallback([&console](int percent) {
+        console.progressBar(percent);
+    });
+
+    bool mapped = remapper.performMapping();
+    console.clearLine();
+    if (!mpi.allTrue(mapped)) {
+        if (!mapped) console.error("Mapping failed: " + remapper.getErrorMessage());
+        return 1;
+    }
+    console.success("Mapping completed successfully");
+
+    // Reduce statistics
+    const auto& stats = remapper.getStats();
+    long long elements = mpi.sumAll(static_cast<long long>(stats.elementsProcessed));
+    double jacobianSum = mpi.sumAll(stats.avgJacobian * stats.elementsProcessed);
+    double minJacobian = mpi.minAll(stats.elementsProcessed > 0 ? stats.minJacobian
+                                                                : std::numeric_limits<double>::max());
+    double maxJacobian = mpi.maxAll(stats.elementsProcessed > 0 ? stats.maxJacobian
+                                                                : std::numeric_limits<double>::lowest());
+    long long invalid = mpi.sumAll(static_cast<long long>(stats.invalidElements));
+    double timeMs = mpi.maxAll(stats.processingTimeMs);
+
+    console.println("");
+    console.header("Mapping Statistics");
+    console.keyValue("Nodes processed", std::to_string(totalNodes));
+    console.keyValue("Elements processed", std::to_string(elements));
+    console.keyValue("Min Jacobian", std::to_string(minJacobian));
+    console.keyValue("Max Jacobian", std::to_string(maxJacobian));
+    console.keyValue("Avg Jacobian", std::to_string(elements > 0 ? jacobianSum / elements : 0.0));
+    if (invalid > 0) {
+        console.warning("Invalid elements (negative Jacobian): " + std::to_string(invalid));
+    }
+    console.keyValue("Processing time", std::to_string(timeMs) + " ms");
+    console.println("");
+
+    // Only owned nodes are written, so each node appears exactly once
+    Mesh outputMesh;
+    const Mesh& result = remapper.getResult();
+    for (const auto& [id, node] : ownedNodes.nodes) {
+        const Node* mappedNode = result.getNode(id);
+        outputMesh.addNode(mappedNode ? *mappedNode : node);
+    }
+    outputMesh.elements = result.elements;
+
+    console.info("Writing output: " + outputFile);
+    KFileWriter writer;
+    std::ostringstream head, nodes, elemHead, elems, tail;
+    writer.writeHeader(head);
+    writer.writeNodeKeyword(head);
+    writer.writeNodeLines(nodes, outputMesh, true);
+    writer.writeElementKeyword(elemHead);
+    writer.writeElementLines(elems, outputMesh);
+    writer.writeEnd(tail);
+
+    OrderedFileWriter out(mpi);
+    bool ok = out.open(outputFile) &&
+              out.writeRoot(head.str()) &&
+              out.write(nodes.str()) &&
+              out.writeRoot(elemHead.str()) &&
+              out.write(elems.str()) &&
+              out.writeRoot(tail.str());
+    out.close();
+    if (!ok) {
+        if (mpi.isRoot()) console.error("Failed to write output: " + out.getErrorMessage());
+        return 1;
+    }
+    console.success("Output written successfully");
+
+    timer.stop();
+    console.info("Total time: " + timer.elapsedString());
+
+    return 0;
+}
+
+/**
+ * Calculate prestress distributed over MPI ranks
+ *
+ * Elements are partitioned by the reference file; the reference and
+ * deformed coordinates of their nodes are gathered from the owning ranks.
+ * Relaxation and the residual report need the assembled mesh and are not
+ * available in this mode.
+ */
+int runDistributedPrestress(const std::string& refFile, const std::string& defFile,
+                            const std::string& outputFile,
+                            const PrestressOptions& options,
+                            const MpiContext& mpi,
+                            const ConsoleOutput& console) {
+    Timer timer;
+    const double E = options.E;
+    const double nu = options.nu;
+    const StrainType strainType = options.strainType;
+    console.info("Distributed prestress on " + std::to_string(mpi.size()) + " ranks");
+
+    if (options.relax) {
+        console.warning("--relax is not supported with MPI; run on a single rank");
+    }
+    if (options.residual || !options.residualFile.empty()) {
+        console.warning("--residual is not supported with MPI; run on a single rank");
+    }
+
+    // Load partitions
+    DistributedMesh distributed(mpi);
+    Mesh refOwned, defOwned;
+    try {
+        console.info("Loading reference mesh partitions: " + refFile);
+        refOwned = distributed.readPartition(refFile, true);
+        console.info("Loading deformed mesh partitions: " + defFile);
+        defOwned = distributed.readPartition(defFile, false);
+    } catch (const std::exception& e) {
+        if (mpi.isRoot()) console.error("Failed to load mesh: " + std::string(e.what()));
+        return 1;
+    }
+
+    long long refNodes = mpi.sumAll(static_cast<long long>(refOwned.getNodeCount()));
+    long long defNodes = mpi.sumAll(static_cast<long long>(defOwned.getNodeCount()));
+    long long totalElements = mpi.sumAll(static_cast<long long>(refOwned.getElementCount()));
+    console.success("Loaded " + std::to_string(refNodes) + " nodes, " +
+                    std::to_string(totalElements) + " elements");
+
+    if (refOwned.getMaterialCount() > 0) {
+        console.info("Found " + std::to_string(refOwned.getMaterialCount()) + " material(s) in K-file:");
+        for (const auto& [matId, mat] : refOwned.getMaterials()) {
+            console.println("  Material " + std::to_string(matId) +
+                            ": E=" + std::to_string(mat.E) +
+                            ", nu=" + std::to_string(mat.nu));
+        }
+    }
+
+    // Connectivity comes from the reference file; node counts must agree
+    if (refNodes != defNodes) {
+        if (mpi.isRoot()) {
+            console.error("Mesh pair validation failed: Node count mismatch: " +
+                          std::to_string(refNodes) + " vs " + std::to_string(defNodes));
+        }
+        return 1;
+    }
+
+    Mesh refMesh, defMesh;
+    refMesh.elements = refOwned.elements;
+    refMesh.parts = refOwned.parts;
+    refMesh.materials = refOwned.materials;
+    defMesh.elements = refOwned.elements;
+    long long missing = distributed.gatherNodes(refOwned, refMesh);
+    missing += distributed.gatherNodes(defOwned, defMesh);
+    missing = mpi.sumAll(missing);
+    if (missing > 0) {
+        if (mpi.isRoot()) console.error("Elements reference " + std::to_string(missing) + " undefined nodes");
+        return 1;
+    }
+
+    // Setup analyzer
+    console.info("Analyzing strain/stress...");
+    ElementAnalyzer analyzer;
+    analyzer.setStrainType(strainType);
+    analyzer.setUsePartMaterials(true);
+
+    bool hasCmdLineMaterial = (E > 0 && nu > 0 && nu < 0.5);
+    bool hasKFileMaterial = (refMesh.getMaterialCount() > 0);
+    bool hasMaterial = hasCmdLineMaterial || hasKFileMaterial;
+
+    if (hasCmdLineMaterial) {
+        analyzer.setMaterial(MaterialModel::isotropicElastic(E, nu));
+        analyzer.setUsePartMaterials(false);
+        console.info("Using command-line material: E=" + std::to_string(E) + ", nu=" + std::to_string(nu));
+    } else if (hasKFileMaterial) {
+        console.info("Using materials from K-file (per-part)");
+    } else {
+        console.info("No material specified, computing strain only");
+    }
+
+    MeshAnalysisResult results = analyzer.analyzeMesh(refMesh, defMesh,
+        [&console](int percent) {
+            console.progressBar(percent);
+        });
+    console.clearLine();
+    console.success("Analysis completed");
+
+    // Reduce statistics over valid elements of all ranks
+    long long valid = mpi.sumAll(static_cast<long long>(results.validElements));
+    long long invalid = mpi.sumAll(static_cast<long long>(results.invalidElements));
+    bool anyValid = results.validElements > 0;
+    double minStrain = mpi.minAll(anyValid ? results.minVonMisesStrain : std::numeric_limits<double>::max());
+    double maxStrain = mpi.maxAll(anyValid ? results.maxVonMisesStrain : std::numeric_limits<double>::lowest());
+    double avgStrain = mpi.sumAll(results.avgVonMisesStrain * results.validElements);
+    double minStress = mpi.minAll(anyValid ? results.minVonMisesStress : std::numeric_limits<double>::max());
+    double maxStress = mpi.maxAll(anyValid ? results.maxVonMisesStress : std::numeric_limits<double>::lowest());
+    double avgStress = mpi.sumAll(results.avgVonMisesStress * results.validElements);
+    if (valid > 0) {
+        avgStrain /= valid;
+        avgStress /= valid;
+    }
+
+    console.println("");
+    console.header("Analysis Results");
+    console.keyValue("Valid elements", std::to_string(valid));
+    if (invalid > 0) {
+        console.warning("Invalid elements: " + std::to_string(invalid));
+    }
+    console.keyValue("Strain type",
+        strainType == StrainType::ENGINEERING ? "Engineering" : "Green-Lagrange");
+    console.keyValue("Min von Mises strain", std::to_string(minStrain));
+    console.keyValue("Max von Mises strain", std::to_string(maxStrain));
+    console.keyValue("Avg von Mises strain", std::to_string(avgStrain));
+    if (hasMaterial) {
+        console.println("");
+        console.keyValue("Min von Mises stress", std::to_string(minStress));
+        console.keyValue("Max von Mises stress", std::to_string(maxStress));
+        console.keyValue("Avg von Mises stress", std::to_string(avgStress));
+    }
+    console.println("");
+
+    DynainWriter writer;
+    writer.setLargeDeformation(strainType == StrainType::GREEN_LAGRANGE);
+
+    if (hasMaterial) {
+        console.info("Writing dynain file: " + outputFile);
+        std::ostringstream head, cards;
+        writer.writeHeader(head, strainType, refFile, defFile);
+        writer.writeStressCards(cards, results);
+
+        OrderedFileWriter out(mpi);
+        bool ok = out.open(outputFile) &&
+                  out.writeRoot(head.str()) &&
+                  out.write(cards.str()) &&
+                  out.writeRoot("*END\n");
+        out.close();
+        if (!ok) {
+            if (mpi.isRoot()) console.error("Failed to write dynain: " + out.getErrorMessage());
+            return 1;
+        }
+        console.success("Dynain file written successfully");
+    }
+
+    if (options.outputCSV || !hasMaterial) {
+        std::string csvFile = outputFile;
+        if (hasMaterial) {
+            size_t dotPos = csvFile.rfind('.');
+            if (dotPos != std::string::npos) {
+                csvFile = csvFile.substr(0, dotPos) + ".csv";
+            } else {
+                csvFile += ".csv";
+            }
+        }
+
+        console.info("Writing CSV file: " + csvFile);
+        std::ostringstream head, rows;
+        writer.writeStrainCSVHeader(head, results.hasMaterial);
+        writer.writeStrainCSVRows(rows, results);
+
+        OrderedFileWriter out(mpi);
+        bool ok = out.open(csvFile) &&
+                  out.writeRoot(head.str()) &&
+                  out.write(rows.str());
+        out.close();
+        if (!ok) {
+            if (mpi.isRoot()) console.error("Failed to write CSV: " + out.getErrorMessage());
+            return 1;
+        }
+        console.success("CSV file written successfully");
+    }
+
+    timer.stop();
+    console.info("Total time: " + timer.elapsedString());
+
+    return 0;
+}
+#endif
+
+/**
+ * Remove a global "--metrics <file>" / "--metrics=<file>" from argv
+ * Returns the file name, or "" when absent; sets error on a missing value.
+ */
+std::string takeMetricsOption(int& argc, char* argv[], std::string& error) {
+    std::string file;
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--metrics") {
+            if (i + 1 >= argc) {
+                error = "--metrics requires a file name";
+                continue;
+            }
+            file = argv[++i];
+        } else if (arg.rfind("--metrics=", 0) == 0) {
+            file = arg.substr(10);
+        } else {
+            argv[out++] = argv[i];
+        }
+    }
+    argc = out;
+    argv[argc] = nullptr;
+    return file;
+}
+
+/**
+ * Writes the counter snapshot when main returns
+ */
+class MetricsDump {
+public:
+    MetricsDump(const std::string& filename, const ConsoleOutput& console)
+        : filename_(filename), console_(console) {}
+
+    ~MetricsDump() {
+        if (filename_.empty()) return;
+        if (!Metrics::enabled()) {
+            console_.warning("Metrics are compiled out (KOOREMAPPER_METRICS=OFF); " +
+                             filename_ + " has no counts");
+        }
+        std::string error;
+        if (!Metrics::writeJson(filename_, error)) {
+            console_.warning(error);
+        }
+    }
+
+private:
+    std::string filename_;
+    const ConsoleOutput& console_;
+};
+
+int main(int argc, char* argv[]) {
+#ifdef KOOREMAPPER_WITH_MPI
+    MpiContext mpi(&argc, &argv);
+#endif
+    ConsoleOutput console;
+#ifdef KOOREMAPPER_WITH_MPI
+    console.setQuiet(!mpi.isRoot());  // Only rank 0 reports progress
+#endif
+
+    // Global option: dump the hot-path counters at exit
+    std::string metricsError;
+    std::string metricsFile = takeMetricsOption(argc, argv, metricsError);
+    if (!metricsError.empty()) {
+        console.error(metricsError);
+        return 1;
+    }
+#ifdef KOOREMAPPER_WITH_MPI
+    if (!metricsFile.empty() && mpi.size() > 1) {
+        metricsFile += "." + std::to_string(mpi.rank());  // One file per rank
+    }
+#endif
+    MetricsDump metricsDump(metricsFile, console);
+
+    // Check for subcommand
+    if (argc < 2) {
+        printBanner(console);
+        console.println("Usage: KooRemapper <command> [options]");
+        std::cout << "\n";
+        console.println("Commands:");
+        console.println("  map         Map a flat mesh onto a bent reference mesh");
+        console.println("  map-points  Map a CSV/binary point set onto a bent reference mesh");
+        console.println("  unfold      Generate flat mesh from a bent structured mesh");
+        console.println("  generate    Generate example meshes for testing");
+        console.println("  generate-var Generate variable density mesh from YAML config");
+        console.println("  strain      Calculate strain between two meshes");
+        console.println("  prestress   Calculate prestress from deformed configuration");
+        console.println("  info        Display information about a mesh file");
+        console.println("  merge       Merge the outputs of a sharded (--shard) run");
+        console.println("  tune        Benchmark this machine and save a tuning profile");
+        console.println("  help        Show help for a command");
+        console.println("  version     Show version information");
+        std::cout << "\n";
+        console.println("Use 'KooRemapper help <command>' for more information.");
+        console.println("Global option: --metrics <file.json> writes hot-path event counts at exit.");
+        return 1;
+    }
+
+    std::string command = argv[1];
+
+    // "-" names stdin/stdout: data then owns stdout, so console messages
+    // move to stderr
+    for (int i = 2; i < argc; ++i) {
+        if (Platform::isStdStream(argv[i])) {
+            std::ios::sync_with_stdio(false);
+            std::cout.rdbuf(std::cerr.rdbuf());
+            Platform::setBinaryStdio();
+            break;
+        }
+    }
+
+#ifdef KOOREMAPPER_WITH_MPI
+    // Only map and prestress run distributed
+    if (mpi.size() > 1 && command != "map" && command != "prestress") {
+        if (mpi.isRoot()) {
+            console.error("Command '" + command + "' does not support MPI; run it on a single rank");
+        }
+        return 1;
+    }
+#endif
+
+    // Version command
+    if (command == "version" || command == "--version" || command == "-v") {
+        console.println("KooRemapper version " + std::string(VERSION));
+        console.println("Vector kernels: " + CpuFeatures::describe());
+        return 0;
+    }
+
+    // Help command
+    if (command == "help" || command == "--help" || command == "-h") {
+        if (argc > 2) {
+            std::string helpCmd = argv[2];
+            if (helpCmd == "map") {
+                console.println("Usage: KooRemapper map [options] <bent_mesh> <flat_mesh> <output>");
+                std::cout << "\n";
+                console.println("Map a flat unstructured mesh onto a bent structured mesh.");
+                std::cout << "\n";
+                console.println("Arguments:");
+                console.println("  bent_mesh   The bent structured reference mesh (k-file)");
+                console.println("  flat_mesh   The flat mesh to be mapped (k-file)");
+                console.println("  output      Output file path for the mapped mesh");
+                std::cout << "\n";
+                console.println("Options:");
+                console.println("  --shard <k/N>  Process only shard k (0-based) of N; combine");
+                console.println("                 the partial outputs with 'KooRemapper merge'");
+                console.println("  --refine <i,j,k>  Subdivide every flat hex i x j x k times in");
+                console.println("                 memory and map the fine mesh; a single");
+                console.println("                 value n means n,n,n");
+                console.println("  --edge-interp <m>  Curve through the bent edge nodes: linear");
+                console.println("                 (default) or cubic (C1, smooth; a coarser bent");
+                console.println("                 reference gives the same accuracy)");
+                console.println("  --format <f>   lsdyna, abaqus (.inp), nastran (free field bulk");
+                console.println("                 data) or nastran-large; default from the output");
+                console.println("                 extension (.inp, .bdf/.nas, otherwise k-file)");
+            } else if (helpCmd == "map-points") {
+                console.println("Usage: KooRemapper map-points [options] <bent_mesh> <flat_mesh> <points_in> <points_out>");
+                console.println("       KooRemapper map-points [options] --mapper <cache> <points_in> <points_out>");
+                std::cout << "\n";
+                console.println("Map points given in the flat frame onto the bent geometry.");
+                console.println("The points are streamed in chunks, so the set may exceed memory.");
+                std::cout << "\n";
+                console.println("Arguments:");
+                console.println("  bent_mesh   The bent structured reference mesh (k-file)");
+                console.println("  flat_mesh   Flat mesh whose bounding box defines the point frame");
+                console.println("  points_in   Points: CSV (x,y,z[,extra...]) or binary float64 xyz");
+                console.println("  points_out  Mapped points, same format (extra CSV columns kept)");
+                std::cout << "\n";
+                console.println("Options:");
+                console.println("  --mapper <file>  Mapper cache; written when the meshes are given,");
+                console.println("                   used instead of the meshes otherwise");
+                console.println("  --format <f>     csv or bin (default: from extension, .bin/.raw = bin)");
+                console.println("  --chunk <n>      Points per chunk (default: 1048576)");
+                console.println("  --threads <n>    Worker threads (default: all cores)");
+                console.println("  --edge-interp <m> linear (default) or cubic bent edges (as for map;");
+                console.println("                   a mapper cache keeps the mode it was built with)");
+            } else if (helpCmd == "generate") {
+                console.println("Usage: KooRemapper generate [options] <type> <output_prefix>");
+                std::cout << "\n";
+                console.println("Generate example meshes for testing.");
                 std::cout << "\n";
                 console.println("Arguments:");
                 console.println("  type           Mesh type:");
@@ -915,11 +2620,47 @@ int main(int argc, char* argv[]) {
                 console.println("  output     Output CSV file for strain data");
                 std::cout << "\n";
                 console.println("Options:");
-                console.println("  --type <t>  Strain type: engineering (default), green, log");
+                console.println("  --type <t>  Strain type: engineering (default), green, log,");
+                console.println("              a list (green,log) or all; several types are");
+                console.println("              computed in one pass, CSV columns get a type prefix");
+                console.println("  --shard <k/N>  Process only shard k (0-based) of N elements");
+            } else if (helpCmd == "merge") {
+                console.println("Usage: KooRemapper merge [--clean] <output>");
+                std::cout << "\n";
+                console.println("Combine the partial outputs of a sharded run into <output>.");
+                console.println("Shard k of a run writes <output>.shard<k> plus a small");
+                console.println("<output>.shard<k>.manifest; all N shards must be present.");
+                std::cout << "\n";
+                console.println("Options:");
+                console.println("  --clean    Delete the shard files after a successful merge");
+            } else if (helpCmd == "tune") {
+                console.println("Usage: KooRemapper tune [options]");
+                std::cout << "\n";
+                console.println("Benchmark the hot loops (batch mapping, element analysis,");
+                console.println("k-file parsing and formatting) on a synthetic mesh and save");
+                console.println("the fastest thread count and block sizes as a per-host profile.");
+                console.println("Every later run loads the profile automatically; --threads");
+                console.println("still overrides its thread count.");
+                std::cout << "\n";
+                console.println("Options:");
+                console.println("  -o, --output <file>  Profile file (default:");
+                console.println("                 ~/.kooremapper/tune-<host>.cfg, or $KOOREMAPPER_TUNE)");
+                console.println("  --dir <path>   Directory for the temporary k-file (default: .)");
+                console.println("  --quick        Smaller, shorter benchmarks");
+                console.println("  --dry-run      Print the results without saving");
+                console.println("  --show         Print the profile in effect");
+                std::cout << "\n";
+                console.println("KOOREMAPPER_TUNE=none runs without a profile.");
             } else if (helpCmd == "info") {
-                console.println("Usage: KooRemapper info <mesh_file>");
+                console.println("Usage: KooRemapper info [--preflight] <mesh_file>");
                 std::cout << "\n";
                 console.println("Display information about a mesh file.");
+                std::cout << "\n";
+                console.println("Options:");
+                console.println("  --preflight  Only scan the file: keyword blocks, record counts,");
+                console.println("               format and structural errors (truncated file,");
+                console.println("               records too short to parse), without loading it.");
+                console.println("               map and prestress run this scan before loading.");
             } else if (helpCmd == "unfold") {
                 console.println("Usage: KooRemapper unfold <bent_mesh> <output_flat>");
                 std::cout << "\n";
@@ -952,6 +2693,27 @@ int main(int argc, char* argv[]) {
                 console.println("  --nu <value>     Poisson's ratio (overrides K-file materials)");
                 console.println("  --strain <type>  Strain type: engineering (default), green");
                 console.println("  --csv            Also output strain/stress CSV file");
+                console.println("  --relax          Relax stress to a self-equilibrated field");
+                console.println("  --relax-tol <v>  Relaxation relative residual (default: 1e-6)");
+                console.println("  --relax-iter <n> Maximum relaxation iterations (default: 5000)");
+                console.println("  --residual       Report nodal force residual (equilibrium check)");
+                console.println("  --residual-out <file>  Write nodal residual vectors to CSV");
+                console.println("  --threads <n>    Worker threads (default: all cores)");
+                console.println("  --shard <k/N>    Process only shard k (0-based) of N elements");
+                console.println("  --incremental <state>  Reuse the results saved in <state> for");
+                console.println("                   elements whose deformed nodes did not move;");
+                console.println("                   the state is (re)written after every run");
+                console.println("  --analytic       ref_mesh is a flat mesh and def_mesh the bent");
+                console.println("                   reference of 'map': F is evaluated at the Gauss");
+                console.println("                   points from the mapping itself, so no mapped mesh");
+                console.println("                   is needed (smoother than nodal differences)");
+                console.println("  --edge-interp <m> Bent edge curve for --analytic (as for map)");
+                console.println("  --material-sweep <f.csv>");
+                console.println("                   Lines of 'E,nu' or 'name,E,nu': strains are computed");
+                console.println("                   once and out_<name>.dynain written for every set");
+                console.println("  --format <f>     lsdyna (dynain) or abaqus (*INITIAL CONDITIONS,");
+                console.println("                   TYPE=STRESS include); default from the output");
+                console.println("                   extension (.inp: abaqus)");
                 std::cout << "\n";
                 console.println("Material Properties:");
                 console.println("  The tool automatically reads *PART and *MAT_ELASTIC cards from");
@@ -997,11 +2759,24 @@ int main(int argc, char* argv[]) {
                 console.println("    - [50, 0]");
                 console.println("    - [100, 50]");
                 console.println("    - [150, 50]");
+                console.println("  # or a chain of segments instead of centerline_points:");
+                console.println("  # segments:");
+                console.println("  #   - type: straight   # length");
+                console.println("  #     length: 40");
+                console.println("  #     elements: 20");
+                console.println("  #   - type: arc        # radius, angle (deg, + = left)");
+                console.println("  #     radius: 5");
+                console.println("  #     angle: 180");
+                console.println("  #     elements: 30");
+                console.println("  #   - type: spline     # points relative to the segment start");
                 console.println("  interpolation: catmull_rom  # linear, catmull_rom, bspline");
                 console.println("  cross_section:  # Only if no reference");
                 console.println("    width: 10.0");
                 console.println("    thickness: 2.0");
-                console.println("  elements_along_curve: 100");
+                console.println("  cross_section_profile:  # [s/L, width scale, thickness scale]");
+                console.println("    - [0.0, 1.0, 1.0]");
+                console.println("    - [0.5, 1.5, 1.0]");
+                console.println("  elements_along_curve: 100  # or variable_density zones as above");
                 console.println("  elements_j: 20");
                 console.println("  elements_k: 5");
             } else {
@@ -1014,26 +2789,189 @@ int main(int argc, char* argv[]) {
             std::cout << "\n";
             console.println("Commands:");
             console.println("  map         Map a flat mesh onto a bent reference mesh");
+            console.println("  map-points  Map a CSV/binary point set onto a bent reference mesh");
             console.println("  unfold      Generate flat mesh from a bent structured mesh");
             console.println("  generate    Generate example meshes for testing");
             console.println("  generate-var Generate variable density mesh from YAML config");
             console.println("  strain      Calculate strain between two meshes");
             console.println("  prestress   Calculate prestress from deformed configuration");
             console.println("  info        Display information about a mesh file");
+            console.println("  merge       Merge the outputs of a sharded (--shard) run");
+            console.println("  tune        Benchmark this machine and save a tuning profile");
             console.println("  help        Show help for a command");
             console.println("  version     Show version information");
+            std::cout << "\n";
+            console.println("Global option: --metrics <file.json> writes hot-path event counts at exit.");
         }
         return 0;
     }
 
+    // Per-host tuning profile written by 'KooRemapper tune'
+    std::string profilePath;
+    {
+        std::string profileError;
+        if (!TuningProfile::loadDefault(profilePath, profileError)) {
+            console.warning(profileError + " (using built-in defaults)");
+        }
+    }
+
     // Map command
     if (command == "map") {
-        if (argc < 5) {
-            console.error("Usage: KooRemapper map <bent_mesh> <flat_mesh> <output>");
+        ArgumentParser parser("KooRemapper map", "Map a flat mesh onto a bent mesh");
+        parser.addPositional("bent_mesh", "Bent structured reference mesh (k-file)");
+        parser.addPositional("flat_mesh", "Flat mesh to be mapped (k-file)");
+        parser.addPositional("output", "Output k-file");
+        parser.addOption("", "shard", "Process shard k of N (k/N)", "");
+        parser.addOption("", "refine", "Subdivide flat hexes n or i,j,k times", "");
+        parser.addOption("", "edge-interp", "Bent edge curve: linear, cubic", "");
+        parser.addOption("", "format", "Output format: lsdyna, abaqus, nastran, nastran-large", "");
+
+        if (!parser.parse(argc - 1, argv + 1)) {
+            console.error(parser.getError());
+            return 1;
+        }
+
+        std::string bentFile = parser.getPositional("bent_mesh");
+        std::string flatFile = parser.getPositional("flat_mesh");
+        std::string output = parser.getPositional("output");
+        if (bentFile.empty() || flatFile.empty() || output.empty()) {
+            console.error("Usage: KooRemapper map [--shard k/N] [--refine i,j,k] "
+                          "<bent_mesh> <flat_mesh> <output>");
+            return 1;
+        }
+        if (!checkStdinInputs({bentFile, flatFile}, console)) {
+            return 1;
+        }
+
+        EdgeInterpolation edgeInterpolation;
+        if (!parseEdgeInterpolation(parser.getOption("edge-interp"), edgeInterpolation)) {
+            console.error("Invalid --edge-interp (use linear or cubic): " + parser.getOption("edge-interp"));
+            return 1;
+        }
+
+        ShardSpec shard;
+        std::string shardError;
+        if (!parser.getOption("shard").empty() &&
+            !parseShard(parser.getOption("shard"), shard, shardError)) {
+            console.error(shardError);
+            return 1;
+        }
+
+        OutputFormat format;
+        if (!parseOutputFormat(parser.getOption("format"), output, format)) {
+            console.error("Invalid --format (use lsdyna, abaqus, nastran or nastran-large): " +
+                          parser.getOption("format"));
+            return 1;
+        }
+
+        std::array<int, 3> refine = {{1, 1, 1}};
+        bool refined = !parser.getOption("refine").empty();
+        if (refined) {
+            std::string refineError;
+            if (!HexRefiner::parseLevels(parser.getOption("refine"), refine, refineError)) {
+                console.error(refineError);
+                return 1;
+            }
+            if (shard.active) {
+                console.error("--refine cannot be combined with --shard");
+                return 1;
+            }
+        }
+
+        // Sharded, refined and distributed runs stream k-file sections
+        bool streamed = shard.active || refined;
+#ifdef KOOREMAPPER_WITH_MPI
+        streamed = streamed || mpi.size() > 1;
+#endif
+        if (streamed && format != OutputFormat::LSDYNA) {
+            console.error("--shard, --refine and MPI runs write k-files only");
             return 1;
         }
+
         printBanner(console);
-        return runMapping(argv[2], argv[3], argv[4], console);
+#ifdef KOOREMAPPER_WITH_MPI
+        if (mpi.size() > 1) {
+            if (shard.active) {
+                if (mpi.isRoot()) console.error("--shard cannot be combined with MPI");
+                return 1;
+            }
+            if (refined) {
+                if (mpi.isRoot()) console.error("--refine cannot be combined with MPI");
+                return 1;
+            }
+            return runDistributedMapping(bentFile, flatFile, output, edgeInterpolation, mpi, console);
+        }
+#endif
+        if (refined) {
+            return runRefinedMapping(bentFile, flatFile, output, refine, edgeInterpolation, console);
+        }
+        return runMapping(bentFile, flatFile, output, shard, edgeInterpolation, format, console);
+    }
+
+    // Map-points command
+    if (command == "map-points") {
+        ArgumentParser parser("KooRemapper map-points", "Map a point set onto a bent mesh");
+        parser.addPositional("arg1", "", false);
+        parser.addPositional("arg2", "", false);
+        parser.addPositional("arg3", "", false);
+        parser.addPositional("arg4", "", false);
+        parser.addOption("", "mapper", "Mapper cache file", "");
+        parser.addOption("", "format", "Point format: csv, bin", "");
+        parser.addOption("", "chunk", "Points per chunk", "1048576");
+        parser.addOption("", "threads", "Worker threads", "0");
+        parser.addOption("", "edge-interp", "Bent edge curve: linear, cubic", "");
+
+        if (!parser.parse(argc - 1, argv + 1)) {
+            console.error(parser.getError());
+            return 1;
+        }
+
+        std::vector<std::string> args;
+        for (const char* name : {"arg1", "arg2", "arg3", "arg4"}) {
+            if (!parser.getPositional(name).empty()) args.push_back(parser.getPositional(name));
+        }
+
+        MapPointsOptions options;
+        options.mapperFile = parser.getOption("mapper");
+        std::string bentFile, flatFile;
+        if (args.size() == 4) {
+            bentFile = args[0];
+            flatFile = args[1];
+            args.erase(args.begin(), args.begin() + 2);
+        } else if (args.size() != 2 || options.mapperFile.empty()) {
+            console.error("Usage: KooRemapper map-points [options] <bent_mesh> <flat_mesh> <points_in> <points_out>");
+            console.error("       KooRemapper map-points [options] --mapper <cache> <points_in> <points_out>");
+            return 1;
+        }
+        if (!checkStdinInputs({bentFile, flatFile, options.mapperFile, args[0]}, console)) {
+            return 1;
+        }
+
+        if (!parser.getOption("format").empty()) {
+            if (!parsePointFormat(parser.getOption("format"), options.format)) {
+                console.error("Invalid --format (use csv or bin): " + parser.getOption("format"));
+                return 1;
+            }
+            options.formatSet = true;
+        }
+        int chunk = parser.getInt("chunk").value_or(0);
+        if (chunk <= 0) {
+            console.error("--chunk must be a positive number of points");
+            return 1;
+        }
+        options.chunkSize = static_cast<size_t>(chunk);
+        if (!parseEdgeInterpolation(parser.getOption("edge-interp"), options.edgeInterpolation)) {
+            console.error("Invalid --edge-interp (use linear or cubic): " + parser.getOption("edge-interp"));
+            return 1;
+        }
+
+        int threads = parser.getInt("threads").value_or(0);
+        if (threads > 0) {
+            ThreadPool::instance().setThreadCount(threads);
+        }
+
+        printBanner(console);
+        return runMapPoints(bentFile, flatFile, args[0], args[1], options, console);
     }
 
     // Unfold command
@@ -1117,7 +3055,9 @@ int main(int argc, char* argv[]) {
         parser.addPositional("ref_mesh", "Reference mesh (k-file)");
         parser.addPositional("def_mesh", "Deformed mesh (k-file)");
         parser.addPositional("output", "Output CSV file");
-        parser.addOption("", "type", "Strain type: engineering, green, log", "engineering");
+        parser.addOption("", "type", "Strain type: engineering, green, log, a list (green,log) or all",
+                         "engineering");
+        parser.addOption("", "shard", "Process shard k of N (k/N)", "");
 
         int subArgc = argc - 1;
         char** subArgv = argv + 1;
@@ -1132,14 +3072,30 @@ int main(int argc, char* argv[]) {
         std::string output = parser.getPositional("output");
         std::string strainType = parser.getOption("type");
         if (strainType.empty()) strainType = "engineering";
+        std::vector<StrainCalculator::StrainType> strainTypes;
+        if (!parseStrainTypes(strainType, strainTypes)) {
+            console.error("Invalid strain --type (use engineering, green, log, a list or all): " + strainType);
+            return 1;
+        }
 
         if (refFile.empty() || defFile.empty() || output.empty()) {
             console.error("Usage: KooRemapper strain [options] <ref_mesh> <def_mesh> <output.csv>");
             return 1;
         }
+        if (!checkStdinInputs({refFile, defFile}, console)) {
+            return 1;
+        }
+
+        ShardSpec shard;
+        std::string shardError;
+        if (!parser.getOption("shard").empty() &&
+            !parseShard(parser.getOption("shard"), shard, shardError)) {
+            console.error(shardError);
+            return 1;
+        }
 
         printBanner(console);
-        return runStrain(refFile, defFile, output, strainType, console);
+        return runStrain(refFile, defFile, output, strainTypes, shard, console);
     }
 
     // Prestress command
@@ -1152,6 +3108,18 @@ int main(int argc, char* argv[]) {
         parser.addOption("", "nu", "Poisson's ratio", "0");
         parser.addOption("", "strain", "Strain type: engineering, green", "engineering");
         parser.addFlag("", "csv", "Output CSV file");
+        parser.addFlag("", "relax", "Relax stress to equilibrium");
+        parser.addOption("", "relax-tol", "Relaxation tolerance", "1e-6");
+        parser.addOption("", "relax-iter", "Maximum relaxation iterations", "5000");
+        parser.addFlag("", "residual", "Report nodal force residual");
+        parser.addOption("", "residual-out", "Residual vector CSV file", "");
+        parser.addOption("", "threads", "Worker threads", "0");
+        parser.addOption("", "shard", "Process shard k of N (k/N)", "");
+        parser.addOption("", "incremental", "State file for incremental reruns", "");
+        parser.addFlag("", "analytic", "F from the mapping of ref_mesh onto def_mesh");
+        parser.addOption("", "edge-interp", "Bent edge curve for --analytic: linear, cubic", "");
+        parser.addOption("", "material-sweep", "CSV of E,nu sets: one output per set", "");
+        parser.addOption("", "format", "Stress output: lsdyna (dynain), abaqus (.inp)", "");
 
         int subArgc = argc - 1;
         char** subArgv = argv + 1;
@@ -1169,29 +3137,159 @@ int main(int argc, char* argv[]) {
             console.error("Usage: KooRemapper prestress [options] <ref_mesh> <def_mesh> <output>");
             return 1;
         }
+        if (!checkStdinInputs({refFile, defFile}, console)) {
+            return 1;
+        }
 
-        double E = parser.getDouble("E").value_or(0.0);
-        double nu = parser.getDouble("nu").value_or(0.0);
+        PrestressOptions options;
+        options.E = parser.getDouble("E").value_or(0.0);
+        options.nu = parser.getDouble("nu").value_or(0.0);
         std::string strainTypeStr = parser.getOption("strain");
-        bool outputCSV = parser.hasFlag("csv");
+        options.outputCSV = parser.hasFlag("csv");
+        options.relax = parser.hasFlag("relax");
+        options.relaxTolerance = parser.getDouble("relax-tol").value_or(1e-6);
+        options.relaxMaxIterations = parser.getInt("relax-iter").value_or(5000);
+        options.residual = parser.hasFlag("residual");
+        options.residualFile = parser.getOption("residual-out");
+        options.incrementalState = parser.getOption("incremental");
+        options.analytic = parser.hasFlag("analytic");
+        options.materialSweep = parser.getOption("material-sweep");
+        if (!parseEdgeInterpolation(parser.getOption("edge-interp"), options.edgeInterpolation)) {
+            console.error("Invalid --edge-interp (use linear or cubic): " + parser.getOption("edge-interp"));
+            return 1;
+        }
+
+        std::string shardError;
+        if (!parser.getOption("shard").empty() &&
+            !parseShard(parser.getOption("shard"), options.shard, shardError)) {
+            console.error(shardError);
+            return 1;
+        }
+
+        // Stresses go to dynain or Abaqus; Nastran output is geometry only
+        if (!parseOutputFormat(parser.getOption("format"), output, options.format) ||
+            options.format == OutputFormat::NASTRAN || options.format == OutputFormat::NASTRAN_LARGE) {
+            console.error("prestress writes dynain or Abaqus .inp (--format lsdyna or abaqus)");
+            return 1;
+        }
+        if (options.format != OutputFormat::LSDYNA && options.shard.active) {
+            console.error("--shard writes dynain only");
+            return 1;
+        }
 
-        StrainType strainType = StrainType::ENGINEERING;
         if (strainTypeStr == "green" || strainTypeStr == "green-lagrange") {
-            strainType = StrainType::GREEN_LAGRANGE;
+            options.strainType = StrainType::GREEN_LAGRANGE;
+        }
+
+        int threads = parser.getInt("threads").value_or(0);
+        if (threads > 0) {
+            ThreadPool::instance().setThreadCount(threads);
         }
 
         printBanner(console);
-        return runPrestress(refFile, defFile, output, E, nu, strainType, outputCSV, console);
+#ifdef KOOREMAPPER_WITH_MPI
+        if (mpi.size() > 1) {
+            if (options.shard.active) {
+                if (mpi.isRoot()) console.error("--shard cannot be combined with MPI");
+                return 1;
+            }
+            if (!options.incrementalState.empty()) {
+                if (mpi.isRoot()) console.error("--incremental cannot be combined with MPI");
+                return 1;
+            }
+            if (options.analytic) {
+                if (mpi.isRoot()) console.error("--analytic cannot be combined with MPI");
+                return 1;
+            }
+            if (!options.materialSweep.empty()) {
+                if (mpi.isRoot()) console.error("--material-sweep cannot be combined with MPI");
+                return 1;
+            }
+            if (options.format != OutputFormat::LSDYNA) {
+                if (mpi.isRoot()) console.error("MPI runs write dynain only");
+                return 1;
+            }
+            return runDistributedPrestress(refFile, defFile, output, options, mpi, console);
+        }
+#endif
+        return runPrestress(refFile, defFile, output, options, console);
+    }
+
+    // Merge command
+    if (command == "merge") {
+        ArgumentParser parser("KooRemapper merge", "Merge shard outputs");
+        parser.addPositional("output", "Final output file of the sharded run");
+        parser.addFlag("", "clean", "Delete shard files after merging");
+
+        if (!parser.parse(argc - 1, argv + 1)) {
+            console.error(parser.getError());
+            return 1;
+        }
+
+        std::string output = parser.getPositional("output");
+        if (output.empty()) {
+            console.error("Usage: KooRemapper merge [--clean] <output>");
+            return 1;
+        }
+
+        printBanner(console);
+        return runMerge(output, parser.hasFlag("clean"), console);
+    }
+
+    // Tune command
+    if (command == "tune") {
+        ArgumentParser parser("KooRemapper tune", "Benchmark this machine and save a tuning profile");
+        parser.addOption("o", "output", "Profile file", "");
+        parser.addOption("", "dir", "Directory for the temporary I/O benchmark file", ".");
+        parser.addFlag("", "quick", "Smaller, shorter benchmarks");
+        parser.addFlag("", "dry-run", "Only print the results");
+        parser.addFlag("", "show", "Print the profile in effect and exit");
+
+        if (!parser.parse(argc - 1, argv + 1)) {
+            console.error(parser.getError());
+            return 1;
+        }
+        if (parser.hasFlag("show")) {
+            return runTuneShow(profilePath, console);
+        }
+
+        // Benchmarks start from the built-in defaults
+        TuningProfile::apply(TuningProfile());
+
+        std::string output = parser.getOption("output");
+        if (output.empty()) {
+            output = TuningProfile::defaultPath();
+        }
+        if ((output.empty() || output == "none") && !parser.hasFlag("dry-run")) {
+            console.error("No profile location (set HOME or KOOREMAPPER_TUNE, or use -o <file>)");
+            return 1;
+        }
+
+        printBanner(console);
+        return runTune(output, parser.getOption("dir"), parser.hasFlag("quick"),
+                       parser.hasFlag("dry-run"), console);
     }
 
     // Info command
     if (command == "info") {
-        if (argc < 3) {
-            console.error("Usage: KooRemapper info <mesh_file>");
+        ArgumentParser parser("KooRemapper info", "Display information about a mesh file");
+        parser.addPositional("mesh_file", "Mesh file (k-file)");
+        parser.addFlag("", "preflight", "Only scan keyword blocks (no full load)");
+
+        if (!parser.parse(argc - 1, argv + 1)) {
+            console.error(parser.getError());
+            return 1;
+        }
+        std::string meshFile = parser.getPositional("mesh_file");
+        if (meshFile.empty()) {
+            console.error("Usage: KooRemapper info [--preflight] <mesh_file>");
             return 1;
         }
         printBanner(console);
-        return runInfo(argv[2], console);
+        if (parser.hasFlag("preflight")) {
+            return runPreflight(meshFile, console);
+        }
+        return runInfo(meshFile, console);
     }
 
     // Unknown command
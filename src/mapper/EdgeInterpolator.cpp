@@ -1,21 +1,55 @@
 #include "mapper/EdgeInterpolator.h"
+#include "util/Metrics.h"
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 
 namespace KooRemapper {
 
+namespace {
+
+// Tangent dP/d(chord length) at a point between the chords d0 (length h0)
+// and d1 (length h1): Bessel's weighted difference, exact for parabolas
+Vector3D besselTangent(const Vector3D& d0, double h0, const Vector3D& d1, double h1) {
+    if (h0 <= 0.0 && h1 <= 0.0) return Vector3D();
+    if (h0 <= 0.0) return d1 / h1;
+    if (h1 <= 0.0) return d0 / h0;
+    if (d0.dot(d1) <= 0.0) return Vector3D();  // Corner: no overshoot
+    return (d0 * (h1 / h0) + d1 * (h0 / h1)) / (h0 + h1);
+}
+
+// 5-point Gauss-Legendre rule on [-1, 1]
+const double GAUSS_X[5] = {0.0, -0.5384693101056831, 0.5384693101056831,
+                           -0.9061798459386640, 0.9061798459386640};
+const double GAUSS_W[5] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                           0.2369268850561891, 0.2369268850561891};
+
+} // anonymous namespace
+
 EdgeInterpolator::EdgeInterpolator()
     : totalLength_(0.0)
+    , closed_(false)
+    , mode_(EdgeInterpolation::LINEAR)
 {}
 
-void EdgeInterpolator::build(const std::vector<Vector3D>& points) {
+void EdgeInterpolator::build(const std::vector<Vector3D>& points, EdgeInterpolation mode,
+                             bool closed) {
     points_ = points;
     arcLengths_.clear();
     totalLength_ = 0.0;
+    closed_ = false;
+    mode_ = mode;
+    coefficients_.clear();
+    cubicLengths_.clear();
 
     if (points_.size() < 2) {
         return;
     }
 
+    // A closed ring's seam node is shared, so its ends coincide exactly
+    closed_ = closed && points_.size() > 2;
+    assert(!closed_ || points_.front() == points_.back());
+
     // Calculate cumulative arc lengths
     arcLengths_.push_back(0.0);
 
@@ -24,14 +58,74 @@ void EdgeInterpolator::build(const std::vector<Vector3D>& points) {
         totalLength_ += segmentLength;
         arcLengths_.push_back(totalLength_);
     }
+
+    if (mode_ == EdgeInterpolation::CUBIC) {
+        buildCubic();
+    }
+}
+
+void EdgeInterpolator::buildCubic() {
+    const size_t n = points_.size();
+    auto chord = [this](size_t i) { return arcLengths_[i + 1] - arcLengths_[i]; };
+
+    std::vector<Vector3D> tangents(n);
+    for (size_t i = 1; i + 1 < n; ++i) {
+        tangents[i] = besselTangent(points_[i] - points_[i - 1], chord(i - 1),
+                                    points_[i + 1] - points_[i], chord(i));
+    }
+    if (closed_) {
+        tangents[0] = besselTangent(points_[n - 1] - points_[n - 2], chord(n - 2),
+                                    points_[1] - points_[0], chord(0));
+        tangents[n - 1] = tangents[0];
+    } else if (n == 2) {
+        tangents[0] = tangents[1] = besselTangent(Vector3D(), 0.0, points_[1] - points_[0], chord(0));
+    } else {
+        // Parabolic end conditions
+        double h0 = chord(0);
+        double h1 = chord(n - 2);
+        tangents[0] = (h0 > 0.0) ? (points_[1] - points_[0]) * (2.0 / h0) - tangents[1] : Vector3D();
+        tangents[n - 1] = (h1 > 0.0) ? (points_[n - 1] - points_[n - 2]) * (2.0 / h1) - tangents[n - 2]
+                                     : Vector3D();
+    }
+
+    // Hermite segments in s = 0..1, and their arc lengths per sub-step
+    coefficients_.reserve(4 * (n - 1));
+    cubicLengths_.reserve(CUBIC_SAMPLES * (n - 1) + 1);
+    cubicLengths_.push_back(0.0);
+    double length = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double h = chord(i);
+        const Vector3D& p0 = points_[i];
+        const Vector3D& p1 = points_[i + 1];
+        Vector3D m0 = tangents[i] * h;
+        Vector3D m1 = tangents[i + 1] * h;
+        Vector3D b = m0;
+        Vector3D c = (p1 - p0) * 3.0 - m0 * 2.0 - m1;
+        Vector3D d = (p0 - p1) * 2.0 + m0 + m1;
+        coefficients_.insert(coefficients_.end(), {p0, b, c, d});
+
+        for (size_t k = 0; k < CUBIC_SAMPLES; ++k) {
+            double half = 0.5 / CUBIC_SAMPLES;
+            double mid = (k + 0.5) / CUBIC_SAMPLES;
+            double step = 0.0;
+            for (int g = 0; g < 5; ++g) {
+                double sg = mid + half * GAUSS_X[g];
+                step += GAUSS_W[g] * (b + (c * 2.0 + d * (3.0 * sg)) * sg).magnitude();
+            }
+            length += half * step;
+            cubicLengths_.push_back(length);
+        }
+    }
+    totalLength_ = length;
 }
 
 Vector3D EdgeInterpolator::interpolate(double t) const {
     if (points_.empty()) return Vector3D();
     if (points_.size() == 1) return points_[0];
 
-    t = std::max(0.0, std::min(1.0, t));
+    t = normalizeParameter(t);
 
+    Metrics::add(Metrics::EDGE_QUERIES);
     if (t <= 0.0) return points_.front();
     if (t >= 1.0) return points_.back();
 
@@ -40,15 +134,16 @@ Vector3D EdgeInterpolator::interpolate(double t) const {
     // This ensures physical correspondence between flat and bent meshes
     double targetLength = t * totalLength_;
 
-    // Find the segment containing this arc-length position
-    size_t idx = 0;
-    for (size_t i = 0; i + 1 < arcLengths_.size(); ++i) {
-        if (targetLength >= arcLengths_[i] && targetLength <= arcLengths_[i + 1]) {
-            idx = i;
-            break;
-        }
+    if (mode_ == EdgeInterpolation::CUBIC) {
+        double s;
+        size_t step = locateCubic(targetLength, s);
+        const Vector3D* c = &coefficients_[4 * (step / CUBIC_SAMPLES)];
+        return ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
     }
 
+    // Find the segment containing this arc-length position
+    size_t idx = locate(arcLengths_, targetLength);
+
     // Calculate local parameter within the segment
     double segmentLength = arcLengths_[idx + 1] - arcLengths_[idx];
     double localT = (segmentLength > 0)
@@ -61,7 +156,11 @@ Vector3D EdgeInterpolator::interpolate(double t) const {
 Vector3D EdgeInterpolator::tangent(double t) const {
     if (points_.size() < 2) return Vector3D(1, 0, 0);
 
-    t = std::max(0.0, std::min(1.0, t));
+    t = normalizeParameter(t);
+
+    if (mode_ == EdgeInterpolation::CUBIC) {
+        return derivative(t).normalized();
+    }
 
     auto [segIdx, localT] = findSegment(t);
 
@@ -69,14 +168,117 @@ Vector3D EdgeInterpolator::tangent(double t) const {
     return dir.normalized();
 }
 
+Vector3D EdgeInterpolator::derivative(double t) const {
+    Vector3D position, deriv;
+    evaluate(t, position, deriv);
+    return deriv;
+}
+
+void EdgeInterpolator::evaluate(double t, Vector3D& position, Vector3D& deriv) const {
+    if (points_.size() < 2 || totalLength_ <= 0.0) {
+        position = points_.empty() ? Vector3D() : points_[0];
+        deriv = Vector3D();
+        return;
+    }
+
+    t = normalizeParameter(t);
+    double targetLength = t * totalLength_;
+    Metrics::add(Metrics::EDGE_QUERIES);
+
+    if (mode_ == EdgeInterpolation::CUBIC) {
+        double s;
+        size_t step = locateCubic(targetLength, s);
+        const Vector3D* c = &coefficients_[4 * (step / CUBIC_SAMPLES)];
+        if (t <= 0.0) {
+            position = points_.front();
+        } else if (t >= 1.0) {
+            position = points_.back();
+        } else {
+            position = ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
+        }
+
+        // s is linear in arc length on each table step, so
+        // dP/dt = P'(s) * totalLength / (subLength * CUBIC_SAMPLES);
+        // zero-length steps (coincident points) take the next one
+        double subLength = cubicLengths_[step + 1] - cubicLengths_[step];
+        while (subLength <= 0.0 && step + 2 < cubicLengths_.size()) {
+            ++step;
+            subLength = cubicLengths_[step + 1] - cubicLengths_[step];
+            s = static_cast<double>(step % CUBIC_SAMPLES) / CUBIC_SAMPLES;
+            c = &coefficients_[4 * (step / CUBIC_SAMPLES)];
+        }
+        deriv = (subLength > 0.0)
+              ? (c[1] + (c[2] * 2.0 + c[3] * (3.0 * s)) * s) *
+                (totalLength_ / (subLength * CUBIC_SAMPLES))
+              : Vector3D();
+        return;
+    }
+
+    size_t idx = locate(arcLengths_, targetLength);
+
+    double segmentLength = arcLengths_[idx + 1] - arcLengths_[idx];
+    double localT = (segmentLength > 0)
+                  ? (targetLength - arcLengths_[idx]) / segmentLength
+                  : 0.0;
+
+    if (t <= 0.0) {
+        position = points_.front();
+    } else if (t >= 1.0) {
+        position = points_.back();
+    } else {
+        position = Vector3D::lerp(points_[idx], points_[idx + 1], localT);
+    }
+
+    // Skip zero-length segments for the one-sided derivative
+    while (segmentLength <= 0.0 && idx + 2 < arcLengths_.size()) {
+        ++idx;
+        segmentLength = arcLengths_[idx + 1] - arcLengths_[idx];
+    }
+    deriv = (segmentLength > 0.0)
+          ? (points_[idx + 1] - points_[idx]) * (totalLength_ / segmentLength)
+          : Vector3D();
+}
+
+double EdgeInterpolator::normalizeParameter(double t) const {
+    if (closed_ && (t < 0.0 || t > 1.0)) {
+        return t - std::floor(t);
+    }
+    return std::max(0.0, std::min(1.0, t));
+}
+
+size_t EdgeInterpolator::locate(const std::vector<double>& lengths, double targetLength) const {
+    // First i with lengths[i + 1] >= targetLength; same segment the
+    // linear scan "lengths[i] <= target <= lengths[i + 1]" picks
+    std::uint64_t steps = 0;
+    auto it = std::lower_bound(lengths.begin() + 1, lengths.end(), targetLength,
+                               [&steps](double a, double b) { ++steps; return a < b; });
+    Metrics::add(Metrics::EDGE_SEARCHES);
+    Metrics::add(Metrics::EDGE_SEARCH_STEPS, steps);
+    if (it == lengths.end()) {
+        return lengths.size() - 2;
+    }
+    return static_cast<size_t>(it - lengths.begin()) - 1;
+}
+
+size_t EdgeInterpolator::locateCubic(double targetLength, double& s) const {
+    // Table step, then s linear in arc length within the step
+    // (Kernels::mapEdgeBlend repeats these operations exactly)
+    size_t step = locate(cubicLengths_, targetLength);
+    double subLength = cubicLengths_[step + 1] - cubicLengths_[step];
+    double f = (subLength > 0) ? (targetLength - cubicLengths_[step]) / subLength : 0.0;
+    s = (static_cast<double>(step % CUBIC_SAMPLES) + f) / static_cast<double>(CUBIC_SAMPLES);
+    return step;
+}
+
 std::pair<size_t, double> EdgeInterpolator::findSegment(double t) const {
     if (totalLength_ <= 0.0) return {0, 0.0};
 
     double targetLength = t * totalLength_;
 
-    // Binary search for the segment
+    // Linear scan for the segment
     for (size_t i = 0; i + 1 < arcLengths_.size(); ++i) {
         if (targetLength >= arcLengths_[i] && targetLength <= arcLengths_[i + 1]) {
+            Metrics::add(Metrics::EDGE_LINEAR_STEPS, i + 1);
             double segmentLength = arcLengths_[i + 1] - arcLengths_[i];
             double localT = (segmentLength > 0)
                           ? (targetLength - arcLengths_[i]) / segmentLength
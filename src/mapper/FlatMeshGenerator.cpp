@@ -45,6 +45,12 @@ bool FlatMeshGenerator::analyzeBentMesh(const Mesh& bentMesh) {
         return false;
     }
 
+    // A closed ring unfolds into a strip cut at i = 0
+    if (indexer_.isPeriodic(1) || indexer_.isPeriodic(2)) {
+        errorMessage_ = "Closed meshes can be unfolded along the i direction only";
+        return false;
+    }
+
     // Build index lookup
     indexer_.buildIndexLookup(analyzedMesh_);
 
@@ -7,7 +7,7 @@
 namespace KooRemapper {
 
 MeshRemapper::MeshRemapper()
-    : bentMesh_(nullptr), flatMesh_(nullptr)
+    : bentMesh_(nullptr), flatMesh_(nullptr), hasFlatBounds_(false)
 {}
 
 void MeshRemapper::setBentMesh(const Mesh* mesh) {
@@ -18,6 +18,12 @@ void MeshRemapper::setFlatMesh(const Mesh* mesh) {
     flatMesh_ = mesh;
 }
 
+void MeshRemapper::setFlatBounds(const Vector3D& minBound, const Vector3D& maxBound) {
+    flatMin_ = minBound;
+    flatMax_ = maxBound;
+    hasFlatBounds_ = true;
+}
+
 bool MeshRemapper::performMapping() {
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -79,6 +85,17 @@ bool MeshRemapper::performMapping() {
     return true;
 }
 
+bool MeshRemapper::buildMapper() {
+    errorMessage_.clear();
+
+    if (!bentMesh_) {
+        errorMessage_ = "Bent mesh not set";
+        return false;
+    }
+
+    return step1_AnalyzeBentMesh() && step2_BuildParametricSpace();
+}
+
 bool MeshRemapper::step1_AnalyzeBentMesh() {
     // Need non-const copy for modification during indexing
     Mesh tempMesh = *bentMesh_;
@@ -99,6 +116,12 @@ bool MeshRemapper::step1_AnalyzeBentMesh() {
         return false;
     }
 
+    // A closed reference is mapped as a loop of i-edges
+    if (indexer_.isPeriodic(1) || indexer_.isPeriodic(2)) {
+        errorMessage_ = "Closed reference meshes are supported along the i direction only";
+        return false;
+    }
+
     // Build index lookup
     indexer_.buildIndexLookup(tempMesh);
 
@@ -121,7 +144,7 @@ bool MeshRemapper::step2_BuildParametricSpace() {
     boundary_.extract(tempMesh);
 
     // Build parametric mapper
-    paramMapper_.build(tempMesh, boundary_, edgeCalc_);
+    paramMapper_.build(tempMesh, boundary_, edgeCalc_, indexer_.isPeriodic(0));
 
     if (!paramMapper_.isValid()) {
         errorMessage_ = "Failed to build parametric mapper";
@@ -145,7 +168,12 @@ bool MeshRemapper::step4_MapNodes() {
 
     // Get bounding box of flat mesh
     Vector3D minBound, maxBound;
-    flatMesh_->calculateBoundingBox(minBound, maxBound);
+    if (hasFlatBounds_) {
+        minBound = flatMin_;
+        maxBound = flatMax_;
+    } else {
+        flatMesh_->calculateBoundingBox(minBound, maxBound);
+    }
 
     // Use flat mesh dimensions for parametric mapping
     double flatSizeI = maxBound.x - minBound.x;
@@ -177,7 +205,7 @@ bool MeshRemapper::step4_MapNodes() {
 
         if (flatSizeI > 0) {
             u = (flatNode.position.x - minBound.x) / flatSizeI;
-            u = std::max(0.0, std::min(1.0, u));
+            if (!paramMapper_.isClosed()) u = std::max(0.0, std::min(1.0, u));
         }
         if (flatSizeJ > 0) {
             v = (flatNode.position.y - minBound.y) / flatSizeJ;
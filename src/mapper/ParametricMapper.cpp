@@ -1,15 +1,23 @@
 #include "mapper/ParametricMapper.h"
+#include "kernels/BatchKernels.h"
+#include "util/ThreadPool.h"
+#include "util/TuningProfile.h"
+#include "util/Metrics.h"
 #include <cmath>
 #include <algorithm>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
 
 namespace KooRemapper {
 
 ParametricMapper::ParametricMapper()
-    : isValid_(false), useTransfinite_(true)
+    : isValid_(false), useTransfinite_(true), edgeInterpolation_(EdgeInterpolation::LINEAR)
 {}
 
 void ParametricMapper::build(const Mesh& mesh, const BoundaryExtractor& boundary,
-                              const EdgeCalculator& edgeCalc) {
+                              const EdgeCalculator& edgeCalc, bool closed) {
     isValid_ = false;
 
     // Get corner nodes
@@ -26,7 +34,7 @@ void ParametricMapper::build(const Mesh& mesh, const BoundaryExtractor& boundary
     }
 
     // Build edge interpolators
-    buildEdges(mesh, edgeCalc);
+    buildEdges(mesh, edgeCalc, closed);
 
     // Build face interpolators
     buildFaces();
@@ -34,12 +42,12 @@ void ParametricMapper::build(const Mesh& mesh, const BoundaryExtractor& boundary
     isValid_ = true;
 }
 
-void ParametricMapper::buildEdges(const Mesh& mesh, const EdgeCalculator& edgeCalc) {
+void ParametricMapper::buildEdges(const Mesh& mesh, const EdgeCalculator& edgeCalc, bool closed) {
     (void)mesh;  // Suppress unused warning
-    // Copy edge data from EdgeCalculator
+    // Copy edge data from EdgeCalculator; edges 0-3 run along i
     for (int i = 0; i < 12; ++i) {
         const EdgeInfo& info = edgeCalc.getEdge(i);
-        edges_[i].build(info.points);
+        edges_[i].build(info.points, edgeInterpolation_, closed && i < 4);
     }
 }
 
@@ -65,9 +73,10 @@ void ParametricMapper::buildFaces() {
 
 Vector3D ParametricMapper::mapToPhysical(double u, double v, double w) const {
     if (!isValid_) return Vector3D();
+    Metrics::add(Metrics::MAPPER_POINTS);
 
-    // Clamp to valid range
-    u = std::max(0.0, std::min(1.0, u));
+    // Clamp to valid range; the i-edges of a closed reference wrap u
+    if (!isClosed()) u = std::max(0.0, std::min(1.0, u));
     v = std::max(0.0, std::min(1.0, v));
     w = std::max(0.0, std::min(1.0, w));
 
@@ -84,6 +93,160 @@ Vector3D ParametricMapper::mapToPhysical(double u, double v, double w) const {
     return edgeBasedInterpolate(u, v, w);
 }
 
+template <bool WithDerivatives>
+void ParametricMapper::evaluateKernel(double u, double v, double w,
+                                      MappingDerivatives& out) const {
+    if (!isClosed()) u = std::max(0.0, std::min(1.0, u));
+    v = std::max(0.0, std::min(1.0, v));
+    w = std::max(0.0, std::min(1.0, w));
+
+    const double mv = 1.0 - v;
+    const double mw = 1.0 - w;
+
+    // Same blend as edgeBasedInterpolate(), plus its derivatives:
+    //   X     = mw*(mv*e0 + v*e1) + w*(mv*e2 + v*e3)
+    //   dX/du = mw*(mv*e0' + v*e1') + w*(mv*e2' + v*e3')
+    //   dX/dv = mw*(e1 - e0) + w*(e3 - e2)
+    //   dX/dw = (mv*e2 + v*e3) - (mv*e0 + v*e1)
+    Vector3D p[4];
+    Vector3D d[4];
+    for (int e = 0; e < 4; ++e) {
+        if (WithDerivatives) {
+            edges_[e].evaluate(u, p[e], d[e]);
+        } else {
+            p[e] = edges_[e].interpolate(u);
+        }
+    }
+
+    Vector3D bottom = p[0] * mv + p[1] * v;
+    Vector3D top = p[2] * mv + p[3] * v;
+    out.position = bottom * mw + top * w;
+
+    if (WithDerivatives) {
+        out.dXdu = (d[0] * mv + d[1] * v) * mw + (d[2] * mv + d[3] * v) * w;
+        out.dXdv = (p[1] - p[0]) * mw + (p[3] - p[2]) * w;
+        out.dXdw = top - bottom;
+    }
+}
+
+MappingDerivatives ParametricMapper::evaluate(double u, double v, double w) const {
+    MappingDerivatives result;
+    if (isValid_) {
+        Metrics::add(Metrics::MAPPER_POINTS);
+        evaluateKernel<true>(u, v, w, result);
+    }
+    return result;
+}
+
+void ParametricMapper::mapToPhysicalBatch(const std::vector<Vector3D>& uvw,
+                                          std::vector<Vector3D>& positions) const {
+    positions.assign(uvw.size(), Vector3D());
+    if (!isValid_) return;
+
+    // Vector3D is three packed doubles, so the arrays go to the kernel as is
+    static_assert(sizeof(Vector3D) == 3 * sizeof(double), "Vector3D must be x,y,z only");
+
+    Kernels::EdgePolyline polylines[4];
+    for (int e = 0; e < 4; ++e) {
+        const auto& points = edges_[e].getPoints();
+        polylines[e].points = points.empty() ? nullptr : &points[0].x;
+        polylines[e].arcLengths = edges_[e].getArcLengths().data();
+        polylines[e].count = points.size();
+        polylines[e].totalLength = edges_[e].getTotalLength();
+        polylines[e].closed = edges_[e].isClosed();
+        if (edgeInterpolation_ == EdgeInterpolation::CUBIC) {
+            polylines[e].cubic = &edges_[e].getCubicCoefficients()[0].x;
+            polylines[e].cubicLengths = edges_[e].getCubicLengths().data();
+            polylines[e].cubicSamples = EdgeInterpolator::CUBIC_SAMPLES;
+        }
+    }
+
+    const Kernels::KernelTable& kernels = Kernels::active();
+    ThreadPool::instance().parallelFor(uvw.size(), [&](size_t begin, size_t end) {
+        kernels.mapEdgeBlend(polylines, &uvw[begin].x, end - begin, &positions[begin].x);
+        Metrics::add(Metrics::MAPPER_BATCH_POINTS, end - begin);
+        Metrics::add(Metrics::MAPPER_KERNEL_EDGE_SEARCHES, 4 * (end - begin));
+    }, TuningProfile::active().mapChunk);
+}
+
+void ParametricMapper::evaluateBatch(const std::vector<Vector3D>& uvw,
+                                     std::vector<MappingDerivatives>& results) const {
+    results.assign(uvw.size(), MappingDerivatives());
+    if (!isValid_) return;
+
+    ThreadPool::instance().parallelFor(uvw.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            evaluateKernel<true>(uvw[i].x, uvw[i].y, uvw[i].z, results[i]);
+        }
+        Metrics::add(Metrics::MAPPER_POINTS, end - begin);
+    }, TuningProfile::active().mapChunk);
+}
+
+bool ParametricMapper::save(std::ostream& out) const {
+    if (!isValid_) return false;
+
+    auto writePoint = [&out](const Vector3D& p) {
+        out << p.x << " " << p.y << " " << p.z << "\n";
+    };
+
+    std::streamsize oldPrecision = out.precision(std::numeric_limits<double>::max_digits10);
+    if (edgeInterpolation_ == EdgeInterpolation::CUBIC) {
+        out << "interpolation cubic\n";
+    }
+    if (isClosed()) {
+        out << "closed\n";
+    }
+    out << "corners\n";
+    for (const auto& corner : corners_) {
+        writePoint(corner);
+    }
+    for (const auto& edge : edges_) {
+        out << "edge " << edge.getPointCount() << "\n";
+        for (size_t i = 0; i < edge.getPointCount(); ++i) {
+            writePoint(edge.getPoint(i));
+        }
+    }
+    out.precision(oldPrecision);
+    return static_cast<bool>(out);
+}
+
+bool ParametricMapper::load(std::istream& in) {
+    isValid_ = false;
+
+    std::string keyword;
+    if (!(in >> keyword)) return false;
+    edgeInterpolation_ = EdgeInterpolation::LINEAR;
+    if (keyword == "interpolation") {
+        std::string mode;
+        if (!(in >> mode) || mode != "cubic" || !(in >> keyword)) return false;
+        edgeInterpolation_ = EdgeInterpolation::CUBIC;
+    }
+    bool closed = false;
+    if (keyword == "closed") {
+        closed = true;
+        if (!(in >> keyword)) return false;
+    }
+    if (keyword != "corners") return false;
+    for (auto& corner : corners_) {
+        if (!(in >> corner.x >> corner.y >> corner.z)) return false;
+    }
+
+    for (size_t e = 0; e < edges_.size(); ++e) {
+        EdgeInterpolator& edge = edges_[e];
+        size_t count = 0;
+        if (!(in >> keyword >> count) || keyword != "edge" || count < 2) return false;
+        std::vector<Vector3D> points(count);
+        for (auto& p : points) {
+            if (!(in >> p.x >> p.y >> p.z)) return false;
+        }
+        edge.build(points, edgeInterpolation_, closed && e < 4);
+    }
+
+    buildFaces();
+    isValid_ = true;
+    return true;
+}
+
 bool ParametricMapper::isUFoldGeometry() const {
     // Check if start and end X coordinates of i-edges are similar
     // This indicates a U-fold shape where the mesh folds back on itself
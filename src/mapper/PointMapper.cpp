@@ -0,0 +1,125 @@
+#include "mapper/PointMapper.h"
+#include "mapper/MeshRemapper.h"
+#include "util/Metrics.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace KooRemapper {
+
+namespace {
+
+const char* CACHE_TAG = "KooRemapper mapper cache";
+const int CACHE_VERSION = 2;  // 2: closed references are marked
+
+} // anonymous namespace
+
+PointMapper::PointMapper() {}
+
+bool PointMapper::build(const Mesh& bentMesh, const Vector3D& flatMin, const Vector3D& flatMax) {
+    errorMessage_.clear();
+    Metrics::add(Metrics::MAPPER_CACHE_MISSES);
+
+    MeshRemapper remapper;
+    remapper.setBentMesh(&bentMesh);
+    remapper.setEdgeInterpolation(edgeInterpolation_);
+    if (!remapper.buildMapper()) {
+        errorMessage_ = remapper.getErrorMessage();
+        return false;
+    }
+
+    mapper_ = remapper.getParametricMapper();
+    flatMin_ = flatMin;
+    flatMax_ = flatMax;
+    return true;
+}
+
+bool PointMapper::save(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << CACHE_TAG << "\n";
+    file << "version " << CACHE_VERSION << "\n";
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << "flat " << flatMin_.x << " " << flatMin_.y << " " << flatMin_.z << " "
+         << flatMax_.x << " " << flatMax_.y << " " << flatMax_.z << "\n";
+    return mapper_.save(file) && static_cast<bool>(file);
+}
+
+bool PointMapper::load(const std::string& filename) {
+    errorMessage_.clear();
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file: " + filename;
+        return false;
+    }
+
+    std::string tag, keyword;
+    int version = 0;
+    std::getline(file, tag);
+    file >> keyword >> version;
+    if (tag != CACHE_TAG || keyword != "version" || version != CACHE_VERSION) {
+        errorMessage_ = "Not a mapper cache (or written by another version): " + filename;
+        return false;
+    }
+
+    file >> keyword >> flatMin_.x >> flatMin_.y >> flatMin_.z
+         >> flatMax_.x >> flatMax_.y >> flatMax_.z;
+    if (!file || keyword != "flat" || !mapper_.load(file)) {
+        errorMessage_ = "Invalid mapper cache: " + filename;
+        return false;
+    }
+    Metrics::add(Metrics::MAPPER_CACHE_HITS);
+    return true;
+}
+
+void PointMapper::toParametric(const std::vector<Vector3D>& points) const {
+    // Same flat -> (u,v,w) conversion as MeshRemapper::step4_MapNodes
+    // (u of a closed reference is left for the mapper to wrap)
+    const Vector3D size = flatMax_ - flatMin_;
+    auto parameter = [](double value, double minValue, double extent, bool wrap = false) {
+        if (extent <= 0) return 0.0;
+        double t = (value - minValue) / extent;
+        return wrap ? t : std::max(0.0, std::min(1.0, t));
+    };
+    const bool closed = mapper_.isClosed();
+
+    uvw_.resize(points.size());
+    ThreadPool::instance().parallelFor(points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uvw_[i] = Vector3D(parameter(points[i].x, flatMin_.x, size.x, closed),
+                               parameter(points[i].y, flatMin_.y, size.y),
+                               parameter(points[i].z, flatMin_.z, size.z));
+        }
+    }, 4096);
+}
+
+void PointMapper::mapPoints(std::vector<Vector3D>& points) const {
+    toParametric(points);
+    mapper_.mapToPhysicalBatch(uvw_, points);
+}
+
+void PointMapper::evaluatePoints(const std::vector<Vector3D>& points,
+                                 std::vector<MappingDerivatives>& results) const {
+    toParametric(points);
+    mapper_.evaluateBatch(uvw_, results);
+
+    // u = (x - min.x) / size.x, so d/dx = d/du / size.x (likewise v, w)
+    const Vector3D size = flatMax_ - flatMin_;
+    const double sx = size.x > 0 ? 1.0 / size.x : 0.0;
+    const double sy = size.y > 0 ? 1.0 / size.y : 0.0;
+    const double sz = size.z > 0 ? 1.0 / size.z : 0.0;
+    ThreadPool::instance().parallelFor(results.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i].dXdu *= sx;
+            results[i].dXdv *= sy;
+            results[i].dXdw *= sz;
+        }
+    }, 4096);
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,199 @@
+#include "parallel/DistributedMesh.h"
+#include "parser/KFileReader.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace KooRemapper {
+
+namespace {
+
+// Wire format of a node record: id followed by x, y, z
+constexpr size_t NODE_RECORD_SIZE = sizeof(int) + 3 * sizeof(double);
+
+void appendInt(std::string& buffer, int value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(int));
+}
+
+void appendNode(std::string& buffer, int id, const Vector3D& pos)
+{
+    double xyz[3] = {pos.x, pos.y, pos.z};
+    appendInt(buffer, id);
+    buffer.append(reinterpret_cast<const char*>(xyz), sizeof(xyz));
+}
+
+void readNode(const char* data, int& id, Vector3D& pos)
+{
+    double xyz[3];
+    std::memcpy(&id, data, sizeof(int));
+    std::memcpy(xyz, data + sizeof(int), sizeof(xyz));
+    pos = Vector3D(xyz[0], xyz[1], xyz[2]);
+}
+
+std::string serializeSections(const std::vector<KFileSection>& sections)
+{
+    std::ostringstream oss;
+    for (const auto& s : sections) {
+        oss << s.keyword << ' ' << s.keywordOffset << ' '
+            << s.dataBegin << ' ' << s.dataEnd << '\n';
+    }
+    return oss.str();
+}
+
+std::vector<KFileSection> deserializeSections(const std::string& text)
+{
+    std::vector<KFileSection> sections;
+    std::istringstream iss(text);
+    KFileSection s;
+    while (iss >> s.keyword >> s.keywordOffset >> s.dataBegin >> s.dataEnd) {
+        sections.push_back(s);
+    }
+    return sections;
+}
+
+} // anonymous namespace
+
+DistributedMesh::DistributedMesh(const MpiContext& mpi)
+    : mpi_(mpi)
+{}
+
+Mesh DistributedMesh::readPartition(const std::string& filename, bool readElements)
+{
+    KFileReader reader;
+
+    // Section layout: scanned once on root, status byte + payload
+    std::string layout;
+    if (mpi_.isRoot()) {
+        try {
+            layout = "O" + serializeSections(reader.scanSections(filename));
+        }
+        catch (const std::exception& e) {
+            layout = std::string("E") + e.what();
+        }
+    }
+    mpi_.broadcast(layout);
+
+    if (layout.empty() || layout[0] != 'O') {
+        throw std::runtime_error(layout.empty() ? "Cannot scan " + filename
+                                                : layout.substr(1));
+    }
+    std::vector<KFileSection> sections = deserializeSections(layout.substr(1));
+
+    Mesh mesh;
+    std::string localError;
+    try {
+        mesh = reader.readPartition(filename, sections, mpi_.rank(), mpi_.size(),
+                                    readElements);
+    }
+    catch (const std::exception& e) {
+        localError = e.what();
+    }
+
+    if (!mpi_.allTrue(localError.empty())) {
+        throw std::runtime_error(localError.empty()
+            ? "Failed to read " + filename + " on another rank"
+            : localError);
+    }
+    return mesh;
+}
+
+long long DistributedMesh::gatherNodes(const Mesh& owned, Mesh& target) const
+{
+    const int size = mpi_.size();
+    auto directoryRank = [size](int id) {
+        return static_cast<int>(static_cast<unsigned int>(id) % static_cast<unsigned int>(size));
+    };
+
+    // Round 1: register owned nodes at their directory rank
+    std::vector<std::string> send(size);
+    for (const auto& [id, node] : owned.nodes) {
+        appendNode(send[directoryRank(id)], id, node.position);
+    }
+    std::vector<std::string> received = mpi_.exchange(send);
+
+    std::unordered_map<int, Vector3D> directory;
+    for (const auto& block : received) {
+        for (size_t off = 0; off + NODE_RECORD_SIZE <= block.size(); off += NODE_RECORD_SIZE) {
+            int id;
+            Vector3D pos;
+            readNode(block.data() + off, id, pos);
+            directory[id] = pos;
+        }
+    }
+
+    // Round 2: request referenced nodes this rank does not own
+    std::unordered_set<int> needed;
+    for (const auto& [id, elem] : target.elements) {
+        for (int n : elem.nodeIds) {
+            if (n > 0) {
+                needed.insert(n);
+            }
+        }
+    }
+
+    long long requested = 0;
+    for (auto& block : send) {
+        block.clear();
+    }
+    for (int id : needed) {
+        const Node* local = owned.getNode(id);
+        if (local) {
+            target.addNode(Node(id, local->position));
+        } else {
+            appendInt(send[directoryRank(id)], id);
+            ++requested;
+        }
+    }
+    received = mpi_.exchange(send);
+
+    // Round 3: directory answers with the coordinates it knows
+    for (int r = 0; r < size; ++r) {
+        send[r].clear();
+        const std::string& block = received[r];
+        for (size_t off = 0; off + sizeof(int) <= block.size(); off += sizeof(int)) {
+            int id;
+            std::memcpy(&id, block.data() + off, sizeof(int));
+            auto it = directory.find(id);
+            if (it != directory.end()) {
+                appendNode(send[r], id, it->second);
+            }
+        }
+    }
+    received = mpi_.exchange(send);
+
+    long long found = 0;
+    for (const auto& block : received) {
+        for (size_t off = 0; off + NODE_RECORD_SIZE <= block.size(); off += NODE_RECORD_SIZE) {
+            int id;
+            Vector3D pos;
+            readNode(block.data() + off, id, pos);
+            target.addNode(Node(id, pos));
+            ++found;
+        }
+    }
+
+    return requested - found;
+}
+
+void DistributedMesh::globalBounds(const Mesh& owned, Vector3D& minBound, Vector3D& maxBound) const
+{
+    const double inf = std::numeric_limits<double>::max();
+    Vector3D localMin(inf, inf, inf);
+    Vector3D localMax(-inf, -inf, -inf);
+
+    for (const auto& [id, node] : owned.nodes) {
+        const Vector3D& p = node.position;
+        localMin = Vector3D(std::min(localMin.x, p.x), std::min(localMin.y, p.y), std::min(localMin.z, p.z));
+        localMax = Vector3D(std::max(localMax.x, p.x), std::max(localMax.y, p.y), std::max(localMax.z, p.z));
+    }
+
+    minBound = Vector3D(mpi_.minAll(localMin.x), mpi_.minAll(localMin.y), mpi_.minAll(localMin.z));
+    maxBound = Vector3D(mpi_.maxAll(localMax.x), mpi_.maxAll(localMax.y), mpi_.maxAll(localMax.z));
+}
+
+} // namespace KooRemapper
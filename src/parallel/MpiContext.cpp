@@ -0,0 +1,126 @@
+#include "parallel/MpiContext.h"
+#include <mpi.h>
+#include <stdexcept>
+
+namespace KooRemapper {
+
+MpiContext::MpiContext(int* argc, char*** argv)
+    : rank_(0)
+    , size_(1)
+{
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        MPI_Init(argc, argv);
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &size_);
+}
+
+MpiContext::~MpiContext()
+{
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        MPI_Finalize();
+    }
+}
+
+void MpiContext::barrier() const
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+double MpiContext::minAll(double value) const
+{
+    double result = value;
+    MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    return result;
+}
+
+double MpiContext::maxAll(double value) const
+{
+    double result = value;
+    MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return result;
+}
+
+double MpiContext::sumAll(double value) const
+{
+    double result = value;
+    MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return result;
+}
+
+long long MpiContext::sumAll(long long value) const
+{
+    long long result = value;
+    MPI_Allreduce(&value, &result, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    return result;
+}
+
+bool MpiContext::allTrue(bool value) const
+{
+    int local = value ? 1 : 0;
+    int result = 0;
+    MPI_Allreduce(&local, &result, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    return result == 1;
+}
+
+void MpiContext::broadcast(std::string& data, int root) const
+{
+    long long length = static_cast<long long>(data.size());
+    MPI_Bcast(&length, 1, MPI_LONG_LONG, root, MPI_COMM_WORLD);
+    data.resize(static_cast<size_t>(length));
+    if (length > 0) {
+        MPI_Bcast(&data[0], static_cast<int>(length), MPI_CHAR, root, MPI_COMM_WORLD);
+    }
+}
+
+std::vector<std::string> MpiContext::exchange(const std::vector<std::string>& send) const
+{
+    std::vector<int> sendCounts(size_), recvCounts(size_);
+    std::vector<int> sendDispl(size_), recvDispl(size_);
+
+    long long sendTotal = 0;
+    for (int r = 0; r < size_; ++r) {
+        sendCounts[r] = static_cast<int>(send[r].size());
+        sendDispl[r] = static_cast<int>(sendTotal);
+        sendTotal += sendCounts[r];
+    }
+    // Every rank must leave together: agree on the size check before the
+    // collectives, or the ranks that pass would wait forever
+    if (!allTrue(sendTotal <= 0x7fffffff)) {
+        throw std::runtime_error("MPI exchange buffer exceeds 2 GB on at least one rank");
+    }
+
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    long long recvTotal = 0;
+    for (int r = 0; r < size_; ++r) {
+        recvDispl[r] = static_cast<int>(recvTotal);
+        recvTotal += recvCounts[r];
+    }
+    if (!allTrue(recvTotal <= 0x7fffffff)) {
+        throw std::runtime_error("MPI exchange buffer exceeds 2 GB on at least one rank");
+    }
+
+    std::string sendBuffer;
+    sendBuffer.reserve(static_cast<size_t>(sendTotal));
+    for (const auto& block : send) {
+        sendBuffer += block;
+    }
+    std::string recvBuffer(static_cast<size_t>(recvTotal), '\0');
+
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispl.data(), MPI_CHAR,
+                  &recvBuffer[0], recvCounts.data(), recvDispl.data(), MPI_CHAR,
+                  MPI_COMM_WORLD);
+
+    std::vector<std::string> received(size_);
+    for (int r = 0; r < size_; ++r) {
+        received[r] = recvBuffer.substr(recvDispl[r], recvCounts[r]);
+    }
+    return received;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,97 @@
+#include "parallel/OrderedFileWriter.h"
+#include <algorithm>
+
+namespace KooRemapper {
+
+namespace {
+
+// MPI counts are int; larger blocks are written in pieces
+constexpr long long MAX_WRITE_CHUNK = 1LL << 30;
+
+} // anonymous namespace
+
+OrderedFileWriter::OrderedFileWriter(const MpiContext& mpi)
+    : mpi_(mpi)
+    , file_(MPI_FILE_NULL)
+    , isOpen_(false)
+    , offset_(0)
+{}
+
+OrderedFileWriter::~OrderedFileWriter()
+{
+    close();
+}
+
+bool OrderedFileWriter::open(const std::string& filename)
+{
+    errorMessage_.clear();
+    close();
+
+    int rc = MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL, &file_);
+    if (rc != MPI_SUCCESS) {
+        errorMessage_ = "Cannot create file: " + filename;
+        file_ = MPI_FILE_NULL;
+        return false;
+    }
+
+    // Truncate any previous content
+    if (MPI_File_set_size(file_, 0) != MPI_SUCCESS) {
+        errorMessage_ = "Cannot truncate file: " + filename;
+        MPI_File_close(&file_);
+        return false;
+    }
+
+    isOpen_ = true;
+    offset_ = 0;
+    return true;
+}
+
+bool OrderedFileWriter::write(const std::string& block)
+{
+    if (!isOpen_) {
+        errorMessage_ = "File not open";
+        return false;
+    }
+
+    long long length = static_cast<long long>(block.size());
+    long long start = 0;
+    MPI_Exscan(&length, &start, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    if (mpi_.isRoot()) {
+        start = 0;  // MPI_Exscan leaves rank 0 undefined
+    }
+
+    bool ok = true;
+    for (long long done = 0; done < length && ok; ) {
+        int count = static_cast<int>(std::min(MAX_WRITE_CHUNK, length - done));
+        MPI_Status status;
+        int rc = MPI_File_write_at(file_, offset_ + start + done,
+                                   block.data() + done, count, MPI_CHAR, &status);
+        ok = (rc == MPI_SUCCESS);
+        done += count;
+    }
+
+    offset_ += mpi_.sumAll(length);
+
+    if (!mpi_.allTrue(ok)) {
+        errorMessage_ = "Error writing output file";
+        return false;
+    }
+    return true;
+}
+
+bool OrderedFileWriter::writeRoot(const std::string& block)
+{
+    return write(mpi_.isRoot() ? block : std::string());
+}
+
+void OrderedFileWriter::close()
+{
+    if (file_ != MPI_FILE_NULL) {
+        MPI_File_close(&file_);
+    }
+    isOpen_ = false;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,184 @@
+#include "parser/AbaqusWriter.h"
+#include "core/ElementBuckets.h"
+#include "util/AsyncFileWriter.h"
+#include "util/Metrics.h"
+#include <ctime>
+#include <iomanip>
+#include <type_traits>
+
+namespace KooRemapper {
+
+namespace {
+
+std::string currentDateTime() {
+    std::time_t now = std::time(nullptr);
+    char timeStr[64];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+    return timeStr;
+}
+
+bool closeFile(AsyncOutputStream& file, const std::string& filename, std::string& error) {
+    if (!file.close()) {
+        error = file.getErrorMessage().empty() ? "Error writing " + filename
+                                               : file.getErrorMessage();
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+AbaqusWriter::AbaqusWriter()
+    : precision_(9)
+{}
+
+bool AbaqusWriter::writeFile(const std::string& filename, const Mesh& mesh,
+                             bool useMappedPositions) {
+    errorMessage_.clear();
+
+    AsyncOutputStream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot create file: " + filename;
+        return false;
+    }
+
+    bool ok = write(file, mesh, useMappedPositions);
+    std::string closeError;
+    if (!closeFile(file, filename, closeError) && ok) {
+        errorMessage_ = closeError;
+        ok = false;
+    }
+    return ok;
+}
+
+bool AbaqusWriter::write(std::ostream& out, const Mesh& mesh, bool useMappedPositions) {
+    try {
+        writeHeader(out);
+        writeNodeKeyword(out);
+        writeNodeLines(out, mesh, useMappedPositions);
+        writeElements(out, mesh);
+    }
+    catch (const std::exception& e) {
+        errorMessage_ = std::string("Error writing file: ") + e.what();
+        return false;
+    }
+    if (!out) {
+        errorMessage_ = "Error writing output stream";
+        return false;
+    }
+    return true;
+}
+
+bool AbaqusWriter::writeStressFile(const std::string& filename,
+                                   const MeshAnalysisResult& results,
+                                   const std::string& refFile,
+                                   const std::string& defFile) {
+    errorMessage_.clear();
+
+    AsyncOutputStream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file for writing: " + filename;
+        return false;
+    }
+
+    writeStressHeader(file, refFile, defFile);
+    writeStressLines(file, results);
+
+    return closeFile(file, filename, errorMessage_);
+}
+
+void AbaqusWriter::writeHeader(std::ostream& out) {
+    out << "*HEADING\n"
+        << "KooRemapper mesh\n"
+        << "**\n"
+        << "** Abaqus Input File\n"
+        << "** Generated by KooRemapper\n"
+        << "** Date: " << currentDateTime() << "\n"
+        << "**\n";
+}
+
+void AbaqusWriter::writeNodeKeyword(std::ostream& out) {
+    out << "*NODE\n";
+}
+
+void AbaqusWriter::writeNodeLines(std::ostream& out, const Mesh& mesh,
+                                  bool useMappedPositions) {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::scientific << std::setprecision(precision_);
+
+    // Mesh::nodes is ordered by ID
+    for (const auto& [id, node] : mesh.nodes) {
+        const Vector3D& pos = useMappedPositions && node.isMapped
+                            ? node.mappedPosition
+                            : node.position;
+        out << id << ", " << pos.x << ", " << pos.y << ", " << pos.z << "\n";
+    }
+    Metrics::add(Metrics::WRITER_NODE_LINES, mesh.nodes.size());
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void AbaqusWriter::writeElements(std::ostream& out, const Mesh& mesh) {
+    // Same-type runs in ID order; a new *ELEMENT block starts on every
+    // type or part change
+    ElementBuckets buckets(mesh);
+    buckets.forEachRun([&](const auto& bucket, size_t first, size_t count) {
+        using Bucket = std::decay_t<decltype(bucket)>;
+        constexpr int N = Bucket::NODES;
+        const char* type = (Bucket::TYPE == ElementType::TET4) ? "C3D4" : "C3D8";
+
+        for (size_t s = first; s < first + count; ++s) {
+            if (s == first || bucket.partIds[s] != bucket.partIds[s - 1]) {
+                out << "*ELEMENT, TYPE=" << type << ", ELSET=PART-" << bucket.partIds[s] << "\n";
+            }
+            out << bucket.ids[s];
+            for (int i = 0; i < N; ++i) {
+                out << ", " << bucket.nodeIds[s][i];
+            }
+            out << "\n";
+        }
+        Metrics::add(Metrics::WRITER_ELEMENT_LINES, count);
+    });
+}
+
+void AbaqusWriter::writeStressHeader(std::ostream& out, const std::string& refFile,
+                                     const std::string& defFile) {
+    out << "**\n"
+        << "** Abaqus Initial Stress (include file)\n"
+        << "** Generated by KooRemapper\n"
+        << "** Date: " << currentDateTime() << "\n";
+    if (!refFile.empty()) {
+        out << "** Reference mesh: " << refFile << "\n";
+    }
+    if (!defFile.empty()) {
+        out << "** Deformed mesh: " << defFile << "\n";
+    }
+    out << "**\n";
+}
+
+void AbaqusWriter::writeStressLines(std::ostream& out, const MeshAnalysisResult& results) {
+    if (!results.hasMaterial) return;
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::scientific << std::setprecision(precision_);
+
+    out << "*INITIAL CONDITIONS, TYPE=STRESS\n";
+    size_t records = 0;
+    for (const auto& r : results.elementResults) {
+        if (!r.isValid) continue;
+        // Abaqus component order: S11, S22, S33, S12, S13, S23
+        out << r.elementId << ", "
+            << r.stress.xx << ", " << r.stress.yy << ", " << r.stress.zz << ", "
+            << r.stress.xy << ", " << r.stress.xz << ", " << r.stress.yz << "\n";
+        ++records;
+    }
+    Metrics::add(Metrics::WRITER_STRESS_RECORDS, records);
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace KooRemapper
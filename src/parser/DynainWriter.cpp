@@ -1,4 +1,6 @@
 #include "parser/DynainWriter.h"
+#include "util/AsyncFileWriter.h"
+#include "util/Metrics.h"
 #include <iomanip>
 #include <sstream>
 #include <ctime>
@@ -26,7 +28,7 @@ std::string DynainWriter::getCurrentDateTime()
     return oss.str();
 }
 
-void DynainWriter::writeHeader(std::ofstream& file,
+void DynainWriter::writeHeader(std::ostream& file,
                                StrainType strainType,
                                const std::string& refFile,
                                const std::string& defFile)
@@ -52,9 +54,10 @@ void DynainWriter::writeHeader(std::ofstream& file,
     file << "$\n";
 }
 
-void DynainWriter::writeStressCard(std::ofstream& file, const ElementResult& result)
+void DynainWriter::writeStressCard(std::ostream& file, const ElementResult& result)
 {
     if (!result.isValid) return;
+    Metrics::add(Metrics::WRITER_STRESS_RECORDS);
     
     // *INITIAL_STRESS_SOLID
     // Card 1: eid, nint, nhisv, large, ics, ncomp
@@ -84,6 +87,27 @@ void DynainWriter::writeStressCard(std::ofstream& file, const ElementResult& res
     file << std::setw(10) << 0.0 << "\n";
 }
 
+void DynainWriter::writeStressCards(std::ostream& file, const MeshAnalysisResult& results)
+{
+    if (!results.hasMaterial) return;
+    
+    for (const auto& result : results.elementResults) {
+        if (result.isValid) {
+            writeStressCard(file, result);
+        }
+    }
+}
+
+bool DynainWriter::closeFile(AsyncOutputStream& file, const std::string& filename)
+{
+    if (!file.close()) {
+        errorMessage_ = file.getErrorMessage().empty() ? "Error writing " + filename
+                                                       : file.getErrorMessage();
+        return false;
+    }
+    return true;
+}
+
 bool DynainWriter::writeFile(
     const std::string& filename,
     const MeshAnalysisResult& results,
@@ -91,7 +115,7 @@ bool DynainWriter::writeFile(
     const std::string& refFile,
     const std::string& defFile)
 {
-    std::ofstream file(filename);
+    AsyncOutputStream file(filename);
     if (!file.is_open()) {
         errorMessage_ = "Cannot open file for writing: " + filename;
         return false;
@@ -101,41 +125,45 @@ bool DynainWriter::writeFile(
     writeHeader(file, strainType, refFile, defFile);
     
     // Write stress cards for each element
-    for (const auto& result : results.elementResults) {
-        if (result.isValid && results.hasMaterial) {
-            writeStressCard(file, result);
-        }
-    }
+    writeStressCards(file, results);
     
     // End keyword
     file << "*END\n";
     
-    file.close();
-    return true;
+    return closeFile(file, filename);
 }
 
 bool DynainWriter::writeStrainCSV(
     const std::string& filename,
     const MeshAnalysisResult& results)
 {
-    std::ofstream file(filename);
+    AsyncOutputStream file(filename);
     if (!file.is_open()) {
         errorMessage_ = "Cannot open file for writing: " + filename;
         return false;
     }
     
-    // Header
+    writeStrainCSVHeader(file, results.hasMaterial);
+    writeStrainCSVRows(file, results);
+    
+    return closeFile(file, filename);
+}
+
+void DynainWriter::writeStrainCSVHeader(std::ostream& file, bool hasMaterial)
+{
     file << "ElementID,CenterX,CenterY,CenterZ,"
          << "eps_xx,eps_yy,eps_zz,eps_xy,eps_yz,eps_xz,"
          << "vonMisesStrain,maxPrincipalStrain,minPrincipalStrain";
     
-    if (results.hasMaterial) {
+    if (hasMaterial) {
         file << ",sig_xx,sig_yy,sig_zz,sig_xy,sig_yz,sig_xz,"
              << "vonMisesStress,maxPrincipalStress,minPrincipalStress";
     }
     file << "\n";
-    
-    // Data rows
+}
+
+void DynainWriter::writeStrainCSVRows(std::ostream& file, const MeshAnalysisResult& results)
+{
     file << std::scientific << std::setprecision(6);
     
     for (const auto& r : results.elementResults) {
@@ -156,10 +184,29 @@ bool DynainWriter::writeStrainCSV(
         }
         file << "\n";
     }
+}
+
+bool DynainWriter::writeResidualCSV(
+    const std::string& filename,
+    const ResidualReport& report)
+{
+    AsyncOutputStream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file for writing: " + filename;
+        return false;
+    }
     
-    file.close();
-    return true;
+    file << "NodeID,X,Y,Z,Fx,Fy,Fz,Magnitude\n";
+    file << std::scientific << std::setprecision(6);
+    
+    for (const auto& r : report.nodes) {
+        file << r.nodeId << ","
+             << r.position.x << "," << r.position.y << "," << r.position.z << ","
+             << r.force.x << "," << r.force.y << "," << r.force.z << ","
+             << r.magnitude << "\n";
+    }
+    
+    return closeFile(file, filename);
 }
 
 } // namespace KooRemapper
-
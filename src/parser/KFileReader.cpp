@@ -1,5 +1,7 @@
 #include "parser/KFileReader.h"
 #include "core/Platform.h"
+#include "util/TuningProfile.h"
+#include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
@@ -12,16 +14,27 @@ KFileReader::KFileReader()
     : currentLine_(0)
     , linesProcessed_(0)
     , fileSize_(0)
+    , bytesRead_(0)
+    , hasPendingLine_(false)
     , progressCallback_(nullptr)
+    , nodeVisitor_(nullptr)
+    , counts_{}
+    , blockCounter_(Metrics::KFILE_BYTES_OTHER)
 {}
 
 Mesh KFileReader::readFile(const std::string& filename) {
-    mesh_.clear();
-    errorMessage_.clear();
-    currentLine_ = 0;
-    linesProcessed_ = 0;
+    if (Platform::isStdStream(filename)) {
+        Platform::setBinaryStdio();
+        return read(std::cin);
+    }
 
-    std::ifstream file(filename);
+    // The stream buffer must be installed before the file is opened
+    std::vector<char> buffer(TuningProfile::active().readBuffer);
+    std::ifstream file;
+    if (!buffer.empty()) {
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+    file.open(filename);
     if (!file.is_open()) {
         errorMessage_ = "Cannot open file: " + filename;
         throw std::runtime_error(errorMessage_);
@@ -32,18 +45,54 @@ Mesh KFileReader::readFile(const std::string& filename) {
     fileSize_ = file.tellg();
     file.seekg(0, std::ios::beg);
 
-    if (!parseFile(file)) {
+    return readStream(file);
+}
+
+Mesh KFileReader::read(std::istream& in) {
+    fileSize_ = 0;  // Unknown; no progress reports
+    return readStream(in);
+}
+
+Mesh KFileReader::readStream(std::istream& in) {
+    mesh_.clear();
+    errorMessage_.clear();
+    currentLine_ = 0;
+    linesProcessed_ = 0;
+    bytesRead_ = 0;
+    hasPendingLine_ = false;
+    blockCounter_ = Metrics::KFILE_BYTES_OTHER;
+
+    bool ok = parseFile(in);
+    flushMetrics();
+    if (!ok) {
         throw std::runtime_error(errorMessage_);
     }
-
-    file.close();
     return std::move(mesh_);
 }
 
-bool KFileReader::parseFile(std::ifstream& file) {
+bool KFileReader::nextLine(std::istream& in, std::string& line) {
+    if (hasPendingLine_) {
+        line.swap(pendingLine_);
+        hasPendingLine_ = false;
+        return true;
+    }
+    if (!std::getline(in, line)) {
+        return false;
+    }
+    bytesRead_ += static_cast<long long>(line.size()) + 1;
+    countLine(line);
+    return true;
+}
+
+void KFileReader::pushBackLine(const std::string& line) {
+    pendingLine_ = line;
+    hasPendingLine_ = true;
+}
+
+bool KFileReader::parseFile(std::istream& file) {
     std::string line;
 
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         linesProcessed_++;
 
@@ -87,17 +136,16 @@ bool KFileReader::parseFile(std::ifstream& file) {
             // Other keywords are skipped
         }
 
-        reportProgress(file.tellg());
+        reportProgress(bytesRead_);
     }
 
     return true;
 }
 
-bool KFileReader::parseNodeSection(std::ifstream& file) {
+bool KFileReader::parseNodeSection(std::istream& file) {
     std::string line;
-    std::streampos lastPos = file.tellg();
 
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         linesProcessed_++;
 
@@ -108,40 +156,19 @@ bool KFileReader::parseNodeSection(std::ifstream& file) {
 
         // Skip empty lines and comments
         if (line.empty() || isCommentLine(line)) {
-            lastPos = file.tellg();
             continue;
         }
 
         // Check for new keyword (end of NODE section)
         if (isKeywordLine(line)) {
-            file.seekg(lastPos);  // Go back to re-read keyword
+            pushBackLine(line);  // Re-read keyword by the caller
             currentLine_--;
             return true;
         }
 
         // Parse node data
-        // LS-DYNA format: nid, x, y, z (can be fixed or free format)
         try {
-            // Try free format first (comma or space separated)
-            auto tokens = tokenize(line);
-            if (tokens.size() >= 4) {
-                int nid = parseInt(tokens[0]);
-                double x = parseDouble(tokens[1]);
-                double y = parseDouble(tokens[2]);
-                double z = parseDouble(tokens[3]);
-
-                mesh_.addNode(nid, x, y, z);
-            }
-            else if (line.length() >= 40) {
-                // Try fixed format (8-character fields for ID, 16 for coordinates)
-                // Standard: I8, 3E16.0
-                int nid = parseInt(line.substr(0, 8));
-                double x = parseDouble(line.substr(8, 16));
-                double y = parseDouble(line.substr(24, 16));
-                double z = parseDouble(line.substr(40, 16));
-
-                mesh_.addNode(nid, x, y, z);
-            }
+            parseNodeLine(line);
         }
         catch (const std::exception& e) {
             errorMessage_ = "Error parsing node at line " + std::to_string(currentLine_) +
@@ -149,18 +176,16 @@ bool KFileReader::parseNodeSection(std::ifstream& file) {
             return false;
         }
 
-        lastPos = file.tellg();
-        reportProgress(lastPos);
+        reportProgress(bytesRead_);
     }
 
     return true;
 }
 
-bool KFileReader::parseElementSolidSection(std::ifstream& file) {
+bool KFileReader::parseElementSolidSection(std::istream& file) {
     std::string line;
-    std::streampos lastPos = file.tellg();
 
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         linesProcessed_++;
 
@@ -171,71 +196,289 @@ bool KFileReader::parseElementSolidSection(std::ifstream& file) {
 
         // Skip empty lines and comments
         if (line.empty() || isCommentLine(line)) {
-            lastPos = file.tellg();
             continue;
         }
 
         // Check for new keyword
         if (isKeywordLine(line)) {
-            file.seekg(lastPos);
+            pushBackLine(line);
             currentLine_--;
             return true;
         }
 
         // Parse element data
-        // LS-DYNA format: eid, pid, n1, n2, n3, n4, n5, n6, n7, n8
         try {
-            auto tokens = tokenize(line);
-            if (tokens.size() >= 10) {
-                int eid = parseInt(tokens[0]);
-                int pid = parseInt(tokens[1]);
-                std::array<int, 8> nodeIds;
-                for (int i = 0; i < 8; ++i) {
-                    nodeIds[i] = parseInt(tokens[2 + i]);
-                }
+            parseElementLine(line);
+        }
+        catch (const std::exception& e) {
+            errorMessage_ = "Error parsing element at line " + std::to_string(currentLine_) +
+                          ": " + e.what();
+            return false;
+        }
+
+        reportProgress(bytesRead_);
+    }
+
+    return true;
+}
+
+void KFileReader::parseNodeLine(const std::string& line) {
+    // LS-DYNA format: nid, x, y, z (can be fixed or free format)
+    // Try free format first (comma or space separated)
+    auto tokens = tokenize(line);
+    if (tokens.size() >= 4) {
+        int nid = parseInt(tokens[0]);
+        double x = parseDouble(tokens[1]);
+        double y = parseDouble(tokens[2]);
+        double z = parseDouble(tokens[3]);
+
+        if (nodeVisitor_) {
+            nodeVisitor_(nid, Vector3D(x, y, z));
+        } else {
+            mesh_.addNode(nid, x, y, z);
+        }
+    }
+    else if (line.length() >= 40) {
+        // Try fixed format (8-character fields for ID, 16 for coordinates)
+        // Standard: I8, 3E16.0
+        int nid = parseInt(line.substr(0, 8));
+        double x = parseDouble(line.substr(8, 16));
+        double y = parseDouble(line.substr(24, 16));
+        double z = parseDouble(line.substr(40, 16));
+
+        if (nodeVisitor_) {
+            nodeVisitor_(nid, Vector3D(x, y, z));
+        } else {
+            mesh_.addNode(nid, x, y, z);
+        }
+    }
+}
+
+void KFileReader::parseElementLine(const std::string& line) {
+    // LS-DYNA format: eid, pid, n1, n2, n3, n4, n5, n6, n7, n8
+    auto tokens = tokenize(line);
+    int eid = 0, pid = 0;
+    std::array<int, 8> nodeIds;
+
+    if (tokens.size() >= 10) {
+        eid = parseInt(tokens[0]);
+        pid = parseInt(tokens[1]);
+        for (int i = 0; i < 8; ++i) {
+            nodeIds[i] = parseInt(tokens[2 + i]);
+        }
+    }
+    else if (line.length() >= 80) {
+        // Try fixed format (8-character fields)
+        eid = parseInt(line.substr(0, 8));
+        pid = parseInt(line.substr(8, 8));
+        for (int i = 0; i < 8; ++i) {
+            nodeIds[i] = parseInt(line.substr(16 + i * 8, 8));
+        }
+    }
+    else {
+        return;
+    }
+
+    Element elem(eid, pid, nodeIds);
+    // Detect TET4: n5=n6=n7=n8=n4 (LS-DYNA convention)
+    if (nodeIds[4] == nodeIds[3] && nodeIds[5] == nodeIds[3] &&
+        nodeIds[6] == nodeIds[3] && nodeIds[7] == nodeIds[3]) {
+        elem.type = ElementType::TET4;
+    }
+    mesh_.addElement(elem);
+}
+
+std::vector<KFileSection> KFileReader::scanSections(const std::string& filename) {
+    if (Platform::isStdStream(filename)) {
+        errorMessage_ = "Partitioned reads need a seekable file, not stdin";
+        throw std::runtime_error(errorMessage_);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file: " + filename;
+        throw std::runtime_error(errorMessage_);
+    }
+
+    std::vector<KFileSection> sections;
+    std::string line;
+    long long pos = 0;
+
+    while (std::getline(file, line)) {
+        long long lineStart = pos;
+        pos += static_cast<long long>(line.size()) + 1;
+
+        if (!isKeywordLine(line)) continue;
+
+        if (!sections.empty()) {
+            sections.back().dataEnd = lineStart;
+        }
+
+        KFileSection section;
+        section.keyword = extractKeyword(line);
+        section.keywordOffset = lineStart;
+        section.dataBegin = pos;
+        section.dataEnd = -1;
+        sections.push_back(section);
+
+        if (section.keyword == "END") {
+            sections.back().dataEnd = pos;
+            return sections;
+        }
+    }
 
-                Element elem(eid, pid, nodeIds);
-                // Detect TET4: n5=n6=n7=n8=n4 (LS-DYNA convention)
-                if (nodeIds[4] == nodeIds[3] && nodeIds[5] == nodeIds[3] &&
-                    nodeIds[6] == nodeIds[3] && nodeIds[7] == nodeIds[3]) {
-                    elem.type = ElementType::TET4;
+    if (!sections.empty() && sections.back().dataEnd < 0) {
+        sections.back().dataEnd = pos;
+    }
+    return sections;
+}
+
+Mesh KFileReader::readPartition(const std::string& filename,
+                                const std::vector<KFileSection>& sections,
+                                int part, int numParts,
+                                bool readElements) {
+    mesh_.clear();
+    errorMessage_.clear();
+    currentLine_ = 0;
+    linesProcessed_ = 0;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file: " + filename;
+        throw std::runtime_error(errorMessage_);
+    }
+
+    // Split the concatenated data of all sections with this keyword
+    auto readShare = [&](const std::string& keyword, bool nodes) {
+        long long total = 0;
+        for (const auto& section : sections) {
+            if (section.keyword == keyword) total += section.dataEnd - section.dataBegin;
+        }
+
+        long long start = total * part / numParts;
+        long long stop = total * (part + 1) / numParts;
+        long long offset = 0;
+
+        for (const auto& section : sections) {
+            if (section.keyword != keyword) continue;
+            long long length = section.dataEnd - section.dataBegin;
+            long long begin = std::max(start, offset);
+            long long end = std::min(stop, offset + length);
+            if (begin < end) {
+                if (!parseLineRange(file, section,
+                                    section.dataBegin + (begin - offset),
+                                    section.dataBegin + (end - offset), nodes)) {
+                    return false;
                 }
-                mesh_.addElement(elem);
             }
-            else if (line.length() >= 80) {
-                // Try fixed format (8-character fields)
-                int eid = parseInt(line.substr(0, 8));
-                int pid = parseInt(line.substr(8, 8));
-                std::array<int, 8> nodeIds;
-                for (int i = 0; i < 8; ++i) {
-                    nodeIds[i] = parseInt(line.substr(16 + i * 8, 8));
-                }
+            offset += length;
+        }
+        return true;
+    };
 
-                Element elem(eid, pid, nodeIds);
-                // Detect TET4: n5=n6=n7=n8=n4 (LS-DYNA convention)
-                if (nodeIds[4] == nodeIds[3] && nodeIds[5] == nodeIds[3] &&
-                    nodeIds[6] == nodeIds[3] && nodeIds[7] == nodeIds[3]) {
-                    elem.type = ElementType::TET4;
-                }
-                mesh_.addElement(elem);
+    if (!readShare("NODE", true) || (readElements && !readShare("ELEMENT_SOLID", false))) {
+        flushMetrics();
+        throw std::runtime_error(errorMessage_);
+    }
+
+    for (const auto& section : sections) {
+        if (section.keyword != "PART" && section.keyword != "MAT_ELASTIC" &&
+            section.keyword != "MAT_001") {
+            continue;
+        }
+        file.clear();
+        file.seekg(section.dataBegin);
+        hasPendingLine_ = false;
+        blockCounter_ = keywordCounter(section.keyword);
+        if (section.keyword == "PART") {
+            parsePartSection(file);
+        } else {
+            parseMatElasticSection(file);
+        }
+    }
+
+    flushMetrics();
+    return std::move(mesh_);
+}
+
+void KFileReader::forEachNode(const std::string& filename,
+                              const std::vector<KFileSection>& sections,
+                              const NodeVisitor& visitor) {
+    errorMessage_.clear();
+    linesProcessed_ = 0;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot open file: " + filename;
+        throw std::runtime_error(errorMessage_);
+    }
+
+    nodeVisitor_ = visitor;
+    bool ok = true;
+    for (const auto& section : sections) {
+        if (section.keyword == "NODE" &&
+            !parseLineRange(file, section, section.dataBegin, section.dataEnd, true)) {
+            ok = false;
+            break;
+        }
+    }
+    nodeVisitor_ = nullptr;
+    flushMetrics();
+
+    if (!ok) {
+        throw std::runtime_error(errorMessage_);
+    }
+}
+
+bool KFileReader::parseLineRange(std::ifstream& file, const KFileSection& section,
+                                 long long begin, long long end, bool nodes) {
+    std::string line;
+    file.clear();
+
+    // A line that starts before begin belongs to the previous part
+    if (begin > section.dataBegin) {
+        file.seekg(begin - 1);
+        if (file.get() != '\n') {
+            std::getline(file, line);
+        }
+    } else {
+        file.seekg(begin);
+    }
+
+    long long pos = static_cast<long long>(file.tellg());
+    blockCounter_ = nodes ? Metrics::KFILE_BYTES_NODE : Metrics::KFILE_BYTES_ELEMENT;
+
+    while (pos < end && std::getline(file, line)) {
+        pos += static_cast<long long>(line.size()) + 1;
+        linesProcessed_++;
+        countLine(line);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || isCommentLine(line)) {
+            continue;
+        }
+
+        try {
+            if (nodes) {
+                parseNodeLine(line);
+            } else {
+                parseElementLine(line);
             }
         }
         catch (const std::exception& e) {
-            errorMessage_ = "Error parsing element at line " + std::to_string(currentLine_) +
-                          ": " + e.what();
+            errorMessage_ = std::string("Error parsing ") + (nodes ? "node" : "element") +
+                          " near byte " + std::to_string(pos) + ": " + e.what();
             return false;
         }
-
-        lastPos = file.tellg();
-        reportProgress(lastPos);
     }
 
     return true;
 }
 
-bool KFileReader::parsePartSection(std::ifstream& file) {
+bool KFileReader::parsePartSection(std::istream& file) {
     std::string line;
-    std::streampos lastPos = file.tellg();
     int dataLineCount = 0;  // Track data lines (skip comment lines)
     
     // *PART format:
@@ -244,7 +487,7 @@ bool KFileReader::parsePartSection(std::ifstream& file) {
     
     int pid = 0, secid = 0, mid = 0;
     
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         linesProcessed_++;
         
@@ -255,19 +498,17 @@ bool KFileReader::parsePartSection(std::ifstream& file) {
         
         // Skip empty lines
         if (line.empty()) {
-            lastPos = file.tellg();
             continue;
         }
         
         // Skip comment lines (but don't count as data)
         if (isCommentLine(line)) {
-            lastPos = file.tellg();
             continue;
         }
         
         // Check for new keyword (end of PART section)
         if (isKeywordLine(line)) {
-            file.seekg(lastPos);
+            pushBackLine(line);
             currentLine_--;
             return true;
         }
@@ -295,7 +536,6 @@ bool KFileReader::parsePartSection(std::ifstream& file) {
             // Non-fatal, just skip
         }
         
-        lastPos = file.tellg();
         dataLineCount++;
         
         // Only read one data line per *PART card
@@ -307,9 +547,8 @@ bool KFileReader::parsePartSection(std::ifstream& file) {
     return true;
 }
 
-bool KFileReader::parseMatElasticSection(std::ifstream& file) {
+bool KFileReader::parseMatElasticSection(std::istream& file) {
     std::string line;
-    std::streampos lastPos = file.tellg();
     int dataLineCount = 0;
     
     // *MAT_ELASTIC format:
@@ -319,7 +558,7 @@ bool KFileReader::parseMatElasticSection(std::ifstream& file) {
     int mid = 0;
     double density = 0, E = 0, nu = 0;
     
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         linesProcessed_++;
         
@@ -330,19 +569,17 @@ bool KFileReader::parseMatElasticSection(std::ifstream& file) {
         
         // Skip empty lines
         if (line.empty()) {
-            lastPos = file.tellg();
             continue;
         }
         
         // Skip comment lines
         if (isCommentLine(line)) {
-            lastPos = file.tellg();
             continue;
         }
         
         // Check for new keyword
         if (isKeywordLine(line)) {
-            file.seekg(lastPos);
+            pushBackLine(line);
             currentLine_--;
             return true;
         }
@@ -374,7 +611,6 @@ bool KFileReader::parseMatElasticSection(std::ifstream& file) {
             }
         }
         
-        lastPos = file.tellg();
         dataLineCount++;
         
         // Only need first data line for *MAT_ELASTIC
@@ -386,13 +622,12 @@ bool KFileReader::parseMatElasticSection(std::ifstream& file) {
     return true;
 }
 
-void KFileReader::skipToNextKeyword(std::ifstream& file) {
+void KFileReader::skipToNextKeyword(std::istream& file) {
     std::string line;
-    while (std::getline(file, line)) {
+    while (nextLine(file, line)) {
         currentLine_++;
         if (isKeywordLine(line)) {
-            // Seek back to re-read the keyword line
-            file.seekg(-static_cast<int>(line.length()) - 1, std::ios::cur);
+            pushBackLine(line);
             currentLine_--;
             break;
         }
@@ -404,6 +639,40 @@ bool KFileReader::isKeywordLine(const std::string& line) const {
     return line[0] == '*' && line.length() > 1 && std::isalpha(line[1]);
 }
 
+void KFileReader::countLine(const std::string& line) {
+#ifdef KOOREMAPPER_METRICS
+    if (!line.empty() && line[0] == '*') {
+        blockCounter_ = keywordCounter(extractKeyword(line));
+    }
+    counts_[Metrics::KFILE_LINES]++;
+    counts_[blockCounter_] += line.size() + 1;
+    if (line.empty() || line == "\r") {
+        counts_[Metrics::KFILE_BLANK_LINES]++;
+    } else if (line[0] == '$') {
+        counts_[Metrics::KFILE_COMMENT_LINES]++;
+    }
+#else
+    (void)line;
+#endif
+}
+
+void KFileReader::flushMetrics() {
+    for (int c = 0; c < Metrics::COUNTER_COUNT; ++c) {
+        if (counts_[c] > 0) {
+            Metrics::add(static_cast<Metrics::Counter>(c), counts_[c]);
+        }
+    }
+    counts_.fill(0);
+}
+
+Metrics::Counter KFileReader::keywordCounter(const std::string& keyword) {
+    if (keyword == "NODE") return Metrics::KFILE_BYTES_NODE;
+    if (keyword == "ELEMENT_SOLID") return Metrics::KFILE_BYTES_ELEMENT;
+    if (keyword == "PART") return Metrics::KFILE_BYTES_PART;
+    if (keyword == "MAT_ELASTIC" || keyword == "MAT_001") return Metrics::KFILE_BYTES_MATERIAL;
+    return Metrics::KFILE_BYTES_OTHER;
+}
+
 bool KFileReader::isCommentLine(const std::string& line) const {
     if (line.empty()) return false;
     return line[0] == '$';
@@ -489,9 +758,9 @@ int KFileReader::parseInt(const std::string& str) const {
     }
 }
 
-void KFileReader::reportProgress(std::streampos currentPos) {
+void KFileReader::reportProgress(long long bytesRead) {
     if (progressCallback_ && fileSize_ > 0) {
-        int percent = static_cast<int>((static_cast<long>(currentPos) * 100) / fileSize_);
+        int percent = static_cast<int>((bytesRead * 100) / fileSize_);
         progressCallback_(percent);
     }
 }
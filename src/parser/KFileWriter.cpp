@@ -1,8 +1,12 @@
 #include "parser/KFileWriter.h"
+#include "core/ElementBuckets.h"
+#include "util/AsyncFileWriter.h"
+#include "util/Metrics.h"
 #include <sstream>
 #include <iomanip>
 #include <ctime>
 #include <algorithm>
+#include <type_traits>
 
 namespace KooRemapper {
 
@@ -16,32 +20,46 @@ bool KFileWriter::writeFile(const std::string& filename, const Mesh& mesh,
                             bool useMappedPositions) {
     errorMessage_.clear();
 
-    std::ofstream file(filename);
+    // Lines are formatted here while the previous buffer goes to disk
+    AsyncOutputStream file(filename);
     if (!file.is_open()) {
         errorMessage_ = "Cannot create file: " + filename;
         return false;
     }
 
+    bool ok = write(file, mesh, useMappedPositions);
+    if (!file.close() && ok) {
+        errorMessage_ = file.getErrorMessage().empty() ? "Error writing " + filename
+                                                       : file.getErrorMessage();
+        ok = false;
+    }
+    return ok;
+}
+
+bool KFileWriter::write(std::ostream& out, const Mesh& mesh, bool useMappedPositions) {
     try {
         if (includeHeader_) {
-            writeHeader(file);
+            writeHeader(out);
         }
 
-        writeNodeSection(file, mesh, useMappedPositions);
-        writeElementSection(file, mesh);
-        writeEnd(file);
-
-        file.close();
-        return true;
+        writeNodeKeyword(out);
+        writeNodeLines(out, mesh, useMappedPositions);
+        writeElementKeyword(out);
+        writeElementLines(out, mesh);
+        writeEnd(out);
     }
     catch (const std::exception& e) {
         errorMessage_ = std::string("Error writing file: ") + e.what();
-        file.close();
         return false;
     }
+    if (!out) {
+        errorMessage_ = "Error writing output stream";
+        return false;
+    }
+    return true;
 }
 
-void KFileWriter::writeHeader(std::ofstream& file) {
+void KFileWriter::writeHeader(std::ostream& file) {
     // Get current time
     std::time_t now = std::time(nullptr);
     char timeStr[64];
@@ -54,11 +72,13 @@ void KFileWriter::writeHeader(std::ofstream& file) {
     file << "$" << std::endl;
 }
 
-void KFileWriter::writeNodeSection(std::ofstream& file, const Mesh& mesh,
-                                   bool useMappedPositions) {
+void KFileWriter::writeNodeKeyword(std::ostream& file) {
     file << "*NODE" << std::endl;
     file << "$#   nid               x               y               z" << std::endl;
+}
 
+void KFileWriter::writeNodeLines(std::ostream& file, const Mesh& mesh,
+                                 bool useMappedPositions) {
     // Sort nodes by ID for consistent output
     std::vector<std::pair<int, const Node*>> sortedNodes;
     for (const auto& [id, node] : mesh.nodes) {
@@ -72,52 +92,69 @@ void KFileWriter::writeNodeSection(std::ofstream& file, const Mesh& mesh,
         const Vector3D& pos = useMappedPositions && node.isMapped
                             ? node.mappedPosition
                             : node.position;
-
-        file << std::setw(8) << node.id
-             << formatDouble(pos.x)
-             << formatDouble(pos.y)
-             << formatDouble(pos.z)
-             << std::endl;
+        writeNodeLine(file, node.id, pos);
     }
 }
 
-void KFileWriter::writeElementSection(std::ofstream& file, const Mesh& mesh) {
+void KFileWriter::writeNodeLine(std::ostream& file, int id, const Vector3D& pos) {
+    Metrics::add(Metrics::WRITER_NODE_LINES);
+    file << std::setw(8) << id
+         << formatDouble(pos.x)
+         << formatDouble(pos.y)
+         << formatDouble(pos.z)
+         << std::endl;
+}
+
+void KFileWriter::writeElementKeyword(std::ostream& file) {
     file << "*ELEMENT_SOLID" << std::endl;
     file << "$#   eid     pid      n1      n2      n3      n4      n5      n6      n7      n8" << std::endl;
+}
 
-    // Sort elements by ID
-    std::vector<std::pair<int, const Element*>> sortedElements;
-    for (const auto& [id, elem] : mesh.elements) {
-        sortedElements.push_back({id, &elem});
-    }
-    std::sort(sortedElements.begin(), sortedElements.end(),
-              [](const auto& a, const auto& b) { return a.first < b.first; });
-
-    for (const auto& [id, elemPtr] : sortedElements) {
-        const Element& elem = *elemPtr;
-
-        file << std::setw(8) << elem.id
-             << std::setw(8) << elem.partId;
-
-        if (elem.type == ElementType::TET4) {
-            // TET4: write 4 nodes, then repeat n4 for n5-n8 (LS-DYNA convention)
-            for (int i = 0; i < 4; ++i) {
-                file << std::setw(8) << elem.nodeIds[i];
-            }
-            for (int i = 4; i < 8; ++i) {
-                file << std::setw(8) << elem.nodeIds[3];  // Repeat n4
+void KFileWriter::writeElementLines(std::ostream& file, const Mesh& mesh) {
+    // Same-type runs in ID order, each written by the loop for its type
+    ElementBuckets buckets(mesh);
+    buckets.forEachRun([&](const auto& bucket, size_t first, size_t count) {
+        constexpr int N = std::decay_t<decltype(bucket)>::NODES;
+        for (size_t s = first; s < first + count; ++s) {
+            const auto& nodes = bucket.nodeIds[s];
+            file << std::setw(8) << bucket.ids[s]
+                 << std::setw(8) << bucket.partIds[s];
+            for (int i = 0; i < N; ++i) {
+                file << std::setw(8) << nodes[i];
             }
-        } else {
-            // HEX8 and others: write all 8 nodes
-            for (int i = 0; i < Element::NUM_NODES; ++i) {
-                file << std::setw(8) << elem.nodeIds[i];
+            // TET4: repeat n4 for n5-n8 (LS-DYNA convention)
+            for (int i = N; i < Element::NUM_NODES; ++i) {
+                file << std::setw(8) << nodes[N - 1];
             }
+            file << std::endl;
+        }
+        Metrics::add(Metrics::WRITER_ELEMENT_LINES, count);
+    });
+}
+
+void KFileWriter::writeElementLine(std::ostream& file, const Element& elem) {
+    Metrics::add(Metrics::WRITER_ELEMENT_LINES);
+    file << std::setw(8) << elem.id
+         << std::setw(8) << elem.partId;
+
+    if (elem.type == ElementType::TET4) {
+        // TET4: write 4 nodes, then repeat n4 for n5-n8 (LS-DYNA convention)
+        for (int i = 0; i < 4; ++i) {
+            file << std::setw(8) << elem.nodeIds[i];
+        }
+        for (int i = 4; i < 8; ++i) {
+            file << std::setw(8) << elem.nodeIds[3];  // Repeat n4
+        }
+    } else {
+        // HEX8 and others: write all 8 nodes
+        for (int i = 0; i < Element::NUM_NODES; ++i) {
+            file << std::setw(8) << elem.nodeIds[i];
         }
-        file << std::endl;
     }
+    file << std::endl;
 }
 
-void KFileWriter::writeEnd(std::ofstream& file) {
+void KFileWriter::writeEnd(std::ostream& file) {
     file << "*END" << std::endl;
 }
 
@@ -0,0 +1,200 @@
+#include "parser/NastranWriter.h"
+#include "core/ElementBuckets.h"
+#include "util/AsyncFileWriter.h"
+#include "util/Metrics.h"
+#include <algorithm>
+#include <ctime>
+#include <initializer_list>
+#include <iomanip>
+#include <stdexcept>
+#include <type_traits>
+
+namespace KooRemapper {
+
+namespace {
+
+// 9 significant digits still fit a 16-character field with a 3-digit exponent
+const int REAL_PRECISION = 8;
+
+bool allDistinct(std::initializer_list<int> ids) {
+    for (auto a = ids.begin(); a != ids.end(); ++a) {
+        for (auto b = a + 1; b != ids.end(); ++b) {
+            if (*a == *b) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Nastran entry of an 8-node solid and its grid IDs; collapsed hexes in
+ * the LS-DYNA conventions become CPENTA (n5=n6, n7=n8), CPYRAM
+ * (n5=n6=n7=n8) or CTETRA (n4=...=n8). nullptr if there is none.
+ */
+const char* solidEntry(const std::array<int, 8>& n, int* grids, int& count) {
+    if (allDistinct({n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]})) {
+        std::copy(n.begin(), n.end(), grids);
+        count = 8;
+        return "CHEXA";
+    }
+    const bool baseDistinct = allDistinct({n[0], n[1], n[2], n[3]});
+    if (baseDistinct && n[4] == n[5] && n[5] == n[6] && n[6] == n[7]) {
+        if (n[4] == n[3]) {
+            std::copy(n.begin(), n.begin() + 4, grids);
+            count = 4;
+            return "CTETRA";
+        }
+        if (allDistinct({n[0], n[1], n[2], n[3], n[4]})) {
+            std::copy(n.begin(), n.begin() + 5, grids);
+            count = 5;
+            return "CPYRAM";
+        }
+    }
+    if (n[4] == n[5] && n[6] == n[7] && allDistinct({n[0], n[1], n[2], n[3], n[4], n[6]})) {
+        // Triangles (n1, n2, n5) and (n4, n3, n7) face each other
+        const int order[6] = {0, 1, 4, 3, 2, 6};
+        for (int i = 0; i < 6; ++i) grids[i] = n[order[i]];
+        count = 6;
+        return "CPENTA";
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+NastranWriter::NastranWriter()
+    : format_(NastranField::FREE)
+{}
+
+bool NastranWriter::writeFile(const std::string& filename, const Mesh& mesh,
+                              bool useMappedPositions) {
+    errorMessage_.clear();
+
+    AsyncOutputStream file(filename);
+    if (!file.is_open()) {
+        errorMessage_ = "Cannot create file: " + filename;
+        return false;
+    }
+
+    bool ok = write(file, mesh, useMappedPositions);
+    if (!file.close() && ok) {
+        errorMessage_ = file.getErrorMessage().empty() ? "Error writing " + filename
+                                                       : file.getErrorMessage();
+        ok = false;
+    }
+    return ok;
+}
+
+bool NastranWriter::write(std::ostream& out, const Mesh& mesh, bool useMappedPositions) {
+    try {
+        writeHeader(out);
+        writeNodeLines(out, mesh, useMappedPositions);
+        writeElementLines(out, mesh);
+        writeEnd(out);
+    }
+    catch (const std::exception& e) {
+        errorMessage_ = std::string("Error writing file: ") + e.what();
+        return false;
+    }
+    if (!out) {
+        errorMessage_ = "Error writing output stream";
+        return false;
+    }
+    return true;
+}
+
+void NastranWriter::writeHeader(std::ostream& out) {
+    std::time_t now = std::time(nullptr);
+    char timeStr[64];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+    out << "$\n"
+        << "$ Nastran Bulk Data (" << (format_ == NastranField::LARGE ? "large" : "free")
+        << " field)\n"
+        << "$ Generated by KooRemapper\n"
+        << "$ Date: " << timeStr << "\n"
+        << "$\n"
+        << "BEGIN BULK\n";
+}
+
+void NastranWriter::writeNodeLines(std::ostream& out, const Mesh& mesh,
+                                   bool useMappedPositions) {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::scientific << std::uppercase << std::setprecision(REAL_PRECISION);
+
+    // Mesh::nodes is ordered by ID
+    for (const auto& [id, node] : mesh.nodes) {
+        const Vector3D& pos = useMappedPositions && node.isMapped
+                            ? node.mappedPosition
+                            : node.position;
+        if (format_ == NastranField::LARGE) {
+            out << "GRID*   " << std::setw(16) << id << std::setw(16) << ""
+                << std::setw(16) << pos.x << std::setw(16) << pos.y << "\n"
+                << "*       " << std::setw(16) << pos.z << "\n";
+        } else {
+            out << "GRID*," << id << ",," << pos.x << "," << pos.y << "\n"
+                << "*," << pos.z << "\n";
+        }
+    }
+    Metrics::add(Metrics::WRITER_NODE_LINES, mesh.nodes.size());
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void NastranWriter::writeElementLines(std::ostream& out, const Mesh& mesh) {
+    // Same-type runs in ID order, each written by the loop for its type
+    ElementBuckets buckets(mesh);
+    buckets.forEachRun([&](const auto& bucket, size_t first, size_t count) {
+        using Bucket = std::decay_t<decltype(bucket)>;
+        constexpr int N = Bucket::NODES;
+
+        int fields[2 + N];
+        for (size_t s = first; s < first + count; ++s) {
+            fields[0] = bucket.ids[s];
+            fields[1] = bucket.partIds[s];
+            if constexpr (N == 4) {
+                std::copy(bucket.nodeIds[s].begin(), bucket.nodeIds[s].end(), fields + 2);
+                writeIntEntry(out, "CTETRA", fields, 2 + N);
+            } else {
+                // Nastran rejects repeated grids, so collapsed hexes change entry
+                int grids = 0;
+                const char* name = solidEntry(bucket.nodeIds[s], fields + 2, grids);
+                if (!name) {
+                    throw std::runtime_error("element " + std::to_string(bucket.ids[s]) +
+                                             " repeats nodes in a way no Nastran solid supports");
+                }
+                writeIntEntry(out, name, fields, 2 + grids);
+            }
+        }
+        Metrics::add(Metrics::WRITER_ELEMENT_LINES, count);
+    });
+}
+
+void NastranWriter::writeIntEntry(std::ostream& out, const char* name,
+                                  const int* fields, int count) {
+    if (format_ == NastranField::LARGE) {
+        out << std::left << std::setw(8) << (std::string(name) + "*") << std::right;
+        for (int i = 0; i < count; ++i) {
+            if (i > 0 && i % 4 == 0) {
+                out << "\n*       ";
+            }
+            out << std::setw(16) << fields[i];
+        }
+    } else {
+        out << name;
+        for (int i = 0; i < count; ++i) {
+            if (i > 0 && i % 8 == 0) {
+                out << "\n+";
+            }
+            out << "," << fields[i];
+        }
+    }
+    out << "\n";
+}
+
+void NastranWriter::writeEnd(std::ostream& out) {
+    out << "ENDDATA\n";
+}
+
+} // namespace KooRemapper
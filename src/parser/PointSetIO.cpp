@@ -0,0 +1,301 @@
+#include "parser/PointSetIO.h"
+#include "core/Platform.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace KooRemapper {
+
+namespace {
+
+std::string lowerExtension(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return "";
+    }
+    std::string ext = path.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext;
+}
+
+bool isSeparator(char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == ';';
+}
+
+bool isBlank(const std::string& line) {
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+// Parse one number starting at pos (leading blanks skipped); advance pos past it
+bool parseNumber(const std::string& line, size_t& pos, double& value) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    const char* begin = line.c_str() + pos;
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    if (end == begin) return false;
+    pos += static_cast<size_t>(end - begin);
+    return true;
+}
+
+// Skip the separator after a column (blanks around a single , or ;)
+void skipSeparator(const std::string& line, size_t& pos) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    if (pos < line.size() && (line[pos] == ',' || line[pos] == ';')) ++pos;
+}
+
+} // anonymous namespace
+
+PointFormat pointFormatFromPath(const std::string& path) {
+    std::string ext = lowerExtension(path);
+    if (ext == "bin" || ext == "raw" || ext == "xyzb") {
+        return PointFormat::BINARY;
+    }
+    return PointFormat::CSV;
+}
+
+bool parsePointFormat(const std::string& text, PointFormat& format) {
+    if (text == "csv") {
+        format = PointFormat::CSV;
+        return true;
+    }
+    if (text == "bin" || text == "binary") {
+        format = PointFormat::BINARY;
+        return true;
+    }
+    return false;
+}
+
+// ============================================================
+// PointSetReader
+// ============================================================
+
+PointSetReader::PointSetReader()
+    : in_(nullptr)
+    , format_(PointFormat::CSV)
+    , hasPending_(false)
+    , separator_(',')
+    , lineNumber_(0)
+    , pointsRead_(0)
+{}
+
+bool PointSetReader::open(const std::string& filename, PointFormat format) {
+    close();
+    errorMessage_.clear();
+    header_.clear();
+    pending_.clear();
+    hasPending_ = false;
+    separator_ = ',';
+    lineNumber_ = 0;
+    pointsRead_ = 0;
+    filename_ = filename;
+    format_ = format;
+
+    if (Platform::isStdStream(filename)) {
+        Platform::setBinaryStdio();
+        in_ = &std::cin;
+    } else {
+        file_.open(filename, std::ios::binary);
+        if (!file_.is_open()) {
+            errorMessage_ = "Cannot open file: " + filename;
+            return false;
+        }
+        in_ = &file_;
+    }
+    if (format_ == PointFormat::BINARY) {
+        return true;
+    }
+
+    // First non-blank line: header if it does not start with x,y,z
+    std::string line;
+    while (std::getline(*in_, line)) {
+        ++lineNumber_;
+        if (!isBlank(line)) break;
+    }
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (isBlank(line)) {
+        return true;  // Empty point set
+    }
+
+    Vector3D point;
+    std::string extra;
+    if (parseLine(line, point, extra)) {
+        pending_ = line;
+        hasPending_ = true;
+    } else {
+        header_ = line;
+    }
+
+    // Separator of the first data line (or of the header)
+    const std::string& sample = hasPending_ ? pending_ : header_;
+    size_t pos = sample.find_first_of(",;\t");
+    separator_ = (pos != std::string::npos) ? sample[pos] : ' ';
+    return true;
+}
+
+bool PointSetReader::parseLine(const std::string& line, Vector3D& point,
+                               std::string& extra) const {
+    size_t pos = 0;
+    double xyz[3];
+    for (int c = 0; c < 3; ++c) {
+        if (c > 0) skipSeparator(line, pos);
+        if (!parseNumber(line, pos, xyz[c])) return false;
+        if (pos < line.size() && !isSeparator(line[pos]) && line[pos] != '\r') return false;
+    }
+    point = Vector3D(xyz[0], xyz[1], xyz[2]);
+
+    // Everything after the z column (without its separator)
+    skipSeparator(line, pos);
+    extra = (pos < line.size()) ? line.substr(pos) : std::string();
+    while (!extra.empty() && (extra.back() == '\r' || extra.back() == ' ')) extra.pop_back();
+    return true;
+}
+
+size_t PointSetReader::read(PointChunk& chunk, size_t maxPoints) {
+    chunk.clear();
+    if (!in_ || hasError() || maxPoints == 0) {
+        return 0;
+    }
+
+    if (format_ == PointFormat::BINARY) {
+        std::vector<double> raw(maxPoints * 3);
+        in_->read(reinterpret_cast<char*>(raw.data()),
+                  static_cast<std::streamsize>(raw.size() * sizeof(double)));
+        size_t bytes = static_cast<size_t>(in_->gcount());
+        if (bytes % (3 * sizeof(double)) != 0) {
+            errorMessage_ = "Truncated binary point file (size not a multiple of 24 bytes): " +
+                            filename_;
+            return 0;
+        }
+        size_t count = bytes / (3 * sizeof(double));
+        chunk.points.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            chunk.points[i] = Vector3D(raw[3 * i], raw[3 * i + 1], raw[3 * i + 2]);
+        }
+        pointsRead_ += static_cast<long long>(count);
+        return count;
+    }
+
+    chunk.points.reserve(maxPoints);
+    chunk.extras.reserve(maxPoints);
+    bool anyExtra = false;
+    std::string line;
+    Vector3D point;
+    std::string extra;
+    while (chunk.points.size() < maxPoints) {
+        if (hasPending_) {
+            line.swap(pending_);
+            hasPending_ = false;
+        } else {
+            if (!std::getline(*in_, line)) break;
+            ++lineNumber_;
+            if (isBlank(line)) continue;
+        }
+        if (!parseLine(line, point, extra)) {
+            errorMessage_ = "Invalid point at line " + std::to_string(lineNumber_) +
+                            " of " + filename_;
+            chunk.clear();
+            return 0;
+        }
+        chunk.points.push_back(point);
+        chunk.extras.push_back(extra);
+        anyExtra = anyExtra || !extra.empty();
+    }
+    if (!anyExtra) {
+        chunk.extras.clear();
+    }
+
+    pointsRead_ += static_cast<long long>(chunk.points.size());
+    return chunk.points.size();
+}
+
+void PointSetReader::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    file_.clear();
+    in_ = nullptr;
+}
+
+// ============================================================
+// PointSetWriter
+// ============================================================
+
+PointSetWriter::PointSetWriter()
+    : format_(PointFormat::CSV)
+    , separator_(',')
+{}
+
+bool PointSetWriter::open(const std::string& filename, PointFormat format,
+                          const std::string& header, char separator) {
+    errorMessage_.clear();
+    filename_ = filename;
+    format_ = format;
+    separator_ = separator;
+
+    // Chunks are formatted on the caller's thread while earlier ones are
+    // written out, so mapping the next chunk overlaps the disk writes
+    if (!file_.open(filename, std::ios::binary)) {
+        errorMessage_ = "Cannot create file: " + filename;
+        return false;
+    }
+    if (format_ == PointFormat::CSV && !header.empty()) {
+        file_ << header << '\n';
+    }
+    return true;
+}
+
+bool PointSetWriter::write(const PointChunk& chunk) {
+    if (!file_.is_open()) {
+        errorMessage_ = "Point output not open";
+        return false;
+    }
+
+    if (format_ == PointFormat::BINARY) {
+        std::vector<double> raw(chunk.points.size() * 3);
+        for (size_t i = 0; i < chunk.points.size(); ++i) {
+            raw[3 * i] = chunk.points[i].x;
+            raw[3 * i + 1] = chunk.points[i].y;
+            raw[3 * i + 2] = chunk.points[i].z;
+        }
+        file_.write(reinterpret_cast<const char*>(raw.data()),
+                    static_cast<std::streamsize>(raw.size() * sizeof(double)));
+    } else {
+        const bool hasExtras = !chunk.extras.empty();
+        char line[96];
+        for (size_t i = 0; i < chunk.points.size(); ++i) {
+            const Vector3D& p = chunk.points[i];
+            int n = std::snprintf(line, sizeof(line), "%.10g%c%.10g%c%.10g",
+                                  p.x, separator_, p.y, separator_, p.z);
+            file_.write(line, n);
+            if (hasExtras && !chunk.extras[i].empty()) {
+                file_.put(separator_);
+                file_.write(chunk.extras[i].data(),
+                            static_cast<std::streamsize>(chunk.extras[i].size()));
+            }
+            file_.put('\n');
+        }
+    }
+
+    if (!file_) {
+        errorMessage_ = "Error writing " + filename_;
+        return false;
+    }
+    return true;
+}
+
+bool PointSetWriter::close() {
+    if (!file_.is_open()) {
+        return errorMessage_.empty();
+    }
+    if (!file_.close()) {
+        errorMessage_ = "Error writing " + filename_;
+        return false;
+    }
+    return true;
+}
+
+} // namespace KooRemapper
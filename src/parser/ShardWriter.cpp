@@ -0,0 +1,228 @@
+#include "parser/ShardWriter.h"
+#include "core/Platform.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace KooRemapper {
+
+namespace {
+
+const char* MANIFEST_TAG = "KooRemapper shard manifest";
+
+} // anonymous namespace
+
+// ============================================================
+// ShardWriter
+// ============================================================
+
+ShardWriter::ShardWriter()
+    : shard_(0)
+    , numShards_(1)
+{}
+
+std::string ShardWriter::partialPath(const std::string& output, int shard) {
+    return output + ".shard" + std::to_string(shard);
+}
+
+std::string ShardWriter::manifestPath(const std::string& output, int shard) {
+    return partialPath(output, shard) + ".manifest";
+}
+
+bool ShardWriter::open(const std::string& output, int shard, int numShards) {
+    errorMessage_.clear();
+    segments_.clear();
+
+    if (numShards < 1 || shard < 0 || shard >= numShards) {
+        errorMessage_ = "Invalid shard " + std::to_string(shard) + "/" + std::to_string(numShards);
+        return false;
+    }
+
+    if (Platform::isStdStream(output)) {
+        errorMessage_ = "Sharded runs need a named output file, not stdout";
+        return false;
+    }
+
+    output_ = output;
+    shard_ = shard;
+    numShards_ = numShards;
+
+    std::string path = partialPath(output, shard);
+    if (!file_.open(path, std::ios::binary)) {
+        errorMessage_ = "Cannot create file: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool ShardWriter::write(const std::string& block) {
+    if (!file_.is_open()) {
+        errorMessage_ = "Shard output not open";
+        return false;
+    }
+    file_.write(block.data(), static_cast<std::streamsize>(block.size()));
+    if (!file_) {
+        errorMessage_ = "Error writing " + partialPath(output_, shard_);
+        return false;
+    }
+    segments_.push_back(static_cast<long long>(block.size()));
+    return true;
+}
+
+bool ShardWriter::writeFirst(const std::string& block) {
+    return write(shard_ == 0 ? block : std::string());
+}
+
+bool ShardWriter::close() {
+    if (!file_.is_open()) {
+        return errorMessage_.empty();
+    }
+    if (!file_.close()) {
+        errorMessage_ = "Error writing " + partialPath(output_, shard_);
+        return false;
+    }
+
+    std::string path = manifestPath(output_, shard_);
+    std::ofstream manifest(path);
+    if (!manifest.is_open()) {
+        errorMessage_ = "Cannot create file: " + path;
+        return false;
+    }
+
+    manifest << MANIFEST_TAG << "\n";
+    manifest << "shard " << shard_ << " " << numShards_ << "\n";
+    manifest << "segments " << segments_.size() << "\n";
+    for (long long length : segments_) {
+        manifest << length << "\n";
+    }
+    return static_cast<bool>(manifest);
+}
+
+// ============================================================
+// ShardMerger
+// ============================================================
+
+ShardMerger::ShardMerger()
+    : shardCount_(0)
+    , bytesWritten_(0)
+{}
+
+bool ShardMerger::readManifest(const std::string& output, int shard, int& numShards,
+                               std::vector<long long>& segments) {
+    std::string path = ShardWriter::manifestPath(output, shard);
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        errorMessage_ = "Missing shard manifest: " + path;
+        return false;
+    }
+
+    std::string tag, keyword;
+    int index = -1;
+    size_t count = 0;
+    std::getline(file, tag);
+    file >> keyword >> index >> numShards;
+    if (tag != MANIFEST_TAG || keyword != "shard" || index != shard) {
+        errorMessage_ = "Invalid shard manifest: " + path;
+        return false;
+    }
+    file >> keyword >> count;
+    if (keyword != "segments") {
+        errorMessage_ = "Invalid shard manifest: " + path;
+        return false;
+    }
+
+    segments.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!(file >> segments[i]) || segments[i] < 0) {
+            errorMessage_ = "Invalid shard manifest: " + path;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ShardMerger::merge(const std::string& output, bool removeParts) {
+    errorMessage_.clear();
+    shardCount_ = 0;
+    bytesWritten_ = 0;
+
+    // Layout of every shard
+    int numShards = 0;
+    std::vector<std::vector<long long>> segments(1);
+    if (!readManifest(output, 0, numShards, segments[0])) {
+        return false;
+    }
+    if (numShards < 1) {
+        errorMessage_ = "Invalid shard count in " + ShardWriter::manifestPath(output, 0);
+        return false;
+    }
+
+    segments.resize(numShards);
+    for (int k = 1; k < numShards; ++k) {
+        int n = 0;
+        if (!readManifest(output, k, n, segments[k])) {
+            return false;
+        }
+        if (n != numShards || segments[k].size() != segments[0].size()) {
+            errorMessage_ = "Shard " + std::to_string(k) + " does not match shard 0 "
+                            "(different run or command?)";
+            return false;
+        }
+    }
+
+    std::vector<std::ifstream> parts(numShards);
+    for (int k = 0; k < numShards; ++k) {
+        std::string path = ShardWriter::partialPath(output, k);
+        parts[k].open(path, std::ios::binary);
+        if (!parts[k].is_open()) {
+            errorMessage_ = "Missing shard output: " + path;
+            return false;
+        }
+    }
+
+    // Reading the next shard overlaps writing the previous block
+    AsyncOutputStream out(output, std::ios::binary);
+    if (!out.is_open()) {
+        errorMessage_ = "Cannot create file: " + output;
+        return false;
+    }
+
+    // Segment s of the output = segment s of shard 0, 1, ..., N-1
+    std::vector<char> buffer(1 << 20);
+    for (size_t s = 0; s < segments[0].size(); ++s) {
+        for (int k = 0; k < numShards; ++k) {
+            long long remaining = segments[k][s];
+            while (remaining > 0) {
+                std::streamsize chunk = static_cast<std::streamsize>(
+                    std::min<long long>(remaining, static_cast<long long>(buffer.size())));
+                parts[k].read(buffer.data(), chunk);
+                if (parts[k].gcount() != chunk) {
+                    errorMessage_ = "Shard output truncated: " + ShardWriter::partialPath(output, k);
+                    return false;
+                }
+                out.write(buffer.data(), chunk);
+                remaining -= chunk;
+                bytesWritten_ += chunk;
+            }
+        }
+    }
+
+    if (!out.close()) {
+        errorMessage_ = "Error writing " + output;
+        return false;
+    }
+
+    for (auto& part : parts) {
+        part.close();
+    }
+    if (removeParts) {
+        for (int k = 0; k < numShards; ++k) {
+            std::remove(ShardWriter::partialPath(output, k).c_str());
+            std::remove(ShardWriter::manifestPath(output, k).c_str());
+        }
+    }
+
+    shardCount_ = numShards;
+    return true;
+}
+
+} // namespace KooRemapper
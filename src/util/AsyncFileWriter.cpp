@@ -0,0 +1,230 @@
+#include "util/AsyncFileWriter.h"
+#include "core/Platform.h"
+#include "util/Metrics.h"
+#include "util/TuningProfile.h"
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+namespace KooRemapper {
+
+// ============================================================
+// AsyncFileWriter
+// ============================================================
+
+AsyncFileWriter::AsyncFileWriter()
+    : file_(nullptr)
+    , ownsFile_(false)
+    , current_(0)
+    , threaded_(false)
+    , stop_(false)
+    , failed_(false)
+    , bytesWritten_(0)
+{}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    close();
+}
+
+bool AsyncFileWriter::open(const std::string& filename, std::ios::openmode mode,
+                           size_t bufferSize, size_t bufferCount) {
+    close();
+    errorMessage_.clear();
+    failed_ = false;
+    bytesWritten_ = 0;
+
+    if (Platform::isStdStream(filename)) {
+        file_ = stdout;
+        ownsFile_ = false;
+        filename_ = "<stdout>";
+    } else {
+        const bool binary = (mode & std::ios::binary) != 0;
+        const char* fopenMode = (mode & std::ios::app) ? (binary ? "ab" : "a")
+                                                       : (binary ? "wb" : "w");
+        file_ = std::fopen(filename.c_str(), fopenMode);
+        if (!file_) {
+            errorMessage_ = "Cannot create file: " + filename;
+            return false;
+        }
+        // Buffers are already large; let fwrite go straight to the OS
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+        ownsFile_ = true;
+        filename_ = filename;
+    }
+
+    bufferSize = std::max<size_t>(bufferSize, 1);
+    bufferCount = std::max<size_t>(bufferCount, 2);
+    buffers_.assign(bufferCount, std::vector<char>(bufferSize));
+    ready_.clear();
+    free_.clear();
+    for (size_t i = 1; i < bufferCount; ++i) {
+        free_.push_back(i);
+    }
+    current_ = 0;
+    setp(buffers_[0].data(), buffers_[0].data() + bufferSize);
+
+    stop_ = false;
+    threaded_ = true;
+    try {
+        thread_ = std::thread(&AsyncFileWriter::writerLoop, this);
+    }
+    catch (const std::system_error&) {
+        threaded_ = false;
+    }
+    return true;
+}
+
+bool AsyncFileWriter::close() {
+    if (!file_) {
+        return !failed_;
+    }
+
+    submit();
+    if (threaded_) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        readyCv_.notify_one();
+        thread_.join();
+        threaded_ = false;
+    }
+
+    int status = ownsFile_ ? std::fclose(file_) : std::fflush(file_);
+    if (status != 0 && !failed_) {
+        failed_ = true;
+        errorMessage_ = "Error writing " + filename_;
+    }
+    file_ = nullptr;
+    buffers_.clear();
+    setp(nullptr, nullptr);
+    return !failed_;
+}
+
+bool AsyncFileWriter::submit() {
+    size_t length = static_cast<size_t>(pptr() - pbase());
+    if (length == 0) {
+        return !failed_;
+    }
+
+    if (!threaded_) {
+        writeBuffer(current_, length);
+    } else {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.emplace_back(current_, length);
+        readyCv_.notify_one();
+        freeCv_.wait(lock, [this] { return !free_.empty(); });
+        current_ = free_.back();
+        free_.pop_back();
+    }
+
+    std::vector<char>& buffer = buffers_[current_];
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return !failed_;
+}
+
+void AsyncFileWriter::writeBuffer(size_t index, size_t length) {
+    // After a failure buffers are still recycled, so the producer never stalls
+    if (failed_) {
+        return;
+    }
+    size_t written = std::fwrite(buffers_[index].data(), 1, length, file_);
+    bytesWritten_ += static_cast<long long>(written);
+    Metrics::add(Metrics::WRITER_BUFFER_WRITES);
+    Metrics::add(Metrics::WRITER_BYTES, written);
+    if (written != length) {
+        errorMessage_ = "Error writing " + filename_;
+        failed_ = true;
+    }
+}
+
+void AsyncFileWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        readyCv_.wait(lock, [this] { return stop_ || !ready_.empty(); });
+        if (ready_.empty()) {
+            break;
+        }
+        std::pair<size_t, size_t> job = ready_.front();
+        ready_.pop_front();
+
+        lock.unlock();
+        writeBuffer(job.first, job.second);
+        lock.lock();
+
+        free_.push_back(job.first);
+        freeCv_.notify_one();
+    }
+}
+
+AsyncFileWriter::int_type AsyncFileWriter::overflow(int_type ch) {
+    if (!file_ || !submit()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize AsyncFileWriter::xsputn(const char* data, std::streamsize count) {
+    if (!file_) {
+        return 0;
+    }
+    std::streamsize done = 0;
+    while (done < count) {
+        std::streamsize room = epptr() - pptr();
+        if (room == 0) {
+            if (!submit()) {
+                break;
+            }
+            continue;
+        }
+        std::streamsize n = std::min(room, count - done);
+        std::memcpy(pptr(), data + done, static_cast<size_t>(n));
+        // pbump takes an int; n is bounded by the buffer size
+        pbump(static_cast<int>(n));
+        done += n;
+    }
+    return done;
+}
+
+int AsyncFileWriter::sync() {
+    return failed_ ? -1 : 0;
+}
+
+// ============================================================
+// AsyncOutputStream
+// ============================================================
+
+AsyncOutputStream::AsyncOutputStream()
+    : std::ostream(nullptr)
+{
+    rdbuf(&writer_);
+}
+
+AsyncOutputStream::AsyncOutputStream(const std::string& filename, std::ios::openmode mode)
+    : AsyncOutputStream()
+{
+    open(filename, mode);
+}
+
+bool AsyncOutputStream::open(const std::string& filename, std::ios::openmode mode) {
+    if (!writer_.open(filename, mode, TuningProfile::active().writeBuffer)) {
+        setstate(std::ios::failbit);
+        return false;
+    }
+    clear();
+    return true;
+}
+
+bool AsyncOutputStream::close() {
+    bool ok = writer_.close() && !bad();
+    if (!ok) {
+        setstate(std::ios::badbit);
+    }
+    return ok;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,199 @@
+#include "util/AutoTuner.h"
+#include "analysis/ElementAnalyzer.h"
+#include "core/Platform.h"
+#include "example/ExampleMeshGenerator.h"
+#include "grid/BoundaryExtractor.h"
+#include "grid/ConnectivityAnalyzer.h"
+#include "grid/EdgeCalculator.h"
+#include "grid/StructuredGridIndexer.h"
+#include "mapper/ParametricMapper.h"
+#include "parser/KFileReader.h"
+#include "parser/KFileWriter.h"
+#include "util/ThreadPool.h"
+#include "util/Timer.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace KooRemapper {
+
+namespace {
+
+// Candidates within this factor of the fastest count as equal
+const double TIE_FACTOR = 1.03;
+
+std::vector<size_t> threadCandidates() {
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> values;
+    for (size_t t = 1; t < cores; t *= 2) {
+        values.push_back(t);
+    }
+    values.push_back(cores);
+    return values;
+}
+
+} // anonymous namespace
+
+AutoTuner::AutoTuner()
+    : quick_(false)
+    , workDir_(".")
+{}
+
+double AutoTuner::timeBest(const std::function<void()>& body) const {
+    const double minTotal = quick_ ? 0.05 : 0.3;
+    const int maxRuns = 50;
+
+    body();  // Warm-up: page faults, caches, pool start-up
+
+    double best = std::numeric_limits<double>::max();
+    double total = 0;
+    for (int runs = 0; runs < 3 || (total < minTotal && runs < maxRuns); ++runs) {
+        Timer timer;
+        timer.start();
+        body();
+        timer.stop();
+        double seconds = timer.elapsedSec();
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+void AutoTuner::sweep(const std::string& benchmark, const std::string& parameter,
+                      const std::vector<size_t>& values, TuningProfile& profile,
+                      const std::function<void(TuningProfile&, size_t)>& set,
+                      const std::function<void()>& body) {
+    TuningSweep result;
+    result.benchmark = benchmark;
+    result.parameter = parameter;
+    result.values = values;
+
+    for (size_t value : values) {
+        TuningProfile candidate = profile;
+        set(candidate, value);
+        TuningProfile::apply(candidate);
+        result.seconds.push_back(timeBest(body));
+    }
+
+    double best = *std::min_element(result.seconds.begin(), result.seconds.end());
+    while (result.seconds[result.chosen] > best * TIE_FACTOR) {
+        ++result.chosen;
+    }
+    set(profile, values[result.chosen]);
+    TuningProfile::apply(profile);
+
+    sweeps_.push_back(result);
+    if (sweepCallback_) {
+        sweepCallback_(result);
+    }
+}
+
+bool AutoTuner::run(TuningProfile& profile) {
+    sweeps_.clear();
+    errorMessage_.clear();
+    const TuningProfile saved = TuningProfile::active();
+    profile = TuningProfile();
+    TuningProfile::apply(profile);
+
+    // Synthetic reference: the same bent ARC block in flat and bent form
+    ExampleMeshConfig config;
+    config.bentType = BentMeshType::ARC;
+    config.dimI = quick_ ? 40 : 80;
+    config.dimJ = quick_ ? 12 : 24;
+    config.dimK = quick_ ? 12 : 24;
+
+    ExampleMeshGenerator generator;
+    Mesh flat = generator.generateFlatMesh(config);
+    Mesh bent = generator.generateBentMesh(config);
+
+    std::string pairError;
+    if (!ElementAnalyzer::validateMeshPair(flat, bent, pairError)) {
+        errorMessage_ = "Benchmark meshes do not match: " + pairError;
+        TuningProfile::apply(saved);
+        return false;
+    }
+
+    ParametricMapper mapper;
+    {
+        Mesh reference = bent;
+        ConnectivityAnalyzer connectivity;
+        StructuredGridIndexer indexer;
+        BoundaryExtractor boundary;
+        EdgeCalculator edgeCalc;
+        connectivity.buildConnectivity(reference);
+        if (indexer.assignIndices(reference, connectivity)) {
+            boundary.extract(reference);
+            edgeCalc.calculateAllEdges(reference, boundary);
+            mapper.build(reference, boundary, edgeCalc, indexer.isPeriodic(0));
+        }
+    }
+    if (!mapper.isValid()) {
+        errorMessage_ = "Cannot build the benchmark mapper";
+        TuningProfile::apply(saved);
+        return false;
+    }
+
+    // Batch mapping: random parametric points
+    std::vector<Vector3D> uvw(quick_ ? 200000 : 1000000);
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (auto& p : uvw) {
+        p = Vector3D(unit(random), unit(random), unit(random));
+    }
+    std::vector<Vector3D> positions;
+    auto mapBatch = [&]() { mapper.mapToPhysicalBatch(uvw, positions); };
+
+    sweep("map batch", "threads", threadCandidates(), profile,
+          [](TuningProfile& p, size_t v) { p.threads = static_cast<int>(v); }, mapBatch);
+    sweep("map batch", "map_chunk", {64, 256, 1024, 4096, 16384}, profile,
+          [](TuningProfile& p, size_t v) { p.mapChunk = v; }, mapBatch);
+
+    // Element analysis (strain and stress)
+    ElementAnalyzer analyzer;
+    analyzer.setMaterial(MaterialModel::isotropicElastic(200000.0, 0.3));
+    sweep("hex analysis", "element_chunk", {16, 64, 256, 1024}, profile,
+          [](TuningProfile& p, size_t v) { p.elementChunk = v; },
+          [&]() { analyzer.analyzeMesh(flat, bent); });
+
+    // Parsing and formatting through a temporary k-file
+    const std::string kfile = workDir_ + PATH_SEPARATOR_STR + "kooremapper_tune.k";
+    KFileWriter writer;
+    if (!writer.writeFile(kfile, bent)) {
+        errorMessage_ = writer.getErrorMessage();
+        TuningProfile::apply(saved);
+        return false;
+    }
+
+    bool readOk = true;
+    sweep("k-file parse", "read_buffer", {0, 65536, 262144, 1048576, 4194304}, profile,
+          [](TuningProfile& p, size_t v) { p.readBuffer = v; },
+          [&]() {
+              try {
+                  KFileReader reader;
+                  reader.readFile(kfile);
+              } catch (const std::exception& e) {
+                  errorMessage_ = e.what();
+                  readOk = false;
+              }
+          });
+
+    bool writeOk = readOk;
+    if (readOk) {
+        sweep("k-file format", "write_buffer", {262144, 1 << 20, 4 << 20, 16 << 20}, profile,
+              [](TuningProfile& p, size_t v) { p.writeBuffer = v; },
+              [&]() {
+                  if (!writer.writeFile(kfile, bent)) {
+                      errorMessage_ = writer.getErrorMessage();
+                      writeOk = false;
+                  }
+              });
+    }
+    std::remove(kfile.c_str());
+
+    TuningProfile::apply(saved);
+    return writeOk;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,135 @@
+#include "util/CpuFeatures.h"
+#include <atomic>
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace KooRemapper {
+
+namespace {
+
+IsaLevel detectLevel() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // libgcc/compiler-rt also check that the OS saves the wide registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        return IsaLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return IsaLevel::AVX2;
+    }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuidex(info, 1, 0);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (osxsave && avx) {
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        const bool avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 17)) != 0;
+        if (avx512 && (xcr0 & 0xE6) == 0xE6) {
+            return IsaLevel::AVX512;
+        }
+        if (avx2 && fma && (xcr0 & 0x6) == 0x6) {
+            return IsaLevel::AVX2;
+        }
+    }
+#endif
+    return IsaLevel::BASELINE;
+}
+
+// Highest level that is both supported and compiled, capped by the env override
+IsaLevel selectLevel() {
+    IsaLevel best = CpuFeatures::detected();
+    const char* env = std::getenv("KOOREMAPPER_ISA");
+    IsaLevel cap;
+    if (env && CpuFeatures::parse(env, cap) && cap < best) {
+        best = cap;
+    }
+    while (best != IsaLevel::BASELINE && !CpuFeatures::isCompiled(best)) {
+        best = static_cast<IsaLevel>(static_cast<int>(best) - 1);
+    }
+    return best;
+}
+
+std::atomic<int> g_active{-1};
+
+} // anonymous namespace
+
+IsaLevel CpuFeatures::detected() {
+    static const IsaLevel level = detectLevel();
+    return level;
+}
+
+bool CpuFeatures::isCompiled(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::BASELINE:
+            return true;
+        case IsaLevel::AVX2:
+#ifdef KOOREMAPPER_KERNELS_AVX2
+            return true;
+#else
+            return false;
+#endif
+        case IsaLevel::AVX512:
+#ifdef KOOREMAPPER_KERNELS_AVX512
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+IsaLevel CpuFeatures::active() {
+    int level = g_active.load(std::memory_order_acquire);
+    if (level < 0) {
+        int selected = static_cast<int>(selectLevel());
+        g_active.compare_exchange_strong(level, selected, std::memory_order_acq_rel);
+        return static_cast<IsaLevel>(g_active.load(std::memory_order_acquire));
+    }
+    return static_cast<IsaLevel>(level);
+}
+
+bool CpuFeatures::setActive(IsaLevel level) {
+    if (level > detected() || !isCompiled(level)) {
+        return false;
+    }
+    g_active.store(static_cast<int>(level), std::memory_order_release);
+    return true;
+}
+
+const char* CpuFeatures::name(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::BASELINE: return "baseline";
+        case IsaLevel::AVX2:     return "avx2";
+        case IsaLevel::AVX512:   return "avx512";
+    }
+    return "unknown";
+}
+
+bool CpuFeatures::parse(const std::string& text, IsaLevel& level) {
+    for (IsaLevel candidate : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (text == name(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string CpuFeatures::describe() {
+    std::string built;
+    for (IsaLevel level : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (isCompiled(level)) {
+            built += (built.empty() ? "" : " ") + std::string(name(level));
+        }
+    }
+    return std::string(name(active())) + " (cpu: " + name(detected()) + ", built: " + built + ")";
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,132 @@
+#include "util/MappedFile.h"
+
+#ifdef PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace KooRemapper {
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+#ifdef PLATFORM_WINDOWS
+    , fileHandle_(INVALID_HANDLE_VALUE)
+    , mappingHandle_(nullptr)
+#else
+    , fd_(-1)
+#endif
+{}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef PLATFORM_WINDOWS
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    errorMessage_.clear();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        errorMessage_ = "Cannot open file: " + filename;
+        return false;
+    }
+    fileHandle_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        errorMessage_ = "Cannot determine size of " + filename;
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+        return true;
+    }
+
+    mappingHandle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle_) {
+        data_ = static_cast<const char*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!data_) {
+        errorMessage_ = "Cannot map file: " + filename;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mappingHandle_) {
+        CloseHandle(mappingHandle_);
+    }
+    if (fileHandle_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mappingHandle_ = nullptr;
+    fileHandle_ = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    errorMessage_.clear();
+
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        errorMessage_ = "Cannot open file: " + filename;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) {
+        errorMessage_ = "Not a regular file: " + filename;
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+        return true;
+    }
+
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (address == MAP_FAILED) {
+        errorMessage_ = "Cannot map file: " + filename;
+        size_ = 0;
+        close();
+        return false;
+    }
+    data_ = static_cast<const char*>(address);
+    // One front-to-back pass
+    madvise(address, size_, MADV_SEQUENTIAL);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    fd_ = -1;
+}
+
+#endif
+
+} // namespace KooRemapper
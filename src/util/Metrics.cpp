@@ -0,0 +1,137 @@
+#include "util/Metrics.h"
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace KooRemapper {
+namespace Metrics {
+
+namespace {
+
+const char* const NAMES[COUNTER_COUNT] = {
+    "kfile.lines",
+    "kfile.comment_lines",
+    "kfile.blank_lines",
+    "kfile.bytes.node",
+    "kfile.bytes.element_solid",
+    "kfile.bytes.part",
+    "kfile.bytes.material",
+    "kfile.bytes.other",
+    "edge.queries",
+    "edge.searches",
+    "edge.search_steps",
+    "edge.linear_steps",
+    "mapper.points",
+    "mapper.batch_points",
+    "mapper.kernel_edge_searches",
+    "mapper.cache_hits",
+    "mapper.cache_misses",
+    "analysis.elements",
+    "analysis.node_lookups",
+    "analysis.material_lookups",
+    "writer.node_lines",
+    "writer.element_lines",
+    "writer.stress_records",
+    "writer.buffer_writes",
+    "writer.bytes"
+};
+
+#ifdef KOOREMAPPER_METRICS
+struct Registry {
+    std::mutex mutex;
+    std::deque<std::unique_ptr<ThreadBlock>> blocks;
+};
+
+// Never destroyed: threads may still count during static destruction
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+#endif
+
+double ratio(std::uint64_t numerator, std::uint64_t denominator) {
+    return denominator > 0 ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+}
+
+} // anonymous namespace
+
+const char* name(Counter counter) {
+    return (counter >= 0 && counter < COUNTER_COUNT) ? NAMES[counter] : "unknown";
+}
+
+#ifdef KOOREMAPPER_METRICS
+ThreadBlock* registerThread() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.blocks.push_back(std::make_unique<ThreadBlock>());
+    return r.blocks.back().get();
+}
+#endif
+
+Values snapshot() {
+    Values sum{};
+#ifdef KOOREMAPPER_METRICS
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& block : r.blocks) {
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            sum[c] += block->values[c].load(std::memory_order_relaxed);
+        }
+    }
+#endif
+    return sum;
+}
+
+size_t threadCount() {
+#ifdef KOOREMAPPER_METRICS
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.blocks.size();
+#else
+    return 0;
+#endif
+}
+
+bool writeJson(const std::string& filename, std::string& error) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        error = "Cannot create metrics file: " + filename;
+        return false;
+    }
+
+    Values v = snapshot();
+    file << "{\n"
+         << "  \"enabled\": " << (enabled() ? "true" : "false") << ",\n"
+         << "  \"threads\": " << threadCount() << ",\n"
+         << "  \"counters\": {\n";
+    for (int c = 0; c < COUNTER_COUNT; ++c) {
+        file << "    \"" << NAMES[c] << "\": " << v[c] << (c + 1 < COUNTER_COUNT ? ",\n" : "\n");
+    }
+
+    std::uint64_t kfileBytes = v[KFILE_BYTES_NODE] + v[KFILE_BYTES_ELEMENT] + v[KFILE_BYTES_PART] +
+                               v[KFILE_BYTES_MATERIAL] + v[KFILE_BYTES_OTHER];
+    file << std::setprecision(6)
+         << "  },\n"
+         << "  \"derived\": {\n"
+         << "    \"kfile.bytes\": " << kfileBytes << ",\n"
+         << "    \"kfile.skipped_fraction\": "
+         << ratio(v[KFILE_COMMENT_LINES] + v[KFILE_BLANK_LINES], v[KFILE_LINES]) << ",\n"
+         << "    \"edge.steps_per_search\": " << ratio(v[EDGE_SEARCH_STEPS], v[EDGE_SEARCHES]) << ",\n"
+         << "    \"edge.searches_per_query\": " << ratio(v[EDGE_SEARCHES], v[EDGE_QUERIES]) << ",\n"
+         << "    \"analysis.lookups_per_element\": "
+         << ratio(v[ANALYSIS_NODE_LOOKUPS] + v[ANALYSIS_MATERIAL_LOOKUPS], v[ANALYSIS_ELEMENTS]) << ",\n"
+         << "    \"writer.bytes_per_buffer\": " << ratio(v[WRITER_BYTES], v[WRITER_BUFFER_WRITES]) << "\n"
+         << "  }\n"
+         << "}\n";
+
+    if (!file) {
+        error = "Error writing " + filename;
+        return false;
+    }
+    return true;
+}
+
+} // namespace Metrics
+} // namespace KooRemapper
@@ -0,0 +1,201 @@
+#include "util/ThreadPool.h"
+#include <algorithm>
+
+namespace KooRemapper {
+
+namespace {
+    // True while the current thread executes a parallel body
+    thread_local bool t_insideParallel = false;
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool::ThreadPool()
+    : threadCount_(1)
+    , stop_(false)
+    , generation_(0)
+    , pending_(0)
+    , body_(nullptr)
+    , count_(0)
+    , chunk_(1)
+    , numChunks_(0)
+    , nextChunk_(0)
+{
+    setThreadCount(0);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+void ThreadPool::setThreadCount(int count)
+{
+    std::lock_guard<std::mutex> callLock(callMutex_);
+
+    size_t total = count > 0 ? static_cast<size_t>(count)
+                             : std::max(1u, std::thread::hardware_concurrency());
+
+    stopWorkers();
+    startWorkers(total - 1);
+    threadCount_ = static_cast<int>(workers_.size()) + 1;
+}
+
+int ThreadPool::threadCount() const
+{
+    return threadCount_;
+}
+
+void ThreadPool::startWorkers(size_t count)
+{
+    // New workers must only react to jobs published after they start, so
+    // they begin at the current generation rather than 0
+    size_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+        generation = generation_;
+    }
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, generation);
+    }
+}
+
+void ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void ThreadPool::workerLoop(size_t seen)
+{
+    t_insideParallel = true;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                finished_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runChunks()
+{
+    size_t c;
+    while ((c = nextChunk_.fetch_add(1)) < numChunks_) {
+        size_t begin = c * chunk_;
+        size_t end = std::min(count_, begin + chunk_);
+        try {
+            (*body_)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const RangeBody& body, size_t minChunk)
+{
+    if (count == 0) return;
+
+    // Nested calls run serially (the outer call holds callMutex_)
+    if (t_insideParallel) {
+        body(0, count);
+        return;
+    }
+
+    // Workers may be resized by setThreadCount(), so size the job under the lock
+    std::unique_lock<std::mutex> callLock(callMutex_);
+
+    // Aim for a few chunks per thread so uneven work still balances
+    size_t threads = workers_.size() + 1;
+    size_t chunk = std::max<size_t>(std::max<size_t>(minChunk, 1),
+                                    (count + threads * 4 - 1) / (threads * 4));
+    size_t numChunks = (count + chunk - 1) / chunk;
+
+    if (workers_.empty() || numChunks == 1) {
+        callLock.unlock();
+        body(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        chunk_ = chunk;
+        numChunks_ = numChunks;
+        nextChunk_ = 0;
+        error_ = nullptr;
+        pending_ = workers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    t_insideParallel = true;
+    runChunks();
+    t_insideParallel = false;
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return pending_ == 0; });
+        body_ = nullptr;
+        error = error_;
+        error_ = nullptr;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+double ThreadPool::parallelSum(size_t count, const SumBody& body, size_t chunkSize)
+{
+    if (count == 0) return 0.0;
+
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    size_t numChunks = (count + chunkSize - 1) / chunkSize;
+    std::vector<double> partial(numChunks, 0.0);
+
+    parallelFor(numChunks, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            size_t first = c * chunkSize;
+            partial[c] = body(first, std::min(count, first + chunkSize));
+        }
+    }, 1);
+
+    double sum = 0.0;
+    for (double p : partial) {
+        sum += p;
+    }
+    return sum;
+}
+
+} // namespace KooRemapper
@@ -0,0 +1,148 @@
+#include "util/TuningProfile.h"
+#include "core/Platform.h"
+#include "util/CpuFeatures.h"
+#include "util/ThreadPool.h"
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+namespace KooRemapper {
+
+namespace {
+
+TuningProfile& activeProfile() {
+    static TuningProfile profile;
+    return profile;
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool parseSize(const std::string& text, size_t minValue, size_t& value) {
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || *end != '\0' || parsed < minValue) {
+        return false;
+    }
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+} // anonymous namespace
+
+const TuningProfile& TuningProfile::active() {
+    return activeProfile();
+}
+
+void TuningProfile::apply(const TuningProfile& profile) {
+    activeProfile() = profile;
+    ThreadPool::instance().setThreadCount(profile.threads);
+}
+
+std::string TuningProfile::defaultPath() {
+    const char* env = std::getenv("KOOREMAPPER_TUNE");
+    if (env && *env) {
+        return env;
+    }
+    std::string home = Platform::getHomeDirectory();
+    if (home.empty()) {
+        return "";
+    }
+    return home + PATH_SEPARATOR_STR + ".kooremapper" + PATH_SEPARATOR_STR +
+           "tune-" + Platform::getHostName() + ".cfg";
+}
+
+bool TuningProfile::loadDefault(std::string& path, std::string& error) {
+    path = defaultPath();
+    if (path.empty() || path == "none" || !Platform::fileExists(path)) {
+        path.clear();
+        return true;
+    }
+
+    TuningProfile profile;
+    if (!profile.load(path, error)) {
+        return false;
+    }
+    apply(profile);
+    return true;
+}
+
+bool TuningProfile::load(const std::string& filename, std::string& error) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        error = "Cannot open tuning profile: " + filename;
+        return false;
+    }
+
+    TuningProfile profile;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = filename + ":" + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        size_t number = 0;
+        bool ok = true;
+        if (key == "threads") {
+            ok = parseSize(value, 0, number);
+            profile.threads = static_cast<int>(number);
+        } else if (key == "map_chunk") {
+            ok = parseSize(value, 1, profile.mapChunk);
+        } else if (key == "element_chunk") {
+            ok = parseSize(value, 1, profile.elementChunk);
+        } else if (key == "read_buffer") {
+            ok = parseSize(value, 0, profile.readBuffer);
+        } else if (key == "write_buffer") {
+            ok = parseSize(value, 4096, profile.writeBuffer);
+        }
+        if (!ok) {
+            error = filename + ":" + std::to_string(lineNumber) + ": invalid " + key + ": " + value;
+            return false;
+        }
+    }
+
+    *this = profile;
+    return true;
+}
+
+bool TuningProfile::save(const std::string& filename, std::string& error) const {
+    // ~/.kooremapper may not exist yet
+    Platform::createDirectory(Platform::getDirectory(filename));
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        error = "Cannot create tuning profile: " + filename;
+        return false;
+    }
+
+    file << "# KooRemapper tuning profile (written by 'KooRemapper tune')\n"
+         << "# host: " << Platform::getHostName()
+         << ", cores: " << std::thread::hardware_concurrency()
+         << ", kernels: " << CpuFeatures::name(CpuFeatures::active()) << "\n"
+         << "threads = " << threads << "\n"
+         << "map_chunk = " << mapChunk << "\n"
+         << "element_chunk = " << elementChunk << "\n"
+         << "read_buffer = " << readBuffer << "\n"
+         << "write_buffer = " << writeBuffer << "\n";
+
+    if (!file) {
+        error = "Error writing " + filename;
+        return false;
+    }
+    return true;
+}
+
+} // namespace KooRemapper
@@ -1,7 +1,12 @@
 #include "util/Validator.h"
+#include "core/ElementBuckets.h"
 #include "core/Platform.h"
+#include "kernels/BatchKernels.h"
+#include "util/MappedFile.h"
 #include <fstream>
 #include <cmath>
+#include <cctype>
+#include <cstring>
 #include <algorithm>
 
 namespace KooRemapper {
@@ -102,10 +107,13 @@ ValidationResult Validator::validateElementQuality(const Mesh& mesh) {
     double minJacobian = std::numeric_limits<double>::max();
     double maxAspectRatio = 0;
 
+    std::vector<double> jacobians = calculateJacobians(mesh);
+    size_t index = 0;
+
     for (const auto& pair : mesh.getElements()) {
         const Element& elem = pair.second;
 
-        double jacobian = calculateJacobian(mesh, elem);
+        double jacobian = jacobians[index++];
         double aspectRatio = calculateAspectRatio(mesh, elem);
 
         if (jacobian <= 0) {
@@ -132,6 +140,68 @@ ValidationResult Validator::validateElementQuality(const Mesh& mesh) {
     return result;
 }
 
+namespace {
+
+// TET4 Jacobian: 6 * volume = det([v1-v0, v2-v0, v3-v0])
+double tet4Jacobian(const std::array<Vector3D, 4>& verts) {
+    Vector3D e1 = verts[1] - verts[0];
+    Vector3D e2 = verts[2] - verts[0];
+    Vector3D e3 = verts[3] - verts[0];
+
+    // Jacobian = e1 . (e2 x e3)  (6 * signed volume)
+    return e1.dot(e2.cross(e3));
+}
+
+// Jacobians of one element bucket, stored at the elements' mesh positions.
+// TET4 uses the closed form; all other buckets are treated as HEX8 and
+// go through the batch kernel. Elements with a missing node get 0.
+template <ElementType Type>
+void bucketJacobians(const Mesh& mesh, const ElementBucket<Type>& bucket,
+                     std::vector<double>& jacobians) {
+    constexpr int N = ElementTraits<Type>::NODES;
+    std::array<Vector3D, N> verts;
+
+    auto gather = [&](size_t s) {
+        for (int i = 0; i < N; ++i) {
+            const Node* node = mesh.getNode(bucket.nodeIds[s][i]);
+            if (!node) return false;
+            verts[i] = node->getEffectivePosition();
+        }
+        return true;
+    };
+
+    if constexpr (Type == ElementType::TET4) {
+        for (size_t s = 0; s < bucket.size(); ++s) {
+            jacobians[bucket.positions[s]] = gather(s) ? tet4Jacobian(verts) : 0.0;
+        }
+    } else {
+        std::vector<size_t> gathered;
+        std::vector<double> corners;
+        gathered.reserve(bucket.size());
+        corners.reserve(bucket.size() * 3 * N);
+        for (size_t s = 0; s < bucket.size(); ++s) {
+            if (!gather(s)) {
+                jacobians[bucket.positions[s]] = 0.0;
+                continue;
+            }
+            gathered.push_back(bucket.positions[s]);
+            for (const Vector3D& p : verts) {
+                corners.push_back(p.x);
+                corners.push_back(p.y);
+                corners.push_back(p.z);
+            }
+        }
+
+        std::vector<double> values(gathered.size());
+        Kernels::active().hex8CenterJacobians(corners.data(), gathered.size(), values.data());
+        for (size_t n = 0; n < gathered.size(); ++n) {
+            jacobians[gathered[n]] = values[n];
+        }
+    }
+}
+
+} // anonymous namespace
+
 double Validator::calculateJacobian(const Mesh& mesh, const Element& elem) {
     if (elem.type == ElementType::TET4) {
         // TET4 Jacobian: 6 * volume = det([v1-v0, v2-v0, v3-v0])
@@ -142,12 +212,7 @@ double Validator::calculateJacobian(const Mesh& mesh, const Element& elem) {
             verts[i] = node->getEffectivePosition();
         }
 
-        Vector3D e1 = verts[1] - verts[0];
-        Vector3D e2 = verts[2] - verts[0];
-        Vector3D e3 = verts[3] - verts[0];
-
-        // Jacobian = e1 . (e2 x e3)  (6 * signed volume)
-        return e1.dot(e2.cross(e3));
+        return tet4Jacobian(verts);
     }
 
     // HEX8: Get corner nodes
@@ -169,6 +234,15 @@ double Validator::calculateJacobian(const Mesh& mesh, const Element& elem) {
     return dxdu.dot(dxdv.cross(dxdw));
 }
 
+std::vector<double> Validator::calculateJacobians(const Mesh& mesh) {
+    ElementBuckets buckets(mesh);
+    std::vector<double> jacobians(buckets.size());
+    buckets.forEachBucket([&](const auto& bucket) {
+        bucketJacobians(mesh, bucket, jacobians);
+    });
+    return jacobians;
+}
+
 double Validator::calculateAspectRatio(const Mesh& mesh, const Element& elem) {
     // Get corner nodes
     std::array<Vector3D, 8> corners;
@@ -230,30 +304,162 @@ bool Validator::isWritable(const std::string& path) {
 }
 
 bool Validator::isValidKFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) return false;
+    return preflightKFile(path).validation.isValid;
+}
 
-    std::string line;
-    bool hasKeyword = false;
+namespace {
+
+// Fields separated by commas, blanks or tabs (as KFileReader tokenizes)
+size_t countFields(const char* line, size_t length) {
+    size_t fields = 0;
+    bool inField = false;
+    for (size_t i = 0; i < length; ++i) {
+        char c = line[i];
+        bool separator = (c == ',' || c == ' ' || c == '\t');
+        if (!separator && !inField) ++fields;
+        inField = !separator;
+    }
+    return fields;
+}
 
-    while (std::getline(file, line)) {
-        // Skip empty lines
-        if (line.empty()) continue;
+// Records the parser would drop: shorter than its fixed-column layout
+// and with too few separated fields (see KFileReader::parseNodeLine and
+// parseElementLine)
+bool isShortRecord(const std::string& keyword, const char* line, size_t length) {
+    if (keyword == "NODE") {
+        return length < 40 && countFields(line, length) < 4;
+    }
+    if (keyword == "ELEMENT_SOLID") {
+        return length < 80 && countFields(line, length) < 10;
+    }
+    return false;
+}
+
+bool containsNoCase(const std::string& text, const std::string& upperNeedle) {
+    std::string upper(text);
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return upper.find(upperNeedle) != std::string::npos;
+}
+
+} // anonymous namespace
 
-        // Check for k-file keyword (starts with *)
-        if (line[0] == '*') {
-            hasKeyword = true;
-            break;
+KFilePreflight Validator::preflightKFile(const std::string& path) {
+    KFilePreflight report;
+    ValidationResult& result = report.validation;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        result.addError(file.getErrorMessage());
+        return report;
+    }
+    report.fileSize = static_cast<long long>(file.size());
+
+    const char* const begin = file.data();
+    const char* const end = begin + file.size();
+    bool defaultLong = false;
+    bool endsWithNewline = true;
+
+    // Short records per block: count and first line
+    size_t shortRecords = 0;
+    size_t firstShortLine = 0;
+    auto closeBlock = [&](long long blockEnd) {
+        if (report.blocks.empty()) return;
+        KFileBlock& block = report.blocks.back();
+        block.bytes = blockEnd - block.offset;
+        std::string where = "*" + block.keyword + " at line " + std::to_string(block.line);
+        if (shortRecords > 0) {
+            result.addError(where + ": " + std::to_string(shortRecords) +
+                            " record(s) too short to parse (first at line " +
+                            std::to_string(firstShortLine) + ")");
+        }
+        if (block.records == 0 && (block.keyword == "NODE" || block.keyword == "ELEMENT_SOLID")) {
+            result.addWarning(where + " has no data");
+        }
+        shortRecords = 0;
+    };
+
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        endsWithNewline = newline != nullptr;
+        size_t length = static_cast<size_t>(lineEnd - line);
+        if (length > 0 && line[length - 1] == '\r') {
+            --length;
+        }
+        report.lines++;
+        const long long offset = line - begin;
+        const char* next = newline ? newline + 1 : end;
+
+        if (length == 0 || line[0] == '$') {
+            line = next;
+            continue;
         }
 
-        // Check for comment lines ($ prefix)
-        if (line[0] == '$') continue;
+        if (line[0] == '*' && length > 1 && std::isalpha(static_cast<unsigned char>(line[1]))) {
+            closeBlock(offset);
 
-        // If we hit a non-comment, non-keyword line first, might not be valid
-        break;
+            KFileBlock block;
+            size_t k = 1;
+            while (k < length && (std::isalnum(static_cast<unsigned char>(line[k])) || line[k] == '_')) {
+                block.keyword += static_cast<char>(std::toupper(static_cast<unsigned char>(line[k])));
+                ++k;
+            }
+            std::string suffix(line + k, length - k);
+            if (block.keyword == "KEYWORD") {
+                if (containsNoCase(suffix, "LONG=Y")) defaultLong = true;
+                if (containsNoCase(suffix, "LONG=S")) defaultLong = false;
+            }
+            block.line = report.lines;
+            block.offset = offset;
+            block.longFormat = suffix.find('+') != std::string::npos ||
+                               (defaultLong && suffix.find('-') == std::string::npos);
+            report.blocks.push_back(block);
+
+            if (block.keyword == "END") {
+                report.hasEnd = true;
+                closeBlock(next - begin);
+                break;
+            }
+            line = next;
+            continue;
+        }
+
+        if (report.blocks.empty()) {
+            result.addError("Not a keyword file: data before the first keyword at line " +
+                            std::to_string(report.lines));
+            return report;
+        }
+
+        KFileBlock& block = report.blocks.back();
+        if (block.records == 0) {
+            block.freeFormat = std::memchr(line, ',', length) != nullptr;
+        }
+        block.records++;
+        if (!block.longFormat && isShortRecord(block.keyword, line, length)) {
+            if (shortRecords++ == 0) firstShortLine = report.lines;
+        }
+        line = next;
     }
 
-    return hasKeyword;
+    if (!report.hasEnd) {
+        closeBlock(report.fileSize);
+        if (report.blocks.empty()) {
+            result.addError("No keywords found");
+        } else {
+            result.addError(endsWithNewline ? "Missing *END (file truncated?)"
+                                            : "Missing *END; the last line is cut off (file truncated?)");
+        }
+    }
+
+    for (const auto& block : report.blocks) {
+        if (block.longFormat && (block.keyword == "NODE" || block.keyword == "ELEMENT_SOLID")) {
+            result.addWarning("*" + block.keyword + " at line " + std::to_string(block.line) +
+                              " uses long format; records are read as separated fields");
+        }
+    }
+    return report;
 }
 
 } // namespace KooRemapper
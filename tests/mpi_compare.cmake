@@ -0,0 +1,42 @@
+# Runs map and prestress serially and on 4 MPI ranks and compares outputs.
+# Invoked by ctest with -DKOOREMAPPER=... -DMPIEXEC=... -DWORK_DIR=...
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+function(run_checked)
+    execute_process(COMMAND ${ARGN}
+        WORKING_DIRECTORY ${WORK_DIR}
+        RESULT_VARIABLE rc
+        OUTPUT_VARIABLE out
+        ERROR_VARIABLE err)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "Command failed (${rc}): ${ARGN}\n${out}\n${err}")
+    endif()
+endfunction()
+
+# Compare two text files, ignoring '$' comment lines (they carry timestamps)
+function(compare_outputs a b)
+    file(STRINGS ${WORK_DIR}/${a} linesA REGEX "^[^$]")
+    file(STRINGS ${WORK_DIR}/${b} linesB REGEX "^[^$]")
+    list(LENGTH linesA countA)
+    if(countA EQUAL 0)
+        message(FATAL_ERROR "${a} is empty")
+    endif()
+    if(NOT "${linesA}" STREQUAL "${linesB}")
+        message(FATAL_ERROR "${a} and ${b} differ")
+    endif()
+endfunction()
+
+set(MPIRUN ${MPIEXEC} ${MPIEXEC_NUMPROC_FLAG} 4 ${MPIEXEC_PREFLAGS} ${KOOREMAPPER})
+
+run_checked(${KOOREMAPPER} generate arc ex)
+
+run_checked(${KOOREMAPPER} map ex_bent.k ex_flat_fine.k serial_map.k)
+run_checked(${MPIRUN} map ex_bent.k ex_flat_fine.k mpi_map.k)
+compare_outputs(serial_map.k mpi_map.k)
+
+run_checked(${KOOREMAPPER} prestress --E 200000 --nu 0.3 --csv ex_flat_fine.k serial_map.k serial_dynain.k)
+run_checked(${MPIRUN} prestress --E 200000 --nu 0.3 --csv ex_flat_fine.k serial_map.k mpi_dynain.k)
+compare_outputs(serial_dynain.k mpi_dynain.k)
+compare_outputs(serial_dynain.csv mpi_dynain.csv)
@@ -0,0 +1,470 @@
+#include "TestFramework.h"
+#include "core/Mesh.h"
+#include "analysis/ElementAnalyzer.h"
+#include "analysis/DeformationGradient.h"
+#include "analysis/EquilibriumRelaxer.h"
+#include "analysis/ResidualAnalyzer.h"
+#include "analysis/PrestressState.h"
+#include "analysis/StrainCalculator.h"
+#include "analysis/MaterialModel.h"
+#include "analysis/MaterialSweep.h"
+#include "mapper/PointMapper.h"
+#include "util/ThreadPool.h"
+#include "util/CpuFeatures.h"
+#include "util/Validator.h"
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace KooRemapper;
+using namespace KooRemapper::Test;
+
+// Structured HEX8 block of ni x nj x nk unit cubes
+Mesh createAnalysisBlock(int ni, int nj, int nk) {
+    Mesh mesh;
+    auto nodeId = [&](int i, int j, int k) { return 1 + i + j * (ni + 1) + k * (ni + 1) * (nj + 1); };
+
+    for (int k = 0; k <= nk; ++k) {
+        for (int j = 0; j <= nj; ++j) {
+            for (int i = 0; i <= ni; ++i) {
+                mesh.addNode(Node(nodeId(i, j, k), i, j, k));
+            }
+        }
+    }
+
+    int elemId = 1;
+    for (int k = 0; k < nk; ++k) {
+        for (int j = 0; j < nj; ++j) {
+            for (int i = 0; i < ni; ++i) {
+                mesh.addElement(elemId++, 1, {
+                    nodeId(i, j, k), nodeId(i + 1, j, k), nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k),
+                    nodeId(i, j, k + 1), nodeId(i + 1, j, k + 1), nodeId(i + 1, j + 1, k + 1), nodeId(i, j + 1, k + 1)
+                });
+            }
+        }
+    }
+    return mesh;
+}
+
+// Uniform stress field on every element of a mesh
+MeshAnalysisResult uniformStressResult(const Mesh& mesh, const StressTensor& stress) {
+    MeshAnalysisResult result;
+    result.hasMaterial = true;
+    for (const auto& [id, elem] : mesh.getElements()) {
+        ElementResult er;
+        er.elementId = id;
+        er.stress = stress;
+        er.vonMisesStress = stress.vonMises();
+        result.elementResults.push_back(er);
+        result.validElements++;
+    }
+    return result;
+}
+
+// ============================================================
+// Batched Deformation Gradient Tests
+// ============================================================
+
+TEST(DeformationGradient_Hex8BatchMatchesScalar) {
+    // Odd count so the last SIMD group is partial; element 5 is degenerate
+    std::vector<std::array<Vector3D, 8>> ref, def;
+    for (int e = 0; e < 11; ++e) {
+        std::array<Vector3D, 8> r, d;
+        for (int k = 0; k < 8; ++k) {
+            const Vector3D& c = DeformationGradient::HEX8_CORNERS[k];
+            r[k] = Vector3D(e + 0.5 * (c.x + 1), 0.5 * (c.y + 1) * (1 + 0.1 * e), 0.5 * (c.z + 1));
+            d[k] = Vector3D(r[k].x * 1.01 + 0.02 * r[k].y * r[k].z,
+                            r[k].y - 0.03 * r[k].x,
+                            r[k].z * (0.98 + 0.01 * e));
+        }
+        if (e == 5) {
+            for (auto& p : r) p.z = 0.0;  // Flat element: singular reference Jacobian
+        }
+        ref.push_back(r);
+        def.push_back(d);
+    }
+
+    // Every kernel ISA level this machine can run gives the scalar result
+    IsaLevel original = CpuFeatures::active();
+    for (IsaLevel level : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (!CpuFeatures::setActive(level)) continue;
+
+        std::vector<Matrix3x3> F;
+        std::vector<bool> valid;
+        DeformationGradient::computeHex8Batch(ref, def, 0.2, -0.4, 0.6, F, valid);
+
+        ASSERT_EQ(F.size(), ref.size());
+        for (size_t e = 0; e < ref.size(); ++e) {
+            if (e == 5) {
+                ASSERT_FALSE(valid[e]);
+                continue;
+            }
+            ASSERT_TRUE(valid[e]);
+            Matrix3x3 expected = DeformationGradient::computeHex8(ref[e], def[e], 0.2, -0.4, 0.6);
+            ASSERT_TRUE(F[e].isApprox(expected, 0.0));
+        }
+    }
+    CpuFeatures::setActive(original);
+}
+
+TEST(Validator_BatchJacobiansMatchScalar) {
+    Mesh mesh = createAnalysisBlock(3, 2, 2);
+    int n = 0;
+    for (auto& [id, node] : mesh.nodes) {
+        node.position = node.position + Vector3D(0.05 * (n % 3), -0.04 * (n % 5), 0.03 * (n % 7));
+        ++n;
+    }
+    mesh.addNode(Node(1000, 0.0, 0.0, 5.0));
+    Element tet;
+    tet.id = 100;
+    tet.type = ElementType::TET4;
+    tet.nodeIds = {1, 2, 4, 1000, 0, 0, 0, 0};
+    mesh.addElement(tet);
+
+    std::vector<double> batch = Validator::calculateJacobians(mesh);
+    ASSERT_EQ(batch.size(), mesh.getElementCount());
+    size_t index = 0;
+    for (const auto& [id, elem] : mesh.getElements()) {
+        ASSERT_TRUE(batch[index++] == Validator::calculateJacobian(mesh, elem));
+    }
+}
+
+// ============================================================
+// Thread Pool Tests
+// ============================================================
+
+TEST(ThreadPool_ParallelSum) {
+    auto& pool = ThreadPool::instance();
+    pool.setThreadCount(4);
+    ASSERT_EQ(pool.threadCount(), 4);
+
+    double sum = pool.parallelSum(100000, [](size_t begin, size_t end) {
+        double s = 0.0;
+        for (size_t i = begin; i < end; ++i) s += static_cast<double>(i);
+        return s;
+    }, 1000);
+    ASSERT_NEAR(sum, 99999.0 * 100000.0 / 2.0, 1e-6);
+
+    pool.setThreadCount(0);
+}
+
+TEST(ThreadPool_ResizeBetweenJobs) {
+    // Workers started after earlier jobs must not join a job twice, or
+    // parallelFor could return while chunks are still running
+    auto& pool = ThreadPool::instance();
+    for (int round = 0; round < 50; ++round) {
+        for (int job = 0; job < 2; ++job) {
+            std::atomic<size_t> done(0);
+            pool.parallelFor(64, [&done](size_t begin, size_t end) {
+                std::this_thread::yield();
+                done += end - begin;
+            }, 1);
+            ASSERT_EQ(done.load(), static_cast<size_t>(64));
+        }
+        pool.setThreadCount(2 + round % 3);
+    }
+    pool.setThreadCount(0);
+}
+
+// ============================================================
+// Equilibrium Relaxation Tests
+// ============================================================
+
+TEST(EquilibriumRelaxer_UniformStressRelaxesToZero) {
+    // A free body cannot carry a uniform stress: relaxation must remove it
+    Mesh mesh = createAnalysisBlock(3, 2, 2);
+    MeshAnalysisResult result = uniformStressResult(mesh, StressTensor(100.0, 0, 0, 20.0, 0, 0));
+
+    EquilibriumRelaxer relaxer;
+    relaxer.setMaterial(MaterialModel::isotropicElastic(1000.0, 0.3));
+    relaxer.setTolerance(1e-10);
+
+    ASSERT_TRUE(relaxer.relax(mesh, mesh, result));
+    ASSERT_TRUE(relaxer.getStats().converged);
+    ASSERT_GT(relaxer.getStats().initialResidual, 1.0);
+
+    for (const auto& er : result.elementResults) {
+        ASSERT_NEAR(er.stress.xx, 0.0, 1e-6);
+        ASSERT_NEAR(er.stress.xy, 0.0, 1e-6);
+    }
+    ASSERT_NEAR(result.maxVonMisesStress, 0.0, 1e-6);
+}
+
+TEST(EquilibriumRelaxer_RequiresMaterial) {
+    Mesh mesh = createAnalysisBlock(1, 1, 1);
+    MeshAnalysisResult result = uniformStressResult(mesh, StressTensor());
+    result.hasMaterial = false;
+
+    EquilibriumRelaxer relaxer;
+    ASSERT_FALSE(relaxer.relax(mesh, mesh, result));
+}
+
+// ============================================================
+// Residual Tests
+// ============================================================
+
+TEST(ResidualAnalyzer_UniformStressBalancesInterior) {
+    Mesh mesh = createAnalysisBlock(2, 2, 2);
+    MeshAnalysisResult result = uniformStressResult(mesh, StressTensor(100.0, 50.0, 0, 0, 0, 0));
+
+    ResidualAnalyzer analyzer;
+    analyzer.setWorstNodeCount(3);
+    ResidualReport report;
+    ASSERT_TRUE(analyzer.compute(mesh, result, report));
+    ASSERT_EQ(report.nodes.size(), static_cast<size_t>(27));
+    ASSERT_EQ(report.worstNodes.size(), static_cast<size_t>(3));
+    ASSERT_EQ(report.parts.size(), static_cast<size_t>(1));
+
+    // Center node (1,1,1) is interior: uniform stress is balanced there
+    const NodalResidual& center = report.nodes[13];
+    ASSERT_EQ(center.nodeId, 14);
+    ASSERT_NEAR(center.magnitude, 0.0, 1e-9);
+
+    // Net force over the free body vanishes
+    Vector3D total(0, 0, 0);
+    for (const auto& r : report.nodes) total += r.force;
+    ASSERT_NEAR(total.magnitude(), 0.0, 1e-9);
+    ASSERT_GT(report.maxNorm, 1.0);
+}
+
+TEST(ResidualAnalyzer_PartNormsCoverPartNodes) {
+    Mesh mesh = createAnalysisBlock(3, 1, 1);
+    mesh.elements[2].partId = 2;
+    mesh.elements[3].partId = 2;
+    MeshAnalysisResult result = uniformStressResult(mesh, StressTensor(100.0, 0, 0, 0, 0, 0));
+
+    ResidualAnalyzer analyzer;
+    ResidualReport report;
+    ASSERT_TRUE(analyzer.compute(mesh, result, report));
+    ASSERT_EQ(report.parts.size(), static_cast<size_t>(2));
+    ASSERT_EQ(report.parts[0].partId, 1);
+    ASSERT_EQ(report.parts[0].nodeCount, static_cast<size_t>(8));
+    ASSERT_EQ(report.parts[1].partId, 2);
+    ASSERT_EQ(report.parts[1].nodeCount, static_cast<size_t>(12));
+
+    ASSERT_NEAR(std::max(report.parts[0].maxNorm, report.parts[1].maxNorm), report.maxNorm, 1e-12);
+}
+
+TEST(ResidualAnalyzer_RelaxedFieldIsBalanced) {
+    Mesh mesh = createAnalysisBlock(3, 2, 1);
+    MeshAnalysisResult result = uniformStressResult(mesh, StressTensor(0, 80.0, 0, 0, 10.0, 0));
+
+    EquilibriumRelaxer relaxer;
+    relaxer.setMaterial(MaterialModel::isotropicElastic(1000.0, 0.3));
+    relaxer.setTolerance(1e-10);
+    ASSERT_TRUE(relaxer.relax(mesh, mesh, result));
+
+    ResidualAnalyzer analyzer;
+    ResidualReport report;
+    ASSERT_TRUE(analyzer.compute(mesh, result, report));
+    ASSERT_LT(report.maxNorm, 1e-6);
+}
+
+// ============================================================
+// Incremental Prestress Tests
+// ============================================================
+
+TEST(PrestressState_IncrementalMatchesFullAnalysis) {
+    Mesh refMesh = createAnalysisBlock(3, 2, 2);
+    Mesh defMesh = createAnalysisBlock(3, 2, 2);
+    for (auto& [id, node] : defMesh.nodes) {
+        node.position.x *= 1.01;
+    }
+
+    ElementAnalyzer analyzer;
+    analyzer.setMaterial(MaterialModel::isotropicElastic(1000.0, 0.3));
+    MeshAnalysisResult previous = analyzer.analyzeMesh(refMesh, defMesh);
+
+    std::string file = (std::filesystem::temp_directory_path() / "kooremapper_test_state.kps").string();
+    std::uint64_t fingerprint = PrestressState::fingerprint(refMesh, "strain=0");
+    PrestressState saved;
+    ASSERT_TRUE(saved.save(file, fingerprint, defMesh, previous));
+
+    // Move one interior node: only the 8 elements around it change
+    defMesh.getNode(18)->position.z += 0.05;
+
+    PrestressState state;
+    ASSERT_TRUE(state.load(file));
+    ASSERT_EQ(state.getFingerprint(), fingerprint);
+    ASSERT_NE(PrestressState::fingerprint(refMesh, "strain=1"), fingerprint);
+
+    std::vector<size_t> changed;
+    size_t movedNodes = 0;
+    ASSERT_TRUE(state.findChangedElements(defMesh, changed, movedNodes));
+    ASSERT_EQ(movedNodes, static_cast<size_t>(1));
+    ASSERT_EQ(changed.size(), static_cast<size_t>(8));
+
+    MeshAnalysisResult patched = state.takeResults();
+    analyzer.reanalyzeElements(refMesh, defMesh, changed, patched);
+    MeshAnalysisResult full = analyzer.analyzeMesh(refMesh, defMesh);
+
+    ASSERT_EQ(patched.elementResults.size(), full.elementResults.size());
+    for (size_t i = 0; i < full.elementResults.size(); ++i) {
+        ASSERT_EQ(patched.elementResults[i].elementId, full.elementResults[i].elementId);
+        ASSERT_NEAR(patched.elementResults[i].stress.xx, full.elementResults[i].stress.xx, 0.0);
+        ASSERT_NEAR(patched.elementResults[i].stress.yz, full.elementResults[i].stress.yz, 0.0);
+        ASSERT_NEAR(patched.elementResults[i].vonMisesStrain, full.elementResults[i].vonMisesStrain, 0.0);
+    }
+    ASSERT_NEAR(patched.maxVonMisesStress, full.maxVonMisesStress, 0.0);
+    ASSERT_EQ(patched.validElements, full.validElements);
+
+    std::filesystem::remove(file);
+}
+
+TEST(ElementAnalyzer_AnalyticMappingMatchesMappedMesh) {
+    // Flat 24 x 3 x 2 block mapped onto the quarter ring of test_Mapping
+    Mesh flatMesh = createAnalysisBlock(24, 3, 2);
+    Vector3D flatMin, flatMax;
+    flatMesh.calculateBoundingBox(flatMin, flatMax);
+
+    PointMapper mapper;
+    ASSERT_TRUE(mapper.build(createQuarterRingMesh(12, 2, 2), flatMin, flatMax));
+
+    std::vector<Vector3D> points;
+    for (const auto& [id, node] : flatMesh.getNodes()) {
+        points.push_back(node.position);
+    }
+    mapper.mapPoints(points);
+    Mesh mappedMesh = flatMesh;
+    size_t n = 0;
+    for (auto& [id, node] : mappedMesh.nodes) {
+        node.position = points[n++];
+    }
+
+    ElementAnalyzer analyzer;
+    analyzer.setMaterial(MaterialModel::isotropicElastic(1000.0, 0.3));
+    MeshAnalysisResult meshBased = analyzer.analyzeMesh(flatMesh, mappedMesh);
+    MeshAnalysisResult analytic = analyzer.analyzeMapping(flatMesh, mapper);
+
+    ASSERT_EQ(analytic.validElements, 144);
+    ASSERT_EQ(analytic.invalidElements, 0);
+    ASSERT_TRUE(analytic.hasMaterial);
+
+    std::map<int, const ElementResult*> byId;
+    for (const auto& er : meshBased.elementResults) {
+        byId[er.elementId] = &er;
+    }
+    for (const auto& er : analytic.elementResults) {
+        const ElementResult& ref = *byId.at(er.elementId);
+        // Same deformation; only the nodal interpolation of the mapped mesh differs
+        ASSERT_NEAR(er.vonMisesStrain, ref.vonMisesStrain, 0.01 * ref.vonMisesStrain + 1e-6);
+        ASSERT_NEAR(er.strain.xx, ref.strain.xx, 0.01);
+        ASSERT_NEAR(er.stress.xx, ref.stress.xx, 10.0);
+        ASSERT_NEAR((er.center - ref.center).magnitude(), 0.0, 0.01);
+    }
+}
+
+TEST(StrainCalculator_FusedTypesMatchSeparateRuns) {
+    Mesh refMesh = createAnalysisBlock(3, 2, 2);
+    Mesh defMesh = createAnalysisBlock(3, 2, 2);
+    for (auto& [id, node] : defMesh.nodes) {
+        node.position.x *= 1.05;
+        node.position.y += 0.02 * node.position.z * node.position.x;
+    }
+
+    using Type = StrainCalculator::StrainType;
+    const std::vector<Type> types = {Type::LOGARITHMIC, Type::ENGINEERING, Type::GREEN_LAGRANGE};
+
+    StrainCalculator fused;
+    fused.setReferenceMesh(&refMesh);
+    fused.setDeformedMesh(&defMesh);
+    fused.setStrainTypes({Type::LOGARITHMIC, Type::ENGINEERING, Type::LOGARITHMIC, Type::GREEN_LAGRANGE});
+    ASSERT_EQ(fused.getStrainTypes().size(), static_cast<size_t>(3));
+    ASSERT_TRUE(fused.calculate());
+
+    for (size_t m = 0; m < types.size(); ++m) {
+        StrainCalculator single;
+        single.setReferenceMesh(&refMesh);
+        single.setDeformedMesh(&defMesh);
+        single.setStrainType(types[m]);
+        ASSERT_TRUE(single.calculate());
+
+        for (const auto& [id, data] : single.getElementStrains()) {
+            const StrainData& s = fused.getElementStrain(id)->measures[m];
+            ASSERT_NEAR(s.exx, data.strain.exx, 0.0);
+            ASSERT_NEAR(s.eyz, data.strain.eyz, 0.0);
+            ASSERT_NEAR(s.exz, data.strain.exz, 0.0);
+        }
+        ASSERT_NEAR(fused.getStatistics(m).maxVonMises, single.getStatistics().maxVonMises, 0.0);
+    }
+    ASSERT_NEAR(fused.getStatistics().avgVonMises, fused.getStatistics(0).avgVonMises, 0.0);
+
+    std::ostringstream header;
+    fused.writeCSVHeader(header);
+    ASSERT_EQ(header.str().find("ElementID,log_exx,"), static_cast<size_t>(0));
+    ASSERT_TRUE(header.str().find("engineering_VonMises") != std::string::npos);
+}
+
+TEST(MaterialSweep_ApplyMaterialMatchesFullAnalysis) {
+    std::string file = (std::filesystem::temp_directory_path() / "kooremapper_test_sweep.csv").string();
+    {
+        std::ofstream out(file);
+        out << "# sweep\nname,E,nu\nsteel, 200000, 0.3\n\nsoft,1000,0.45\n";
+    }
+    MaterialSweep sweep;
+    ASSERT_TRUE(sweep.load(file));
+    ASSERT_EQ(sweep.getSets().size(), static_cast<size_t>(2));
+    ASSERT_TRUE(sweep.getSets()[1].name == "soft");
+    ASSERT_TRUE(MaterialSweep::outputPath("dir.v1/out.dynain", sweep.getSets()[0]) == "dir.v1/out_steel.dynain");
+    ASSERT_TRUE(MaterialSweep::outputPath("dir.v1/out", sweep.getSets()[0]) == "dir.v1/out_steel");
+
+    Mesh refMesh = createAnalysisBlock(3, 2, 2);
+    Mesh defMesh = createAnalysisBlock(3, 2, 2);
+    for (auto& [id, node] : defMesh.nodes) {
+        node.position.x *= 1.02;
+        node.position.z += 0.01 * node.position.x;
+    }
+
+    ElementAnalyzer strainOnly;
+    MeshAnalysisResult swept = strainOnly.analyzeMesh(refMesh, defMesh);
+    ASSERT_FALSE(swept.hasMaterial);
+
+    for (const auto& set : sweep.getSets()) {
+        ElementAnalyzer::applyMaterial(swept, set.material());
+
+        ElementAnalyzer analyzer;
+        analyzer.setMaterial(set.material());
+        MeshAnalysisResult full = analyzer.analyzeMesh(refMesh, defMesh);
+
+        ASSERT_TRUE(swept.hasMaterial);
+        for (size_t i = 0; i < full.elementResults.size(); ++i) {
+            ASSERT_NEAR(swept.elementResults[i].stress.xx, full.elementResults[i].stress.xx, 0.0);
+            ASSERT_NEAR(swept.elementResults[i].stress.xz, full.elementResults[i].stress.xz, 0.0);
+            ASSERT_NEAR(swept.elementResults[i].maxPrincipalStress, full.elementResults[i].maxPrincipalStress, 0.0);
+        }
+        ASSERT_NEAR(swept.maxVonMisesStress, full.maxVonMisesStress, 0.0);
+        ASSERT_NEAR(swept.avgVonMisesStress, full.avgVonMisesStress, 0.0);
+    }
+
+    {
+        std::ofstream out(file);
+        out << "steel,200000,0.3\nsteel,210000,0.3\n";
+    }
+    ASSERT_FALSE(sweep.load(file));
+
+    std::filesystem::remove(file);
+}
+
+TEST(PrestressState_RejectsDifferentMesh) {
+    Mesh mesh = createAnalysisBlock(2, 1, 1);
+    ElementAnalyzer analyzer;
+    MeshAnalysisResult result = analyzer.analyzeMesh(mesh, mesh);
+
+    std::string file = (std::filesystem::temp_directory_path() / "kooremapper_test_state2.kps").string();
+    PrestressState saved;
+    ASSERT_TRUE(saved.save(file, 1, mesh, result));
+
+    PrestressState state;
+    ASSERT_TRUE(state.load(file));
+    std::vector<size_t> changed;
+    size_t movedNodes = 0;
+    Mesh larger = createAnalysisBlock(3, 1, 1);
+    ASSERT_FALSE(state.findChangedElements(larger, changed, movedNodes));
+    std::filesystem::remove(file);
+
+    ASSERT_FALSE(state.load(file));
+}
@@ -2,6 +2,9 @@
 #include "core/Vector3D.h"
 #include "mapper/EdgeInterpolator.h"
 #include "mapper/FaceInterpolator.h"
+#include "generator/SpaceCurveInterpolator.h"
+#include "generator/CurvedMeshGenerator.h"
+#include "generator/YamlConfigReader.h"
 #include <vector>
 #include <cmath>
 
@@ -99,6 +102,70 @@ TEST(EdgeInterpolator_ArcLength) {
 // Face Interpolation Tests
 // ============================================================
 
+TEST(EdgeInterpolator_CubicCoarseArc) {
+    // Quarter circle through only 5 points
+    std::vector<Vector3D> points;
+    for (int i = 0; i <= 4; ++i) {
+        double angle = 0.5 * M_PI * i / 4;
+        points.push_back(Vector3D(std::cos(angle), std::sin(angle), 0.0));
+    }
+    EdgeInterpolator linear, cubic;
+    linear.build(points);
+    cubic.build(points, EdgeInterpolation::CUBIC);
+    ASSERT_NEAR(cubic.getTotalLength(), 0.5 * M_PI, 1e-3);
+
+    double linearError = 0.0, cubicError = 0.0, angleError = 0.0;
+    for (int n = 0; n <= 200; ++n) {
+        double t = n / 200.0;
+        Vector3D pl = linear.interpolate(t);
+        Vector3D pc = cubic.interpolate(t);
+        linearError = std::max(linearError, std::abs(std::hypot(pl.x, pl.y) - 1.0));
+        cubicError = std::max(cubicError, std::abs(std::hypot(pc.x, pc.y) - 1.0));
+        // Arc-length parameterized: equal steps in t are equal angles
+        angleError = std::max(angleError, std::abs(std::atan2(pc.y, pc.x) - 0.5 * M_PI * t));
+    }
+    ASSERT_TRUE(cubicError < linearError / 20.0);
+    ASSERT_TRUE(angleError < 1e-3);
+
+    // Passes through the points, at the tabulated arc length of each
+    const auto& lengths = cubic.getCubicLengths();
+    for (size_t i = 0; i < points.size(); ++i) {
+        double t = lengths[i * EdgeInterpolator::CUBIC_SAMPLES] / cubic.getTotalLength();
+        ASSERT_NEAR((cubic.interpolate(t) - points[i]).magnitude(), 0.0, 1e-12);
+    }
+
+    // Derivative of the evaluated curve
+    const double h = 1e-7;
+    for (double t : {0.13, 0.5, 0.91}) {
+        Vector3D position, deriv;
+        cubic.evaluate(t, position, deriv);
+        ASSERT_TRUE(position == cubic.interpolate(t));
+        Vector3D fd = (cubic.interpolate(t + h) - cubic.interpolate(t - h)) / (2 * h);
+        ASSERT_NEAR((deriv - fd).magnitude(), 0.0, 1e-5);
+    }
+}
+
+TEST(EdgeInterpolator_CubicKeepsLinesAndCorners) {
+    // Unevenly spaced straight line: the cubic is the line itself
+    EdgeInterpolator line;
+    line.build({Vector3D(0, 0, 0), Vector3D(0.1, 0, 0), Vector3D(0.7, 0, 0), Vector3D(1, 0, 0)},
+               EdgeInterpolation::CUBIC);
+    for (double t : {0.05, 0.3, 0.8}) {
+        Vector3D p = line.interpolate(t);
+        ASSERT_NEAR(p.x, t, 1e-12);
+        ASSERT_NEAR(p.y, 0.0, 1e-15);
+    }
+
+    // A right-angle corner does not overshoot
+    EdgeInterpolator corner;
+    corner.build({Vector3D(0, 0, 0), Vector3D(1, 0, 0), Vector3D(1, 1, 0)}, EdgeInterpolation::CUBIC);
+    for (int n = 0; n <= 100; ++n) {
+        Vector3D p = corner.interpolate(n / 100.0);
+        ASSERT_TRUE(p.x <= 1.0 + 1e-12);
+        ASSERT_TRUE(p.y >= -1e-12);
+    }
+}
+
 TEST(FaceInterpolator_BilinearSquare) {
     FaceInterpolator interp;
     interp.buildBilinear(
@@ -239,3 +306,139 @@ TEST(FaceInterpolator_BoundaryConditions) {
     ASSERT_NEAR(p.x, 0.5, 1e-6);
     ASSERT_NEAR(p.y, 0.5, 1e-6);
 }
+
+// ============================================================
+// Space Curve Tests
+// ============================================================
+
+TEST(SpaceCurve_HelixFramesAreRotationMinimizing) {
+    // Helix of radius 10, pitch 4 over two turns
+    std::vector<Vector3D> points;
+    const double pi = std::acos(-1.0);
+    for (int i = 0; i <= 64; ++i) {
+        double t = i / 64.0 * 4 * pi;
+        points.push_back(Vector3D(10 * std::cos(t), 10 * std::sin(t), 4 * t / (2 * pi)));
+    }
+
+    SpaceCurveInterpolator curve;
+    curve.setControlPoints(points);
+    double expected = 2 * std::sqrt(std::pow(2 * pi * 10, 2) + 16.0);
+    ASSERT_NEAR(curve.getArcLength(), expected, 1e-2);
+
+    curve.buildFrames(Vector3D(0, 0, 1), 2000);
+    CurveFrame previous = curve.frameAtArcLength(0);
+    ASSERT_NEAR(previous.binormal.dot(previous.tangent), 0.0, 1e-12);
+
+    const int stations = 500;
+    for (int i = 1; i <= stations; ++i) {
+        CurveFrame f = curve.frameAtArcLength(curve.getArcLength() * i / stations);
+        ASSERT_NEAR(f.tangent.magnitude(), 1.0, 1e-12);
+        ASSERT_NEAR(f.binormal.magnitude(), 1.0, 1e-12);
+        ASSERT_NEAR(f.binormal.dot(f.tangent), 0.0, 1e-12);
+        ASSERT_NEAR(f.normal.dot(f.tangent.cross(f.binormal)), 1.0, 1e-12);
+
+        // No rotation about the tangent between neighbouring stations
+        // (the helix torsion, which a Frenet frame would follow, is 6.3e-3)
+        double ds = curve.getArcLength() / stations;
+        Vector3D midNormal = (f.normal + previous.normal) * 0.5;
+        ASSERT_NEAR((f.binormal - previous.binormal).dot(midNormal) / ds, 0.0, 1e-4);
+        previous = f;
+    }
+}
+
+TEST(SpaceCurve_PlanarCurveKeepsBinormal) {
+    // S-curve in the XZ plane: the binormal must stay on +Y through the
+    // inflection, where a Frenet frame would flip
+    SpaceCurveInterpolator curve;
+    curve.setControlPoints({Vector3D(0, 0, 0), Vector3D(10, 0, 5), Vector3D(20, 0, -5),
+                            Vector3D(30, 0, 0)});
+    curve.buildFrames(Vector3D(0, 1, 0), 200);
+
+    for (int i = 0; i <= 50; ++i) {
+        CurveFrame f = curve.frameAtArcLength(curve.getArcLength() * i / 50);
+        ASSERT_NEAR(f.binormal.y, 1.0, 1e-12);
+        ASSERT_NEAR(f.normal.y, 0.0, 1e-12);
+    }
+    ASSERT_GT(curve.curvature(0.5), -1.0);
+    ASSERT_NEAR(curve.evaluateAtArcLength(curve.getArcLength()).x, 30.0, 1e-9);
+}
+
+TEST(CurvedMeshGenerator_ZonedStationsAndProfile) {
+    // Straight centerline along X: node X coordinates are the stations
+    CurvedMeshConfig config;
+    config.centerlinePoints = {Vector2D(0, 0), Vector2D(100, 0)};
+    config.interpolation = InterpolationType::LINEAR;
+    config.width = 4.0;
+    config.thickness = 1.0;
+    config.elementsWidth = 2;
+    config.elementsThickness = 1;
+    config.densityZones.zone1_denseStart = ZoneConfig(10, 5);
+    config.densityZones.zone3_sparse = ZoneConfig(80, 4);
+    config.densityZones.zone5_denseEnd = ZoneConfig(10, 5);
+    config.crossSectionProfile = {CrossSectionStation(0, 1, 1), CrossSectionStation(1, 3, 2)};
+
+    CurvedMeshGenerator generator;
+    Mesh mesh = generator.generate(config);
+
+    const int ni = 15, nj = 3;
+    ASSERT_EQ(mesh.getElementCount(), static_cast<size_t>(14 * 2 * 1));
+    ASSERT_NEAR(mesh.getNode(2)->position.x, 2.0, 1e-9);
+    ASSERT_NEAR(mesh.getNode(8)->position.x - mesh.getNode(7)->position.x, 20.0, 1e-9);
+    ASSERT_NEAR(mesh.getNode(ni)->position.x, 100.0, 1e-9);
+    ASSERT_NEAR(generator.getStats().minElementLength, 2.0, 1e-9);
+    ASSERT_NEAR(generator.getStats().maxElementLength, 20.0, 1e-9);
+
+    // Width and thickness grow linearly to 3x / 2x at the end
+    ASSERT_NEAR(mesh.getNode(1 + 2 * ni)->position.y, 2.0, 1e-9);
+    ASSERT_NEAR(mesh.getNode(ni + 2 * ni)->position.y, 6.0, 1e-9);
+    ASSERT_NEAR(mesh.getNode(ni + ni * nj)->position.z, 1.0, 1e-9);
+}
+
+TEST(CurvedMeshGenerator_SegmentAssemblySharesInterfaces) {
+    YamlConfigReader reader;
+    ExtendedMeshConfig config = reader.readExtendedString(
+        "type: curved\n"
+        "segments:\n"
+        "  - type: straight\n"
+        "    length: 40\n"
+        "    elements: 10\n"
+        "  - type: arc\n"
+        "    radius: 5\n"
+        "    angle: 180\n"
+        "    elements: 20\n"
+        "  - type: spline\n"
+        "    points:\n"
+        "      - [0, 0]\n"
+        "      - [10, 0]\n"
+        "      - [20, 0]\n"
+        "    elements: 4\n"
+        "cross_section:\n"
+        "  width: 2.0\n"
+        "  thickness: 1.0\n"
+        "elements_j: 2\n"
+        "elements_k: 2\n");
+    ASSERT_EQ(config.curvedConfig.segments.size(), static_cast<size_t>(3));
+    ASSERT_TRUE(config.curvedConfig.segments[1].type == SegmentType::ARC);
+
+    CurvedMeshGenerator generator;
+    Mesh mesh = generator.generate(config.curvedConfig);
+
+    // One shared station per interface: 34 elements, 35 stations
+    const int ni = 35, nj = 3, nk = 3;
+    ASSERT_EQ(mesh.getNodeCount(), static_cast<size_t>(ni * nj * nk));
+    ASSERT_NEAR(generator.getStats().arcLength, 40 + 5 * M_PI + 20, 1e-6);
+
+    // Centerline node of station i (middle of width and thickness)
+    auto center = [&](int i) { return mesh.getNode(1 + i + ni + ni * nj)->position; };
+    ASSERT_NEAR(center(10).x, 40.0, 1e-9);      // straight -> arc
+    ASSERT_NEAR(center(10).z, 0.0, 1e-9);
+    ASSERT_NEAR(center(20).x, 45.0, 1e-9);      // arc apex
+    ASSERT_NEAR(center(20).z, 5.0, 1e-9);
+    ASSERT_NEAR(center(30).x, 40.0, 1e-9);      // arc -> spline, heading back along -X
+    ASSERT_NEAR(center(30).z, 10.0, 1e-9);
+    ASSERT_NEAR(center(34).x, 20.0, 1e-6);
+    ASSERT_NEAR(center(34).z, 10.0, 1e-6);
+
+    // Thickness follows the arc normal: k = 0 is the outside of the turn
+    ASSERT_NEAR(mesh.getNode(1 + 20 + ni)->position.x, 45.5, 1e-9);
+}
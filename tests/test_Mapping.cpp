@@ -7,7 +7,13 @@
 #include "mapper/FaceInterpolator.h"
 #include "grid/BoundaryExtractor.h"
 #include "grid/EdgeCalculator.h"
+#include "grid/ConnectivityAnalyzer.h"
+#include "grid/StructuredGridIndexer.h"
+#include "grid/HexRefiner.h"
+#include "util/CpuFeatures.h"
+#include <algorithm>
 #include <cmath>
+#include <sstream>
 
 using namespace KooRemapper;
 using namespace KooRemapper::Test;
@@ -339,3 +345,392 @@ TEST(Mapping_LargeGridInterpolation) {
     }
     ASSERT_EQ(count, expected);
 }
+
+// ============================================================
+// Mapping Derivative Tests
+// ============================================================
+
+// Quarter-ring block: i runs along the arc, j across, k through the radius
+Mesh createQuarterRingMesh(int ni, int nj, int nk) {
+    Mesh mesh;
+    auto nodeId = [=](int i, int j, int k) { return 1 + i + j * (ni + 1) + k * (ni + 1) * (nj + 1); };
+
+    for (int k = 0; k <= nk; ++k) {
+        for (int j = 0; j <= nj; ++j) {
+            for (int i = 0; i <= ni; ++i) {
+                double theta = 0.5 * M_PI * i / ni;
+                double r = 10.0 + 2.0 * k / nk;
+                mesh.addNode(Node(nodeId(i, j, k), r * std::sin(theta), 3.0 * j / nj, r * std::cos(theta)));
+            }
+        }
+    }
+
+    int elemId = 1;
+    for (int k = 0; k < nk; ++k) {
+        for (int j = 0; j < nj; ++j) {
+            for (int i = 0; i < ni; ++i) {
+                Element elem;
+                elem.id = elemId++;
+                elem.partId = 1;
+                elem.nodeIds = {nodeId(i, j, k), nodeId(i + 1, j, k), nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k),
+                                nodeId(i, j, k + 1), nodeId(i + 1, j, k + 1), nodeId(i + 1, j + 1, k + 1), nodeId(i, j + 1, k + 1)};
+                mesh.addElement(elem);
+            }
+        }
+    }
+    return mesh;
+}
+
+bool buildMapperFor(Mesh mesh, ParametricMapper& mapper) {
+    ConnectivityAnalyzer connectivity;
+    StructuredGridIndexer indexer;
+    BoundaryExtractor boundary;
+    EdgeCalculator edgeCalc;
+
+    connectivity.buildConnectivity(mesh);
+    if (!indexer.assignIndices(mesh, connectivity)) return false;
+    boundary.extract(mesh);
+    edgeCalc.calculateAllEdges(mesh, boundary);
+    mapper.build(mesh, boundary, edgeCalc, indexer.isPeriodic(0));
+    return mapper.isValid();
+}
+
+TEST(ParametricMapper_DerivativesMatchFiniteDifferences) {
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(12, 2, 2), mapper));
+
+    const double h = 1e-6;
+    const double points[3][3] = {{0.31, 0.4, 0.7}, {0.55, 0.2, 0.1}, {0.82, 0.9, 0.5}};
+    for (const auto& p : points) {
+        MappingDerivatives d = mapper.evaluate(p[0], p[1], p[2]);
+        Vector3D pos = mapper.mapToPhysical(p[0], p[1], p[2]);
+        ASSERT_NEAR((d.position - pos).magnitude(), 0.0, 1e-12);
+
+        Vector3D fdU = (mapper.mapToPhysical(p[0] + h, p[1], p[2]) -
+                        mapper.mapToPhysical(p[0] - h, p[1], p[2])) / (2 * h);
+        Vector3D fdV = (mapper.mapToPhysical(p[0], p[1] + h, p[2]) -
+                        mapper.mapToPhysical(p[0], p[1] - h, p[2])) / (2 * h);
+        Vector3D fdW = (mapper.mapToPhysical(p[0], p[1], p[2] + h) -
+                        mapper.mapToPhysical(p[0], p[1], p[2] - h)) / (2 * h);
+
+        ASSERT_NEAR((d.dXdu - fdU).magnitude(), 0.0, 1e-5 * fdU.magnitude());
+        ASSERT_NEAR((d.dXdv - fdV).magnitude(), 0.0, 1e-6);
+        ASSERT_NEAR((d.dXdw - fdW).magnitude(), 0.0, 1e-6);
+        ASSERT_GT(d.jacobian(), 0.0);
+    }
+}
+
+TEST(ParametricMapper_BatchMatchesSinglePoint) {
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(8, 2, 2), mapper));
+
+    std::vector<Vector3D> uvw;
+    for (int n = 0; n < 2000; ++n) {
+        uvw.push_back(Vector3D((n % 101) / 100.0, (n % 7) / 6.0, (n % 13) / 12.0));
+    }
+
+    std::vector<Vector3D> positions;
+    std::vector<MappingDerivatives> derivatives;
+    mapper.mapToPhysicalBatch(uvw, positions);
+    mapper.evaluateBatch(uvw, derivatives);
+
+    ASSERT_EQ(positions.size(), uvw.size());
+    ASSERT_EQ(derivatives.size(), uvw.size());
+    for (size_t n = 0; n < uvw.size(); ++n) {
+        Vector3D expected = mapper.mapToPhysical(uvw[n].x, uvw[n].y, uvw[n].z);
+        ASSERT_TRUE(positions[n] == expected);
+        ASSERT_TRUE(derivatives[n].position == expected);
+    }
+}
+
+TEST(ParametricMapper_BatchIdenticalOnEveryIsaLevel) {
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(9, 3, 2), mapper));
+
+    // Includes out-of-range parameters (clamped) and an odd tail
+    std::vector<Vector3D> uvw;
+    for (int n = 0; n < 1001; ++n) {
+        uvw.push_back(Vector3D(-0.1 + 1.2 * n / 1000.0, (n % 11) / 10.0, (n % 17) / 16.0));
+    }
+
+    IsaLevel original = CpuFeatures::active();
+    for (IsaLevel level : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (!CpuFeatures::setActive(level)) continue;
+
+        std::vector<Vector3D> positions;
+        mapper.mapToPhysicalBatch(uvw, positions);
+        for (size_t n = 0; n < uvw.size(); ++n) {
+            ASSERT_TRUE(positions[n] == mapper.mapToPhysical(uvw[n].x, uvw[n].y, uvw[n].z));
+        }
+    }
+    CpuFeatures::setActive(original);
+}
+
+TEST(ParametricMapper_SaveLoadRoundTrip) {
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(8, 2, 2), mapper));
+
+    std::stringstream cache;
+    ASSERT_TRUE(mapper.save(cache));
+
+    ParametricMapper loaded;
+    ASSERT_TRUE(loaded.load(cache));
+    ASSERT_TRUE(loaded.isValid());
+
+    for (int n = 0; n <= 50; ++n) {
+        double u = n / 50.0;
+        double v = (n % 5) / 4.0;
+        double w = (n % 3) / 2.0;
+        ASSERT_TRUE(loaded.mapToPhysical(u, v, w) == mapper.mapToPhysical(u, v, w));
+    }
+}
+
+TEST(ParametricMapper_CubicEdgesBatchAndCacheMatch) {
+    ParametricMapper coarse, fine, cubic;
+    cubic.setEdgeInterpolation(EdgeInterpolation::CUBIC);
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(6, 2, 2), coarse));
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(6, 2, 2), cubic));
+    ASSERT_TRUE(buildMapperFor(createQuarterRingMesh(24, 2, 2), fine));
+
+    // A coarse cubic reference beats a 4x finer linear one
+    double fineError = 0.0, cubicError = 0.0;
+    for (int n = 0; n <= 100; ++n) {
+        Vector3D pf = fine.mapToPhysical(n / 100.0, 0.5, 0.0);
+        Vector3D pc = cubic.mapToPhysical(n / 100.0, 0.5, 0.0);
+        fineError = std::max(fineError, std::abs(std::hypot(pf.x, pf.z) - 10.0));
+        cubicError = std::max(cubicError, std::abs(std::hypot(pc.x, pc.z) - 10.0));
+    }
+    ASSERT_TRUE(cubicError < fineError);
+
+    std::vector<Vector3D> uvw;
+    for (int n = 0; n < 1001; ++n) {
+        uvw.push_back(Vector3D(-0.1 + 1.2 * n / 1000.0, (n % 11) / 10.0, (n % 17) / 16.0));
+    }
+    IsaLevel original = CpuFeatures::active();
+    for (IsaLevel level : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (!CpuFeatures::setActive(level)) continue;
+
+        std::vector<Vector3D> positions;
+        cubic.mapToPhysicalBatch(uvw, positions);
+        for (size_t n = 0; n < uvw.size(); ++n) {
+            ASSERT_TRUE(positions[n] == cubic.mapToPhysical(uvw[n].x, uvw[n].y, uvw[n].z));
+        }
+    }
+    CpuFeatures::setActive(original);
+
+    std::stringstream cache;
+    ASSERT_TRUE(cubic.save(cache));
+    ParametricMapper loaded;
+    ASSERT_TRUE(loaded.load(cache));
+    ASSERT_TRUE(loaded.getEdgeInterpolation() == EdgeInterpolation::CUBIC);
+    for (const auto& p : uvw) {
+        ASSERT_TRUE(loaded.mapToPhysical(p.x, p.y, p.z) == cubic.mapToPhysical(p.x, p.y, p.z));
+    }
+}
+
+// Full ring around the y axis; the last elements reuse the i = 0 nodes,
+// or, without shareSeam, end on separate nodes at the same positions
+Mesh createClosedRingMesh(int ni, int nj, int nk, bool shareSeam = true) {
+    Mesh mesh;
+    const int columns = shareSeam ? ni : ni + 1;
+    auto nodeId = [=](int i, int j, int k) { return 1 + i % columns + j * columns + k * columns * (nj + 1); };
+
+    for (int k = 0; k <= nk; ++k) {
+        for (int j = 0; j <= nj; ++j) {
+            for (int i = 0; i < columns; ++i) {
+                double theta = 2.0 * M_PI * (i % ni) / ni;
+                double r = 10.0 + 2.0 * k / nk;
+                mesh.addNode(Node(nodeId(i, j, k), r * std::sin(theta), 3.0 * j / nj, r * std::cos(theta)));
+            }
+        }
+    }
+
+    int elemId = 1;
+    for (int k = 0; k < nk; ++k) {
+        for (int j = 0; j < nj; ++j) {
+            for (int i = 0; i < ni; ++i) {
+                Element elem;
+                elem.id = elemId++;
+                elem.partId = 1;
+                elem.nodeIds = {nodeId(i, j, k), nodeId(i + 1, j, k), nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k),
+                                nodeId(i, j, k + 1), nodeId(i + 1, j, k + 1), nodeId(i + 1, j + 1, k + 1), nodeId(i, j + 1, k + 1)};
+                mesh.addElement(elem);
+            }
+        }
+    }
+    return mesh;
+}
+
+TEST(StructuredGridIndexer_ClosedRingIsPeriodic) {
+    Mesh mesh = createClosedRingMesh(16, 2, 3);
+
+    ConnectivityAnalyzer connectivity;
+    connectivity.buildConnectivity(mesh);
+    ASSERT_TRUE(connectivity.isStructuredGrid());
+    ASSERT_TRUE(connectivity.findCornerElements().empty());
+
+    StructuredGridIndexer indexer;
+    ASSERT_TRUE(indexer.assignIndices(mesh, connectivity));
+    ASSERT_EQ(indexer.getDimI(), 16);
+    ASSERT_EQ(indexer.getDimJ(), 2);
+    ASSERT_EQ(indexer.getDimK(), 3);
+    ASSERT_TRUE(indexer.isPeriodic(0));
+    ASSERT_FALSE(indexer.isPeriodic(1));
+    ASSERT_FALSE(indexer.isPeriodic(2));
+
+    // Neighbours through the i faces are one index apart around the ring
+    for (const auto& [id, elem] : mesh.getElements()) {
+        for (const auto& neighbor : connectivity.getNeighbors(id)) {
+            if (neighbor.throughFace != 1) continue;
+            ASSERT_EQ(mesh.getElement(neighbor.neighborElementId)->i, (elem.i + 1) % 16);
+        }
+    }
+}
+
+TEST(ParametricMapper_ClosedRingWrapsAround) {
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createClosedRingMesh(16, 2, 2), mapper));
+    ASSERT_TRUE(mapper.isClosed());
+
+    // The seam maps to one place, and u continues past it
+    for (int n = 0; n <= 4; ++n) {
+        double v = n / 4.0;
+        double w = (n % 3) / 2.0;
+        Vector3D start = mapper.mapToPhysical(0.0, v, w);
+        ASSERT_NEAR((mapper.mapToPhysical(1.0, v, w) - start).magnitude(), 0.0, 1e-9);
+        ASSERT_TRUE(mapper.mapToPhysical(1.25, v, w) == mapper.mapToPhysical(0.25, v, w));
+        ASSERT_TRUE(mapper.mapToPhysical(-0.25, v, w) == mapper.mapToPhysical(0.75, v, w));
+    }
+
+    // Ring nodes of the inner surface (w = 0) are reproduced
+    for (int n = 0; n < 16; ++n) {
+        Vector3D p = mapper.mapToPhysical(n / 16.0, 0.5, 0.0);
+        ASSERT_NEAR(std::sqrt(p.x * p.x + p.z * p.z), 10.0, 1e-9);
+    }
+
+    std::vector<Vector3D> uvw;
+    for (int n = 0; n < 301; ++n) {
+        uvw.push_back(Vector3D(-1.5 + 3.0 * n / 300.0, (n % 5) / 4.0, (n % 7) / 6.0));
+    }
+    IsaLevel original = CpuFeatures::active();
+    for (IsaLevel level : {IsaLevel::BASELINE, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (!CpuFeatures::setActive(level)) continue;
+
+        std::vector<Vector3D> positions;
+        mapper.mapToPhysicalBatch(uvw, positions);
+        for (size_t n = 0; n < uvw.size(); ++n) {
+            ASSERT_TRUE(positions[n] == mapper.mapToPhysical(uvw[n].x, uvw[n].y, uvw[n].z));
+        }
+    }
+    CpuFeatures::setActive(original);
+}
+
+TEST(ParametricMapper_UnmergedSeamStaysOpen) {
+    // Ends coincide in space but share no nodes: an open block, so u clamps
+    ParametricMapper mapper;
+    ASSERT_TRUE(buildMapperFor(createClosedRingMesh(16, 2, 2, false), mapper));
+    ASSERT_FALSE(mapper.isClosed());
+    ASSERT_TRUE(mapper.mapToPhysical(1.25, 0.5, 0.5) == mapper.mapToPhysical(1.0, 0.5, 0.5));
+    ASSERT_TRUE(mapper.mapToPhysical(-0.25, 0.5, 0.5) == mapper.mapToPhysical(0.0, 0.5, 0.5));
+
+    std::stringstream cache;
+    ASSERT_TRUE(mapper.save(cache));
+    ParametricMapper loaded;
+    ASSERT_TRUE(loaded.load(cache));
+    ASSERT_FALSE(loaded.isClosed());
+
+    ParametricMapper ring;
+    ASSERT_TRUE(buildMapperFor(createClosedRingMesh(16, 2, 2), ring));
+    std::stringstream ringCache;
+    ASSERT_TRUE(ring.save(ringCache));
+    ASSERT_TRUE(loaded.load(ringCache));
+    ASSERT_TRUE(loaded.isClosed());
+}
+
+// ============================================================
+// HexRefiner Tests
+// ============================================================
+
+TEST(HexRefiner_SharedNodesCreatedOnce) {
+    Mesh mesh = create2x2x2Mesh();
+
+    HexRefiner refiner;
+    ASSERT_TRUE(refiner.build(mesh, {{2, 1, 3}}));
+
+    // Conforming lattice of (2*2+1) x (2*1+1) x (2*3+1) nodes
+    ASSERT_EQ(refiner.getNodeCount(), static_cast<size_t>(5 * 3 * 7));
+    ASSERT_EQ(refiner.getElementCount(), static_cast<size_t>(8 * 6));
+
+    // Originals keep their IDs, new ones follow the highest
+    const auto& ids = refiner.getNodeIds();
+    ASSERT_EQ(ids.front(), 1);
+    ASSERT_EQ(ids[27], 28);
+    ASSERT_EQ(ids.back(), static_cast<int>(5 * 3 * 7));
+
+    // No two nodes share a position
+    std::vector<std::array<long, 3>> keys;
+    for (const auto& p : refiner.getPositions()) {
+        keys.push_back({{std::lround(p.x * 12), std::lround(p.y * 12), std::lround(p.z * 12)}});
+    }
+    std::sort(keys.begin(), keys.end());
+    ASSERT_TRUE(std::adjacent_find(keys.begin(), keys.end()) == keys.end());
+
+    // Sub-elements use existing nodes and keep their parent's volume
+    double volume = 0.0;
+    int expectedId = 1;
+    bool idsInOrder = true;
+    refiner.forEachElement([&](const Element& elem) {
+        idsInOrder = idsInOrder && elem.id == expectedId++;
+        std::array<Vector3D, 8> c;
+        for (int i = 0; i < 8; ++i) {
+            c[i] = refiner.getPositions()[static_cast<size_t>(refiner.indexOf(elem.nodeIds[i]))];
+        }
+        Vector3D size = c[6] - c[0];
+        volume += size.x * size.y * size.z;
+    });
+    ASSERT_TRUE(idsInOrder);
+    ASSERT_NEAR(volume, 1.0, 1e-12);
+
+    // Rebuilding gives the same numbering
+    HexRefiner again;
+    ASSERT_TRUE(again.build(mesh, {{2, 1, 3}}));
+    ASSERT_TRUE(again.getNodeIds() == ids);
+    ASSERT_NEAR(again.getPositions().back().x, refiner.getPositions().back().x, 0.0);
+}
+
+TEST(HexRefiner_RejectsMismatchedSharedEdges) {
+    // Two unit hexes sharing face 2-3-7-6, the second one rotated so its
+    // local first axis runs along global y
+    Mesh mesh;
+    mesh.addNode(Node(1, 0, 0, 0));
+    mesh.addNode(Node(2, 1, 0, 0));
+    mesh.addNode(Node(3, 1, 1, 0));
+    mesh.addNode(Node(4, 0, 1, 0));
+    mesh.addNode(Node(5, 0, 0, 1));
+    mesh.addNode(Node(6, 1, 0, 1));
+    mesh.addNode(Node(7, 1, 1, 1));
+    mesh.addNode(Node(8, 0, 1, 1));
+    mesh.addNode(Node(9, 2, 0, 0));
+    mesh.addNode(Node(10, 2, 1, 0));
+    mesh.addNode(Node(11, 2, 0, 1));
+    mesh.addNode(Node(12, 2, 1, 1));
+    mesh.addElement(Element(1, 1, {{1, 2, 3, 4, 5, 6, 7, 8}}));
+    mesh.addElement(Element(2, 1, {{9, 10, 3, 2, 11, 12, 7, 6}}));
+
+    HexRefiner refiner;
+    ASSERT_FALSE(refiner.build(mesh, {{2, 1, 1}}));
+    ASSERT_FALSE(refiner.getErrorMessage().empty());
+
+    // Equal factors are orientation independent: 3x3x3 lattice x 2 - shared face
+    ASSERT_TRUE(refiner.build(mesh, {{2, 2, 2}}));
+    ASSERT_EQ(refiner.getNodeCount(), static_cast<size_t>(5 * 3 * 3));
+
+    std::array<int, 3> levels;
+    std::string error;
+    ASSERT_TRUE(HexRefiner::parseLevels("3", levels, error));
+    ASSERT_EQ(levels[2], 3);
+    ASSERT_TRUE(HexRefiner::parseLevels("2,1,4", levels, error));
+    ASSERT_EQ(levels[1], 1);
+    ASSERT_FALSE(HexRefiner::parseLevels("2,0,1", levels, error));
+    ASSERT_FALSE(HexRefiner::parseLevels("2,2", levels, error));
+}
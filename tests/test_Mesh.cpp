@@ -2,6 +2,8 @@
 #include "core/Mesh.h"
 #include "core/Node.h"
 #include "core/Element.h"
+#include "core/ElementBuckets.h"
+#include "util/Validator.h"
 
 using namespace KooRemapper;
 using namespace KooRemapper::Test;
@@ -183,6 +185,71 @@ TEST(Element_StaticFaceInfo) {
     ASSERT_EQ(Element::getFaceAxis(5), 2);  // k+
 }
 
+TEST(ElementBuckets_SplitByTypeInIdOrder) {
+    // Unit cube nodes 1-8 plus an apex 9 above the top face
+    Mesh mesh;
+    const double xyz[9][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                              {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1},
+                              {0.5, 0.5, 2}};
+    for (int n = 0; n < 9; ++n) {
+        mesh.addNode(Node(n + 1, xyz[n][0], xyz[n][1], xyz[n][2]));
+    }
+
+    // IDs 1, 2 HEX8; 3 TET4; 4 HEX8; 5 HEX20
+    mesh.addElement(1, 1, {1, 2, 3, 4, 5, 6, 7, 8});
+    mesh.addElement(2, 1, {1, 2, 3, 4, 5, 6, 7, 8});
+    Element tet(3, 2, {5, 6, 7, 9, 9, 9, 9, 9});
+    tet.type = ElementType::TET4;
+    mesh.addElement(tet);
+    mesh.addElement(4, 1, {1, 2, 3, 4, 5, 6, 7, 8});
+    Element other(5, 3, {1, 2, 3, 4, 5, 6, 7, 8});
+    other.type = ElementType::HEX20;
+    mesh.addElement(other);
+
+    ElementBuckets buckets(mesh);
+    ASSERT_EQ(buckets.size(), 5u);
+    ASSERT_EQ(buckets.hex8().size(), 3u);
+    ASSERT_EQ(buckets.tet4().size(), 1u);
+    ASSERT_EQ(buckets.other().size(), 1u);
+    ASSERT_EQ(buckets.getRunCount(), 4u);
+
+    ASSERT_EQ(buckets.hex8().ids[2], 4);
+    ASSERT_EQ(buckets.hex8().positions[2], 3u);
+    ASSERT_EQ(buckets.tet4().partIds[0], 2);
+    ASSERT_EQ(buckets.tet4().nodeIds[0][3], 9);
+
+    ElementType type;
+    size_t slot = 0;
+    ASSERT_TRUE(buckets.find(3, type, slot));
+    ASSERT_TRUE(type == ElementType::TET4);
+    ASSERT_EQ(slot, 0u);
+    ASSERT_TRUE(buckets.find(4, type, slot));
+    ASSERT_TRUE(type == ElementType::HEX8);
+    ASSERT_EQ(slot, 2u);
+    ASSERT_FALSE(buckets.find(6, type, slot));
+
+    // Runs visit every element once, in ID order
+    std::vector<int> order;
+    buckets.forEachRun([&](const auto& bucket, size_t first, size_t count) {
+        for (size_t s = first; s < first + count; ++s) {
+            order.push_back(bucket.ids[s]);
+        }
+    });
+    ASSERT_EQ(order.size(), 5u);
+    for (size_t n = 0; n < order.size(); ++n) {
+        ASSERT_EQ(order[n], static_cast<int>(n + 1));
+    }
+
+    // Bucketed Jacobians match the per-element path, in mesh order
+    std::vector<double> jacobians = Validator::calculateJacobians(mesh);
+    ASSERT_EQ(jacobians.size(), 5u);
+    size_t index = 0;
+    for (const auto& [id, elem] : mesh.getElements()) {
+        ASSERT_NEAR(jacobians[index++], Validator::calculateJacobian(mesh, elem), 1e-12);
+    }
+    ASSERT_NEAR(jacobians[2], 1.0, 1e-12);
+}
+
 // ============================================================
 // Node Tests
 // ============================================================
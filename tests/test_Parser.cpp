@@ -0,0 +1,492 @@
+#include "TestFramework.h"
+#include "core/Mesh.h"
+#include "parser/KFileReader.h"
+#include "parser/KFileWriter.h"
+#include "parser/AbaqusWriter.h"
+#include "parser/NastranWriter.h"
+#include "parser/ShardWriter.h"
+#include "parser/PointSetIO.h"
+#include "util/AsyncFileWriter.h"
+#include "util/Metrics.h"
+#include "util/TuningProfile.h"
+#include "util/Validator.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace KooRemapper;
+using namespace KooRemapper::Test;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("kooremapper_test_" + name)).string();
+}
+
+// Row of n HEX8 elements (4n+4 nodes)
+Mesh createHexRow(int n) {
+    Mesh mesh;
+    int id = 1;
+    for (int i = 0; i <= n; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            mesh.addNode(id++, i, (c == 1 || c == 2) ? 1.0 : 0.0, c >= 2 ? 1.0 : 0.0);
+        }
+    }
+    for (int e = 0; e < n; ++e) {
+        int a = 4 * e + 1;
+        int b = a + 4;
+        mesh.addElement(e + 1, 1, {a, b, b + 1, a + 1, a + 3, b + 3, b + 2, a + 2});
+    }
+    return mesh;
+}
+
+// Input that can only be read forward, like a pipe
+class ForwardOnlyBuffer : public std::streambuf {
+public:
+    explicit ForwardOnlyBuffer(const std::string& data) : data_(data), pos_(0) {}
+
+protected:
+    int_type underflow() override {
+        if (pos_ >= data_.size()) return traits_type::eof();
+        size_t n = std::min<size_t>(7, data_.size() - pos_);
+        std::copy(data_.begin() + pos_, data_.begin() + pos_ + n, chunk_);
+        pos_ += n;
+        setg(chunk_, chunk_, chunk_ + n);
+        return traits_type::to_int_type(chunk_[0]);
+    }
+
+private:
+    std::string data_;
+    size_t pos_;
+    char chunk_[7];
+};
+
+} // anonymous namespace
+
+// ============================================================
+// Partitioned Reading Tests
+// ============================================================
+
+TEST(KFileReader_PartitionsCoverMeshOnce) {
+    std::string file = tempPath("partition.k");
+    KFileWriter writer;
+    ASSERT_TRUE(writer.writeFile(file, createHexRow(25), false));
+
+    KFileReader reader;
+    Mesh full = reader.readFile(file);
+    auto sections = reader.scanSections(file);
+
+    size_t nodes = 0, elements = 0;
+    Mesh merged;
+    for (int part = 0; part < 3; ++part) {
+        Mesh mesh = reader.readPartition(file, sections, part, 3);
+        nodes += mesh.getNodeCount();
+        elements += mesh.getElementCount();
+        for (const auto& [id, node] : mesh.nodes) merged.addNode(node);
+        for (const auto& [id, elem] : mesh.elements) merged.addElement(elem);
+    }
+
+    ASSERT_EQ(nodes, full.getNodeCount());
+    ASSERT_EQ(elements, full.getElementCount());
+    ASSERT_EQ(merged.getNodeCount(), full.getNodeCount());
+    ASSERT_EQ(merged.getElementCount(), full.getElementCount());
+
+    std::filesystem::remove(file);
+}
+
+TEST(KFileReader_ReadsNonSeekableStream) {
+    std::ostringstream text;
+    KFileWriter writer;
+    ASSERT_TRUE(writer.write(text, createHexRow(4), false));
+    std::string data = text.str();
+    // Sections after the elements exercise the keyword look-ahead
+    data.insert(data.rfind("*END"),
+                "*PART\n$ heading\n       1       1       7\n"
+                "*MAT_ELASTIC\n         7    7.8e-9  210000.0       0.3\n");
+
+    ForwardOnlyBuffer buffer(data);
+    std::istream in(&buffer);
+    KFileReader reader;
+    Mesh mesh = reader.read(in);
+
+    Mesh expected = createHexRow(4);
+    ASSERT_EQ(mesh.getNodeCount(), expected.getNodeCount());
+    ASSERT_EQ(mesh.getElementCount(), expected.getElementCount());
+    for (const auto& [id, node] : expected.nodes) {
+        ASSERT_TRUE(mesh.getNode(id) != nullptr);
+        ASSERT_NEAR(mesh.getNode(id)->position.y, node.position.y, 1e-9);
+    }
+    ASSERT_EQ(mesh.parts.size(), static_cast<size_t>(1));
+    ASSERT_EQ(mesh.materials.size(), static_cast<size_t>(1));
+}
+
+TEST(Validator_PreflightFindsBlocksAndTruncation) {
+    std::ostringstream text;
+    KFileWriter writer;
+    ASSERT_TRUE(writer.write(text, createHexRow(4), false));
+    const std::string data = text.str();
+    Mesh expected = createHexRow(4);
+
+    std::string file = tempPath("preflight.k");
+    std::ofstream(file, std::ios::binary) << data;
+    KFilePreflight report = Validator::preflightKFile(file);
+    ASSERT_TRUE(report.validation.isValid);
+    ASSERT_TRUE(report.hasEnd);
+    ASSERT_EQ(report.fileSize, static_cast<long long>(data.size()));
+
+    size_t nodeRecords = 0, elementRecords = 0;
+    long long blockBytes = 0;
+    for (const auto& block : report.blocks) {
+        if (block.keyword == "NODE") nodeRecords += block.records;
+        if (block.keyword == "ELEMENT_SOLID") elementRecords += block.records;
+        ASSERT_FALSE(block.freeFormat);
+        blockBytes += block.bytes;
+    }
+    ASSERT_EQ(nodeRecords, expected.getNodeCount());
+    ASSERT_EQ(elementRecords, expected.getElementCount());
+    ASSERT_TRUE(blockBytes <= report.fileSize);
+
+    // Cut inside the element block: no *END, last line incomplete
+    std::ofstream(file, std::ios::binary | std::ios::trunc) << data.substr(0, data.rfind("*END") - 30);
+    report = Validator::preflightKFile(file);
+    ASSERT_FALSE(report.validation.isValid);
+    ASSERT_FALSE(report.hasEnd);
+    ASSERT_FALSE(Validator::isValidKFile(file));
+
+    // Records the parser would drop
+    std::ofstream(file, std::ios::binary | std::ios::trunc)
+        << "*KEYWORD\n*NODE\n1,0.0,0.0,0.0\n2 1.0 0.0\n*END\n";
+    report = Validator::preflightKFile(file);
+    ASSERT_FALSE(report.validation.isValid);
+    ASSERT_EQ(report.blocks.size(), static_cast<size_t>(3));
+    ASSERT_TRUE(report.blocks[1].freeFormat);
+    ASSERT_EQ(report.blocks[1].records, static_cast<size_t>(2));
+
+    std::filesystem::remove(file);
+}
+
+// ============================================================
+// Shard Output Tests
+// ============================================================
+
+TEST(ShardMerger_ConcatenatesSegmentsInOrder) {
+    std::string output = tempPath("merged.txt");
+
+    for (int k = 0; k < 3; ++k) {
+        ShardWriter writer;
+        ASSERT_TRUE(writer.open(output, k, 3));
+        ASSERT_TRUE(writer.writeFirst("head\n"));
+        ASSERT_TRUE(writer.write("a" + std::to_string(k) + "\n"));
+        ASSERT_TRUE(writer.write("b" + std::to_string(k) + "\n"));
+        ASSERT_TRUE(writer.writeFirst("end\n"));
+        ASSERT_TRUE(writer.close());
+    }
+
+    ShardMerger merger;
+    ASSERT_TRUE(merger.merge(output, true));
+    ASSERT_EQ(merger.getShardCount(), 3);
+
+    std::ifstream in(output);
+    std::stringstream content;
+    content << in.rdbuf();
+    ASSERT_EQ(content.str(), std::string("head\na0\na1\na2\nb0\nb1\nb2\nend\n"));
+    ASSERT_FALSE(std::filesystem::exists(ShardWriter::partialPath(output, 1)));
+
+    in.close();
+    std::filesystem::remove(output);
+}
+
+TEST(ShardMerger_RequiresAllShards) {
+    std::string output = tempPath("incomplete.txt");
+
+    ShardWriter writer;
+    ASSERT_TRUE(writer.open(output, 0, 2));
+    ASSERT_TRUE(writer.write("only shard 0\n"));
+    ASSERT_TRUE(writer.close());
+
+    ShardMerger merger;
+    ASSERT_FALSE(merger.merge(output));
+
+    std::filesystem::remove(ShardWriter::partialPath(output, 0));
+    std::filesystem::remove(ShardWriter::manifestPath(output, 0));
+}
+
+// ============================================================
+// Point Set Tests
+// ============================================================
+
+TEST(PointSetIO_CsvKeepsHeaderAndExtraColumns) {
+    std::string input = tempPath("points.csv");
+    std::string output = tempPath("points_out.csv");
+    {
+        std::ofstream file(input);
+        file << "x,y,z,label\n1,2,3,a\n\n4.5,-5,6e1,b c\n7,8,9\n";
+    }
+
+    PointSetReader reader;
+    ASSERT_TRUE(reader.open(input, pointFormatFromPath(input)));
+    ASSERT_EQ(reader.getHeader(), std::string("x,y,z,label"));
+
+    PointSetWriter writer;
+    ASSERT_TRUE(writer.open(output, PointFormat::CSV, reader.getHeader(), reader.getSeparator()));
+
+    PointChunk chunk;
+    size_t chunks = 0;
+    while (reader.read(chunk, 2) > 0) {
+        ++chunks;
+        ASSERT_TRUE(writer.write(chunk));
+    }
+    ASSERT_FALSE(reader.hasError());
+    ASSERT_TRUE(writer.close());
+    ASSERT_EQ(chunks, static_cast<size_t>(2));
+    ASSERT_EQ(reader.getPointsRead(), 3LL);
+    reader.close();
+
+    std::ifstream in(output);
+    std::stringstream content;
+    content << in.rdbuf();
+    ASSERT_EQ(content.str(), std::string("x,y,z,label\n1,2,3,a\n4.5,-5,60,b c\n7,8,9\n"));
+
+    in.close();
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST(PointSetIO_BinaryRoundTrip) {
+    std::string file = tempPath("points.bin");
+    ASSERT_TRUE(pointFormatFromPath(file) == PointFormat::BINARY);
+
+    PointChunk chunk;
+    for (int n = 0; n < 1000; ++n) {
+        chunk.points.push_back(Vector3D(n * 0.1, -n / 3.0, 1e-7 * n));
+    }
+    PointSetWriter writer;
+    ASSERT_TRUE(writer.open(file, PointFormat::BINARY));
+    ASSERT_TRUE(writer.write(chunk));
+    ASSERT_TRUE(writer.close());
+
+    PointSetReader reader;
+    ASSERT_TRUE(reader.open(file, PointFormat::BINARY));
+    PointChunk part;
+    std::vector<Vector3D> all;
+    while (reader.read(part, 300) > 0) {
+        all.insert(all.end(), part.points.begin(), part.points.end());
+    }
+    ASSERT_FALSE(reader.hasError());
+    ASSERT_EQ(all.size(), chunk.points.size());
+    for (size_t n = 0; n < all.size(); ++n) {
+        ASSERT_TRUE(all[n] == chunk.points[n]);
+    }
+
+    reader.close();
+    std::filesystem::remove(file);
+}
+
+// ============================================================
+// Async Output Tests
+// ============================================================
+
+TEST(AsyncFileWriter_ManySmallBuffersKeepOrder) {
+    std::string file = tempPath("async.txt");
+
+    // 64-byte buffers force thousands of hand-offs to the writer thread
+    AsyncFileWriter writer;
+    ASSERT_TRUE(writer.open(file, std::ios::binary, 64, 3));
+    std::ostream out(&writer);
+    std::string expected;
+    for (int i = 0; i < 20000; ++i) {
+        std::string line = std::to_string(i) + (i % 7 == 0 ? std::string(150, 'x') : "") + "\n";
+        out << line;
+        expected += line;
+    }
+    ASSERT_TRUE(writer.close());
+    ASSERT_EQ(writer.getBytesWritten(), static_cast<long long>(expected.size()));
+
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    ASSERT_TRUE(content.str() == expected);
+
+    in.close();
+    std::filesystem::remove(file);
+}
+
+TEST(AsyncOutputStream_ReportsOpenFailure) {
+    std::string file = (std::filesystem::temp_directory_path() /
+                        "kooremapper_missing_dir" / "out.k").string();
+    AsyncOutputStream out(file);
+    ASSERT_FALSE(out.is_open());
+    ASSERT_FALSE(out.good());
+
+    KFileWriter writer;
+    ASSERT_FALSE(writer.writeFile(file, createHexRow(1)));
+}
+
+TEST(TuningProfile_SaveLoadAndSmallBuffers) {
+    std::string file = tempPath("tune.cfg");
+    TuningProfile profile;
+    profile.threads = 3;
+    profile.mapChunk = 1024;
+    profile.elementChunk = 16;
+    profile.readBuffer = 4096;
+    profile.writeBuffer = 4096;
+
+    std::string error;
+    ASSERT_TRUE(profile.save(file, error));
+    TuningProfile loaded;
+    ASSERT_TRUE(loaded.load(file, error));
+    ASSERT_EQ(loaded.threads, 3);
+    ASSERT_EQ(loaded.mapChunk, 1024u);
+    ASSERT_EQ(loaded.elementChunk, 16u);
+    ASSERT_EQ(loaded.readBuffer, 4096u);
+    ASSERT_EQ(loaded.writeBuffer, 4096u);
+
+    // Rejected values leave the profile unchanged
+    {
+        std::ofstream out(file);
+        out << "map_chunk = 0\n";
+    }
+    ASSERT_FALSE(loaded.load(file, error));
+    ASSERT_EQ(loaded.mapChunk, 1024u);
+    std::filesystem::remove(file);
+
+    // Buffers far smaller than the file still round-trip a mesh
+    TuningProfile::apply(loaded);
+    std::string kfile = tempPath("tune.k");
+    KFileWriter writer;
+    ASSERT_TRUE(writer.writeFile(kfile, createHexRow(200)));
+    KFileReader reader;
+    Mesh mesh = reader.readFile(kfile);
+    TuningProfile::apply(TuningProfile());
+    std::filesystem::remove(kfile);
+
+    ASSERT_EQ(mesh.getNodeCount(), 804u);
+    ASSERT_EQ(mesh.getElementCount(), 200u);
+}
+
+TEST(Metrics_CountsKFileLinesAndWriterRecords) {
+    if (!Metrics::enabled()) return;  // Built with KOOREMAPPER_METRICS=OFF
+
+    std::string kfile = tempPath("metrics.k");
+    Metrics::Values before = Metrics::snapshot();
+    KFileWriter writer;
+    ASSERT_TRUE(writer.writeFile(kfile, createHexRow(3)));
+    Metrics::Values written = Metrics::snapshot();
+
+    size_t lines = 0, comments = 0, bytes = 0;
+    {
+        std::ifstream in(kfile);
+        std::string line;
+        while (std::getline(in, line)) {
+            ++lines;
+            if (!line.empty() && line[0] == '$') ++comments;
+            bytes += line.size() + 1;
+        }
+    }
+
+    KFileReader reader;
+    Mesh mesh = reader.readFile(kfile);
+    Metrics::Values after = Metrics::snapshot();
+    std::filesystem::remove(kfile);
+    ASSERT_EQ(mesh.getNodeCount(), 16u);
+
+    auto delta = [](const Metrics::Values& a, const Metrics::Values& b, Metrics::Counter c) {
+        return static_cast<size_t>(b[c] - a[c]);
+    };
+    ASSERT_EQ(delta(before, written, Metrics::WRITER_NODE_LINES), 16u);
+    ASSERT_EQ(delta(before, written, Metrics::WRITER_ELEMENT_LINES), 3u);
+    ASSERT_EQ(delta(before, written, Metrics::WRITER_BYTES), bytes);
+    ASSERT_EQ(delta(written, after, Metrics::KFILE_LINES), lines);
+    ASSERT_EQ(delta(written, after, Metrics::KFILE_COMMENT_LINES), comments);
+    ASSERT_TRUE(delta(written, after, Metrics::KFILE_BYTES_NODE) > 16u * 40u);
+
+    size_t total = 0;
+    for (int c = Metrics::KFILE_BYTES_NODE; c <= Metrics::KFILE_BYTES_OTHER; ++c) {
+        total += delta(written, after, static_cast<Metrics::Counter>(c));
+    }
+    ASSERT_EQ(total, bytes);
+}
+
+TEST(SolverWriters_AbaqusAndNastranLayout) {
+    Mesh mesh = createHexRow(3);
+    mesh.elements[3].partId = 2;
+
+    std::vector<std::string> lines;
+    auto split = [&lines](const std::string& text) {
+        lines.clear();
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) lines.push_back(line);
+    };
+    auto count = [&lines](const std::string& prefix) {
+        int n = 0;
+        for (const auto& line : lines) n += line.compare(0, prefix.size(), prefix) == 0;
+        return n;
+    };
+
+    // Abaqus: a new *ELEMENT block where the part changes
+    std::ostringstream inp;
+    AbaqusWriter abaqus;
+    ASSERT_TRUE(abaqus.write(inp, mesh, false));
+    split(inp.str());
+    ASSERT_EQ(count("*NODE"), 1);
+    ASSERT_EQ(count("*ELEMENT, TYPE=C3D8, ELSET=PART-1"), 1);
+    ASSERT_EQ(count("*ELEMENT, TYPE=C3D8, ELSET=PART-2"), 1);
+    ASSERT_EQ(count("3, 9, 13, 14, 10, 12, 16, 15, 11"), 1);
+
+    MeshAnalysisResult results;
+    results.hasMaterial = true;
+    ElementResult er;
+    er.elementId = 7;
+    er.stress = StressTensor(1, 2, 3, 4, 5, 6);  // xx yy zz xy yz xz
+    results.elementResults.push_back(er);
+    std::ostringstream stress;
+    abaqus.setPrecision(1);
+    abaqus.writeStressLines(stress, results);
+    split(stress.str());
+    ASSERT_EQ(lines.size(), static_cast<size_t>(2));
+    ASSERT_TRUE(lines[1] == "7, 1.0e+00, 2.0e+00, 3.0e+00, 4.0e+00, 6.0e+00, 5.0e+00");
+
+    // Nastran free field: GRID* with a continuation, CHEXA over two lines
+    NastranWriter nastran;
+    std::ostringstream free;
+    ASSERT_TRUE(nastran.write(free, mesh, false));
+    split(free.str());
+    ASSERT_EQ(count("BEGIN BULK"), 1);
+    ASSERT_EQ(count("GRID*,"), 16);
+    ASSERT_EQ(count("CHEXA,"), 3);
+    ASSERT_EQ(count("CHEXA,3,2,9,13,14,10,12,16"), 1);
+    ASSERT_EQ(count("+,15,11"), 1);
+    ASSERT_EQ(count("ENDDATA"), 1);
+
+    // Large field: 8-character name plus 16-character fields
+    nastran.setFieldFormat(NastranField::LARGE);
+    std::ostringstream large;
+    ASSERT_TRUE(nastran.write(large, mesh, false));
+    split(large.str());
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].compare(0, 5, "GRID*") == 0) {
+            ASSERT_EQ(lines[i].size(), static_cast<size_t>(72));
+            ASSERT_EQ(lines[i + 1].size(), static_cast<size_t>(24));
+        }
+    }
+    ASSERT_EQ(count("CHEXA*  "), 3);
+    ASSERT_EQ(count("*       "), 16 + 3 * 2);
+
+    // Collapsed hexes: no repeated grids in any entry
+    nastran.setFieldFormat(NastranField::FREE);
+    mesh.addElement(4, 1, {1, 2, 3, 4, 5, 5, 8, 8});   // Wedge
+    mesh.addElement(5, 1, {1, 2, 3, 4, 5, 5, 5, 5});   // Pyramid
+    mesh.addElement(6, 1, {1, 2, 3, 4, 4, 4, 4, 4});   // Tetrahedron in hex form
+    std::ostringstream collapsed;
+    ASSERT_TRUE(nastran.write(collapsed, mesh, false));
+    split(collapsed.str());
+    ASSERT_EQ(count("CPENTA,4,1,1,2,5,4,3,8"), 1);
+    ASSERT_EQ(count("CPYRAM,5,1,1,2,3,4,5"), 1);
+    ASSERT_EQ(count("CTETRA,6,1,1,2,3,4"), 1);
+
+    mesh.addElement(7, 1, {1, 2, 2, 4, 5, 6, 7, 8});
+    std::ostringstream rejected;
+    ASSERT_FALSE(nastran.write(rejected, mesh, false));
+    ASSERT_TRUE(nastran.getErrorMessage().find("element 7") != std::string::npos);
+}
@@ -1,5 +1,6 @@
 #include "TestFramework.h"
 #include "core/Vector3D.h"
+#include "core/SimdMath.h"
 #include <cmath>
 
 using namespace KooRemapper;
@@ -169,3 +170,66 @@ TEST(Vector3D_CrossProductProperties) {
     ASSERT_NEAR(axb.dot(a), 0.0, 1e-10);
     ASSERT_NEAR(axb.dot(b), 0.0, 1e-10);
 }
+
+// ============================================================
+// SIMD Batch Math Tests
+// ============================================================
+
+TEST(SimdMath_Vec3PackMatchesScalar) {
+    const size_t W = SimdDouble::WIDTH;
+    std::vector<Vector3D> a, b;
+    for (size_t n = 0; n < W; ++n) {
+        a.push_back(Vector3D(1.0 + n, -2.0 * n, 0.5 + n * n));
+        b.push_back(Vector3D(0.3 * n, 4.0, -1.0 - n));
+    }
+    Vec3Pack pa = Vec3Pack::gather(a.data());
+    Vec3Pack pb = Vec3Pack::gather(b.data());
+
+    Vec3Pack cross = pa.cross(pb);
+    SimdDouble dot = pa.dot(pb);
+    SimdDouble mag = pa.magnitude();
+    for (size_t n = 0; n < W; ++n) {
+        Vector3D c = a[n].cross(b[n]);
+        ASSERT_NEAR((cross.lane(n) - c).magnitude(), 0.0, 1e-12);
+        ASSERT_NEAR(dot.lane(n), a[n].dot(b[n]), 1e-12);
+        ASSERT_NEAR(mag.lane(n), a[n].magnitude(), 1e-12);
+    }
+
+    // Partial gather zero-fills the remaining lanes
+    Vec3Pack partial = Vec3Pack::gather(a.data(), 1);
+    ASSERT_NEAR(partial.x.sum(), a[0].x, 1e-15);
+}
+
+TEST(SimdMath_Mat3PackInverseAndProducts) {
+    const size_t W = SimdDouble::WIDTH;
+    std::vector<Matrix3x3> mats;
+    for (size_t n = 0; n < W; ++n) {
+        double s = 1.0 + 0.1 * n;
+        mats.push_back(Matrix3x3(2.0 * s, 0.3, -0.1,
+                                 0.2, 1.5, 0.4 * s,
+                                 -0.3, 0.1 * n, 3.0));
+    }
+    Mat3Pack pack = Mat3Pack::gather(mats.data());
+
+    SimdDouble det;
+    Mat3Pack inv = pack.inverse(det);
+    Mat3Pack product = pack * inv;
+    SymTensorPack C = SymTensorPack::transposeProduct(pack);
+    SimdDouble detC;
+    SymTensorPack Cinv = C.inverse(detC);
+
+    std::vector<Matrix3x3> out(W);
+    product.scatter(out.data());
+    for (size_t n = 0; n < W; ++n) {
+        ASSERT_NEAR(det.lane(n), mats[n].determinant(), 1e-12);
+        ASSERT_TRUE(out[n].isApprox(Matrix3x3::identity(), 1e-12));
+        ASSERT_TRUE(inv.lane(n).isApprox(mats[n].inverse(), 1e-12));
+
+        Matrix3x3 c = mats[n].transpose() * mats[n];
+        ASSERT_TRUE(C.toMatrix().lane(n).isApprox(c, 1e-12));
+        ASSERT_NEAR(detC.lane(n), c.determinant(), 1e-10);
+        ASSERT_TRUE(Cinv.toMatrix().lane(n).isApprox(c.inverse(), 1e-12));
+        ASSERT_NEAR(C.frobeniusNorm().lane(n), c.frobeniusNorm(), 1e-12);
+        ASSERT_NEAR(pack.frobeniusNorm().lane(n), mats[n].frobeniusNorm(), 1e-12);
+    }
+}
@@ -5,6 +5,8 @@
 #include "test_Mesh.cpp"
 #include "test_Interpolation.cpp"
 #include "test_Mapping.cpp"
+#include "test_Analysis.cpp"
+#include "test_Parser.cpp"
 
 int main(int argc, char* argv[]) {
     (void)argc;